@@ -0,0 +1 @@
+Added ``asdf_access_hint_t`` access-pattern hints (``madvise``/``posix_fadvise``) for block data, settable per file with ``asdf_config_t.io.access_hint`` or per block/array with ``asdf_block_access_hint`` and ``asdf_ndarray_access_hint``; whole-array reads now prefetch by default and partial tile reads disable read-ahead.
@@ -0,0 +1 @@
+Added the ``io.background_blocks`` option to discover a file's blocks on a background thread while its YAML tree is built.
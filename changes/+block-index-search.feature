@@ -0,0 +1 @@
+The block index is now found in files with very many blocks by searching backwards from the end of the file, and is parsed without building a YAML document.
@@ -0,0 +1 @@
+Extension lookups no longer allocate, and the extension resolved for each tag is cached per file.
@@ -0,0 +1 @@
+Added `asdf_find_by_tag` and `asdf_find_by_key` for finding values by tag or mapping key through an index of the tree built on first use.
@@ -0,0 +1 @@
+Support reading ``float16``, ``complex64``, ``complex128`` and ``bool8`` ndarrays into any numeric datatype, with F16C fast paths for ``float16``.
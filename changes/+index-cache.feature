@@ -0,0 +1 @@
+Added an opt-in block index cache (``asdf_config_t.io.index_cache``) so that files written without a block index do not need to be scanned for their blocks on every open.
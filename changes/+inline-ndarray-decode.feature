@@ -0,0 +1 @@
+Inline ndarray data is now decoded straight from the YAML nodes without allocating a value per element, and large inline arrays are decoded on the file's worker threads when ``threads.n_threads`` is set.
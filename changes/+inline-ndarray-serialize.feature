@@ -0,0 +1 @@
+Inline ndarray data is now written as YAML text in a single buffer instead of building a node per element, and floats are written with the shortest digits that read back as the same value.
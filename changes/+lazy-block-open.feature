@@ -0,0 +1 @@
+Opening a block with ``asdf_block_open`` no longer parses the entire file when the file has a valid block index; only the requested block's header is read.
@@ -0,0 +1 @@
+Paths of values created while iterating over mappings and sequences are now only built when requested with ``asdf_value_path``.
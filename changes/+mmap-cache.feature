@@ -0,0 +1 @@
+Block data mappings are now shared between nearby blocks and cached for reuse, with O(log n) lookups and a configurable limit on the number of mappings (``asdf_config_t.io.mmap_cache_max_mappings`` and ``io.mmap_cache_granularity``).
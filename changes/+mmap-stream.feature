@@ -0,0 +1 @@
+Files opened read-only with ``asdf_open_file`` are now memory-mapped and parsed directly from the mapping by default, with a windowed mode for very large files; this can be configured with the new ``asdf_config_t.io`` options.
@@ -0,0 +1 @@
+Added ``asdf_ndarray_view`` for getting a pointer to a tile of an ndarray along with its byte strides, without copying the data.
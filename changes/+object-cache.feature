@@ -0,0 +1 @@
+Extension objects read from a file are now cached and reference counted, so reading the same value again returns the same object.
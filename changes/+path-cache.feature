@@ -0,0 +1 @@
+Cache the nodes found by the ``asdf_get_*`` and ``asdf_is_*`` path lookups per file, and add ``asdf_path_compile`` and ``asdf_get_value_path`` for looking up pre-parsed paths.
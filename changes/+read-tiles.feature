@@ -0,0 +1 @@
+Added ``asdf_ndarray_read_tiles`` for reading many tiles of an ndarray in one call, in order of their position in the data, with the ranges they cover prefetched and the tiles copied in parallel when threads are configured.
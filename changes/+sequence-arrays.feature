@@ -0,0 +1 @@
+Added ``asdf_sequence_as_<type>_array`` and ``asdf_get_<type>_array`` for reading sequences of numbers into C arrays in one call, and sped up parsing of plain decimal numbers.
@@ -0,0 +1 @@
+Byteswapping copies and the int16/uint16 to float32, float64 to float32 and int32/int16 narrowing ndarray conversions now use SSE4.1, AVX2 or AVX-512 kernels selected at runtime.
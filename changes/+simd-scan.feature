@@ -0,0 +1 @@
+Scanning the file for YAML tree and block boundaries now uses SSE2/AVX2 vectorized search when the CPU supports it, with a faster portable fallback otherwise.
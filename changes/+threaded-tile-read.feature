@@ -0,0 +1 @@
+Tile and full-array reads of ndarrays can be split across a pool of worker threads, configured with the new ``threads.n_threads`` and ``threads.min_task_bytes`` options of ``asdf_config_t``.
@@ -0,0 +1 @@
+ISO times may now be given as just a date (e.g. ``2025-10-14``), read as midnight UTC.  The date and time fields of ``iso_time`` and ``yday`` times must be zero-padded to their full width, and a date followed by a separator but no valid time of day is now a parse failure instead of being read as only the date.
@@ -0,0 +1 @@
+Time values are now parsed with a hand-written single-pass parser instead of regular expressions, and added `asdf_value_as_timespec_array` for converting a sequence or ndarray of times in one call.
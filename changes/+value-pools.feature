@@ -0,0 +1 @@
+Values and container iterators are now allocated from per-file pools and reused, rather than each being allocated from the system allocator; any left over are released by ``asdf_close``.
@@ -0,0 +1 @@
+The YAML tree is no longer copied out of the input when reading from memory or from a memory-mapped file; it is parsed directly from the input.
@@ -60,6 +60,9 @@ check_endian_decl(htole32)
 
 
 check_function_exists(strptime HAVE_STRPTIME)
+check_function_exists(madvise HAVE_MADVISE)
+check_function_exists(posix_fadvise HAVE_POSIX_FADVISE)
+check_function_exists(strtod_l HAVE_STRTOD_L)
 
 
 # Check for userfaultfd (for lazy decompression support, Linux only currently)
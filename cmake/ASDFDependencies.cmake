@@ -56,6 +56,10 @@ else()
     endif()
 endif()
 
+# POSIX threads, for discovering blocks in the background (io.background_blocks)
+set(THREADS_PREFER_PTHREAD_FLAG ON)
+find_package(Threads REQUIRED)
+
 option(USE_STATGRAB "Use libstatgrab for memory info" ON)
 option(STATGRAB_NO_PKGCONFIG "Detect libstatgrab without using pkg-config" NO)
 if(STATGRAB_NO_PKGCONFIG)
@@ -41,6 +41,9 @@
 #cmakedefine HAVE_MACHINE_ENDIAN_H
 #cmakedefine HAVE_SYS_ENDIAN_H
 #cmakedefine HAVE_STRPTIME
+#cmakedefine HAVE_MADVISE
+#cmakedefine HAVE_POSIX_FADVISE
+#cmakedefine HAVE_STRTOD_L
 #cmakedefine01 HAVE_DECL_BE64TOH
 #cmakedefine01 HAVE_DECL_BE32TOH
 #cmakedefine01 HAVE_DECL_HTOBE16
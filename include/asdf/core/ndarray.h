@@ -13,21 +13,19 @@
  * `asdf_ndarray_read_tile_ndim` and `asdf_ndarray_read_tile_2d` functions.
  *
  * * ASDF internal block sources
- * * All int and most float data types (other data types can be read but are
- *   not fully implemented)
+ * * All int, float (including ``float16``), ``complex64``, ``complex128``,
+ *   and ``bool8`` data types
  * * :c:member:`shape <asdf_ndarray_t.shape>`,
- *   :c:member:`byeorder <asdf_ndarray_t.byteorder>`, and
- *   :c:member:`offset <asdf_ndarray_t.offset>`
- * * :c:member:`strides <asdf_ndarray_t.strides>` are partially supported
+ *   :c:member:`byeorder <asdf_ndarray_t.byteorder>`,
+ *   :c:member:`offset <asdf_ndarray_t.offset>`, and
+ *   :c:member:`strides <asdf_ndarray_t.strides>` (including negative strides)
  *
  * What is not yet supported:
  *
  * * Shape containing '*'
- * * Reading ``complex64`` or ``complex128``, or ``float16`` datatypes
  * * Reading string datatypes (``ascii`` or ``ucs4``)
  * * Reading structured datatypes (the datatypes are parsed but there is are
  *   no APIs yet for interpreted structured array data
- * * Reading arbitrarily strided data
  * * Masks are not parsed or used at all, whether simple mask values or mask
  *   arrays (though if present a warning is logged indicating lack of support)
  *
@@ -71,6 +69,11 @@ typedef enum {
     ASDF_NDARRAY_ERR_INVAL,
     ASDF_NDARRAY_ERR_OVERFLOW,
     ASDF_NDARRAY_ERR_CONVERSION,
+    /**
+     * Returned by `asdf_ndarray_view` when the data cannot be viewed as-is, and
+     * must be copied (e.g. with `asdf_ndarray_read_tile_ndim`) instead
+     */
+    ASDF_NDARRAY_ERR_COPY_REQUIRED,
 } asdf_ndarray_err_t;
 
 
@@ -101,7 +104,7 @@ typedef struct {
     uint64_t offset;
     /**
      * Optional strides to use when iterating/index array data (an array of
-     * size ``.ndim`` giving the stride for each dimension)
+     * size ``.ndim`` giving the stride in bytes for each dimension)
      */
     const int64_t *strides;
 
@@ -184,6 +187,23 @@ ASDF_EXPORT uint64_t asdf_ndarray_size(const asdf_ndarray_t *ndarray);
 ASDF_EXPORT uint64_t asdf_ndarray_nbytes(const asdf_ndarray_t *ndarray);
 
 
+/**
+ * Set the access-pattern hint for the ndarray's block data
+ *
+ * See `asdf_access_hint_t`.  By default `asdf_ndarray_data_raw` and
+ * `asdf_ndarray_read_all` hint the data will be read sequentially and
+ * prefetch it, while partial tile reads disable read-ahead; use this to
+ * override that, e.g. with ``ASDF_ACCESS_HINT_RANDOM`` before sparse access
+ * through `asdf_ndarray_data_raw`.  Has no effect on inline ndarrays or
+ * ndarrays not read from a file.
+ *
+ * :param ndarray: An `asdf_ndarray_t *`
+ * :param hint: The hint (or bitwise OR of hints) to apply
+ * :return: 0 on success, non-zero if ``ndarray`` is invalid
+ */
+ASDF_EXPORT int asdf_ndarray_access_hint(asdf_ndarray_t *ndarray, asdf_access_hint_t hint);
+
+
 /**
  * Allocate heap memory large enough to store the data for the ndarray
  *
@@ -375,6 +395,86 @@ ASDF_EXPORT asdf_ndarray_err_t asdf_ndarray_read_tile_2d(
     asdf_scalar_datatype_t dst_t,
     void **dst);
 
+/**
+ * Read many tiles of the same ndarray at once
+ *
+ * Equivalent to calling `asdf_ndarray_read_tile_ndim` for each tile, but the
+ * setup common to all the tiles is only done once, and the tiles are read in
+ * order of their position in the array's data rather than the order given.
+ * The ranges of the data covered by the tiles are prefetched ahead of
+ * copying them, and if the file is configured with more than one thread (see
+ * ``threads.n_threads`` in `asdf_config_t`) the tiles are copied in parallel.
+ * For many small tiles this costs roughly one sequential pass over the data
+ * they cover.  Tiles may overlap.
+ *
+ * All tiles are checked before any is read, so on error none of the ``dsts``
+ * are modified.  Unlike `asdf_ndarray_read_tile_ndim`, if the conversion to
+ * ``dst_t`` is not supported `ASDF_NDARRAY_ERR_CONVERSION` is returned
+ * without reading any tiles.
+ *
+ * :param ndarray: The `asdf_ndarray_t *` handle to the ndarray
+ * :param n_tiles: The number of tiles to read
+ * :param origins: Array of ``n_tiles`` tile origins, each an array of size
+ *   :c:member:`ndim <asdf_ndarray_t.ndim>`
+ * :param shapes: Array of ``n_tiles`` tile shapes, each an array of size
+ *   :c:member:`ndim <asdf_ndarray_t.ndim>`
+ * :param: dst_t: The output datatype, or `ASDF_DATATYPE_SOURCE` to keep the
+ *   source datatype
+ * :param dsts: Array of ``n_tiles`` destination pointers, as for the ``dst``
+ *   argument of `asdf_ndarray_read_tile_ndim`; each that is `NULL` receives
+ *   a newly allocated buffer that the caller is responsible for freeing
+ * :return: `ASDF_NDARRAY_OK` on success, or `ASDF_NDARRAY_ERR_OVERFLOW` if
+ *   any value in any of the tiles overflowed the destination datatype (the
+ *   tiles are still read), otherwise an error code
+ */
+ASDF_EXPORT asdf_ndarray_err_t asdf_ndarray_read_tiles(
+    asdf_ndarray_t *ndarray,
+    size_t n_tiles,
+    const uint64_t *const *origins,
+    const uint64_t *const *shapes,
+    asdf_scalar_datatype_t dst_t,
+    void **dsts);
+
+
+
+/**
+ * Get a view of a tile of an ndarray's data in place, without copying it
+ *
+ * Returns a pointer to the first element of the tile within the array's data
+ * (the memory-mapped or decompressed block, or parsed inline data), along
+ * with the stride in bytes between elements along each dimension, so that
+ * the element at index ``i`` of the tile is at
+ * ``data + i[0] * strides[0] + ... + i[ndim - 1] * strides[ndim - 1]``.
+ * Strides may be negative if the ndarray's own
+ * :c:member:`strides <asdf_ndarray_t.strides>` are.
+ *
+ * This is only possible when the data is stored in the host's native byte
+ * order; otherwise `ASDF_NDARRAY_ERR_COPY_REQUIRED` is returned and the tile
+ * must instead be read with `asdf_ndarray_read_tile_ndim`.  The data is
+ * always viewed in the ndarray's own datatype.
+ *
+ * The view remains valid until the ndarray is destroyed, and must not be
+ * written to.
+ *
+ * :param ndarray: The `asdf_ndarray_t *` handle to the ndarray
+ * :param origin: The indices of the first pixel of the tile--an array of size
+ *   :c:member:`ndim <asdf_ndarray_t.ndim>`, or `NULL` to view the full array
+ * :param shape: The shape of the tile--an array of size
+ *   :c:member:`ndim <asdf_ndarray_t.ndim>`, or `NULL` to view the full array
+ * :param data: Receives the pointer to the first element of the tile
+ * :param strides: An array of size :c:member:`ndim <asdf_ndarray_t.ndim>`
+ *   to receive the stride in bytes along each dimension of the tile
+ * :return: `ASDF_NDARRAY_OK` on success, `ASDF_NDARRAY_ERR_COPY_REQUIRED` if
+ *   the data cannot be viewed in place, or `ASDF_NDARRAY_ERR_OUT_OF_BOUNDS`
+ *   if the tile is not within the bounds of the array
+ */
+ASDF_EXPORT asdf_ndarray_err_t asdf_ndarray_view(
+    asdf_ndarray_t *ndarray,
+    const uint64_t *origin,
+    const uint64_t *shape,
+    const void **data,
+    int64_t *strides);
+
 
 ASDF_END_DECLS
 
@@ -77,6 +77,41 @@ typedef struct {
 
 ASDF_DECLARE_EXTENSION(time, asdf_time_t);
 
+
+/**
+ * Convert a sequence or ndarray of times to an array of ``struct timespec`` in a single call
+ *
+ * This is much faster than reading each time as an `asdf_time_t` for files with many time
+ * stamps, as nothing is allocated for each item.  The items may be time strings (e.g. ISO
+ * times), or numbers such as Julian dates, all in the given ``format``.  If ``format`` is
+ * ``NULL`` the format of each string is guessed as for a time value with no explicit format,
+ * and numbers are taken to be Julian dates.
+ *
+ * ndarrays may be of any integer or floating point datatype, or ``ascii`` or ``ucs4`` strings;
+ * multi-dimensional arrays are flattened in C order.  Sequences must contain only scalars.
+ *
+ * ``arr`` must have room for at least as many items as there are in the sequence or ndarray,
+ * which is always written to ``count`` (if not ``NULL``).  Passing ``NULL`` for ``arr`` only
+ * returns the number of items.  As with `asdf_sequence_as_int64_array` and its relatives, sizes
+ * and counts are ``int``; ndarrays of more than ``INT_MAX`` items are reported as overflowing.
+ *
+ * :param value: The `asdf_value_t *` of a sequence or ndarray
+ * :param format: The format of the times, or ``NULL``
+ * :param arr: Array to write the times into, or ``NULL``
+ * :param size: The number of items ``arr`` has room for
+ * :param count: Receives the number of items (optional)
+ * :return: ``ASDF_VALUE_OK`` on success; ``ASDF_VALUE_ERR_OVERFLOW`` if the times do not fit
+ *   in ``arr``, ``ASDF_VALUE_ERR_TYPE_MISMATCH`` if the value is not a sequence or ndarray of
+ *   times, or ``ASDF_VALUE_ERR_PARSE_FAILURE`` if an item could not be parsed.  On error the
+ *   contents of ``arr`` are unspecified.
+ */
+ASDF_EXPORT asdf_value_err_t asdf_value_as_timespec_array(
+    asdf_value_t *value,
+    const asdf_time_format_t *format,
+    struct timespec *arr,
+    int size,
+    int *count);
+
 ASDF_LOCAL int asdf_time_parse_std(
     const char *s, const asdf_time_format_t *format, struct asdf_time_info_t *out);
 ASDF_LOCAL int asdf_time_parse_byear(const char *s, struct asdf_time_info_t *out);
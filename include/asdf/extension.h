@@ -60,6 +60,21 @@ typedef struct _asdf_extension asdf_extension_t;
 ASDF_EXPORT void asdf_extension_register(asdf_extension_t *ext);
 ASDF_EXPORT const asdf_extension_t *asdf_extension_get(asdf_file_t *file, const char *tag);
 
+/**
+ * Release a reference to an extension object
+ *
+ * Objects read from a file are shared by everything that reads the same value, and are only
+ * freed once every reference to them is released and the file is closed.  Every reference must
+ * be released before the file is closed.  Objects returned for a value built with
+ * `asdf_value_of_extension_type` are references to the caller's own object, which releasing them
+ * never frees.  Other objects that did not come from a file are freed immediately.  Normally
+ * called through the generated ``asdf_<name>_destroy`` functions.
+ *
+ * :param ext: The extension the object belongs to
+ * :param object: The object to release
+ */
+ASDF_EXPORT void asdf_extension_object_destroy(const asdf_extension_t *ext, void *object);
+
 /**
  * Parse a tag string of the form "name" or "name-version" into an
  * asdf_tag_t.  Returns NULL on OOM.  The caller owns the result
@@ -189,10 +204,7 @@ ASDF_EXPORT void asdf_tag_destroy(asdf_tag_t *tag);
     ASDF_EXPORT void asdf_##extname##_destroy(type *object) { \
         if (!object) \
             return; \
-        asdf_extension_t *ext = &ASDF_EXT_STATIC_NAME(extname); \
-        if (!ext && ext->dealloc) \
-            return; \
-        ext->dealloc(object); \
+        asdf_extension_object_destroy(&ASDF_EXT_STATIC_NAME(extname), object); \
     }
 
 
@@ -78,6 +78,91 @@ typedef enum {
 } asdf_block_decomp_mode_t;
 
 
+/**
+ * Options for how file contents are read, for use with
+ * :c:type:`asdf_config_t`
+ *
+ * Only applies to files opened by filename (`asdf_open_file` and
+ * `asdf_open_file_ex`) in read-only mode.
+ */
+typedef enum {
+    /**
+     * Automatically select the best mode; currently this memory-maps regular
+     * files and falls back to buffered reads otherwise
+     */
+    ASDF_FILE_IO_MODE_AUTO = 0,
+    /** Always read the file through a buffered ``FILE *`` */
+    ASDF_FILE_IO_MODE_BUFFERED,
+    /**
+     * Memory-map the file and parse directly from the mapping
+     *
+     * Falls back to buffered reads (with a warning) if the file cannot be
+     * memory-mapped.
+     */
+    ASDF_FILE_IO_MODE_MMAP,
+} asdf_file_io_mode_t;
+
+
+/**
+ * Access-pattern hints for memory-mapped block data
+ *
+ * These are passed on to the operating system (via ``madvise`` and
+ * ``posix_fadvise`` where available) when block data is mapped into memory,
+ * and can be combined with bitwise OR.  They are purely advisory: they never
+ * change the data returned, and are silently ignored where unsupported.
+ *
+ * Hints may be set per-file with the ``io.access_hint`` option of
+ * `asdf_config_t`, or per-block with `asdf_block_access_hint` (or
+ * `asdf_ndarray_access_hint`), the latter taking precedence.  When neither is
+ * set `asdf_ndarray_data_raw` and `asdf_ndarray_read_all` default to
+ * ``ASDF_ACCESS_HINT_SEQUENTIAL | ASDF_ACCESS_HINT_WILLNEED``, while reading
+ * a partial tile defaults to ``ASDF_ACCESS_HINT_RANDOM``.
+ */
+typedef enum {
+    /** No hint; use the default for the access method */
+    ASDF_ACCESS_HINT_NONE = 0,
+    /** Data will be read in order; read ahead aggressively */
+    ASDF_ACCESS_HINT_SEQUENTIAL = 0x01,
+    /** Data will be read in no particular order; disable read-ahead */
+    ASDF_ACCESS_HINT_RANDOM = 0x02,
+    /** Data will be needed soon; start reading it in now */
+    ASDF_ACCESS_HINT_WILLNEED = 0x04,
+    /** Data is no longer needed; its pages may be dropped from memory */
+    ASDF_ACCESS_HINT_DONTNEED = 0x08,
+    /** Back the mapping with huge pages where supported */
+    ASDF_ACCESS_HINT_HUGEPAGE = 0x10,
+    /** Reset to the operating system's default behavior */
+    ASDF_ACCESS_HINT_NORMAL = 0x20,
+} asdf_access_hint_t;
+
+
+/**
+ * Where to keep the block index cache, for use with :c:type:`asdf_config_t`
+ *
+ * Files written without a block index have to be scanned block by block on
+ * every open in order to find their blocks.  When the block index cache is
+ * enabled, the layout found by the first full parse of such a file (the
+ * extent of the YAML tree and the offsets and headers of all blocks) is saved
+ * to a small cache file, and later opens of the same file read the layout from
+ * the cache instead.
+ *
+ * Cache entries are keyed on the file's path, device, inode, size and
+ * modification time, so any change to the file invalidates its entry.  Only
+ * applies to files opened by filename in read-only mode.
+ */
+typedef enum {
+    /** Do not use a block index cache (the default) */
+    ASDF_INDEX_CACHE_NONE = 0,
+    /** Keep the cache in a sidecar file next to the ASDF file, named ``<filename>.index`` */
+    ASDF_INDEX_CACHE_SIDECAR,
+    /**
+     * Keep the cache in the user's cache directory: ``$XDG_CACHE_HOME/libasdf/index``
+     * (or ``~/.cache/libasdf/index``) unless ``io.index_cache_dir`` is set
+     */
+    ASDF_INDEX_CACHE_USER,
+} asdf_index_cache_mode_t;
+
+
 /**
  * Struct containing extended options to use when opening and reading files
  *
@@ -124,6 +209,91 @@ typedef struct {
          */
         const char *tmp_dir;
     } decomp;
+
+    /** File input options */
+    struct {
+        /** How to read the file (see `asdf_file_io_mode_t`) */
+        asdf_file_io_mode_t mode;
+
+        /**
+         * Size in bytes of the window to map at a time when memory-mapping
+         * the file
+         *
+         * By default (``0``) the whole file is mapped at once, except on
+         * 32-bit systems where files larger than 64 MiB are mapped in
+         * windows of that size.  Always rounded up to the nearest page size.
+         */
+        size_t mmap_window_size;
+
+        /**
+         * Default access-pattern hint for block data in this file (see
+         * `asdf_access_hint_t`)
+         */
+        asdf_access_hint_t access_hint;
+
+        /**
+         * Maximum number of memory mappings of block data to keep open
+         *
+         * Mappings no longer in use by any block are kept for reuse, and
+         * unmapped least recently used first once there are more than this
+         * many.  Defaults (``0``) to 1024.
+         */
+        size_t mmap_cache_max_mappings;
+
+        /**
+         * Alignment in bytes of memory mappings of block data
+         *
+         * Block data is mapped in ranges aligned to this size so that nearby
+         * blocks share a single mapping.  Defaults (``0``) to 1 MiB, and is
+         * always rounded up to the nearest page size.
+         */
+        size_t mmap_cache_granularity;
+
+        /** Block index cache to use (see `asdf_index_cache_mode_t`) */
+        asdf_index_cache_mode_t index_cache;
+
+        /**
+         * Optional directory for the block index cache when ``index_cache``
+         * is ``ASDF_INDEX_CACHE_USER``, instead of the user's cache directory
+         */
+        const char *index_cache_dir;
+
+        /**
+         * Discover the file's blocks on a background thread while its YAML
+         * tree is being built
+         *
+         * Once the end of the tree has been found, the remainder of the file
+         * (block headers and the block index) is parsed concurrently with
+         * building the tree, so that both are ready sooner when a file is
+         * opened to read its tree and then immediately its arrays.  Defaults
+         * to ``false``.
+         */
+        bool background_blocks;
+    } io;
+
+    /** Multithreading options */
+    struct {
+        /**
+         * Maximum number of threads, including the calling thread, used to
+         * read ndarray data with `asdf_ndarray_read_tile_ndim` and its
+         * relatives, and to decode large inline arrays
+         *
+         * Large reads are split along the tile's outer dimensions and
+         * converted concurrently by a pool of worker threads, which is
+         * started the first time it is needed and kept until the file is
+         * closed.  The data read is identical either way.  Defaults (``0``)
+         * to reading on the calling thread only.
+         */
+        unsigned int n_threads;
+
+        /**
+         * Minimum size in bytes of the data each thread converts, below
+         * which fewer threads are used
+         *
+         * Defaults (``0``) to 1 MiB.
+         */
+        size_t min_task_bytes;
+    } threads;
 } asdf_config_t;
 
 
@@ -475,6 +645,55 @@ ASDF_EXPORT int asdf_error_errno(asdf_file_t *file);
  */
 ASDF_EXPORT asdf_value_t *asdf_get_value(asdf_file_t *file, const char *path);
 
+/**
+ * Opaque struct holding a pre-parsed tree path
+ *
+ * Paths looked up through any of the ``asdf_get_*`` functions are cached per
+ * file, so repeated lookups of the same path are already cheap.  A compiled
+ * path additionally saves re-parsing the path the first time it is looked up
+ * in each file, which is useful when reading the same paths out of many
+ * files.
+ */
+typedef struct asdf_path asdf_path_t;
+
+/**
+ * Parse a :ref:`yaml-pointer` once for repeated lookups with
+ * `asdf_get_value_path`
+ *
+ * The compiled path is not tied to any one file and may be used with any
+ * number of files.
+ *
+ * :param path: The :ref:`yaml-pointer` to compile
+ * :return: A new `asdf_path_t *`, or `NULL` if the path is invalid or memory
+ *   could not be allocated; free with `asdf_path_destroy`
+ */
+ASDF_EXPORT asdf_path_t *asdf_path_compile(const char *path);
+
+/**
+ * Return the original string a path was compiled from
+ *
+ * :param path: A compiled `asdf_path_t *`
+ * :return: The path string, owned by the `asdf_path_t *`
+ */
+ASDF_EXPORT const char *asdf_path_str(const asdf_path_t *path);
+
+/**
+ * Free a path returned by `asdf_path_compile`
+ *
+ * :param path: The `asdf_path_t *` to free
+ */
+ASDF_EXPORT void asdf_path_destroy(asdf_path_t *path);
+
+/**
+ * Like `asdf_get_value` but using a path compiled with `asdf_path_compile`
+ *
+ * :param file: The `asdf_file_t *` for the file
+ * :param path: A compiled `asdf_path_t *`
+ * :return: An `asdf_value_t *` wrapping the value, or `NULL` if the path does
+ *   not exist in the tree
+ */
+ASDF_EXPORT asdf_value_t *asdf_get_value_path(asdf_file_t *file, const asdf_path_t *path);
+
 /**
  * Check if the value at the given tree path is a YAML mapping
  *
@@ -544,6 +763,43 @@ ASDF_EXPORT bool asdf_is_sequence(asdf_file_t *file, const char *path);
 ASDF_EXPORT asdf_value_err_t
 asdf_get_sequence(asdf_file_t *file, const char *path, asdf_sequence_t **out);
 
+/**
+ * Read a sequence of numbers out of the ASDF tree into a C array
+ *
+ * Shortcut for `asdf_get_sequence` followed by the corresponding
+ * ``asdf_sequence_as_<type>_array`` (e.g. `asdf_sequence_as_double_array`);
+ * see there for details.
+ *
+ * :param file: The `asdf_file_t *` for the file
+ * :param path: The :ref:`yaml-pointer` to the sequence
+ * :param arr: Array to write the items into, or ``NULL`` to only count them
+ * :param size: The number of items ``arr`` has room for
+ * :param count: Receives the number of items in the sequence (optional)
+ * :return: `ASDF_VALUE_OK` if the value exists and all its items were read,
+ *   otherwise an `asdf_value_err_t` such as `ASDF_VALUE_ERR_NOT_FOUND` or
+ *   `ASDF_VALUE_ERR_TYPE_MISMATCH`.
+ */
+ASDF_EXPORT asdf_value_err_t
+asdf_get_int8_array(asdf_file_t *file, const char *path, int8_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_get_int16_array(asdf_file_t *file, const char *path, int16_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_get_int32_array(asdf_file_t *file, const char *path, int32_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_get_int64_array(asdf_file_t *file, const char *path, int64_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_get_uint8_array(asdf_file_t *file, const char *path, uint8_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_get_uint16_array(asdf_file_t *file, const char *path, uint16_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_get_uint32_array(asdf_file_t *file, const char *path, uint32_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_get_uint64_array(asdf_file_t *file, const char *path, uint64_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_get_float_array(asdf_file_t *file, const char *path, float *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_get_double_array(asdf_file_t *file, const char *path, double *arr, int size, int *count);
+
 /**
  * Check if the value at the given tree path is a string scalar
  *
@@ -1033,6 +1289,23 @@ ASDF_EXPORT const void *asdf_block_data(asdf_block_t *block, size_t *size);
  */
 ASDF_EXPORT const void *asdf_block_data_raw(asdf_block_t *block, size_t *size);
 
+
+/**
+ * Set the access-pattern hint for the block's data (see `asdf_access_hint_t`)
+ *
+ * This overrides the file's ``io.access_hint`` option for this block.  If the
+ * block data is already mapped the hint is applied immediately; otherwise it
+ * is applied when the data is next mapped by `asdf_block_data`.
+ *
+ * The hint applies to the block data as stored in the file; for compressed
+ * blocks it does not affect the buffer the data is decompressed into.
+ *
+ * :param block: The `asdf_block_t *` handle
+ * :param hint: The hint (or bitwise OR of hints) to apply
+ * :return: 0 on success, non-zero if ``block`` is invalid
+ */
+ASDF_EXPORT int asdf_block_access_hint(asdf_block_t *block, asdf_access_hint_t hint);
+
 ASDF_END_DECLS
 
 #endif /* ASDF_FILE_H */
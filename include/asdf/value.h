@@ -667,6 +667,49 @@ ASDF_EXPORT asdf_sequence_t *asdf_sequence_of_double(
     asdf_file_t *file, const double *arr, int size);
 
 
+/**
+ * Read a sequence of numbers into a C array in a single call
+ *
+ * Each ``asdf_sequence_as_<type>_array`` function converts every item in
+ * ``sequence`` as by the corresponding ``asdf_value_as_<type>``, writing them
+ * to ``arr`` in order.  This is much faster than iterating over the sequence
+ * for long lists of numbers, as no value is allocated for each item.
+ *
+ * ``arr`` must have room for at least as many items as there are in the
+ * sequence, which is always written to ``count`` (if not ``NULL``).  Passing
+ * ``NULL`` for ``arr`` only returns the number of items.
+ *
+ * :param sequence: The `asdf_sequence_t *` to read
+ * :param arr: Array to write the items into, or ``NULL``
+ * :param size: The number of items ``arr`` has room for
+ * :param count: Receives the number of items in the sequence (optional)
+ * :return: ``ASDF_VALUE_OK`` on success; ``ASDF_VALUE_ERR_OVERFLOW`` if the
+ *   sequence does not fit in ``arr`` or an item does not fit in the type, or
+ *   ``ASDF_VALUE_ERR_TYPE_MISMATCH`` if an item is not a number of the
+ *   requested type.  On error the contents of ``arr`` are unspecified.
+ */
+ASDF_EXPORT asdf_value_err_t
+asdf_sequence_as_int8_array(asdf_sequence_t *sequence, int8_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_sequence_as_int16_array(asdf_sequence_t *sequence, int16_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_sequence_as_int32_array(asdf_sequence_t *sequence, int32_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_sequence_as_int64_array(asdf_sequence_t *sequence, int64_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_sequence_as_uint8_array(asdf_sequence_t *sequence, uint8_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_sequence_as_uint16_array(asdf_sequence_t *sequence, uint16_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_sequence_as_uint32_array(asdf_sequence_t *sequence, uint32_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_sequence_as_uint64_array(asdf_sequence_t *sequence, uint64_t *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_sequence_as_float_array(asdf_sequence_t *sequence, float *arr, int size, int *count);
+ASDF_EXPORT asdf_value_err_t
+asdf_sequence_as_double_array(asdf_sequence_t *sequence, double *arr, int size, int *count);
+
+
 /**
  * Remove a value from a sequence and return the removed value
  *
@@ -1058,6 +1101,39 @@ ASDF_EXPORT bool asdf_value_find_iter_next(asdf_find_iter_t **iter);
  */
 ASDF_EXPORT void asdf_find_iter_destroy(asdf_find_iter_t *iter);
 
+
+/**
+ * Create an iterator over all values in the file's tree with the given tag
+ *
+ * Unlike `asdf_find_iter_init` this does not traverse the tree on each call: the first call
+ * builds an index of the whole tree by tag and by mapping key, and each query after that takes
+ * time proportional to the number of values found.  The index is rebuilt on the next query
+ * after the tree is modified.  Values are yielded in document order, and the iterator is used
+ * with `asdf_value_find_iter_next` and `asdf_find_iter_destroy` like any other find iterator.
+ *
+ * Tags may be given with or without the ``tag:`` prefix.  If no value has exactly the given
+ * tag, values with any version of it are returned, so for example
+ * ``"stsci.edu:asdf/core/ndarray"`` finds all ndarrays regardless of their version.
+ *
+ * :param file: The `asdf_file_t *` to search
+ * :param tag: The tag to search for
+ * :return: A new `asdf_find_iter_t *`, or ``NULL`` if no value has the tag (or on failure)
+ */
+ASDF_EXPORT asdf_find_iter_t *asdf_find_by_tag(asdf_file_t *file, const char *tag);
+
+
+/**
+ * Create an iterator over the values of all mapping entries in the file's tree with the given
+ * key
+ *
+ * Uses the same index as `asdf_find_by_tag`.
+ *
+ * :param file: The `asdf_file_t *` to search
+ * :param key: The mapping key to search for
+ * :return: A new `asdf_find_iter_t *`, or ``NULL`` if no mapping has the key (or on failure)
+ */
+ASDF_EXPORT asdf_find_iter_t *asdf_find_by_key(asdf_file_t *file, const char *key);
+
 ASDF_END_DECLS
 
 #endif /* ASDF_VALUE_H */
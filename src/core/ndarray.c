@@ -1,9 +1,11 @@
 #include <assert.h>
 #include <limits.h>
+#include <stdalign.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 #include <sys/mman.h>
 
 #ifdef HAVE_CONFIG_H
@@ -14,6 +16,7 @@
 #include "../error.h"
 #include "../extension_util.h"
 #include "../file.h"
+#include "../format.h"
 #include "../log.h"
 #include "../util.h"
 #include "../value.h"
@@ -284,15 +287,27 @@ static asdf_scalar_datatype_t infer_scalar_datatype(const ndarray_type_inf_t *in
 }
 
 
+/** Resolve an alias node in inline array data to the node it refers to */
+static inline struct fy_node *inline_node_resolve(struct fy_node *node) {
+    if (node && fy_node_is_alias(node))
+        return fy_node_resolve_alias(node);
+
+    return node;
+}
+
+
 /**
- * Recursively walk ``seq`` at the given ``depth``, recording shape and
- * accumulating type inference state.
+ * Recursively walk the sequence ``node`` at the given ``depth``, recording
+ * shape and accumulating type inference state.
  *
  * ``*shape`` is grown via realloc as new dimensions are discovered.
  * ``*ndim`` is the number of dimensions discovered so far.
+ *
+ * ``inf`` may be NULL when the datatype is given explicitly, in which case
+ * only the shape is checked and the scalars are not parsed at all.
  */
 static asdf_value_err_t infer_inline_array_datatype(
-    asdf_sequence_t *seq,
+    struct fy_node *node,
     uint32_t depth,
     uint64_t **shape,
     uint32_t *ndim,
@@ -300,7 +315,7 @@ static asdf_value_err_t infer_inline_array_datatype(
     asdf_file_t *file) {
     asdf_value_err_t err = ASDF_VALUE_OK;
 
-    int size = asdf_sequence_size(seq);
+    int size = fy_node_sequence_item_count(node);
 
     if (UNLIKELY(size < 0))
         return ASDF_VALUE_ERR_PARSE_FAILURE;
@@ -327,17 +342,21 @@ static asdf_value_err_t infer_inline_array_datatype(
 
     /* Peek at the first element to decide if this level holds sequences or
      * scalars; all elements must be of the same kind */
-    asdf_value_t *first = asdf_sequence_get(seq, 0);
+    struct fy_node *first = inline_node_resolve(fy_node_sequence_get_by_index(node, 0));
     if (!first)
         return ASDF_VALUE_ERR_PARSE_FAILURE;
 
-    bool first_is_seq = (asdf_value_get_type(first) == ASDF_VALUE_SEQUENCE);
-    asdf_value_destroy(first);
+    bool first_is_seq = fy_node_is_sequence(first);
+    struct fy_node *item = NULL;
+    void *iter = NULL;
+
+    while ((item = fy_node_sequence_iterate(node, &iter))) {
+        struct fy_node *elem = inline_node_resolve(item);
+
+        if (UNLIKELY(!elem))
+            return ASDF_VALUE_ERR_PARSE_FAILURE;
 
-    asdf_sequence_iter_t *iter = asdf_sequence_iter_init(seq);
-    while (asdf_sequence_iter_next(&iter)) {
-        asdf_value_t *elem = iter->value;
-        bool elem_is_seq = (asdf_value_get_type(elem) == ASDF_VALUE_SEQUENCE);
+        bool elem_is_seq = fy_node_is_sequence(elem);
 
         if (elem_is_seq != first_is_seq) {
             ASDF_LOG(
@@ -345,19 +364,21 @@ static asdf_value_err_t infer_inline_array_datatype(
                 ASDF_LOG_ERROR,
                 "inline ndarray has mixed sequence/scalar elements at depth %u",
                 depth);
-            asdf_sequence_iter_destroy(iter);
             return ASDF_VALUE_ERR_PARSE_FAILURE;
         }
 
         if (elem_is_seq) {
-            err = infer_inline_array_datatype(
-                (asdf_sequence_t *)elem, depth + 1, shape, ndim, inf, file);
-            if (ASDF_IS_ERR(err)) {
-                asdf_sequence_iter_destroy(iter);
+            err = infer_inline_array_datatype(elem, depth + 1, shape, ndim, inf, file);
+            if (ASDF_IS_ERR(err))
                 return err;
-            }
-        } else {
-            update_type_inference(elem, inf);
+        } else if (inf) {
+            asdf_value_t value;
+
+            if (UNLIKELY(!asdf_value_init(&value, file, elem)))
+                return ASDF_VALUE_ERR_OOM;
+
+            update_type_inference(&value, inf);
+            asdf_value_clear(&value);
         }
     }
 
@@ -441,56 +462,225 @@ static asdf_value_err_t convert_scalar_to_native(
 }
 
 
+/** Default for ``threads.min_task_bytes`` */
+#define ASDF_NDARRAY_READ_MIN_TASK_BYTES (1024 * 1024)
+
+
 /**
- * Recursively walk ``seq`` at ``depth``, writing converted scalars into
- * ``buf`` and advancing ``*offset`` (in elements, not bytes).
+ * Return the number of threads to split ``size`` bytes of ndarray data, made up of ``n_units``
+ * independent rows or elements, across, starting the file's thread pool if more than one
  */
-static asdf_value_err_t parse_inline_array_level(
-    asdf_sequence_t *seq,
-    const asdf_ndarray_t *ndarray,
-    uint8_t *buf,
-    size_t *offset,
-    uint32_t depth) {
+static unsigned int asdf_ndarray_n_tasks(
+    asdf_file_t *file, size_t size, uint64_t n_units, asdf_thread_pool_t **pool) {
+    *pool = NULL;
+
+    if (!file || file->config->threads.n_threads < 2)
+        return 1;
+
+    size_t min_task_bytes = file->config->threads.min_task_bytes;
+
+    if (min_task_bytes == 0)
+        min_task_bytes = ASDF_NDARRAY_READ_MIN_TASK_BYTES;
+
+    size_t n_tasks = size / min_task_bytes;
+
+    if (n_tasks > n_units)
+        n_tasks = n_units;
+
+    if (n_tasks < 2)
+        return 1;
+
+    *pool = asdf_file_thread_pool(file);
+    unsigned int n_threads = asdf_thread_pool_size(*pool);
+    return n_tasks < n_threads ? (unsigned int)n_tasks : n_threads;
+}
+
+
+typedef struct {
+    asdf_file_t *file;
+    asdf_scalar_datatype_t dtype;
+    size_t elem_size;
+    uint32_t ndim;
+} inline_decoder_t;
+
+
+/**
+ * Recursively walk ``node`` at ``depth``, converting its scalars straight into
+ * ``*dst`` and advancing it past each element written
+ *
+ * Each scalar is parsed once, through a value on the stack, and nothing is
+ * allocated per element.  ``end`` bounds the output in case the tree no
+ * longer matches the shape found when the ndarray was deserialized.
+ */
+static asdf_value_err_t decode_inline_array_node(
+    const inline_decoder_t *dec,
+    struct fy_node *node,
+    uint32_t depth,
+    uint8_t **dst,
+    uint8_t *end) {
     asdf_value_err_t err = ASDF_VALUE_OK;
-    asdf_scalar_datatype_t dtype = ndarray->datatype.type;
-    size_t elem_size = asdf_scalar_datatype_size(dtype);
-    asdf_file_t *file = ndarray->internal->file;
-
-    asdf_sequence_iter_t *iter = asdf_sequence_iter_init(seq);
-    while (asdf_sequence_iter_next(&iter)) {
-        asdf_value_t *elem = iter->value;
-        if (depth == ndarray->ndim - 1) {
-            /* Leaf level: convert scalar to C value */
-            err = convert_scalar_to_native(elem, dtype, buf + ((*offset) * elem_size), file);
-            if (ASDF_IS_ERR(err)) {
-                asdf_sequence_iter_destroy(iter);
-                return err;
-            }
-            (*offset)++;
-        } else {
-            /* Non-leaf: recurse into sub-sequence */
-            err = parse_inline_array_level(
-                (asdf_sequence_t *)elem, ndarray, buf, offset, depth + 1);
-            if (ASDF_IS_ERR(err)) {
-                asdf_sequence_iter_destroy(iter);
-                return err;
-            }
-        }
+    node = inline_node_resolve(node);
+
+    if (UNLIKELY(!node))
+        return ASDF_VALUE_ERR_PARSE_FAILURE;
+
+    if (depth == dec->ndim) {
+        /* Leaf level: convert scalar to C value */
+        if (UNLIKELY(*dst + dec->elem_size > end))
+            return ASDF_VALUE_ERR_PARSE_FAILURE;
+
+        asdf_value_t elem;
+
+        if (UNLIKELY(!asdf_value_init(&elem, dec->file, node)))
+            return ASDF_VALUE_ERR_OOM;
+
+        err = convert_scalar_to_native(&elem, dec->dtype, *dst, dec->file);
+        asdf_value_clear(&elem);
+        *dst += dec->elem_size;
+        return err;
+    }
+
+    if (UNLIKELY(!fy_node_is_sequence(node)))
+        return ASDF_VALUE_ERR_PARSE_FAILURE;
+
+    /* Non-leaf: recurse into sub-sequences */
+    struct fy_node *item = NULL;
+    void *iter = NULL;
+
+    while ((item = fy_node_sequence_iterate(node, &iter))) {
+        err = decode_inline_array_node(dec, item, depth + 1, dst, end);
+
+        if (ASDF_IS_ERR(err))
+            return err;
     }
 
     return ASDF_VALUE_OK;
 }
 
 
+/** A contiguous range of rows along the outermost dimension, decoded by one task */
+typedef struct {
+    const inline_decoder_t *dec;
+    struct fy_node **rows;
+    size_t n_rows;
+    uint8_t *dst;
+    uint8_t *end;
+    asdf_value_err_t err;
+} inline_decode_task_t;
+
+
+static void inline_decode_task_run(void *arg) {
+    inline_decode_task_t *task = arg;
+    uint8_t *dst = task->dst;
+
+    task->err = ASDF_VALUE_OK;
+
+    for (size_t idx = 0; idx < task->n_rows && ASDF_IS_OK(task->err); idx++)
+        task->err = decode_inline_array_node(task->dec, task->rows[idx], 1, &dst, task->end);
+
+    if (ASDF_IS_OK(task->err) && dst != task->end)
+        task->err = ASDF_VALUE_ERR_PARSE_FAILURE;
+}
+
+
+/**
+ * Decode large inline arrays by splitting the outermost dimension into
+ * contiguous ranges of rows, one per task run on the file's thread pool
+ *
+ * Every row of an inline array has the same number of elements, so each range
+ * knows up front where its output starts.  Reading the tree and inferring the
+ * scalar types does not modify the document, so the tasks need no locking.
+ */
+static asdf_value_err_t decode_inline_array_parallel(
+    const inline_decoder_t *dec,
+    struct fy_node *root,
+    size_t n_rows,
+    asdf_thread_pool_t *pool,
+    unsigned int n_tasks,
+    uint8_t *buf,
+    size_t nbytes) {
+    asdf_value_err_t err = ASDF_VALUE_OK;
+    struct fy_node **rows = malloc(n_rows * sizeof(struct fy_node *));
+    inline_decode_task_t *tasks = calloc(n_tasks, sizeof(inline_decode_task_t));
+
+    if (UNLIKELY(!rows || !tasks)) {
+        free(rows);
+        free(tasks);
+        return ASDF_VALUE_ERR_OOM;
+    }
+
+    struct fy_node *item = NULL;
+    void *iter = NULL;
+    size_t n_found = 0;
+
+    while ((item = fy_node_sequence_iterate(root, &iter)) && n_found < n_rows)
+        rows[n_found++] = item;
+
+    if (UNLIKELY(n_found != n_rows)) {
+        free(rows);
+        free(tasks);
+        return ASDF_VALUE_ERR_PARSE_FAILURE;
+    }
+
+    size_t row_bytes = nbytes / n_rows;
+    size_t row_start = 0;
+
+    for (unsigned int idx = 0; idx < n_tasks; idx++) {
+        inline_decode_task_t *task = &tasks[idx];
+        size_t row_end = (n_rows * (idx + 1)) / n_tasks;
+        task->dec = dec;
+        task->rows = rows + row_start;
+        task->n_rows = row_end - row_start;
+        task->dst = buf + (row_start * row_bytes);
+        task->end = buf + (row_end * row_bytes);
+        row_start = row_end;
+    }
+
+    asdf_thread_pool_run(
+        pool, inline_decode_task_run, tasks, sizeof(inline_decode_task_t), n_tasks);
+
+    for (unsigned int idx = 0; idx < n_tasks && ASDF_IS_OK(err); idx++)
+        err = tasks[idx].err;
+
+    free(rows);
+    free(tasks);
+    return err;
+}
+
+
 /**
  * Parse ``ndarray->internal->inline_data`` into a flat C array buffer ``buf``.
  *
  * The caller is responsible for allocating ``buf`` with the correct size
  * (asdf_ndarray_nbytes(ndarray) bytes).
  */
-static asdf_value_err_t asdf_ndarray_parse_inline_data(asdf_ndarray_t *ndarray, uint8_t *buf) {
-    size_t offset = 0;
-    return parse_inline_array_level(ndarray->internal->inline_data, ndarray, buf, &offset, 0);
+static asdf_value_err_t asdf_ndarray_parse_inline_data(
+    asdf_ndarray_t *ndarray, uint8_t *buf, size_t nbytes) {
+    /* An empty inline array has no dimensions and nothing to decode */
+    if (ndarray->ndim == 0)
+        return ASDF_VALUE_OK;
+
+    inline_decoder_t dec = {
+        .file = ndarray->internal->file,
+        .dtype = ndarray->datatype.type,
+        .elem_size = asdf_scalar_datatype_size(ndarray->datatype.type),
+        .ndim = ndarray->ndim,
+    };
+    struct fy_node *root = ndarray->internal->inline_data->value.node;
+    size_t n_rows = ndarray->shape[0];
+    asdf_thread_pool_t *pool = NULL;
+    unsigned int n_tasks = asdf_ndarray_n_tasks(dec.file, nbytes, n_rows, &pool);
+
+    if (n_tasks > 1)
+        return decode_inline_array_parallel(&dec, root, n_rows, pool, n_tasks, buf, nbytes);
+
+    uint8_t *dst = buf;
+    asdf_value_err_t err = decode_inline_array_node(&dec, root, 0, &dst, buf + nbytes);
+
+    if (ASDF_IS_OK(err) && dst != buf + nbytes)
+        err = ASDF_VALUE_ERR_PARSE_FAILURE;
+
+    return err;
 }
 
 
@@ -574,7 +764,13 @@ static asdf_value_err_t asdf_ndarray_deserialize_inline(
     }
 
     /* Infer shape (and type if implicit) by walking the YAML sequence */
-    err = infer_inline_array_datatype(ndarray_seq, 0, &shape, &ndim, &inf, value->file);
+    err = infer_inline_array_datatype(
+        ndarray_seq->value.node,
+        0,
+        &shape,
+        &ndim,
+        has_explicit_datatype ? NULL : &inf,
+        value->file);
     if (ASDF_IS_ERR(err))
         goto cleanup;
 
@@ -811,12 +1007,84 @@ void asdf_ndarray_storage_set(asdf_ndarray_t *ndarray, asdf_array_storage_t stor
 
 
 /**
- * Recursively build a nested YAML flow sequence from ndarray data.
+ * Write a single element of inline ndarray data at ``p``, returning the end
+ * of what was written
+ */
+static inline char *inline_format_elem(char *p, asdf_scalar_datatype_t dtype, const void *src) {
+    switch (dtype) {
+    case ASDF_DATATYPE_BOOL8:
+        if (*(const bool *)src) {
+            memcpy(p, "true", 4);
+            return p + 4;
+        }
+        memcpy(p, "false", 5);
+        return p + 5;
+    case ASDF_DATATYPE_INT8:
+        return p + asdf_format_int64(p, *(const int8_t *)src);
+    case ASDF_DATATYPE_INT16:
+        return p + asdf_format_int64(p, *(const int16_t *)src);
+    case ASDF_DATATYPE_INT32:
+        return p + asdf_format_int64(p, *(const int32_t *)src);
+    case ASDF_DATATYPE_INT64:
+        return p + asdf_format_int64(p, *(const int64_t *)src);
+    case ASDF_DATATYPE_UINT8:
+        return p + asdf_format_uint64(p, *(const uint8_t *)src);
+    case ASDF_DATATYPE_UINT16:
+        return p + asdf_format_uint64(p, *(const uint16_t *)src);
+    case ASDF_DATATYPE_UINT32:
+        return p + asdf_format_uint64(p, *(const uint32_t *)src);
+    case ASDF_DATATYPE_UINT64:
+        return p + asdf_format_uint64(p, *(const uint64_t *)src);
+    case ASDF_DATATYPE_FLOAT32:
+        return p + asdf_format_float(p, *(const float *)src);
+    case ASDF_DATATYPE_FLOAT64:
+        return p + asdf_format_double(p, *(const double *)src);
+    default:
+        UNREACHABLE();
+        return p;
+    }
+}
+
+
+/**
+ * Recursively write the nested YAML flow sequence for the ndarray data at
+ * ``*src`` to ``p``, advancing ``*src`` past the elements written
+ */
+static char *asdf_ndarray_format_seq_level(
+    const asdf_ndarray_t *ndarray, const uint8_t **src, uint32_t depth, char *p) {
+    asdf_scalar_datatype_t dtype = ndarray->datatype.type;
+    uint64_t dim_size = ndarray->shape[depth];
+    bool leaf = (depth == ndarray->ndim - 1);
+
+    *p++ = '[';
+
+    for (uint64_t idx = 0; idx < dim_size; idx++) {
+        if (idx > 0) {
+            *p++ = ',';
+            *p++ = ' ';
+        }
+
+        if (leaf) {
+            p = inline_format_elem(p, dtype, *src);
+            *src += ndarray->datatype.size;
+        } else {
+            p = asdf_ndarray_format_seq_level(ndarray, src, depth + 1, p);
+        }
+    }
+
+    *p++ = ']';
+    return p;
+}
+
+
+/**
+ * Build the nested YAML flow sequence for an inline ndarray
  *
- * At the leaf dimension (depth == ndim-1) the appropriate
- * ``asdf_sequence_of_*`` bulk constructor is called.  At all other depths
- * an outer sequence is built by appending the inner sequences returned by
- * recursive calls.  Every sequence is styled as flow (compact inline YAML).
+ * Rather than creating a node for every element and formatting each number
+ * through printf, the whole array is written out as YAML flow sequence text in
+ * one buffer, using the fast number formatters, and handed to libfyaml to
+ * build the nodes from in a single pass.  Floats are written with the
+ * shortest digits that read back as the same value.
  *
  * .. todo::
  *
@@ -824,104 +1092,84 @@ void asdf_ndarray_storage_set(asdf_ndarray_t *ndarray, asdf_array_storage_t stor
  *   to support record types and other compound datatypes (e.g. complex) but
  *   these are not yet fully supported by the library in general.
  */
-static asdf_sequence_t *asdf_ndarray_serialize_seq_level(
-    asdf_file_t *file,
-    const asdf_ndarray_t *ndarray,
-    const void *data,
-    uint32_t depth,
-    size_t *elem_offset) {
-
-    uint32_t ndim = ndarray->ndim;
-    uint64_t dim_size = ndim ? ndarray->shape[depth] : 0;
+static asdf_sequence_t *asdf_ndarray_serialize_inline_data(
+    asdf_file_t *file, const asdf_ndarray_t *ndarray) {
     asdf_scalar_datatype_t dtype = ndarray->datatype.type;
-    asdf_sequence_t *seq = NULL;
 
-    if (ndim && (depth == ndim - 1)) {
-        /* Leaf level: create sequence from the slice of the flat data buffer */
-        const void *start = (const uint8_t *)data + (*elem_offset * ndarray->datatype.size);
-
-        switch (dtype) {
-        case ASDF_DATATYPE_BOOL8:
-            seq = asdf_sequence_of_bool(file, (const bool *)start, (int)dim_size);
-            break;
-        case ASDF_DATATYPE_INT8:
-            seq = asdf_sequence_of_int8(file, (const int8_t *)start, (int)dim_size);
-            break;
-        case ASDF_DATATYPE_INT16:
-            seq = asdf_sequence_of_int16(file, (const int16_t *)start, (int)dim_size);
-            break;
-        case ASDF_DATATYPE_INT32:
-            seq = asdf_sequence_of_int32(file, (const int32_t *)start, (int)dim_size);
-            break;
-        case ASDF_DATATYPE_INT64:
-            seq = asdf_sequence_of_int64(file, (const int64_t *)start, (int)dim_size);
-            break;
-        case ASDF_DATATYPE_UINT8:
-            seq = asdf_sequence_of_uint8(file, (const uint8_t *)start, (int)dim_size);
-            break;
-        case ASDF_DATATYPE_UINT16:
-            seq = asdf_sequence_of_uint16(file, (const uint16_t *)start, (int)dim_size);
-            break;
-        case ASDF_DATATYPE_UINT32:
-            seq = asdf_sequence_of_uint32(file, (const uint32_t *)start, (int)dim_size);
-            break;
-        case ASDF_DATATYPE_UINT64:
-            seq = asdf_sequence_of_uint64(file, (const uint64_t *)start, (int)dim_size);
-            break;
-        case ASDF_DATATYPE_FLOAT32:
-            seq = asdf_sequence_of_float(file, (const float *)start, (int)dim_size);
-            break;
-        case ASDF_DATATYPE_FLOAT64:
-            seq = asdf_sequence_of_double(file, (const double *)start, (int)dim_size);
-            break;
-        default:
+    switch (dtype) {
+    case ASDF_DATATYPE_BOOL8:
+    case ASDF_DATATYPE_INT8:
+    case ASDF_DATATYPE_INT16:
+    case ASDF_DATATYPE_INT32:
+    case ASDF_DATATYPE_INT64:
+    case ASDF_DATATYPE_UINT8:
+    case ASDF_DATATYPE_UINT16:
+    case ASDF_DATATYPE_UINT32:
+    case ASDF_DATATYPE_UINT64:
+    case ASDF_DATATYPE_FLOAT32:
+    case ASDF_DATATYPE_FLOAT64:
+        break;
+    default:
+        if (ndarray->ndim > 0) {
             ASDF_LOG(file, ASDF_LOG_ERROR, "unsupported datatype for inline ndarray serialization");
             return NULL;
         }
+    }
 
-        if (seq)
-            *elem_offset += dim_size;
-    } else {
-        /* Non-leaf: build outer sequence by appending inner sequences;
-         * in the corner-case of ndim == 0 this will still create an empty
-         * sequence */
-        seq = asdf_sequence_create(file);
+    struct fy_document *tree = asdf_file_tree_document(file);
 
-        if (!seq)
-            return NULL;
+    if (!tree)
+        return NULL;
 
-        for (uint64_t idx = 0; idx < dim_size; idx++) {
-            asdf_sequence_t *inner = asdf_ndarray_serialize_seq_level(
-                file, ndarray, data, depth + 1, elem_offset);
+    /* Count the elements and the sequences containing them to size the buffer;
+     * every element or sequence is followed by at most a ", " separator */
+    size_t n_elems = ndarray->ndim > 0 ? 1 : 0;
+    size_t n_seqs = 1;
 
-            if (!inner) {
-                asdf_sequence_destroy(seq);
-                return NULL;
-            }
+    for (uint32_t idx = 0; idx < ndarray->ndim; idx++) {
+        n_elems *= ndarray->shape[idx];
 
-            asdf_value_err_t err = asdf_sequence_append_sequence(seq, inner);
+        if (idx + 1 < ndarray->ndim)
+            n_seqs += n_elems;
+    }
 
-            if (ASDF_IS_ERR(err)) {
-                asdf_sequence_destroy(inner);
-                asdf_sequence_destroy(seq);
-                return NULL;
-            }
-        }
+    const size_t elem_max = ASDF_FORMAT_NUMBER_MAX + 2;
+    const size_t seq_max = 4;
+
+    if (UNLIKELY(n_elems > (SIZE_MAX - (n_seqs * seq_max) - 1) / elem_max)) {
+        ASDF_ERROR_OOM(file);
+        return NULL;
     }
 
-    if (seq)
-        asdf_sequence_set_style(seq, ASDF_YAML_NODE_STYLE_FLOW);
+    char *buf = malloc((n_elems * elem_max) + (n_seqs * seq_max) + 1);
 
-    return seq;
-}
+    if (UNLIKELY(!buf)) {
+        ASDF_ERROR_OOM(file);
+        return NULL;
+    }
 
+    char *end = buf;
 
-static asdf_sequence_t *asdf_ndarray_serialize_inline_data(
-    asdf_file_t *file, const asdf_ndarray_t *ndarray) {
-    size_t elem_offset = 0;
+    if (ndarray->ndim > 0) {
+        const uint8_t *src = ndarray->internal->data;
+        end = asdf_ndarray_format_seq_level(ndarray, &src, 0, buf);
+    } else {
+        /* In the corner-case of ndim == 0 this still creates an empty sequence */
+        *end++ = '[';
+        *end++ = ']';
+    }
 
-    return asdf_ndarray_serialize_seq_level(
-        file, ndarray, ndarray->internal->data, 0, &elem_offset);
+    *end = '\0';
+
+    /* libfyaml takes ownership of the buffer */
+    struct fy_node *node = fy_node_build_from_malloc_string(tree, buf, end - buf);
+
+    if (UNLIKELY(!node)) {
+        ASDF_LOG(file, ASDF_LOG_ERROR, "failed to build inline ndarray data");
+        return NULL;
+    }
+
+    return (asdf_sequence_t *)asdf_value_create(file, node);
 }
 
 
@@ -1263,7 +1511,13 @@ ASDF_REGISTER_EXTENSION(
 
 
 /* ndarray methods */
-const void *asdf_ndarray_data_raw(asdf_ndarray_t *ndarray, size_t *size) {
+
+/**
+ * Implementation of `asdf_ndarray_data_raw` with the access hint to use for the block data
+ * when the user has not set one
+ */
+static const void *asdf_ndarray_data_hinted(
+    asdf_ndarray_t *ndarray, size_t *size, asdf_access_hint_t default_hint) {
     if (!ndarray || !ndarray->internal)
         return NULL;
 
@@ -1280,7 +1534,7 @@ const void *asdf_ndarray_data_raw(asdf_ndarray_t *ndarray, size_t *size) {
         if (UNLIKELY(!buf))
             return NULL;
 
-        if (ASDF_IS_ERR(asdf_ndarray_parse_inline_data(ndarray, buf))) {
+        if (ASDF_IS_ERR(asdf_ndarray_parse_inline_data(ndarray, buf, nbytes))) {
             free(buf);
             return NULL;
         }
@@ -1298,10 +1552,33 @@ const void *asdf_ndarray_data_raw(asdf_ndarray_t *ndarray, size_t *size) {
         if (!block)
             return NULL;
 
+        if (ndarray->internal->access_hint != ASDF_ACCESS_HINT_NONE)
+            asdf_block_access_hint(block, ndarray->internal->access_hint);
+
         ndarray->internal->block = block;
     }
 
-    return asdf_block_data(ndarray->internal->block, size);
+    return asdf_block_data_hinted(ndarray->internal->block, size, default_hint);
+}
+
+
+const void *asdf_ndarray_data_raw(asdf_ndarray_t *ndarray, size_t *size) {
+    // Whole-array access: prefetch aggressively
+    return asdf_ndarray_data_hinted(
+        ndarray, size, ASDF_ACCESS_HINT_SEQUENTIAL | ASDF_ACCESS_HINT_WILLNEED);
+}
+
+
+int asdf_ndarray_access_hint(asdf_ndarray_t *ndarray, asdf_access_hint_t hint) {
+    if (!ndarray || !ndarray->internal)
+        return -1;
+
+    ndarray->internal->access_hint = hint;
+
+    if (ndarray->internal->block)
+        return asdf_block_access_hint(ndarray->internal->block, hint);
+
+    return 0;
 }
 
 
@@ -1455,103 +1732,409 @@ static inline bool should_byteswap(size_t elsize, asdf_byteorder_t byteorder) {
 }
 
 
-static asdf_ndarray_err_t asdf_ndarray_read_tile_init_strides(
-    const uint64_t *shape, uint32_t ndim, int64_t **strides_out) {
-    assert(shape);
-    assert(strides_out);
-    asdf_ndarray_err_t err = ASDF_NDARRAY_OK;
-    uint32_t inner_dim = ndim - 1;
-    int64_t *strides = malloc(sizeof(int64_t) * ndim);
+/** Whether the ndarray's data is in the host byte order, or byte order does not apply to it */
+static bool asdf_ndarray_is_native_byteorder(const asdf_ndarray_t *ndarray) {
+    asdf_scalar_datatype_t type = ndarray->datatype.type;
+    // The byte order of strings applies to each UCS4 code point
+    size_t unit_size = type == ASDF_DATATYPE_UCS4 ? 4 : asdf_scalar_datatype_size(type);
+    return !should_byteswap(unit_size, ndarray->byteorder);
+}
 
-    if (!strides) {
-        err = ASDF_NDARRAY_ERR_OOM;
-        goto cleanup;
-    }
 
-    strides[inner_dim] = 1;
+/**
+ * Fill ``strides`` with the stride in bytes along each dimension of the ndarray's data: its own
+ * strides if it has any, otherwise those of a C-contiguous array of ``elsize`` byte elements
+ */
+static asdf_ndarray_err_t asdf_ndarray_byte_strides(
+    const asdf_ndarray_t *ndarray, size_t elsize, int64_t *strides) {
+    uint32_t ndim = ndarray->ndim;
 
-    if (ndim > 1) {
-        for (uint32_t dim = inner_dim; dim > 0; dim--) {
-            uint64_t extent = shape[dim];
-            int64_t stride = strides[dim];
-            // Bounds checking
-            if (extent > (uint64_t)INT64_MAX / llabs(stride)) {
-                err = ASDF_NDARRAY_ERR_OUT_OF_BOUNDS;
-                goto cleanup;
-            }
-            strides[dim - 1] = stride * (int64_t)extent;
-        }
+    if (ndarray->strides) {
+        memcpy(strides, ndarray->strides, sizeof(int64_t) * ndim);
+        return ASDF_NDARRAY_OK;
     }
 
-    *strides_out = strides;
-cleanup:
-    if (err != ASDF_NDARRAY_OK)
-        free(strides);
+    if (ndim == 0)
+        return ASDF_NDARRAY_OK;
 
-    return err;
+    strides[ndim - 1] = (int64_t)elsize;
+
+    for (uint32_t dim = ndim - 1; dim > 0; dim--) {
+        uint64_t extent = ndarray->shape[dim];
+
+        // Once a dimension is empty, the strides of the dimensions before it are all zero
+        if (strides[dim] != 0 && extent > (uint64_t)INT64_MAX / (uint64_t)strides[dim])
+            return ASDF_NDARRAY_ERR_OUT_OF_BOUNDS;
+
+        strides[dim - 1] = strides[dim] * (int64_t)extent;
+    }
+
+    return ASDF_NDARRAY_OK;
 }
 
 
-static inline asdf_ndarray_err_t asdf_ndarray_read_tile_main_loop(
-    void *dst,
-    size_t dst_elsize,
-    const void *src,
-    size_t src_elsize,
+/**
+ * Compute the lowest and highest byte offsets of the elements of a non-empty tile, given the byte
+ * offset ``start`` of its first element and its byte ``strides``
+ *
+ * Returns false if either would overflow.
+ */
+static bool asdf_ndarray_tile_extent(
+    int64_t start,
     const uint64_t *shape,
     const int64_t *strides,
-    const uint64_t *origin,
-    uint64_t *odometer,
     uint32_t ndim,
-    asdf_ndarray_convert_fn_t convert) {
-    bool done = false;
-    bool overflow = false;
-    uint32_t inner_dim = ndim - 1;
-    uint64_t inner_nelem = shape[inner_dim];
-    size_t inner_size = inner_nelem * dst_elsize;
-    void *dst_tmp = dst;
-
-    while (!done) {
-        overflow = convert(dst_tmp, src, inner_nelem, dst_elsize);
-        dst_tmp += inner_size;
-
-        uint32_t dim = inner_dim - 1;
-        do {
-            odometer[dim]++;
-            src += strides[dim] * src_elsize;
+    int64_t *lowest,
+    int64_t *highest) {
+    *lowest = start;
+    *highest = start;
 
-            if (odometer[dim] < origin[dim] + shape[dim])
-                break;
-
-            if (dim == 0) {
-                done = true;
-                break;
-            }
+    for (uint32_t dim = 0; dim < ndim; dim++) {
+        uint64_t steps = shape[dim] - 1;
+        // Avoids overflow in negating INT64_MIN
+        uint64_t stride_abs = strides[dim] < 0 ? -(uint64_t)strides[dim] : (uint64_t)strides[dim];
 
-            odometer[dim] = origin[dim];
-            // Back up
-            src -= shape[dim] * strides[dim] * src_elsize;
-        } while (dim-- > 0);
-    }
+        if (stride_abs != 0 && steps > (uint64_t)INT64_MAX / stride_abs)
+            return false;
 
-    return overflow ? ASDF_NDARRAY_ERR_OVERFLOW : ASDF_NDARRAY_OK;
-}
+        int64_t span = (int64_t)steps * strides[dim];
 
+        if (span < 0) {
+            if (*lowest < INT64_MIN - span)
+                return false;
 
-static inline bool check_bounds(
-    const asdf_ndarray_t *ndarray, const uint64_t *origin, const uint64_t *shape) {
-    // TODO: (Maybe? allow option for edge cases with fill values for out-of-bound pixels?
-    uint64_t *array_shape = ndarray->shape;
-    uint32_t ndim = ndarray->ndim;
+            *lowest += span;
+        } else {
+            if (*highest > INT64_MAX - span)
+                return false;
 
-    for (uint32_t idx = 0; idx < ndim; idx++) {
-        if (origin[idx] + shape[idx] > array_shape[idx])
-            return false;
+            *highest += span;
+        }
     }
 
     return true;
 }
 
 
+/**
+ * Check that every element of a tile lies within ``data_size`` bytes of data, given the byte
+ * offset ``start`` of its first element and its byte ``strides``
+ */
+static bool asdf_ndarray_tile_in_bounds(
+    int64_t start,
+    const uint64_t *shape,
+    const int64_t *strides,
+    uint32_t ndim,
+    size_t elsize,
+    size_t data_size) {
+    // An empty tile touches no data at all
+    for (uint32_t dim = 0; dim < ndim; dim++) {
+        if (shape[dim] == 0)
+            return true;
+    }
+
+    int64_t lowest = 0;
+    int64_t highest = 0;
+
+    if (!asdf_ndarray_tile_extent(start, shape, strides, ndim, &lowest, &highest))
+        return false;
+
+    return lowest >= 0 && (uint64_t)highest + elsize <= data_size;
+}
+
+
+/** Size of the buffer that rows with non-contiguous elements are gathered into for conversion */
+#define ASDF_NDARRAY_GATHER_BUFFER_SIZE 16384
+
+
+/** Parameters shared by all threads reading a tile */
+typedef struct {
+    uint8_t *dst;
+    size_t dst_elsize;
+    /** Source data at the origin of the tile */
+    const uint8_t *src;
+    size_t src_elsize;
+    const uint64_t *shape;
+    /** Strides in bytes of the source data */
+    const int64_t *strides;
+    uint32_t ndim;
+    asdf_ndarray_convert_fn_t convert;
+    /** Whether the tile is contiguous in the source, and can be read as a single row */
+    bool contiguous;
+    /** Whether the elements of each row are not adjacent, and must be gathered to be converted */
+    bool gather;
+} tile_read_t;
+
+
+/**
+ * A range of a tile read by one thread
+ *
+ * For contiguous tiles this is ``count`` elements starting from element ``start``; otherwise
+ * ``count`` rows (along the innermost dimension) starting from row ``start``, counted over the
+ * outer dimensions of the tile in C order.
+ */
+typedef struct {
+    const tile_read_t *read;
+    uint64_t start;
+    uint64_t count;
+    /** Position of the current row in the outer dimensions of the tile */
+    uint64_t *odometer;
+    bool overflow;
+} tile_read_task_t;
+
+
+#define GATHER_ELEMENTS(type) \
+    do { \
+        for (size_t idx = 0; idx < count; idx++, src += stride, dst += sizeof(type)) \
+            memcpy(dst, src, sizeof(type)); \
+    } while (0)
+
+
+/**
+ * Copy ``count`` elements of ``elsize`` bytes each, spaced ``stride`` bytes apart starting from
+ * ``src``, to be adjacent in ``dst``
+ */
+static void asdf_ndarray_gather(
+    uint8_t *dst, const uint8_t *src, int64_t stride, size_t count, size_t elsize) {
+    switch (elsize) {
+    case 1:
+        GATHER_ELEMENTS(uint8_t);
+        break;
+    case 2:
+        GATHER_ELEMENTS(uint16_t);
+        break;
+    case 4:
+        GATHER_ELEMENTS(uint32_t);
+        break;
+    case 8:
+        GATHER_ELEMENTS(uint64_t);
+        break;
+    default:
+        for (size_t idx = 0; idx < count; idx++, src += stride, dst += elsize)
+            memcpy(dst, src, elsize);
+    }
+}
+
+
+/** Convert one row of a tile whose elements are not adjacent, a buffer's worth at a time */
+static bool asdf_ndarray_read_tile_gather_row(
+    const tile_read_t *read, uint8_t *dst, const uint8_t *src, uint64_t nelem) {
+    alignas(max_align_t) uint8_t buf[ASDF_NDARRAY_GATHER_BUFFER_SIZE];
+    size_t src_elsize = read->src_elsize;
+    int64_t stride = read->strides[read->ndim - 1];
+    uint64_t chunk_nelem = ASDF_NDARRAY_GATHER_BUFFER_SIZE / src_elsize;
+    bool overflow = false;
+
+    while (nelem > 0) {
+        uint64_t chunk = nelem < chunk_nelem ? nelem : chunk_nelem;
+        asdf_ndarray_gather(buf, src, stride, chunk, src_elsize);
+        overflow |= read->convert(dst, buf, chunk, read->dst_elsize);
+        src += (int64_t)chunk * stride;
+        dst += chunk * read->dst_elsize;
+        nelem -= chunk;
+    }
+
+    return overflow;
+}
+
+
+static bool asdf_ndarray_read_tile_rows(
+    const tile_read_t *read, uint64_t start, uint64_t count, uint64_t *odometer) {
+    uint32_t inner_dim = read->ndim - 1;
+    uint64_t inner_nelem = read->shape[inner_dim];
+    size_t inner_size = inner_nelem * read->dst_elsize;
+    const uint64_t *shape = read->shape;
+    const int64_t *strides = read->strides;
+    const uint8_t *src = read->src;
+    uint8_t *dst = read->dst + (start * inner_size);
+    bool overflow = false;
+
+    // Wind the odometer forward to the first row
+    for (uint32_t dim = inner_dim; dim-- > 0;) {
+        odometer[dim] = start % shape[dim];
+        start /= shape[dim];
+        src += (int64_t)odometer[dim] * strides[dim];
+    }
+
+    for (uint64_t row = 0; row < count; row++) {
+        // If convert() returns non-zero it means an overflow occurred while copying; this does
+        // not necessarily have to be treated as an error depending on the application.
+        if (read->gather)
+            overflow |= asdf_ndarray_read_tile_gather_row(read, dst, src, inner_nelem);
+        else
+            overflow |= read->convert(dst, src, inner_nelem, read->dst_elsize);
+
+        dst += inner_size;
+
+        for (uint32_t dim = inner_dim; dim-- > 0;) {
+            src += strides[dim];
+
+            if (++odometer[dim] < shape[dim])
+                break;
+
+            odometer[dim] = 0;
+            // Back up
+            src -= (int64_t)shape[dim] * strides[dim];
+        }
+    }
+
+    return overflow;
+}
+
+
+static void asdf_ndarray_read_tile_task_run(void *arg) {
+    tile_read_task_t *task = arg;
+    const tile_read_t *read = task->read;
+
+    if (read->contiguous) {
+        task->overflow = read->convert(
+            read->dst + (task->start * read->dst_elsize),
+            read->src + (task->start * read->src_elsize),
+            task->count,
+            read->dst_elsize);
+    } else {
+        task->overflow = asdf_ndarray_read_tile_rows(
+            read, task->start, task->count, task->odometer);
+    }
+}
+
+
+/** Return the number of elements (contiguous tiles) or rows (otherwise) the tile is read in */
+static uint64_t asdf_ndarray_read_tile_n_units(const tile_read_t *read) {
+    uint32_t ndim = read->contiguous ? read->ndim : read->ndim - 1;
+    uint64_t n_units = 1;
+
+    for (uint32_t dim = 0; dim < ndim; dim++)
+        n_units *= read->shape[dim];
+
+    return n_units;
+}
+
+
+/**
+ * Read the tile, splitting it into contiguous ranges of rows (or elements, for contiguous tiles)
+ * read in parallel where configured
+ *
+ * The result, including whether any element overflowed, is the same however the tile is split as
+ * every range is converted independently.
+ */
+static asdf_ndarray_err_t asdf_ndarray_read_tile_main_loop(
+    asdf_file_t *file, const tile_read_t *read, size_t tile_size) {
+    uint32_t inner_dim = read->ndim - 1;
+    uint64_t n_units = asdf_ndarray_read_tile_n_units(read);
+    asdf_thread_pool_t *pool = NULL;
+    unsigned int n_tasks = asdf_ndarray_n_tasks(file, tile_size, n_units, &pool);
+    tile_read_task_t single_task = {0};
+    tile_read_task_t *tasks = &single_task;
+    uint64_t *odometers = NULL;
+
+    if (n_tasks > 1)
+        tasks = calloc(n_tasks, sizeof(tile_read_task_t));
+
+    bool need_odometers = !read->contiguous && inner_dim > 0;
+
+    if (need_odometers)
+        odometers = malloc(sizeof(uint64_t) * inner_dim * n_tasks);
+
+    if (UNLIKELY(!tasks || (need_odometers && !odometers))) {
+        if (tasks != &single_task)
+            free(tasks);
+
+        free(odometers);
+        return ASDF_NDARRAY_ERR_OOM;
+    }
+
+    uint64_t start = 0;
+
+    for (unsigned int idx = 0; idx < n_tasks; idx++) {
+        uint64_t end = (n_units * (idx + 1)) / n_tasks;
+        tasks[idx].read = read;
+        tasks[idx].start = start;
+        tasks[idx].count = end - start;
+        tasks[idx].odometer = odometers ? odometers + ((size_t)idx * inner_dim) : NULL;
+        start = end;
+    }
+
+    asdf_thread_pool_run(
+        pool, asdf_ndarray_read_tile_task_run, tasks, sizeof(tile_read_task_t), n_tasks);
+
+    bool overflow = false;
+
+    for (unsigned int idx = 0; idx < n_tasks; idx++)
+        overflow |= tasks[idx].overflow;
+
+    if (tasks != &single_task)
+        free(tasks);
+
+    free(odometers);
+    return overflow ? ASDF_NDARRAY_ERR_OVERFLOW : ASDF_NDARRAY_OK;
+}
+
+
+/**
+ * Point ``read`` at the tile of ``shape`` at ``origin`` in the array's ``data``, and determine
+ * whether it is contiguous in the source
+ *
+ * The rest of ``read``, in particular its strides, must already be set up for the array.  Returns
+ * the byte offset of the tile's first element in ``data``, which must already have been checked
+ * to contain the whole array.
+ */
+static int64_t asdf_ndarray_read_tile_locate(
+    tile_read_t *read,
+    const uint8_t *data,
+    uint64_t array_offset,
+    const uint64_t *origin,
+    const uint64_t *shape) {
+    const int64_t *strides = read->strides;
+    int64_t offset = (int64_t)array_offset;
+    // The tile is contiguous in the source if, skipping over dimensions of length 1, the stride
+    // of each dimension is the size of the tile's extent in the dimensions after it; this is the
+    // case in particular for all of a C-contiguous array, or any row of one
+    bool contiguous = true;
+    int64_t extent = (int64_t)read->src_elsize;
+
+    for (uint32_t dim = read->ndim; dim-- > 0;) {
+        offset += (int64_t)origin[dim] * strides[dim];
+
+        if (contiguous && shape[dim] != 1 && strides[dim] != extent)
+            contiguous = false;
+
+        extent *= (int64_t)shape[dim];
+    }
+
+    read->src = data + offset;
+    read->shape = shape;
+    read->contiguous = contiguous;
+    return offset;
+}
+
+
+static inline bool check_bounds(
+    const asdf_ndarray_t *ndarray, const uint64_t *origin, const uint64_t *shape) {
+    // TODO: (Maybe? allow option for edge cases with fill values for out-of-bound pixels?
+    uint64_t *array_shape = ndarray->shape;
+    uint32_t ndim = ndarray->ndim;
+
+    for (uint32_t idx = 0; idx < ndim; idx++) {
+        if (origin[idx] + shape[idx] > array_shape[idx])
+            return false;
+    }
+
+    return true;
+}
+
+
+/** Number of elements in a tile of ``shape``, where zero-dimensional tiles count as empty */
+static uint64_t asdf_ndarray_tile_nelems(uint32_t ndim, const uint64_t *shape) {
+    uint64_t nelems = ndim > 0 ? 1 : 0;
+
+    for (uint32_t dim = 0; dim < ndim; dim++)
+        nelems *= shape[dim];
+
+    return nelems;
+}
+
+
 asdf_ndarray_err_t asdf_ndarray_read_tile_ndim(
     asdf_ndarray_t *ndarray,
     const uint64_t *origin,
@@ -1565,7 +2148,6 @@ asdf_ndarray_err_t asdf_ndarray_read_tile_ndim(
 
     void *new_buf = NULL;
     int64_t *strides = NULL;
-    uint64_t *odometer = NULL;
     uint32_t ndim = ndarray->ndim;
     asdf_scalar_datatype_t src_t = ndarray->datatype.type;
     asdf_ndarray_err_t err = ASDF_NDARRAY_ERR_INVAL;
@@ -1584,19 +2166,41 @@ asdf_ndarray_err_t asdf_ndarray_read_tile_ndim(
     if (!check_bounds(ndarray, origin, shape))
         return ASDF_NDARRAY_ERR_OUT_OF_BOUNDS;
 
-    size_t tile_nelems = ndim > 0 ? 1 : 0;
-
-    for (uint32_t dim = 0; dim < ndim; dim++) {
-        tile_nelems *= shape[dim];
-    }
-
+    size_t tile_nelems = asdf_ndarray_tile_nelems(ndim, shape);
     size_t src_tile_size = src_elsize * tile_nelems;
     size_t tile_size = dst_elsize * tile_nelems;
     size_t data_size = 0;
-    const void *data = asdf_ndarray_data_raw(ndarray, &data_size);
+    // Reading the whole array is a sequential scan; partial tiles touch sparse ranges of the
+    // block so read-ahead would mostly fetch pages that are never used
+    asdf_access_hint_t default_hint = ASDF_ACCESS_HINT_RANDOM;
 
-    if (data_size < src_tile_size)
-        return ASDF_NDARRAY_ERR_OUT_OF_BOUNDS;
+    if (tile_nelems == asdf_ndarray_size(ndarray))
+        default_hint = ASDF_ACCESS_HINT_SEQUENTIAL | ASDF_ACCESS_HINT_WILLNEED;
+
+    const void *data = asdf_ndarray_data_hinted(ndarray, &data_size, default_hint);
+
+    if (ndim > 0) {
+        strides = malloc(sizeof(int64_t) * ndim);
+
+        if (UNLIKELY(!strides))
+            return ASDF_NDARRAY_ERR_OOM;
+
+        // Byte strides of the source data, from the ndarray's strides if it has them
+        err = asdf_ndarray_byte_strides(ndarray, src_elsize, strides);
+
+        // Checking that the whole array is within the data also ensures that the offset of the
+        // tile's first element can be computed without overflowing
+        if (err == ASDF_NDARRAY_OK && tile_size > 0 &&
+            (!data || ndarray->offset > (uint64_t)INT64_MAX ||
+             !asdf_ndarray_tile_in_bounds(
+                 (int64_t)ndarray->offset, ndarray->shape, strides, ndim, src_elsize, data_size)))
+            err = ASDF_NDARRAY_ERR_OUT_OF_BOUNDS;
+
+        if (err != ASDF_NDARRAY_OK) {
+            free(strides);
+            return err;
+        }
+    }
 
     // If the function is passed a null pointer, allocate memory for the tile ourselves
     // User is responsible for freeing it.
@@ -1608,14 +2212,17 @@ asdf_ndarray_err_t asdf_ndarray_read_tile_ndim(
         new_buf = tile;
     }
 
-    if (UNLIKELY(!tile))
-        return ASDF_NDARRAY_ERR_OOM;
+    if (UNLIKELY(!tile)) {
+        err = ASDF_NDARRAY_ERR_OOM;
+        goto cleanup;
+    }
 
     // Special case, if size of the array is 0 just return now.  We do still malloc though even if
     // it's a bit pointless, just to ensure that the returned pointer can be freed successfully
     if (UNLIKELY(0 == ndim || 0 == tile_size)) {
         *dst = tile;
-        return ASDF_NDARRAY_OK;
+        err = ASDF_NDARRAY_OK;
+        goto cleanup;
     }
 
     // Determine the copy strategy to use; right now this just handles whether-or-not byteswap
@@ -1635,62 +2242,33 @@ asdf_ndarray_err_t asdf_ndarray_read_tile_ndim(
             dst_datatype);
         memcpy(tile, data, src_tile_size);
         *dst = tile;
-        return ASDF_NDARRAY_ERR_CONVERSION;
-    }
-
-    bool overflow = false;
-    // Determine element strides (assume C-order for now; ndarray->strides is not used yet)
-    err = asdf_ndarray_read_tile_init_strides(ndarray->shape, ndim, &strides);
-
-    if (err != ASDF_NDARRAY_OK)
+        err = ASDF_NDARRAY_ERR_CONVERSION;
         goto cleanup;
-
-    uint32_t inner_dim = ndim - 1;
-    uint64_t offset = origin[inner_dim];
-    bool is_1d = true;
-
-    if (ndim > 1) {
-        for (uint32_t dim = 0; dim < inner_dim; dim++) {
-            offset += origin[dim] * strides[dim];
-            // If any of the outer dimensions are >1 than it's not a 1d tile
-            is_1d &= (shape[dim] == 1);
-        }
-        offset *= src_elsize;
-    } else {
-        offset = origin[0] * src_elsize;
     }
 
-    // Special case if the "tile" is one-dimensional, C-contiguous
-    if (is_1d) {
-        const void *src = data + offset;
-        // If convert() returns non-zero it means an overflow occurred
-        // while copying; this does not necessarily have to be treated as an error depending
-        // on the application.
-        overflow = convert(tile, src, tile_nelems, dst_elsize);
-        err = overflow ? ASDF_NDARRAY_ERR_OVERFLOW : ASDF_NDARRAY_OK;
-        *dst = tile;
-        goto cleanup;
-    }
+    tile_read_t read = {
+        .dst = tile,
+        .dst_elsize = dst_elsize,
+        .src_elsize = src_elsize,
+        .strides = strides,
+        .ndim = ndim,
+        .convert = convert,
+        // Rows of Fortran-ordered or sliced arrays, for example
+        .gather = strides[ndim - 1] != (int64_t)src_elsize,
+    };
 
-    odometer = malloc(sizeof(uint64_t) * inner_dim);
+    asdf_ndarray_read_tile_locate(&read, data, ndarray->offset, origin, shape);
+    err = asdf_ndarray_read_tile_main_loop(ndarray->internal->file, &read, tile_size);
 
-    if (!odometer) {
-        err = ASDF_NDARRAY_ERR_OOM;
-        goto cleanup;
-    }
-
-    memcpy(odometer, origin, sizeof(uint64_t) * inner_dim);
-    const void *src = data + offset;
-
-    err = asdf_ndarray_read_tile_main_loop(
-        tile, dst_elsize, src, src_elsize, shape, strides, origin, odometer, ndim, convert);
-    *dst = tile;
+    if (err == ASDF_NDARRAY_OK || err == ASDF_NDARRAY_ERR_OVERFLOW)
+        *dst = tile;
 cleanup:
-    if (!overflow && err != ASDF_NDARRAY_OK)
+    // The tile is still returned on overflow or failed conversion, so only free it on other errors
+    if (err != ASDF_NDARRAY_OK && err != ASDF_NDARRAY_ERR_OVERFLOW &&
+        err != ASDF_NDARRAY_ERR_CONVERSION)
         free(new_buf);
 
     free(strides);
-    free(odometer);
     return err;
 }
 
@@ -1756,3 +2334,323 @@ cleanup:
     free(shape);
     return err;
 }
+
+
+/** Gaps up to this size between the source ranges of a batch of tiles are prefetched too */
+#define ASDF_NDARRAY_PREFETCH_MAX_GAP (64 * 1024)
+
+
+/** One tile of a batched read, read in full by a single thread */
+typedef struct {
+    tile_read_t read;
+    tile_read_task_t task;
+    /** Index of the tile in the caller's arrays */
+    size_t index;
+    /** Range of byte offsets of the source data touched by the tile */
+    int64_t start;
+    int64_t end;
+} tiles_read_item_t;
+
+
+static int tiles_read_item_cmp(const void *a, const void *b) {
+    const tiles_read_item_t *lhs = a;
+    const tiles_read_item_t *rhs = b;
+
+    if (lhs->start != rhs->start)
+        return (lhs->start > rhs->start) - (lhs->start < rhs->start);
+
+    return (lhs->index > rhs->index) - (lhs->index < rhs->index);
+}
+
+
+static void asdf_ndarray_read_tiles_task_run(void *arg) {
+    tiles_read_item_t *item = arg;
+    asdf_ndarray_read_tile_task_run(&item->task);
+}
+
+
+/**
+ * Prefetch the source data of tiles sorted by their start offsets, merging ranges that overlap or
+ * are only separated by small gaps into a single request
+ */
+static void asdf_ndarray_read_tiles_prefetch(
+    asdf_block_t *block, const uint8_t *data, const tiles_read_item_t *items, size_t n_items) {
+    if (!block || n_items == 0)
+        return;
+
+    int64_t start = items[0].start;
+    int64_t end = items[0].end;
+
+    for (size_t idx = 1; idx < n_items; idx++) {
+        if (items[idx].start <= end + ASDF_NDARRAY_PREFETCH_MAX_GAP) {
+            if (items[idx].end > end)
+                end = items[idx].end;
+
+            continue;
+        }
+
+        asdf_block_prefetch(block, data + start, (size_t)(end - start));
+        start = items[idx].start;
+        end = items[idx].end;
+    }
+
+    asdf_block_prefetch(block, data + start, (size_t)(end - start));
+}
+
+
+asdf_ndarray_err_t asdf_ndarray_read_tiles(
+    asdf_ndarray_t *ndarray,
+    size_t n_tiles,
+    const uint64_t *const *origins,
+    const uint64_t *const *shapes,
+    asdf_scalar_datatype_t dst_t,
+    void **dsts) {
+
+    if (UNLIKELY(!ndarray || (n_tiles > 0 && (!origins || !shapes || !dsts))))
+        // Invalid argument, must be non-NULL
+        return ASDF_NDARRAY_ERR_INVAL;
+
+    uint32_t ndim = ndarray->ndim;
+    asdf_scalar_datatype_t src_t = ndarray->datatype.type;
+
+    if (dst_t == ASDF_DATATYPE_SOURCE)
+        dst_t = src_t;
+
+    size_t src_elsize = asdf_scalar_datatype_size(src_t);
+    size_t dst_elsize = asdf_scalar_datatype_size(dst_t);
+
+    // For not-yet-supported datatypes return ERR_INVAL
+    if (src_elsize < 1 || dst_elsize < 1)
+        return ASDF_NDARRAY_ERR_INVAL;
+
+    // Check all the tiles up front so that either all of them are read or none are
+    size_t n_items = 0;
+
+    for (size_t idx = 0; idx < n_tiles; idx++) {
+        if (UNLIKELY(!origins[idx] || !shapes[idx]))
+            return ASDF_NDARRAY_ERR_INVAL;
+
+        if (!check_bounds(ndarray, origins[idx], shapes[idx]))
+            return ASDF_NDARRAY_ERR_OUT_OF_BOUNDS;
+
+        if (asdf_ndarray_tile_nelems(ndim, shapes[idx]) > 0)
+            n_items++;
+    }
+
+    if (n_tiles == 0)
+        return ASDF_NDARRAY_OK;
+
+    asdf_ndarray_err_t err = ASDF_NDARRAY_ERR_OOM;
+    void **tiles = calloc(n_tiles, sizeof(void *));
+    tiles_read_item_t *items = NULL;
+    int64_t *strides = NULL;
+    uint64_t *odometers = NULL;
+    uint32_t inner_dim = ndim > 0 ? ndim - 1 : 0;
+
+    if (n_items > 0) {
+        items = calloc(n_items, sizeof(tiles_read_item_t));
+        strides = malloc(sizeof(int64_t) * ndim);
+
+        // A single allocation of odometers for all the tiles, though contiguous ones do not use
+        // theirs
+        if (inner_dim > 0)
+            odometers = malloc(sizeof(uint64_t) * inner_dim * n_items);
+    }
+
+    if (UNLIKELY(!tiles || (n_items > 0 && (!items || !strides || (inner_dim > 0 && !odometers)))))
+        goto cleanup;
+
+    size_t data_size = 0;
+    // The tiles are likely to touch sparse ranges of the block, so rather than reading ahead
+    // blindly only the ranges they cover are prefetched below
+    const uint8_t *data = asdf_ndarray_data_hinted(ndarray, &data_size, ASDF_ACCESS_HINT_RANDOM);
+    asdf_ndarray_convert_fn_t convert = NULL;
+
+    if (n_items > 0) {
+        err = asdf_ndarray_byte_strides(ndarray, src_elsize, strides);
+
+        if (err == ASDF_NDARRAY_OK &&
+            (!data || ndarray->offset > (uint64_t)INT64_MAX ||
+             !asdf_ndarray_tile_in_bounds(
+                 (int64_t)ndarray->offset, ndarray->shape, strides, ndim, src_elsize, data_size)))
+            err = ASDF_NDARRAY_ERR_OUT_OF_BOUNDS;
+
+        if (err != ASDF_NDARRAY_OK)
+            goto cleanup;
+
+        bool byteswap = should_byteswap(src_elsize, ndarray->byteorder);
+        convert = asdf_ndarray_get_convert_fn(src_t, dst_t, byteswap);
+
+        if (convert == NULL) {
+            ASDF_LOG(
+                ndarray->internal->file,
+                ASDF_LOG_WARN,
+                "datatype conversion from \"%s\" to \"%s\" not supported for ndarray tile copy",
+                asdf_scalar_datatype_to_string(src_t),
+                asdf_scalar_datatype_to_string(dst_t));
+            err = ASDF_NDARRAY_ERR_CONVERSION;
+            goto cleanup;
+        }
+    }
+
+    // If passed null pointers, allocate memory for the tiles ourselves; the user is responsible for
+    // freeing them
+    for (size_t idx = 0; idx < n_tiles; idx++) {
+        tiles[idx] = dsts[idx];
+
+        if (!tiles[idx]) {
+            // NOLINTNEXTLINE(clang-analyzer-optin.portability.UnixAPI)
+            tiles[idx] = malloc(dst_elsize * asdf_ndarray_tile_nelems(ndim, shapes[idx]));
+
+            if (UNLIKELY(!tiles[idx])) {
+                err = ASDF_NDARRAY_ERR_OOM;
+                goto cleanup;
+            }
+        }
+    }
+
+    size_t item_idx = 0;
+    size_t total_size = 0;
+
+    for (size_t idx = 0; idx < n_tiles; idx++) {
+        uint64_t nelems = asdf_ndarray_tile_nelems(ndim, shapes[idx]);
+
+        if (nelems == 0)
+            continue;
+
+        tiles_read_item_t *item = &items[item_idx++];
+        item->index = idx;
+        item->read = (tile_read_t){
+            .dst = tiles[idx],
+            .dst_elsize = dst_elsize,
+            .src_elsize = src_elsize,
+            .strides = strides,
+            .ndim = ndim,
+            .convert = convert,
+            .gather = strides[inner_dim] != (int64_t)src_elsize,
+        };
+
+        int64_t offset = asdf_ndarray_read_tile_locate(
+            &item->read, data, ndarray->offset, origins[idx], shapes[idx]);
+        // Cannot overflow, since the whole array is within the data
+        asdf_ndarray_tile_extent(offset, shapes[idx], strides, ndim, &item->start, &item->end);
+        item->end += (int64_t)src_elsize;
+        total_size += nelems * dst_elsize;
+    }
+
+    bool overflow = false;
+
+    if (n_items > 0) {
+        // Reading the tiles in order of their position in the source turns many small random
+        // reads into (close to) one sequential sweep over the data
+        qsort(items, n_items, sizeof(tiles_read_item_t), tiles_read_item_cmp);
+
+        for (size_t idx = 0; idx < n_items; idx++) {
+            tiles_read_item_t *item = &items[idx];
+            item->task = (tile_read_task_t){
+                .read = &item->read,
+                .count = asdf_ndarray_read_tile_n_units(&item->read),
+                .odometer = odometers ? odometers + (idx * inner_dim) : NULL,
+            };
+        }
+
+        asdf_ndarray_read_tiles_prefetch(ndarray->internal->block, data, items, n_items);
+
+        // Each tile is read whole by one thread, with the pool handing them out in sorted order
+        asdf_thread_pool_t *pool = NULL;
+        asdf_ndarray_n_tasks(ndarray->internal->file, total_size, n_items, &pool);
+        asdf_thread_pool_run(
+            pool, asdf_ndarray_read_tiles_task_run, items, sizeof(tiles_read_item_t), n_items);
+
+        for (size_t idx = 0; idx < n_items; idx++)
+            overflow |= items[idx].task.overflow;
+    }
+
+    for (size_t idx = 0; idx < n_tiles; idx++)
+        dsts[idx] = tiles[idx];
+
+    err = overflow ? ASDF_NDARRAY_ERR_OVERFLOW : ASDF_NDARRAY_OK;
+cleanup:
+    // Free only the tiles allocated here, and only if they are not being returned
+    if (err != ASDF_NDARRAY_OK && err != ASDF_NDARRAY_ERR_OVERFLOW && tiles) {
+        for (size_t idx = 0; idx < n_tiles; idx++) {
+            if (tiles[idx] != dsts[idx])
+                free(tiles[idx]);
+        }
+    }
+
+    free(odometers);
+    free(strides);
+    free(items);
+    free(tiles);
+    return err;
+}
+
+
+asdf_ndarray_err_t asdf_ndarray_view(
+    asdf_ndarray_t *ndarray,
+    const uint64_t *origin,
+    const uint64_t *shape,
+    const void **data,
+    int64_t *strides) {
+
+    if (UNLIKELY(!ndarray || !data || !strides))
+        // Invalid argument, must be non-NULL
+        return ASDF_NDARRAY_ERR_INVAL;
+
+    uint32_t ndim = ndarray->ndim;
+    size_t elsize = ndarray->datatype.size;
+    uint64_t nelems = ndim > 0 ? 1 : 0;
+
+    if (!shape)
+        shape = ndarray->shape;
+
+    for (uint32_t dim = 0; dim < ndim; dim++) {
+        uint64_t first = origin ? origin[dim] : 0;
+
+        if (first + shape[dim] > ndarray->shape[dim])
+            return ASDF_NDARRAY_ERR_OUT_OF_BOUNDS;
+
+        nelems *= shape[dim];
+    }
+
+    if (elsize < 1)
+        return ASDF_NDARRAY_ERR_INVAL;
+
+    if (!asdf_ndarray_is_native_byteorder(ndarray))
+        return ASDF_NDARRAY_ERR_COPY_REQUIRED;
+
+    asdf_ndarray_err_t err = asdf_ndarray_byte_strides(ndarray, elsize, strides);
+
+    if (err != ASDF_NDARRAY_OK)
+        return err;
+
+    // Viewing the whole array is likely to be followed by a sequential scan of it
+    asdf_access_hint_t default_hint = ASDF_ACCESS_HINT_RANDOM;
+
+    if (nelems == asdf_ndarray_size(ndarray))
+        default_hint = ASDF_ACCESS_HINT_SEQUENTIAL | ASDF_ACCESS_HINT_WILLNEED;
+
+    size_t data_size = 0;
+    const uint8_t *base = asdf_ndarray_data_hinted(ndarray, &data_size, default_hint);
+
+    if (nelems == 0) {
+        *data = base;
+        return ASDF_NDARRAY_OK;
+    }
+
+    // Checking that the whole array is within the data also ensures that the offset of the
+    // tile's first element can be computed without overflowing
+    if (!base || ndarray->offset > (uint64_t)INT64_MAX ||
+        !asdf_ndarray_tile_in_bounds(
+            (int64_t)ndarray->offset, ndarray->shape, strides, ndim, elsize, data_size))
+        return ASDF_NDARRAY_ERR_OUT_OF_BOUNDS;
+
+    int64_t start = (int64_t)ndarray->offset;
+
+    for (uint32_t dim = 0; origin && dim < ndim; dim++)
+        start += (int64_t)origin[dim] * strides[dim];
+
+    *data = base + start;
+    return ASDF_NDARRAY_OK;
+}
@@ -22,6 +22,8 @@ typedef struct {
     bool data_is_inline;
     /* Storage mode to use when writing this ndarray */
     asdf_array_storage_t array_storage;
+    /* Access hint set by the user; applied to the block when it is opened */
+    asdf_access_hint_t access_hint;
 } asdf_ndarray_internal_t;
 
 
@@ -11,12 +11,17 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "../util.h"
 
 #include "ndarray.h"
 #include "ndarray_convert.h"
 
+#ifdef ASDF_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
 
 // NOLINTBEGIN(readability-identifier-length)
 static inline uint16_t bswap_uint16_t(uint16_t x) {
@@ -56,20 +61,18 @@ static inline double bswap_double(double x) {
 #define _DO_BSWAP_1(src_t, val) val = bswap_##src_t(val)
 
 
-// TODO: For all these conversion functions also pass in an argument specifying whether the src
-// and dst are aligned; then we can use __builtin_assume_aligned here though need to
-// have a clear routine for checking it first
-typedef void (*asdf_ndarray_tile_convert_fn_t)(
-    void *restrict dst, const void *restrict src, size_t nitems);
-
-
 /**
  * Dispatch table for datatype conversion functions
  *
- * The third dimension is for whether or not to perform byteswap.
+ * The third dimension is for whether or not to perform byteswap.  This starts out as a copy
+ * of ``generic_conversion_table``, with the vectorized kernels (see below) substituted where
+ * the CPU supports them.
  */
 static asdf_ndarray_convert_fn_t conversion_table[ASDF_DATATYPE_STRUCTURED]
                                                  [ASDF_DATATYPE_STRUCTURED][2] = {0};
+/** The scalar conversion functions */
+static asdf_ndarray_convert_fn_t generic_conversion_table[ASDF_DATATYPE_STRUCTURED]
+                                                         [ASDF_DATATYPE_STRUCTURED][2] = {0};
 static atomic_bool conversion_table_initialized = false;
 
 
@@ -352,6 +355,1113 @@ DEFINE_CLAMP_CONVERSION(float64, double, uint64, uint64_t, 0, UINT64_MAX)
 // NOLINTEND(bugprone-easily-swappable-parameters)
 
 
+/**
+ * float16, complex and bool8 conversions
+ *
+ * Rather than a hand-written function for every type pair, conversions to or from these
+ * types read each element into a `conv_value_t` and write it out again with the same
+ * clamping rules as the functions above: out-of-range values are clamped to the limits of the
+ * destination type (reporting overflow), infinities are preserved by the floating point
+ * types, and NaN converts to 0 (also reporting overflow) for the integer types.  Complex
+ * values convert to real types by discarding the imaginary part, as in numpy, and bool8 is
+ * true for any non-zero value.
+ *
+ * float16 to and from float32 have dedicated functions, as the most common conversions for
+ * half-precision data; float16 is decoded with lookup tables, and encoded with a few integer
+ * operations.
+ */
+typedef struct {
+    double re;
+    double im;
+} conv_value_t;
+
+
+#define FLOAT16_MAX 65504.0
+
+
+/**
+ * Lookup tables for decoding float16
+ *
+ * The float32 bits for a float16 ``h`` are
+ * ``float16_mantissa_table[float16_offset_table[h >> 10] + (h & 0x3ff)] +
+ * float16_exponent_table[h >> 10]``; see "Fast Half Float Conversions" by Jeroen van der Zijp.
+ */
+static uint32_t float16_mantissa_table[2048];
+static uint32_t float16_exponent_table[64];
+static uint16_t float16_offset_table[64];
+
+
+static void float16_tables_init(void) {
+    float16_mantissa_table[0] = 0;
+
+    for (uint32_t idx = 1; idx < 1024; idx++) {
+        // Normalize the mantissa of the subnormal float16
+        uint32_t mantissa = idx << 13;
+        uint32_t exponent = 0;
+
+        while (!(mantissa & 0x00800000)) {
+            exponent -= 0x00800000;
+            mantissa <<= 1;
+        }
+
+        mantissa &= ~0x00800000U;
+        exponent += 0x38800000;
+        float16_mantissa_table[idx] = mantissa | exponent;
+    }
+
+    for (uint32_t idx = 1024; idx < 2048; idx++)
+        float16_mantissa_table[idx] = 0x38000000 + ((idx - 1024) << 13);
+
+    for (uint32_t idx = 0; idx < 64; idx++) {
+        uint32_t sign = idx >= 32 ? 0x80000000 : 0;
+        uint32_t exponent = idx & 0x1f;
+
+        if (exponent == 0)
+            float16_exponent_table[idx] = sign;
+        else if (exponent == 31)
+            float16_exponent_table[idx] = sign | 0x47800000;
+        else
+            float16_exponent_table[idx] = sign | (exponent << 23);
+
+        float16_offset_table[idx] = exponent == 0 ? 0 : 1024;
+    }
+}
+
+
+static inline float float16_to_float(uint16_t half) {
+    uint32_t bits = float16_mantissa_table[float16_offset_table[half >> 10] + (half & 0x3ff)] +
+                    float16_exponent_table[half >> 10];
+    float val;
+
+    // Quiet signaling NaNs, as the F16C instructions do
+    if ((half & 0x7c00) == 0x7c00 && (half & 0x3ff))
+        bits |= 0x00400000;
+
+    memcpy(&val, &bits, sizeof(val));
+    return val;
+}
+
+
+/**
+ * Encode a float as float16 with round-to-nearest-even, as the F16C instructions do
+ *
+ * Overflows to infinity; callers clamp finite values to ``FLOAT16_MAX`` first.
+ */
+static inline uint16_t float_to_float16(float val) {
+    // Adding this to a value below the float16 normal range rounds it to a subnormal float16
+    // in the low mantissa bits
+    const uint32_t subnormal_magic_bits = (uint32_t)((127 - 15) + (23 - 10) + 1) << 23;
+    uint32_t bits;
+    memcpy(&bits, &val, sizeof(bits));
+    uint16_t sign = (uint16_t)((bits >> 16) & 0x8000);
+    bits &= 0x7fffffff;
+
+    if (bits >= 0x7f800000)
+        // Infinity, or NaN which keeps the top of its payload and is made quiet
+        return sign | 0x7c00 | (bits > 0x7f800000 ? 0x200 | ((bits >> 13) & 0x3ff) : 0);
+
+    if (bits >= (uint32_t)(127 + 16) << 23)
+        return sign | 0x7c00;
+
+    if (bits < (uint32_t)(127 - 14) << 23) {
+        float magic;
+        memcpy(&magic, &subnormal_magic_bits, sizeof(magic));
+        memcpy(&val, &bits, sizeof(val));
+        val += magic;
+        memcpy(&bits, &val, sizeof(bits));
+        return sign | (uint16_t)(bits - subnormal_magic_bits);
+    }
+
+    // Rebias the exponent and round the mantissa, ties to even
+    uint32_t odd = (bits >> 13) & 1;
+    bits += ((uint32_t)(15 - 127) << 23) + 0xfff + odd;
+    return sign | (uint16_t)(bits >> 13);
+}
+
+
+/**
+ * Encode a double as float16
+ *
+ * Rounding to float first could round twice, so the double is rounded to odd instead (toward
+ * zero, setting the lowest bit if inexact), which then rounds correctly to float16.
+ */
+static inline uint16_t double_to_float16(double val) {
+    float fval = (float)val;
+
+    if (isfinite(val) && (double)fval != val) {
+        uint32_t bits;
+        memcpy(&bits, &fval, sizeof(bits));
+
+        if (fabs((double)fval) > fabs(val))
+            bits--;
+
+        bits |= 1;
+        memcpy(&fval, &bits, sizeof(fval));
+    }
+
+    return float_to_float16(fval);
+}
+
+
+#define DEFINE_LOAD_VALUE(name, type) \
+    static inline conv_value_t load_##name(const void *src, size_t idx, bool bswap) { \
+        type val; \
+        memcpy(&val, (const type *)src + idx, sizeof(val)); \
+        if (bswap) \
+            val = bswap_##type(val); \
+        return (conv_value_t){(double)val, 0.0}; \
+    }
+
+
+// NOLINTBEGIN(bugprone-easily-swappable-parameters)
+DEFINE_LOAD_VALUE(int8, int8_t)
+DEFINE_LOAD_VALUE(uint8, uint8_t)
+DEFINE_LOAD_VALUE(int16, int16_t)
+DEFINE_LOAD_VALUE(uint16, uint16_t)
+DEFINE_LOAD_VALUE(int32, int32_t)
+DEFINE_LOAD_VALUE(uint32, uint32_t)
+DEFINE_LOAD_VALUE(int64, int64_t)
+DEFINE_LOAD_VALUE(uint64, uint64_t)
+DEFINE_LOAD_VALUE(float32, float)
+DEFINE_LOAD_VALUE(float64, double)
+// NOLINTEND(bugprone-easily-swappable-parameters)
+
+
+static inline conv_value_t load_float16(const void *src, size_t idx, bool bswap) {
+    uint16_t half;
+    memcpy(&half, (const uint16_t *)src + idx, sizeof(half));
+    return (conv_value_t){float16_to_float(bswap ? bswap_uint16_t(half) : half), 0.0};
+}
+
+
+static inline conv_value_t load_complex64(const void *src, size_t idx, bool bswap) {
+    float val[2];
+    memcpy(val, (const float *)src + 2 * idx, sizeof(val));
+    if (bswap) {
+        val[0] = bswap_float(val[0]);
+        val[1] = bswap_float(val[1]);
+    }
+    return (conv_value_t){val[0], val[1]};
+}
+
+
+static inline conv_value_t load_complex128(const void *src, size_t idx, bool bswap) {
+    double val[2];
+    memcpy(val, (const double *)src + 2 * idx, sizeof(val));
+    if (bswap) {
+        val[0] = bswap_double(val[0]);
+        val[1] = bswap_double(val[1]);
+    }
+    return (conv_value_t){val[0], val[1]};
+}
+
+
+static inline conv_value_t load_bool8(const void *src, size_t idx, UNUSED(bool bswap)) {
+    return (conv_value_t){((const uint8_t *)src)[idx] != 0, 0.0};
+}
+
+
+/**
+ * Defines a function like store_int8 writing the real part of a `conv_value_t` as an integer
+ * type, returning 1 if it was clamped
+ */
+#define DEFINE_STORE_INT_VALUE(name, type, minval, maxval) \
+    static inline int store_##name(void *dst, size_t idx, conv_value_t val) { \
+        type *_dst = (type *)dst + idx; /* NOLINT(bugprone-macro-parentheses) */ \
+        if (isnan(val.re)) { \
+            *_dst = 0; \
+            return 1; \
+        } \
+        if (val.re < (double)(minval)) { \
+            *_dst = minval; \
+            return 1; \
+        } \
+        if (val.re >= (double)(maxval)) { \
+            *_dst = maxval; \
+            return val.re > (double)(maxval); \
+        } \
+        *_dst = (type)val.re; \
+        return 0; \
+    }
+
+
+// NOLINTBEGIN(bugprone-easily-swappable-parameters)
+DEFINE_STORE_INT_VALUE(int8, int8_t, INT8_MIN, INT8_MAX)
+DEFINE_STORE_INT_VALUE(uint8, uint8_t, 0, UINT8_MAX)
+DEFINE_STORE_INT_VALUE(int16, int16_t, INT16_MIN, INT16_MAX)
+DEFINE_STORE_INT_VALUE(uint16, uint16_t, 0, UINT16_MAX)
+DEFINE_STORE_INT_VALUE(int32, int32_t, INT32_MIN, INT32_MAX)
+DEFINE_STORE_INT_VALUE(uint32, uint32_t, 0, UINT32_MAX)
+DEFINE_STORE_INT_VALUE(int64, int64_t, INT64_MIN, INT64_MAX)
+DEFINE_STORE_INT_VALUE(uint64, uint64_t, 0, UINT64_MAX)
+// NOLINTEND(bugprone-easily-swappable-parameters)
+
+
+/** Clamp a finite value to +/- ``maxval``, setting ``*overflow`` if it was clamped */
+static inline double clamp_float_value(double val, double maxval, int *overflow) {
+    if (val > maxval && !isinf(val)) {
+        *overflow = 1;
+        return maxval;
+    }
+
+    if (val < -maxval && !isinf(val)) {
+        *overflow = 1;
+        return -maxval;
+    }
+
+    return val;
+}
+
+
+static inline int store_float16(void *dst, size_t idx, conv_value_t val) {
+    int overflow = 0;
+    ((uint16_t *)dst)[idx] = double_to_float16(clamp_float_value(val.re, FLOAT16_MAX, &overflow));
+    return overflow;
+}
+
+
+static inline int store_float32(void *dst, size_t idx, conv_value_t val) {
+    int overflow = 0;
+    ((float *)dst)[idx] = (float)clamp_float_value(val.re, FLT_MAX, &overflow);
+    return overflow;
+}
+
+
+static inline int store_float64(void *dst, size_t idx, conv_value_t val) {
+    ((double *)dst)[idx] = val.re;
+    return 0;
+}
+
+
+static inline int store_complex64(void *dst, size_t idx, conv_value_t val) {
+    int overflow = 0;
+    float *_dst = (float *)dst + 2 * idx;
+    _dst[0] = (float)clamp_float_value(val.re, FLT_MAX, &overflow);
+    _dst[1] = (float)clamp_float_value(val.im, FLT_MAX, &overflow);
+    return overflow;
+}
+
+
+static inline int store_complex128(void *dst, size_t idx, conv_value_t val) {
+    double *_dst = (double *)dst + 2 * idx;
+    _dst[0] = val.re;
+    _dst[1] = val.im;
+    return 0;
+}
+
+
+static inline int store_bool8(void *dst, size_t idx, conv_value_t val) {
+    ((uint8_t *)dst)[idx] = val.re != 0.0 || val.im != 0.0;
+    return 0;
+}
+
+
+/** Defines a conversion function like convert_float16_to_int8_bswap through `conv_value_t` */
+#define _DEFINE_VALUE_CONV_FN(src_name, dst_name, name, bswap) \
+    static int convert_##name(void *dst, const void *src, size_t count, UNUSED(size_t elsize)) { \
+        int overflow = 0; \
+        for (size_t idx = 0; idx < count; idx++) \
+            overflow |= store_##dst_name(dst, idx, load_##src_name(src, idx, bswap)); \
+        return overflow; \
+    }
+
+
+#define DEFINE_VALUE_CONVERSION(src_name, dst_name) \
+    _DEFINE_VALUE_CONV_FN(src_name, dst_name, src_name##_to_##dst_name, false) \
+    _DEFINE_VALUE_CONV_FN(src_name, dst_name, src_name##_to_##dst_name##_bswap, true)
+
+
+/**
+ * Defines identity conversions for types byteswapped as ``n_parts`` values of ``part_name``,
+ * like complex64 which is swapped as two float32
+ */
+#define DEFINE_PARTS_IDENTITY_CONVERSION(src_name, part_name, n_parts) \
+    static int convert_##src_name##_to_##src_name( \
+        void *dst, const void *src, size_t nelem, size_t elsize) { \
+        memcpy(dst, src, nelem *elsize); \
+        return 0; \
+    } \
+    static int convert_##src_name##_to_##src_name##_bswap( \
+        void *dst, const void *src, size_t nelem, size_t elsize) { \
+        return convert_##part_name##_to_##part_name##_bswap( \
+            dst, src, nelem * (n_parts), elsize / (n_parts)); \
+    }
+
+
+static int convert_float16_to_float32(
+    void *dst, const void *src, size_t count, UNUSED(size_t elsize)) {
+    const uint16_t *_src = src;
+    float *_dst = dst;
+
+    for (size_t idx = 0; idx < count; idx++)
+        _dst[idx] = float16_to_float(_src[idx]);
+
+    return 0;
+}
+
+
+static int convert_float16_to_float32_bswap(
+    void *dst, const void *src, size_t count, UNUSED(size_t elsize)) {
+    const uint16_t *_src = src;
+    float *_dst = dst;
+
+    for (size_t idx = 0; idx < count; idx++)
+        _dst[idx] = float16_to_float(bswap_uint16_t(_src[idx]));
+
+    return 0;
+}
+
+
+#define _DEFINE_FLOAT32_TO_FLOAT16_CONV_FN(name, bswap) \
+    static int convert_##name(void *dst, const void *src, size_t count, UNUSED(size_t elsize)) { \
+        const float *_src = src; \
+        uint16_t *_dst = dst; \
+        int overflow = 0; \
+        for (size_t idx = 0; idx < count; idx++) { \
+            float val = _src[idx]; \
+            _DO_BSWAP_##bswap(float, val); \
+            _dst[idx] = float_to_float16( \
+                (float)clamp_float_value(val, FLOAT16_MAX, &overflow)); \
+        } \
+        return overflow; \
+    }
+
+
+_DEFINE_FLOAT32_TO_FLOAT16_CONV_FN(float32_to_float16, 0)
+_DEFINE_FLOAT32_TO_FLOAT16_CONV_FN(float32_to_float16_bswap, 1)
+
+
+// NOLINTBEGIN(bugprone-easily-swappable-parameters)
+/** Conversions from float16 */
+DEFINE_PARTS_IDENTITY_CONVERSION(float16, uint16, 1)
+DEFINE_VALUE_CONVERSION(float16, int8)
+DEFINE_VALUE_CONVERSION(float16, uint8)
+DEFINE_VALUE_CONVERSION(float16, int16)
+DEFINE_VALUE_CONVERSION(float16, uint16)
+DEFINE_VALUE_CONVERSION(float16, int32)
+DEFINE_VALUE_CONVERSION(float16, uint32)
+DEFINE_VALUE_CONVERSION(float16, int64)
+DEFINE_VALUE_CONVERSION(float16, uint64)
+DEFINE_VALUE_CONVERSION(float16, float64)
+DEFINE_VALUE_CONVERSION(float16, complex64)
+DEFINE_VALUE_CONVERSION(float16, complex128)
+DEFINE_VALUE_CONVERSION(float16, bool8)
+
+/** Conversions from complex64 */
+DEFINE_PARTS_IDENTITY_CONVERSION(complex64, uint32, 2)
+DEFINE_VALUE_CONVERSION(complex64, int8)
+DEFINE_VALUE_CONVERSION(complex64, uint8)
+DEFINE_VALUE_CONVERSION(complex64, int16)
+DEFINE_VALUE_CONVERSION(complex64, uint16)
+DEFINE_VALUE_CONVERSION(complex64, int32)
+DEFINE_VALUE_CONVERSION(complex64, uint32)
+DEFINE_VALUE_CONVERSION(complex64, int64)
+DEFINE_VALUE_CONVERSION(complex64, uint64)
+DEFINE_VALUE_CONVERSION(complex64, float16)
+DEFINE_VALUE_CONVERSION(complex64, float32)
+DEFINE_VALUE_CONVERSION(complex64, float64)
+DEFINE_VALUE_CONVERSION(complex64, complex128)
+DEFINE_VALUE_CONVERSION(complex64, bool8)
+
+/** Conversions from complex128 */
+DEFINE_PARTS_IDENTITY_CONVERSION(complex128, uint64, 2)
+DEFINE_VALUE_CONVERSION(complex128, int8)
+DEFINE_VALUE_CONVERSION(complex128, uint8)
+DEFINE_VALUE_CONVERSION(complex128, int16)
+DEFINE_VALUE_CONVERSION(complex128, uint16)
+DEFINE_VALUE_CONVERSION(complex128, int32)
+DEFINE_VALUE_CONVERSION(complex128, uint32)
+DEFINE_VALUE_CONVERSION(complex128, int64)
+DEFINE_VALUE_CONVERSION(complex128, uint64)
+DEFINE_VALUE_CONVERSION(complex128, float16)
+DEFINE_VALUE_CONVERSION(complex128, float32)
+DEFINE_VALUE_CONVERSION(complex128, float64)
+DEFINE_VALUE_CONVERSION(complex128, complex64)
+DEFINE_VALUE_CONVERSION(complex128, bool8)
+
+/** Conversions from bool8 */
+DEFINE_PARTS_IDENTITY_CONVERSION(bool8, uint8, 1)
+DEFINE_VALUE_CONVERSION(bool8, int8)
+DEFINE_VALUE_CONVERSION(bool8, uint8)
+DEFINE_VALUE_CONVERSION(bool8, int16)
+DEFINE_VALUE_CONVERSION(bool8, uint16)
+DEFINE_VALUE_CONVERSION(bool8, int32)
+DEFINE_VALUE_CONVERSION(bool8, uint32)
+DEFINE_VALUE_CONVERSION(bool8, int64)
+DEFINE_VALUE_CONVERSION(bool8, uint64)
+DEFINE_VALUE_CONVERSION(bool8, float16)
+DEFINE_VALUE_CONVERSION(bool8, float32)
+DEFINE_VALUE_CONVERSION(bool8, float64)
+DEFINE_VALUE_CONVERSION(bool8, complex64)
+DEFINE_VALUE_CONVERSION(bool8, complex128)
+
+/** Conversions to float16, complex and bool8 from the other types */
+DEFINE_VALUE_CONVERSION(int8, float16)
+DEFINE_VALUE_CONVERSION(int8, complex64)
+DEFINE_VALUE_CONVERSION(int8, complex128)
+DEFINE_VALUE_CONVERSION(int8, bool8)
+DEFINE_VALUE_CONVERSION(uint8, float16)
+DEFINE_VALUE_CONVERSION(uint8, complex64)
+DEFINE_VALUE_CONVERSION(uint8, complex128)
+DEFINE_VALUE_CONVERSION(uint8, bool8)
+DEFINE_VALUE_CONVERSION(int16, float16)
+DEFINE_VALUE_CONVERSION(int16, complex64)
+DEFINE_VALUE_CONVERSION(int16, complex128)
+DEFINE_VALUE_CONVERSION(int16, bool8)
+DEFINE_VALUE_CONVERSION(uint16, float16)
+DEFINE_VALUE_CONVERSION(uint16, complex64)
+DEFINE_VALUE_CONVERSION(uint16, complex128)
+DEFINE_VALUE_CONVERSION(uint16, bool8)
+DEFINE_VALUE_CONVERSION(int32, float16)
+DEFINE_VALUE_CONVERSION(int32, complex64)
+DEFINE_VALUE_CONVERSION(int32, complex128)
+DEFINE_VALUE_CONVERSION(int32, bool8)
+DEFINE_VALUE_CONVERSION(uint32, float16)
+DEFINE_VALUE_CONVERSION(uint32, complex64)
+DEFINE_VALUE_CONVERSION(uint32, complex128)
+DEFINE_VALUE_CONVERSION(uint32, bool8)
+DEFINE_VALUE_CONVERSION(int64, float16)
+DEFINE_VALUE_CONVERSION(int64, complex64)
+DEFINE_VALUE_CONVERSION(int64, complex128)
+DEFINE_VALUE_CONVERSION(int64, bool8)
+DEFINE_VALUE_CONVERSION(uint64, float16)
+DEFINE_VALUE_CONVERSION(uint64, complex64)
+DEFINE_VALUE_CONVERSION(uint64, complex128)
+DEFINE_VALUE_CONVERSION(uint64, bool8)
+DEFINE_VALUE_CONVERSION(float32, complex64)
+DEFINE_VALUE_CONVERSION(float32, complex128)
+DEFINE_VALUE_CONVERSION(float32, bool8)
+DEFINE_VALUE_CONVERSION(float64, float16)
+DEFINE_VALUE_CONVERSION(float64, complex64)
+DEFINE_VALUE_CONVERSION(float64, complex128)
+DEFINE_VALUE_CONVERSION(float64, bool8)
+// NOLINTEND(bugprone-easily-swappable-parameters)
+
+
+/**
+ * Vectorized conversion kernels
+ *
+ * The hottest conversions have SSE4.1, AVX2 and AVX-512 kernels: byteswap-only copies (the
+ * common case of big-endian data written by Python), int16 and uint16 to float32, float64
+ * to float32, and narrowing int32 and int16 to the next smaller integer types.  float16 to
+ * and from float32 use the F16C instructions, so have AVX2 and AVX-512 kernels only; the
+ * AVX2 kernels are compiled for, and require, F16C as well (every AVX2 CPU has it).  At startup
+ * ``conversion_table`` is updated with the kernels for the best instruction set supported by
+ * the CPU, replacing the scalar functions above.
+ *
+ * The kernels use unaligned loads and stores, so work on buffers of any alignment, and hand
+ * the elements left over after the last full vector to the scalar function for the same
+ * conversion.  Their results, including whether overflow is reported, are identical to the
+ * scalar functions.
+ */
+#ifdef ASDF_X86_DISPATCH
+#define CONV_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define CONV_TARGET_AVX2 __attribute__((target("avx2,f16c")))
+#define CONV_TARGET_AVX512 __attribute__((target("avx512f,avx512bw")))
+
+/** Kernel bodies take the byteswap flag as an argument, and are inlined for each value */
+#define CONV_INLINE static inline __attribute__((always_inline))
+
+
+/** Byte shuffle reversing the bytes of each ``elsize`` byte element of a vector */
+CONV_TARGET_SSE41 CONV_INLINE __m128i bswap_mask_sse41(size_t elsize) {
+    switch (elsize) {
+    case 2:
+        return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+    case 4:
+        return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+    default:
+        return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+    }
+}
+
+
+CONV_TARGET_SSE41 CONV_INLINE __m128i load_sse41(const uint8_t *src, bool bswap, __m128i mask) {
+    __m128i v = _mm_loadu_si128((const __m128i *)src);
+    return bswap ? _mm_shuffle_epi8(v, mask) : v;
+}
+
+
+CONV_TARGET_AVX2 CONV_INLINE __m256i load_avx2(const uint8_t *src, bool bswap, __m256i mask) {
+    __m256i v = _mm256_loadu_si256((const __m256i *)src);
+    return bswap ? _mm256_shuffle_epi8(v, mask) : v;
+}
+
+
+CONV_TARGET_AVX512 CONV_INLINE __m512i load_avx512(const uint8_t *src, bool bswap, __m512i mask) {
+    __m512i v = _mm512_loadu_si512(src);
+    return bswap ? _mm512_shuffle_epi8(v, mask) : v;
+}
+
+
+/** Byteswap the elements that did not fill a whole vector */
+static int bswap_copy_tail(uint8_t *dst, const uint8_t *src, size_t count, size_t elsize) {
+    switch (elsize) {
+    case 2:
+        return convert_uint16_to_uint16_bswap(dst, src, count, elsize);
+    case 4:
+        return convert_uint32_to_uint32_bswap(dst, src, count, elsize);
+    case 8:
+        return convert_uint64_to_uint64_bswap(dst, src, count, elsize);
+    default:
+        return 0;
+    }
+}
+
+
+/** Byteswap-only copy of 2, 4 or 8 byte elements, for all types */
+CONV_TARGET_SSE41 static int bswap_copy_sse41(
+    void *dst, const void *src, size_t count, size_t elsize) {
+    const __m128i mask = bswap_mask_sse41(elsize);
+    const size_t nbytes = count * elsize;
+    const size_t width = sizeof(__m128i);
+    uint8_t *cdst = dst;
+    const uint8_t *csrc = src;
+    size_t idx = 0;
+
+    for (; idx + width <= nbytes; idx += width)
+        _mm_storeu_si128((__m128i *)(cdst + idx), load_sse41(csrc + idx, true, mask));
+
+    return bswap_copy_tail(cdst + idx, csrc + idx, (nbytes - idx) / elsize, elsize);
+}
+
+
+CONV_TARGET_AVX2 static int bswap_copy_avx2(
+    void *dst, const void *src, size_t count, size_t elsize) {
+    const __m256i mask = _mm256_broadcastsi128_si256(bswap_mask_sse41(elsize));
+    const size_t nbytes = count * elsize;
+    const size_t width = sizeof(__m256i);
+    uint8_t *cdst = dst;
+    const uint8_t *csrc = src;
+    size_t idx = 0;
+
+    for (; idx + width <= nbytes; idx += width)
+        _mm256_storeu_si256((__m256i *)(cdst + idx), load_avx2(csrc + idx, true, mask));
+
+    return bswap_copy_tail(cdst + idx, csrc + idx, (nbytes - idx) / elsize, elsize);
+}
+
+
+CONV_TARGET_AVX512 static int bswap_copy_avx512(
+    void *dst, const void *src, size_t count, size_t elsize) {
+    const __m512i mask = _mm512_broadcast_i32x4(bswap_mask_sse41(elsize));
+    const size_t nbytes = count * elsize;
+    const size_t width = sizeof(__m512i);
+    uint8_t *cdst = dst;
+    const uint8_t *csrc = src;
+    size_t idx = 0;
+
+    for (; idx + width <= nbytes; idx += width)
+        _mm512_storeu_si512(cdst + idx, load_avx512(csrc + idx, true, mask));
+
+    return bswap_copy_tail(cdst + idx, csrc + idx, (nbytes - idx) / elsize, elsize);
+}
+
+
+/** Complex values are byteswapped as two separate floats */
+#define DEFINE_BSWAP_COPY_COMPLEX(target, isa) \
+    target static int bswap_copy_complex_##isa( \
+        void *dst, const void *src, size_t count, size_t elsize) { \
+        return bswap_copy_##isa(dst, src, count * 2, elsize / 2); \
+    }
+
+
+DEFINE_BSWAP_COPY_COMPLEX(CONV_TARGET_SSE41, sse41)
+DEFINE_BSWAP_COPY_COMPLEX(CONV_TARGET_AVX2, avx2)
+DEFINE_BSWAP_COPY_COMPLEX(CONV_TARGET_AVX512, avx512)
+
+
+/**
+ * Defines the plain and byteswapping variants of a vector kernel, like
+ * convert_int16_to_float32_avx2 and convert_int16_to_float32_bswap_avx2, from the kernel body
+ * int16_to_float32_avx2
+ */
+#define DEFINE_SIMD_CONVERSION(target, src_name, dst_name, isa) \
+    target static int convert_##src_name##_to_##dst_name##_##isa( \
+        void *dst, const void *src, size_t count, size_t elsize) { \
+        return src_name##_to_##dst_name##_##isa(dst, src, count, elsize, false); \
+    } \
+    target static int convert_##src_name##_to_##dst_name##_bswap_##isa( \
+        void *dst, const void *src, size_t count, size_t elsize) { \
+        return src_name##_to_##dst_name##_##isa(dst, src, count, elsize, true); \
+    }
+
+
+/** Finish a kernel with the scalar conversion for the remaining elements */
+#define CONV_TAIL(src_name, dst_name, src_t, dst_t, bswap, idx) \
+    ((bswap) ? convert_##src_name##_to_##dst_name##_bswap : convert_##src_name##_to_##dst_name)( \
+        (dst_t *)dst + (idx), (const src_t *)src + (idx), count - (idx), elsize)
+
+
+/** int16 and uint16 to float32 */
+#define DEFINE_INT16_TO_FLOAT32_SSE41(src_name, src_t, cvt) \
+    CONV_TARGET_SSE41 CONV_INLINE int src_name##_to_float32_sse41( \
+        void *dst, const void *src, size_t count, size_t elsize, bool bswap) { \
+        const __m128i mask = bswap_mask_sse41(sizeof(src_t)); \
+        const uint8_t *csrc = src; \
+        float *fdst = dst; \
+        size_t idx = 0; \
+        for (; idx + 8 <= count; idx += 8) { \
+            __m128i v = load_sse41(csrc + idx * sizeof(src_t), bswap, mask); \
+            __m128i lo = cvt(v); \
+            __m128i hi = cvt(_mm_srli_si128(v, 8)); \
+            _mm_storeu_ps(fdst + idx, _mm_cvtepi32_ps(lo)); \
+            _mm_storeu_ps(fdst + idx + 4, _mm_cvtepi32_ps(hi)); \
+        } \
+        return CONV_TAIL(src_name, float32, src_t, float, bswap, idx); \
+    } \
+    DEFINE_SIMD_CONVERSION(CONV_TARGET_SSE41, src_name, float32, sse41)
+
+
+#define DEFINE_INT16_TO_FLOAT32_AVX2(src_name, src_t, cvt) \
+    CONV_TARGET_AVX2 CONV_INLINE int src_name##_to_float32_avx2( \
+        void *dst, const void *src, size_t count, size_t elsize, bool bswap) { \
+        const __m256i mask = _mm256_broadcastsi128_si256(bswap_mask_sse41(sizeof(src_t))); \
+        const uint8_t *csrc = src; \
+        float *fdst = dst; \
+        size_t idx = 0; \
+        for (; idx + 16 <= count; idx += 16) { \
+            __m256i v = load_avx2(csrc + idx * sizeof(src_t), bswap, mask); \
+            __m256i lo = cvt(_mm256_castsi256_si128(v)); \
+            __m256i hi = cvt(_mm256_extracti128_si256(v, 1)); \
+            _mm256_storeu_ps(fdst + idx, _mm256_cvtepi32_ps(lo)); \
+            _mm256_storeu_ps(fdst + idx + 8, _mm256_cvtepi32_ps(hi)); \
+        } \
+        return CONV_TAIL(src_name, float32, src_t, float, bswap, idx); \
+    } \
+    DEFINE_SIMD_CONVERSION(CONV_TARGET_AVX2, src_name, float32, avx2)
+
+
+#define DEFINE_INT16_TO_FLOAT32_AVX512(src_name, src_t, cvt) \
+    CONV_TARGET_AVX512 CONV_INLINE int src_name##_to_float32_avx512( \
+        void *dst, const void *src, size_t count, size_t elsize, bool bswap) { \
+        const __m512i mask = _mm512_broadcast_i32x4(bswap_mask_sse41(sizeof(src_t))); \
+        const uint8_t *csrc = src; \
+        float *fdst = dst; \
+        size_t idx = 0; \
+        for (; idx + 32 <= count; idx += 32) { \
+            __m512i v = load_avx512(csrc + idx * sizeof(src_t), bswap, mask); \
+            __m512i lo = cvt(_mm512_castsi512_si256(v)); \
+            __m512i hi = cvt(_mm512_extracti64x4_epi64(v, 1)); \
+            _mm512_storeu_ps(fdst + idx, _mm512_cvtepi32_ps(lo)); \
+            _mm512_storeu_ps(fdst + idx + 16, _mm512_cvtepi32_ps(hi)); \
+        } \
+        return CONV_TAIL(src_name, float32, src_t, float, bswap, idx); \
+    } \
+    DEFINE_SIMD_CONVERSION(CONV_TARGET_AVX512, src_name, float32, avx512)
+
+
+DEFINE_INT16_TO_FLOAT32_SSE41(int16, int16_t, _mm_cvtepi16_epi32)
+DEFINE_INT16_TO_FLOAT32_SSE41(uint16, uint16_t, _mm_cvtepu16_epi32)
+DEFINE_INT16_TO_FLOAT32_AVX2(int16, int16_t, _mm256_cvtepi16_epi32)
+DEFINE_INT16_TO_FLOAT32_AVX2(uint16, uint16_t, _mm256_cvtepu16_epi32)
+DEFINE_INT16_TO_FLOAT32_AVX512(int16, int16_t, _mm512_cvtepi16_epi32)
+DEFINE_INT16_TO_FLOAT32_AVX512(uint16, uint16_t, _mm512_cvtepu16_epi32)
+
+
+/**
+ * float64 to float32, clamping finite values to the float32 range but preserving infinities
+ * and NaNs like the scalar version
+ *
+ * The operand order of max and min matters: they return their second operand if either is
+ * NaN, so NaN passes through unchanged.
+ */
+CONV_TARGET_SSE41 CONV_INLINE __m128 float64_to_float32_clamp_sse41(
+    __m128d val, __m128i *overflow) {
+    const __m128d sign = _mm_set1_pd(-0.0);
+    const __m128d inf = _mm_set1_pd(INFINITY);
+    const __m128d maxval = _mm_set1_pd(FLT_MAX);
+    const __m128d minval = _mm_set1_pd(-FLT_MAX);
+    __m128d absval = _mm_andnot_pd(sign, val);
+    __m128d is_inf = _mm_cmpeq_pd(absval, inf);
+    __m128d clamped = _mm_min_pd(maxval, _mm_max_pd(minval, val));
+    clamped = _mm_blendv_pd(clamped, val, is_inf);
+    __m128d over = _mm_andnot_pd(is_inf, _mm_cmpgt_pd(absval, maxval));
+    *overflow = _mm_or_si128(*overflow, _mm_castpd_si128(over));
+    return _mm_cvtpd_ps(clamped);
+}
+
+
+CONV_TARGET_SSE41 CONV_INLINE int float64_to_float32_sse41(
+    void *dst, const void *src, size_t count, size_t elsize, bool bswap) {
+    const __m128i mask = bswap_mask_sse41(sizeof(double));
+    const uint8_t *csrc = src;
+    float *fdst = dst;
+    __m128i overflow = _mm_setzero_si128();
+    size_t idx = 0;
+
+    for (; idx + 4 <= count; idx += 4) {
+        __m128d lo = _mm_castsi128_pd(load_sse41(csrc + idx * sizeof(double), bswap, mask));
+        __m128d hi = _mm_castsi128_pd(load_sse41(csrc + (idx + 2) * sizeof(double), bswap, mask));
+        __m128 flo = float64_to_float32_clamp_sse41(lo, &overflow);
+        __m128 fhi = float64_to_float32_clamp_sse41(hi, &overflow);
+        _mm_storeu_ps(fdst + idx, _mm_movelh_ps(flo, fhi));
+    }
+
+    return CONV_TAIL(float64, float32, double, float, bswap, idx) |
+           !_mm_testz_si128(overflow, overflow);
+}
+
+
+CONV_TARGET_AVX2 CONV_INLINE int float64_to_float32_avx2(
+    void *dst, const void *src, size_t count, size_t elsize, bool bswap) {
+    const __m256i mask = _mm256_broadcastsi128_si256(bswap_mask_sse41(sizeof(double)));
+    const __m256d sign = _mm256_set1_pd(-0.0);
+    const __m256d inf = _mm256_set1_pd(INFINITY);
+    const __m256d maxval = _mm256_set1_pd(FLT_MAX);
+    const __m256d minval = _mm256_set1_pd(-FLT_MAX);
+    const uint8_t *csrc = src;
+    float *fdst = dst;
+    __m256d overflow = _mm256_setzero_pd();
+    size_t idx = 0;
+
+    for (; idx + 4 <= count; idx += 4) {
+        __m256d val = _mm256_castsi256_pd(load_avx2(csrc + idx * sizeof(double), bswap, mask));
+        __m256d absval = _mm256_andnot_pd(sign, val);
+        __m256d is_inf = _mm256_cmp_pd(absval, inf, _CMP_EQ_OQ);
+        __m256d clamped = _mm256_min_pd(maxval, _mm256_max_pd(minval, val));
+        clamped = _mm256_blendv_pd(clamped, val, is_inf);
+        overflow = _mm256_or_pd(
+            overflow, _mm256_andnot_pd(is_inf, _mm256_cmp_pd(absval, maxval, _CMP_GT_OQ)));
+        _mm_storeu_ps(fdst + idx, _mm256_cvtpd_ps(clamped));
+    }
+
+    return CONV_TAIL(float64, float32, double, float, bswap, idx) |
+           (_mm256_movemask_pd(overflow) != 0);
+}
+
+
+CONV_TARGET_AVX512 CONV_INLINE int float64_to_float32_avx512(
+    void *dst, const void *src, size_t count, size_t elsize, bool bswap) {
+    const __m512i mask = _mm512_broadcast_i32x4(bswap_mask_sse41(sizeof(double)));
+    const __m512d inf = _mm512_set1_pd(INFINITY);
+    const __m512d maxval = _mm512_set1_pd(FLT_MAX);
+    const __m512d minval = _mm512_set1_pd(-FLT_MAX);
+    const uint8_t *csrc = src;
+    float *fdst = dst;
+    __mmask8 overflow = 0;
+    size_t idx = 0;
+
+    for (; idx + 8 <= count; idx += 8) {
+        __m512d val = _mm512_castsi512_pd(load_avx512(csrc + idx * sizeof(double), bswap, mask));
+        __m512d absval = _mm512_abs_pd(val);
+        __mmask8 is_inf = _mm512_cmp_pd_mask(absval, inf, _CMP_EQ_OQ);
+        __m512d clamped = _mm512_min_pd(maxval, _mm512_max_pd(minval, val));
+        clamped = _mm512_mask_blend_pd(is_inf, clamped, val);
+        overflow |= _mm512_cmp_pd_mask(absval, maxval, _CMP_GT_OQ) & ~is_inf;
+        _mm256_storeu_ps(fdst + idx, _mm512_cvtpd_ps(clamped));
+    }
+
+    return CONV_TAIL(float64, float32, double, float, bswap, idx) | (overflow != 0);
+}
+
+
+DEFINE_SIMD_CONVERSION(CONV_TARGET_SSE41, float64, float32, sse41)
+DEFINE_SIMD_CONVERSION(CONV_TARGET_AVX2, float64, float32, avx2)
+DEFINE_SIMD_CONVERSION(CONV_TARGET_AVX512, float64, float32, avx512)
+
+
+/**
+ * float16 to and from float32, with F16C or AVX-512F
+ *
+ * Encoding clamps finite values to the float16 range first, as for float64 to float32 above.
+ */
+CONV_TARGET_AVX2 CONV_INLINE int float16_to_float32_avx2(
+    void *dst, const void *src, size_t count, size_t elsize, bool bswap) {
+    const __m128i mask = bswap_mask_sse41(sizeof(uint16_t));
+    const uint8_t *csrc = src;
+    float *fdst = dst;
+    size_t idx = 0;
+
+    for (; idx + 8 <= count; idx += 8) {
+        __m128i half = load_sse41(csrc + idx * sizeof(uint16_t), bswap, mask);
+        _mm256_storeu_ps(fdst + idx, _mm256_cvtph_ps(half));
+    }
+
+    return CONV_TAIL(float16, float32, uint16_t, float, bswap, idx);
+}
+
+
+CONV_TARGET_AVX2 CONV_INLINE int float32_to_float16_avx2(
+    void *dst, const void *src, size_t count, size_t elsize, bool bswap) {
+    const __m256i mask = _mm256_broadcastsi128_si256(bswap_mask_sse41(sizeof(float)));
+    const __m256 sign = _mm256_set1_ps(-0.0F);
+    const __m256 inf = _mm256_set1_ps(INFINITY);
+    const __m256 maxval = _mm256_set1_ps((float)FLOAT16_MAX);
+    const __m256 minval = _mm256_set1_ps((float)-FLOAT16_MAX);
+    const uint8_t *csrc = src;
+    uint16_t *hdst = dst;
+    __m256 overflow = _mm256_setzero_ps();
+    size_t idx = 0;
+
+    for (; idx + 8 <= count; idx += 8) {
+        __m256 val = _mm256_castsi256_ps(load_avx2(csrc + idx * sizeof(float), bswap, mask));
+        __m256 absval = _mm256_andnot_ps(sign, val);
+        __m256 is_inf = _mm256_cmp_ps(absval, inf, _CMP_EQ_OQ);
+        __m256 clamped = _mm256_min_ps(maxval, _mm256_max_ps(minval, val));
+        clamped = _mm256_blendv_ps(clamped, val, is_inf);
+        overflow = _mm256_or_ps(
+            overflow, _mm256_andnot_ps(is_inf, _mm256_cmp_ps(absval, maxval, _CMP_GT_OQ)));
+        _mm_storeu_si128(
+            (__m128i *)(hdst + idx), _mm256_cvtps_ph(clamped, _MM_FROUND_TO_NEAREST_INT));
+    }
+
+    return CONV_TAIL(float32, float16, float, uint16_t, bswap, idx) |
+           (_mm256_movemask_ps(overflow) != 0);
+}
+
+
+CONV_TARGET_AVX512 CONV_INLINE int float16_to_float32_avx512(
+    void *dst, const void *src, size_t count, size_t elsize, bool bswap) {
+    const __m256i mask = _mm256_broadcastsi128_si256(bswap_mask_sse41(sizeof(uint16_t)));
+    const uint8_t *csrc = src;
+    float *fdst = dst;
+    size_t idx = 0;
+
+    for (; idx + 16 <= count; idx += 16) {
+        __m256i half = _mm256_loadu_si256((const __m256i *)(csrc + idx * sizeof(uint16_t)));
+
+        if (bswap)
+            half = _mm256_shuffle_epi8(half, mask);
+
+        _mm512_storeu_ps(fdst + idx, _mm512_cvtph_ps(half));
+    }
+
+    return CONV_TAIL(float16, float32, uint16_t, float, bswap, idx);
+}
+
+
+CONV_TARGET_AVX512 CONV_INLINE int float32_to_float16_avx512(
+    void *dst, const void *src, size_t count, size_t elsize, bool bswap) {
+    const __m512i mask = _mm512_broadcast_i32x4(bswap_mask_sse41(sizeof(float)));
+    const __m512 inf = _mm512_set1_ps(INFINITY);
+    const __m512 maxval = _mm512_set1_ps((float)FLOAT16_MAX);
+    const __m512 minval = _mm512_set1_ps((float)-FLOAT16_MAX);
+    const uint8_t *csrc = src;
+    uint16_t *hdst = dst;
+    __mmask16 overflow = 0;
+    size_t idx = 0;
+
+    for (; idx + 16 <= count; idx += 16) {
+        __m512 val = _mm512_castsi512_ps(load_avx512(csrc + idx * sizeof(float), bswap, mask));
+        __m512 absval = _mm512_abs_ps(val);
+        __mmask16 is_inf = _mm512_cmp_ps_mask(absval, inf, _CMP_EQ_OQ);
+        __m512 clamped = _mm512_min_ps(maxval, _mm512_max_ps(minval, val));
+        clamped = _mm512_mask_blend_ps(is_inf, clamped, val);
+        overflow |= _mm512_cmp_ps_mask(absval, maxval, _CMP_GT_OQ) & ~is_inf;
+        _mm256_storeu_si256(
+            (__m256i *)(hdst + idx), _mm512_cvtps_ph(clamped, _MM_FROUND_TO_NEAREST_INT));
+    }
+
+    return CONV_TAIL(float32, float16, float, uint16_t, bswap, idx) | (overflow != 0);
+}
+
+
+DEFINE_SIMD_CONVERSION(CONV_TARGET_AVX2, float16, float32, avx2)
+DEFINE_SIMD_CONVERSION(CONV_TARGET_AVX2, float32, float16, avx2)
+DEFINE_SIMD_CONVERSION(CONV_TARGET_AVX512, float16, float32, avx512)
+DEFINE_SIMD_CONVERSION(CONV_TARGET_AVX512, float32, float16, avx512)
+
+
+/**
+ * Integer narrowing with saturation
+ *
+ * SSE4.1 and AVX2 use the saturating pack instructions, which combine two source vectors
+ * into one; AVX2 packs within each 128-bit lane, so the result is permuted back into order
+ * afterwards.  AVX-512 has saturating conversions that narrow a single vector, where the
+ * unsigned ones treat the source as unsigned as well, so negative values are zeroed first.
+ * Overflow is reported for any source value outside the range of the destination type.
+ */
+#define DEFINE_NARROW_CONVERSION_SSE41( \
+    src_name, src_t, dst_name, dst_t, pack, bits, minval, maxval) \
+    CONV_TARGET_SSE41 CONV_INLINE int src_name##_to_##dst_name##_sse41( \
+        void *dst, const void *src, size_t count, size_t elsize, bool bswap) { \
+        const __m128i mask = bswap_mask_sse41(sizeof(src_t)); \
+        const __m128i vmin = _mm_set1_epi##bits(minval); \
+        const __m128i vmax = _mm_set1_epi##bits(maxval); \
+        const size_t n_vec = sizeof(__m128i) / sizeof(src_t); \
+        const uint8_t *csrc = src; \
+        uint8_t *cdst = dst; \
+        __m128i overflow = _mm_setzero_si128(); \
+        size_t idx = 0; \
+        for (; idx + 2 * n_vec <= count; idx += 2 * n_vec) { \
+            __m128i lo = load_sse41(csrc + idx * sizeof(src_t), bswap, mask); \
+            __m128i hi = load_sse41(csrc + (idx + n_vec) * sizeof(src_t), bswap, mask); \
+            overflow = _mm_or_si128(overflow, _mm_cmpgt_epi##bits(lo, vmax)); \
+            overflow = _mm_or_si128(overflow, _mm_cmplt_epi##bits(lo, vmin)); \
+            overflow = _mm_or_si128(overflow, _mm_cmpgt_epi##bits(hi, vmax)); \
+            overflow = _mm_or_si128(overflow, _mm_cmplt_epi##bits(hi, vmin)); \
+            _mm_storeu_si128((__m128i *)(cdst + idx * sizeof(dst_t)), pack(lo, hi)); \
+        } \
+        return CONV_TAIL(src_name, dst_name, src_t, dst_t, bswap, idx) | \
+               !_mm_testz_si128(overflow, overflow); \
+    } \
+    DEFINE_SIMD_CONVERSION(CONV_TARGET_SSE41, src_name, dst_name, sse41)
+
+
+#define DEFINE_NARROW_CONVERSION_AVX2( \
+    src_name, src_t, dst_name, dst_t, pack, bits, minval, maxval) \
+    CONV_TARGET_AVX2 CONV_INLINE int src_name##_to_##dst_name##_avx2( \
+        void *dst, const void *src, size_t count, size_t elsize, bool bswap) { \
+        const __m256i mask = _mm256_broadcastsi128_si256(bswap_mask_sse41(sizeof(src_t))); \
+        const __m256i vmin = _mm256_set1_epi##bits(minval); \
+        const __m256i vmax = _mm256_set1_epi##bits(maxval); \
+        const size_t n_vec = sizeof(__m256i) / sizeof(src_t); \
+        const uint8_t *csrc = src; \
+        uint8_t *cdst = dst; \
+        __m256i overflow = _mm256_setzero_si256(); \
+        size_t idx = 0; \
+        for (; idx + 2 * n_vec <= count; idx += 2 * n_vec) { \
+            __m256i lo = load_avx2(csrc + idx * sizeof(src_t), bswap, mask); \
+            __m256i hi = load_avx2(csrc + (idx + n_vec) * sizeof(src_t), bswap, mask); \
+            overflow = _mm256_or_si256(overflow, _mm256_cmpgt_epi##bits(lo, vmax)); \
+            overflow = _mm256_or_si256(overflow, _mm256_cmpgt_epi##bits(vmin, lo)); \
+            overflow = _mm256_or_si256(overflow, _mm256_cmpgt_epi##bits(hi, vmax)); \
+            overflow = _mm256_or_si256(overflow, _mm256_cmpgt_epi##bits(vmin, hi)); \
+            __m256i packed = _mm256_permute4x64_epi64(pack(lo, hi), 0xd8); \
+            _mm256_storeu_si256((__m256i *)(cdst + idx * sizeof(dst_t)), packed); \
+        } \
+        return CONV_TAIL(src_name, dst_name, src_t, dst_t, bswap, idx) | \
+               !_mm256_testz_si256(overflow, overflow); \
+    } \
+    DEFINE_SIMD_CONVERSION(CONV_TARGET_AVX2, src_name, dst_name, avx2)
+
+
+#define DEFINE_NARROW_CONVERSION_AVX512( \
+    src_name, src_t, dst_name, dst_t, cvt, floor, bits, minval, maxval) \
+    CONV_TARGET_AVX512 CONV_INLINE int src_name##_to_##dst_name##_avx512( \
+        void *dst, const void *src, size_t count, size_t elsize, bool bswap) { \
+        const __m512i mask = _mm512_broadcast_i32x4(bswap_mask_sse41(sizeof(src_t))); \
+        const __m512i vmin = _mm512_set1_epi##bits(minval); \
+        const __m512i vmax = _mm512_set1_epi##bits(maxval); \
+        const size_t n_vec = sizeof(__m512i) / sizeof(src_t); \
+        const uint8_t *csrc = src; \
+        uint8_t *cdst = dst; \
+        uint64_t overflow = 0; \
+        size_t idx = 0; \
+        for (; idx + n_vec <= count; idx += n_vec) { \
+            __m512i val = load_avx512(csrc + idx * sizeof(src_t), bswap, mask); \
+            overflow |= _mm512_cmpgt_epi##bits##_mask(val, vmax); \
+            overflow |= _mm512_cmplt_epi##bits##_mask(val, vmin); \
+            __m256i narrowed = cvt(floor(val, vmin)); \
+            _mm256_storeu_si256((__m256i *)(cdst + idx * sizeof(dst_t)), narrowed); \
+        } \
+        return CONV_TAIL(src_name, dst_name, src_t, dst_t, bswap, idx) | (overflow != 0); \
+    } \
+    DEFINE_SIMD_CONVERSION(CONV_TARGET_AVX512, src_name, dst_name, avx512)
+
+
+/** Identity for the signed conversions, which need no flooring of negative values */
+#define CONV_NO_FLOOR(val, vmin) (val)
+
+
+// NOLINTBEGIN(bugprone-easily-swappable-parameters)
+DEFINE_NARROW_CONVERSION_SSE41(
+    int32, int32_t, int16, int16_t, _mm_packs_epi32, 32, INT16_MIN, INT16_MAX)
+DEFINE_NARROW_CONVERSION_SSE41(
+    int32, int32_t, uint16, uint16_t, _mm_packus_epi32, 32, 0, UINT16_MAX)
+DEFINE_NARROW_CONVERSION_SSE41(
+    int16, int16_t, int8, int8_t, _mm_packs_epi16, 16, INT8_MIN, INT8_MAX)
+DEFINE_NARROW_CONVERSION_SSE41(int16, int16_t, uint8, uint8_t, _mm_packus_epi16, 16, 0, UINT8_MAX)
+DEFINE_NARROW_CONVERSION_AVX2(
+    int32, int32_t, int16, int16_t, _mm256_packs_epi32, 32, INT16_MIN, INT16_MAX)
+DEFINE_NARROW_CONVERSION_AVX2(
+    int32, int32_t, uint16, uint16_t, _mm256_packus_epi32, 32, 0, UINT16_MAX)
+DEFINE_NARROW_CONVERSION_AVX2(
+    int16, int16_t, int8, int8_t, _mm256_packs_epi16, 16, INT8_MIN, INT8_MAX)
+DEFINE_NARROW_CONVERSION_AVX2(int16, int16_t, uint8, uint8_t, _mm256_packus_epi16, 16, 0, UINT8_MAX)
+DEFINE_NARROW_CONVERSION_AVX512(
+    int32, int32_t, int16, int16_t, _mm512_cvtsepi32_epi16, CONV_NO_FLOOR, 32, INT16_MIN, INT16_MAX)
+DEFINE_NARROW_CONVERSION_AVX512(
+    int32, int32_t, uint16, uint16_t, _mm512_cvtusepi32_epi16, _mm512_max_epi32, 32, 0, UINT16_MAX)
+DEFINE_NARROW_CONVERSION_AVX512(
+    int16, int16_t, int8, int8_t, _mm512_cvtsepi16_epi8, CONV_NO_FLOOR, 16, INT8_MIN, INT8_MAX)
+DEFINE_NARROW_CONVERSION_AVX512(
+    int16, int16_t, uint8, uint8_t, _mm512_cvtusepi16_epi8, _mm512_max_epi16, 16, 0, UINT8_MAX)
+// NOLINTEND(bugprone-easily-swappable-parameters)
+#endif /* ASDF_X86_DISPATCH */
+
+
+/** A vector kernel and its byteswapping variant for one type pair */
+typedef struct {
+    asdf_scalar_datatype_t src_t;
+    asdf_scalar_datatype_t dst_t;
+    /** ``NULL`` where the scalar function is kept (e.g. the identity memcpy) */
+    asdf_ndarray_convert_fn_t convert;
+    asdf_ndarray_convert_fn_t convert_bswap;
+} conversion_kernel_t;
+
+
+#ifdef ASDF_X86_DISPATCH
+#define CONV_BSWAP_COPY_KERNELS(isa) \
+    {ASDF_DATATYPE_INT16, ASDF_DATATYPE_INT16, NULL, bswap_copy_##isa}, \
+    {ASDF_DATATYPE_UINT16, ASDF_DATATYPE_UINT16, NULL, bswap_copy_##isa}, \
+    {ASDF_DATATYPE_INT32, ASDF_DATATYPE_INT32, NULL, bswap_copy_##isa}, \
+    {ASDF_DATATYPE_UINT32, ASDF_DATATYPE_UINT32, NULL, bswap_copy_##isa}, \
+    {ASDF_DATATYPE_INT64, ASDF_DATATYPE_INT64, NULL, bswap_copy_##isa}, \
+    {ASDF_DATATYPE_UINT64, ASDF_DATATYPE_UINT64, NULL, bswap_copy_##isa}, \
+    {ASDF_DATATYPE_FLOAT16, ASDF_DATATYPE_FLOAT16, NULL, bswap_copy_##isa}, \
+    {ASDF_DATATYPE_FLOAT32, ASDF_DATATYPE_FLOAT32, NULL, bswap_copy_##isa}, \
+    {ASDF_DATATYPE_FLOAT64, ASDF_DATATYPE_FLOAT64, NULL, bswap_copy_##isa}, \
+    {ASDF_DATATYPE_COMPLEX64, ASDF_DATATYPE_COMPLEX64, NULL, bswap_copy_complex_##isa}, \
+    {ASDF_DATATYPE_COMPLEX128, ASDF_DATATYPE_COMPLEX128, NULL, bswap_copy_complex_##isa}
+
+
+#define CONV_KERNEL(src_enum, src_name, dst_enum, dst_name, isa) \
+    {src_enum, \
+     dst_enum, \
+     convert_##src_name##_to_##dst_name##_##isa, \
+     convert_##src_name##_to_##dst_name##_bswap_##isa}
+
+
+#define CONV_KERNELS(isa) \
+    CONV_BSWAP_COPY_KERNELS(isa), \
+    CONV_KERNEL(ASDF_DATATYPE_INT16, int16, ASDF_DATATYPE_FLOAT32, float32, isa), \
+    CONV_KERNEL(ASDF_DATATYPE_UINT16, uint16, ASDF_DATATYPE_FLOAT32, float32, isa), \
+    CONV_KERNEL(ASDF_DATATYPE_FLOAT64, float64, ASDF_DATATYPE_FLOAT32, float32, isa), \
+    CONV_KERNEL(ASDF_DATATYPE_INT32, int32, ASDF_DATATYPE_INT16, int16, isa), \
+    CONV_KERNEL(ASDF_DATATYPE_INT32, int32, ASDF_DATATYPE_UINT16, uint16, isa), \
+    CONV_KERNEL(ASDF_DATATYPE_INT16, int16, ASDF_DATATYPE_INT8, int8, isa), \
+    CONV_KERNEL(ASDF_DATATYPE_INT16, int16, ASDF_DATATYPE_UINT8, uint8, isa)
+
+
+#define CONV_FLOAT16_KERNELS(isa) \
+    CONV_KERNEL(ASDF_DATATYPE_FLOAT16, float16, ASDF_DATATYPE_FLOAT32, float32, isa), \
+    CONV_KERNEL(ASDF_DATATYPE_FLOAT32, float32, ASDF_DATATYPE_FLOAT16, float16, isa)
+
+
+/** Each list of kernels ends with an entry for ``ASDF_DATATYPE_UNKNOWN`` */
+static const conversion_kernel_t conversion_kernels_sse41[] = {
+    CONV_KERNELS(sse41), {ASDF_DATATYPE_UNKNOWN}};
+static const conversion_kernel_t conversion_kernels_avx2[] = {
+    CONV_KERNELS(avx2), CONV_FLOAT16_KERNELS(avx2), {ASDF_DATATYPE_UNKNOWN}};
+static const conversion_kernel_t conversion_kernels_avx512[] = {
+    CONV_KERNELS(avx512), CONV_FLOAT16_KERNELS(avx512), {ASDF_DATATYPE_UNKNOWN}};
+#endif /* ASDF_X86_DISPATCH */
+
+
+/**
+ * Return the vector kernels for the given kernel type, or ``NULL`` if they are not supported
+ * by the build or the CPU
+ */
+static const conversion_kernel_t *conversion_kernels_get(asdf_ndarray_convert_kernel_t kernel) {
+    switch (kernel) {
+#ifdef ASDF_X86_DISPATCH
+    case ASDF_NDARRAY_CONVERT_KERNEL_SSE41:
+        return asdf_util_cpu_has(ASDF_CPU_FEATURE_SSE41) ? conversion_kernels_sse41 : NULL;
+    case ASDF_NDARRAY_CONVERT_KERNEL_AVX2:
+        return asdf_util_cpu_has(ASDF_CPU_FEATURE_AVX2 | ASDF_CPU_FEATURE_F16C)
+                   ? conversion_kernels_avx2
+                   : NULL;
+    case ASDF_NDARRAY_CONVERT_KERNEL_AVX512:
+        return asdf_util_cpu_has(ASDF_CPU_FEATURE_AVX512) ? conversion_kernels_avx512 : NULL;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+
 /** I am very sorry in advance to anyone who has to read this */
 #define FOR_NUMERIC_TYPES(X) \
     X(ASDF_DATATYPE_INT8, int8) \
@@ -362,8 +1472,12 @@ DEFINE_CLAMP_CONVERSION(float64, double, uint64, uint64_t, 0, UINT64_MAX)
     X(ASDF_DATATYPE_UINT32, uint32) \
     X(ASDF_DATATYPE_INT64, int64) \
     X(ASDF_DATATYPE_UINT64, uint64) \
+    X(ASDF_DATATYPE_FLOAT16, float16) \
     X(ASDF_DATATYPE_FLOAT32, float32) \
-    X(ASDF_DATATYPE_FLOAT64, float64)
+    X(ASDF_DATATYPE_FLOAT64, float64) \
+    X(ASDF_DATATYPE_COMPLEX64, complex64) \
+    X(ASDF_DATATYPE_COMPLEX128, complex128) \
+    X(ASDF_DATATYPE_BOOL8, bool8)
 
 
 #define FOR_NUMERIC_TYPES_EXPAND(X, src_enum, src_name) \
@@ -375,34 +1489,104 @@ DEFINE_CLAMP_CONVERSION(float64, double, uint64, uint64_t, 0, UINT64_MAX)
     X(src_enum, src_name, ASDF_DATATYPE_UINT32, uint32) \
     X(src_enum, src_name, ASDF_DATATYPE_INT64, int64) \
     X(src_enum, src_name, ASDF_DATATYPE_UINT64, uint64) \
+    X(src_enum, src_name, ASDF_DATATYPE_FLOAT16, float16) \
     X(src_enum, src_name, ASDF_DATATYPE_FLOAT32, float32) \
-    X(src_enum, src_name, ASDF_DATATYPE_FLOAT64, float64)
+    X(src_enum, src_name, ASDF_DATATYPE_FLOAT64, float64) \
+    X(src_enum, src_name, ASDF_DATATYPE_COMPLEX64, complex64) \
+    X(src_enum, src_name, ASDF_DATATYPE_COMPLEX128, complex128) \
+    X(src_enum, src_name, ASDF_DATATYPE_BOOL8, bool8)
 
 
 #define REGISTER_CONVERSION_FOR_PAIR(src_enum, src_name, dst_enum, dst_name) \
-    conversion_table[src_enum][dst_enum][false] = convert_##src_name##_to_##dst_name; \
-    conversion_table[src_enum][dst_enum][true] = convert_##src_name##_to_##dst_name##_bswap;
+    generic_conversion_table[src_enum][dst_enum][false] = convert_##src_name##_to_##dst_name; \
+    generic_conversion_table[src_enum][dst_enum][true] = convert_##src_name##_to_##dst_name##_bswap;
 
 
 #define REGISTER_CONVERSION_FOR_SRC(src_enum, src_name) \
     FOR_NUMERIC_TYPES_EXPAND(REGISTER_CONVERSION_FOR_PAIR, src_enum, src_name)
 
 
+/** Substitute the vector kernels supported by the CPU into ``conversion_table`` */
+static void conversion_table_register_kernels(void) {
+#ifdef ASDF_X86_DISPATCH
+    static const asdf_ndarray_convert_kernel_t preferred[] = {
+        ASDF_NDARRAY_CONVERT_KERNEL_AVX512,
+        ASDF_NDARRAY_CONVERT_KERNEL_AVX2,
+        ASDF_NDARRAY_CONVERT_KERNEL_SSE41,
+    };
+    const conversion_kernel_t *kernels = NULL;
+
+    for (size_t idx = 0; idx < sizeof(preferred) / sizeof(preferred[0]) && !kernels; idx++)
+        kernels = conversion_kernels_get(preferred[idx]);
+
+    if (!kernels)
+        return;
+
+    for (const conversion_kernel_t *kernel = kernels; kernel->src_t; kernel++) {
+        if (kernel->convert)
+            conversion_table[kernel->src_t][kernel->dst_t][false] = kernel->convert;
+
+        if (kernel->convert_bswap)
+            conversion_table[kernel->src_t][kernel->dst_t][true] = kernel->convert_bswap;
+    }
+#endif
+}
+
+
 ASDF_CONSTRUCTOR static void asdf_conversion_table_init() {
     if (atomic_load_explicit(&conversion_table_initialized, memory_order_acquire))
         return;
 
+    float16_tables_init();
     FOR_NUMERIC_TYPES(REGISTER_CONVERSION_FOR_SRC);
+    memcpy(conversion_table, generic_conversion_table, sizeof(conversion_table));
+    conversion_table_register_kernels();
 
     atomic_store_explicit(&conversion_table_initialized, true, memory_order_release);
 }
 
 
+static inline bool conversion_types_valid(
+    asdf_scalar_datatype_t src_t, asdf_scalar_datatype_t dst_t) {
+    return src_t >= ASDF_DATATYPE_INT8 && src_t < ASDF_DATATYPE_STRUCTURED &&
+           dst_t >= ASDF_DATATYPE_INT8 && dst_t < ASDF_DATATYPE_STRUCTURED;
+}
+
+
 asdf_ndarray_convert_fn_t asdf_ndarray_get_convert_fn(
     asdf_scalar_datatype_t src_t, asdf_scalar_datatype_t dst_t, bool byteswap) {
-    if (src_t < ASDF_DATATYPE_INT8 || src_t > ASDF_DATATYPE_STRUCTURED ||
-        dst_t < ASDF_DATATYPE_INT8 || dst_t > ASDF_DATATYPE_STRUCTURED)
+    if (!conversion_types_valid(src_t, dst_t))
         return NULL;
 
     return conversion_table[src_t][dst_t][byteswap];
 }
+
+
+asdf_ndarray_convert_fn_t asdf_ndarray_get_convert_fn_kernel(
+    asdf_scalar_datatype_t src_t,
+    asdf_scalar_datatype_t dst_t,
+    bool byteswap,
+    asdf_ndarray_convert_kernel_t kernel) {
+    if (!conversion_types_valid(src_t, dst_t))
+        return NULL;
+
+    switch (kernel) {
+    case ASDF_NDARRAY_CONVERT_KERNEL_AUTO:
+        return conversion_table[src_t][dst_t][byteswap];
+    case ASDF_NDARRAY_CONVERT_KERNEL_GENERIC:
+        return generic_conversion_table[src_t][dst_t][byteswap];
+    default:
+        break;
+    }
+
+#ifdef ASDF_X86_DISPATCH
+    const conversion_kernel_t *kernels = conversion_kernels_get(kernel);
+
+    for (; kernels && kernels->src_t; kernels++) {
+        if (kernels->src_t == src_t && kernels->dst_t == dst_t)
+            return byteswap ? kernels->convert_bswap : kernels->convert;
+    }
+#endif
+
+    return NULL;
+}
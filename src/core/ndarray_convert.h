@@ -12,5 +12,34 @@ typedef int (*asdf_ndarray_convert_fn_t)(
     void *restrict dst, const void *restrict src, size_t bytes, size_t elsize);
 
 
+/**
+ * Implementations of the conversion functions
+ *
+ * Some conversions have vectorized kernels for the listed instruction sets, which are used
+ * automatically when supported by the CPU; the rest always use the generic (scalar) ones.
+ */
+typedef enum {
+    ASDF_NDARRAY_CONVERT_KERNEL_AUTO = 0,
+    ASDF_NDARRAY_CONVERT_KERNEL_GENERIC,
+    ASDF_NDARRAY_CONVERT_KERNEL_SSE41,
+    ASDF_NDARRAY_CONVERT_KERNEL_AVX2,
+    ASDF_NDARRAY_CONVERT_KERNEL_AVX512,
+} asdf_ndarray_convert_kernel_t;
+
+
 ASDF_LOCAL asdf_ndarray_convert_fn_t asdf_ndarray_get_convert_fn(
     asdf_scalar_datatype_t src_t, asdf_scalar_datatype_t dst_t, bool byteswap);
+
+
+/**
+ * Return the conversion function of the given kernel, mainly for testing and benchmarking
+ *
+ * `ASDF_NDARRAY_CONVERT_KERNEL_AUTO` returns the same as `asdf_ndarray_get_convert_fn`.
+ * Returns ``NULL`` if the kernel has no function for the conversion, or is not supported by
+ * the build or the CPU.
+ */
+ASDF_LOCAL asdf_ndarray_convert_fn_t asdf_ndarray_get_convert_fn_kernel(
+    asdf_scalar_datatype_t src_t,
+    asdf_scalar_datatype_t dst_t,
+    bool byteswap,
+    asdf_ndarray_convert_kernel_t kernel);
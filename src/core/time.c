@@ -2,115 +2,24 @@
 #include "config.h"
 #endif
 
-#include <stdatomic.h>
+#include <ctype.h>
+#include <limits.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
 #include <time.h>
 
-#include "stc/cregex.h"
+#include <libfyaml.h>
 
 #include "./time.h"
 #include "asdf.h"
+#include "ndarray.h"
 
 #include "../extension_registry.h"
 #include "../log.h"
 #include "../util.h"
 #include "../value.h"
 
-/**
- * Auto-detect patterns -- compiled once upon first use
- *
- * Each pattern uses capture groups for all date/time fields so that
- * out-of-range values can be flagged.  Patterns deliberately avoid
- * digit-range sub-expressions (e.g. ``[0-5][0-9]`` for minutes) because STC
- * cregex has a hard limit of ``CREG_MAX_CLASSES`` (16) character-class slots
- * per compiled pattern.  Range validation is done manually after the match.
- *
- * Capture group layout per pattern index:
- *   TIME_AUTO_IDX_ISO_TIME:
- *     [1]=year [2]=month [3]=day
- *     [4]=optional "T/space + time" [5]=hour [6]=minute [7]=second [8]=frac
- *   TIME_AUTO_IDX_BYEAR:
- *     [1]=integer-part [2]=optional fractional
- *   TIME_AUTO_IDX_JYEAR:
- *     [1]=integer-part [2]=optional fractional
- *   TIME_AUTO_IDX_YDAY:
- *     [1]=year [2]=day-of-year [3]=hour [4]=minute [5]=second [6]=optional frac
- */
-enum {
-    TIME_AUTO_IDX_ISO_TIME = 0,
-    TIME_AUTO_IDX_BYEAR,
-    TIME_AUTO_IDX_JYEAR,
-    TIME_AUTO_IDX_YDAY,
-    TIME_AUTO_COUNT,
-};
-
-static const struct {
-    asdf_time_base_format_t type;
-    const char *pattern;
-} time_auto_patterns[TIME_AUTO_COUNT] = {
-    [TIME_AUTO_IDX_ISO_TIME] =
-        {
-            ASDF_TIME_FORMAT_ISO_TIME,
-            "^(\\d\\d\\d\\d)-(\\d\\d)-(\\d\\d)([T ](\\d\\d):(\\d\\d):(\\d\\d)(.\\d+)?)?",
-        },
-    [TIME_AUTO_IDX_BYEAR] =
-        {
-            ASDF_TIME_FORMAT_BYEAR,
-            "^B(\\d+)(.\\d+)?",
-        },
-    [TIME_AUTO_IDX_JYEAR] =
-        {
-            ASDF_TIME_FORMAT_JYEAR,
-            "^J(\\d+)(.\\d+)?",
-        },
-    [TIME_AUTO_IDX_YDAY] =
-        {
-            ASDF_TIME_FORMAT_YDAY,
-            "^(\\d\\d\\d\\d):(\\d\\d\\d):(\\d\\d):(\\d\\d):(\\d\\d)(.\\d+)?",
-        },
-};
-
-
-static cregex time_auto_regexes[TIME_AUTO_COUNT];
-static atomic_bool time_auto_regexes_compiled = false;
-
-
-static void compile_time_auto_regexes(void) {
-    if (atomic_load_explicit(&time_auto_regexes_compiled, memory_order_acquire))
-        return;
-    for (size_t jdx = 0; jdx < TIME_AUTO_COUNT; jdx++)
-        time_auto_regexes[jdx] = cregex_make(time_auto_patterns[jdx].pattern, CREG_DEFAULT);
-    atomic_store_explicit(&time_auto_regexes_compiled, true, memory_order_release);
-}
-
-
-ASDF_DESTRUCTOR static void drop_time_auto_regexes(void) {
-    if (atomic_load_explicit(&time_auto_regexes_compiled, memory_order_acquire)) {
-        for (size_t jdx = 0; jdx < TIME_AUTO_COUNT; jdx++) {
-            if (time_auto_regexes[jdx].prog)
-                cregex_drop(&time_auto_regexes[jdx]);
-        }
-        atomic_store_explicit(&time_auto_regexes_compiled, false, memory_order_release);
-    }
-}
-
-#ifdef HAVE_STRPTIME
-static const char *ASDF_TIME_SFMT_ISO_TIME[] = {"%Y-%m-%d %H:%M:%S", "%Y-%m-%d"};
-static const char *ASDF_TIME_SFMT_YDAY[] = {"%Y:%j:%H:%M:%S", "%Y:%j"};
-static const char *ASDF_TIME_SFMT_UNIX[] = {"%s"};
-
-#define check_format_strptime(TYPE, BUF, TM, HAS_TIME, STATUS) \
-    { \
-        size_t idx = 0; \
-        do { \
-            (STATUS) = strptime((BUF), (TYPE)[idx], (TM)); \
-            if ((STATUS)) { \
-                (HAS_TIME) = true; \
-                break; \
-            } \
-        } while (idx++ && idx < sizeof((TYPE)) / sizeof(*(TYPE))); \
-    }
 
 #define JD_B1900 2415020.31352
 #define JD_MJD 2400000.5
@@ -153,15 +62,14 @@ static void julian_to_tm(const double jd, struct tm *t, time_t *nanoseconds) {
     const int day = calendar_day - days_in_years - (int)(AVG_MONTH_LENGTH * month_base) +
                     day_fraction;
     const int month = month_base < 14 ? month_base - 1 : month_base - 13;
-    const int year = month > 2 ? year_base - JD_BASE_YEAR : year_base - JD_BASE_YEAR - 1;
+    const int year = month > 2 ? year_base - JD_BASE_YEAR : year_base - JD_BASE_YEAR + 1;
 
-    const double total_seconds = day_fraction * SECONDS_PER_DAY + 0.5;
+    // Round to the nanosecond in integers so that the rounding does not leak into the seconds
+    const int64_t total_nsec = (int64_t)(day_fraction * SECONDS_PER_DAY * 1e9 + 0.5);
+    const int64_t total_seconds = total_nsec / 1000000000;
     const int hour = (int)(total_seconds / SECONDS_PER_HOUR);
-    const int minute = (int)((total_seconds - hour * SECONDS_PER_HOUR) / SECONDS_PER_MINUTE);
-    const double seconds_whole = total_seconds - hour * SECONDS_PER_HOUR -
-                                 minute * SECONDS_PER_MINUTE;
-    const int second = (int)seconds_whole;
-    const double fractional_seconds = seconds_whole - second;
+    const int minute = (int)((total_seconds % SECONDS_PER_HOUR) / SECONDS_PER_MINUTE);
+    const int second = (int)(total_seconds % SECONDS_PER_MINUTE);
 
     t->tm_year = year - 1900;
     t->tm_mon = month - 1;
@@ -171,135 +79,355 @@ static void julian_to_tm(const double jd, struct tm *t, time_t *nanoseconds) {
     t->tm_sec = second;
 
     if (nanoseconds) {
-        *nanoseconds = (time_t)(fractional_seconds * 1e9) + 0.5;
+        *nanoseconds = (time_t)(total_nsec % 1000000000);
     }
 }
 
 
-static void mjd_to_tm(const double mjd, struct tm *t, time_t *nsec) {
-    const double jd = mjd + JD_MJD;
-    julian_to_tm(jd, t, nsec);
-}
-
-
 static double besselian_to_julian(const double b) {
     return JD_B1900 + AVG_YEAR_LENGTH * (b - 1900.0);
 }
 
 
-int asdf_time_parse_std(
-    const char *s, const asdf_time_format_t *format, struct asdf_time_info_t *out) {
-    if (!s || !out) {
-        return -1;
-    }
+/**
+ * Hand-written scanners for the formats that can be recognized from the value string alone
+ *
+ * Each time string is scanned in a single pass, collecting its date and time fields as it goes,
+ * so the same fields are used both to check their ranges and to compute the time without
+ * parsing the string again.  Like the regular expressions these replaced, the scanners only
+ * look at a prefix of the string: anything following a complete date (and optional time of
+ * day) is ignored.
+ */
+typedef struct {
+    int year;
+    int month;
+    int day;
+    int yday;
+    int hour;
+    int minute;
+    int second;
+    long nsec;
+    /** Offset of the given time zone from UTC in seconds */
+    int utc_offset;
+    bool has_time;
+} time_fields_t;
+
+
+/** Formats guessed from the value string when no explicit format is given, in order */
+static const asdf_time_base_format_t time_auto_formats[] = {
+    ASDF_TIME_FORMAT_ISO_TIME,
+    ASDF_TIME_FORMAT_BYEAR,
+    ASDF_TIME_FORMAT_JYEAR,
+    ASDF_TIME_FORMAT_YDAY,
+};
 
-    struct tm tm = {0};
-    char tz_sign = 0;
-    int tz_hour = 0;
-    int tz_min = 0;
-    long nsec = 0;
-    bool has_time = false;
-    char *rest = NULL;
-    char *buf = strdup(s);
 
-    if (!buf) {
-        return -1;
+#define TIME_AUTO_COUNT (sizeof(time_auto_formats) / sizeof(time_auto_formats[0]))
+
+
+/** Read exactly ``n`` decimal digits, advancing ``*p`` past them only if they were all read */
+static inline bool scan_digits(const char **p, int n, int *out) {
+    const char *s = *p;
+    int val = 0;
+
+    for (int idx = 0; idx < n; idx++) {
+        // Also stops at the terminating null
+        unsigned int digit = (unsigned char)s[idx] - '0';
+
+        if (digit > 9)
+            return false;
+
+        val = val * 10 + (int)digit;
     }
 
-    /* Normalize separators (replace 'T' or 't' with space) */
-    for (char *c = buf; *c; ++c) {
-        if (*c == 'T' || *c == 't')
-            *c = ' ';
+    *p = s + n;
+    *out = val;
+    return true;
+}
+
+
+static inline bool scan_char(const char **p, char c) {
+    if (**p != c)
+        return false;
+
+    (*p)++;
+    return true;
+}
+
+
+/** Read an optional fraction of a second such as ``.0001``, to nanosecond precision */
+static const char *scan_fraction(const char *p, long *nsec) {
+    if (*p != '.' || !isdigit((unsigned char)p[1]))
+        return p;
+
+    long val = 0;
+    int n_digits = 0;
+
+    for (p++; isdigit((unsigned char)*p); p++) {
+        if (n_digits < 9) {
+            val = val * 10 + (*p - '0');
+            n_digits++;
+        }
     }
 
-    switch (format->type) {
-    case ASDF_TIME_FORMAT_DATETIME:
+    for (; n_digits < 9; n_digits++)
+        val *= 10;
+
+    *nsec = val;
+    return p;
+}
+
+
+/** Read an optional time zone such as ``Z``, ``+05``, ``+05:30`` or ``-0530`` */
+static void scan_utc_offset(const char *p, int *offset) {
+    while (*p == ' ')
+        p++;
+
+    if (*p != '+' && *p != '-')
+        return;
+
+    int sign = *p++ == '-' ? -1 : 1;
+    int hour = 0;
+    int minute = 0;
+
+    if (!scan_digits(&p, 2, &hour))
+        return;
+
+    p += *p == ':';
+    scan_digits(&p, 2, &minute);
+    *offset = sign * (hour * SECONDS_PER_HOUR + minute * SECONDS_PER_MINUTE);
+}
+
+
+/** Read a time of day ``HH:MM:SS`` with optional fraction and time zone */
+static bool scan_time_of_day(const char *p, time_fields_t *fields) {
+    if (!scan_digits(&p, 2, &fields->hour) || !scan_char(&p, ':') ||
+        !scan_digits(&p, 2, &fields->minute) || !scan_char(&p, ':') ||
+        !scan_digits(&p, 2, &fields->second))
+        return false;
+
+    fields->has_time = true;
+    p = scan_fraction(p, &fields->nsec);
+    scan_utc_offset(p, &fields->utc_offset);
+    return true;
+}
+
+
+/**
+ * Scan ``YYYY-MM-DD`` optionally followed by ``T`` (or a space) and a time of day
+ *
+ * A separator followed by anything but a valid time of day is rejected rather than read as just
+ * the date.
+ */
+static bool scan_iso_time(const char *s, time_fields_t *fields) {
+    *fields = (time_fields_t){0};
+
+    if (!scan_digits(&s, 4, &fields->year) || !scan_char(&s, '-') ||
+        !scan_digits(&s, 2, &fields->month) || !scan_char(&s, '-') ||
+        !scan_digits(&s, 2, &fields->day))
+        return false;
+
+    if (*s == 'T' || *s == 't' || *s == ' ')
+        return scan_time_of_day(s + 1, fields);
+
+    return true;
+}
+
+
+/** Scan ``YYYY:DDD`` optionally followed by ``:`` and a time of day */
+static bool scan_yday(const char *s, time_fields_t *fields) {
+    *fields = (time_fields_t){0};
+
+    if (!scan_digits(&s, 4, &fields->year) || !scan_char(&s, ':') ||
+        !scan_digits(&s, 3, &fields->yday))
+        return false;
+
+    if (*s == ':')
+        return scan_time_of_day(s + 1, fields);
+
+    return true;
+}
+
+
+/** Check for a ``B`` or ``J`` prefixed epoch such as ``B2025.787`` */
+static inline bool scan_epoch(const char *s, char prefix) {
+    return s[0] == prefix && isdigit((unsigned char)s[1]);
+}
+
+
+/**
+ * Check whether a time string looks like it is in the given format
+ *
+ * Only the formats in ``time_auto_formats`` are recognized.  For ISO and yday times ``fields``
+ * is set to the scanned date and time.
+ */
+static bool time_scan(asdf_time_base_format_t type, const char *s, time_fields_t *fields) {
+    switch (type) {
     case ASDF_TIME_FORMAT_ISO_TIME:
-        check_format_strptime(ASDF_TIME_SFMT_ISO_TIME, buf, &tm, has_time, rest);
-        break;
+        return scan_iso_time(s, fields);
     case ASDF_TIME_FORMAT_YDAY:
-        check_format_strptime(ASDF_TIME_SFMT_YDAY, buf, &tm, has_time, rest);
-        break;
-    case ASDF_TIME_FORMAT_UNIX:
-        check_format_strptime(ASDF_TIME_SFMT_UNIX, buf, &tm, has_time, rest);
-        break;
+        return scan_yday(s, fields) && fields->has_time;
+    case ASDF_TIME_FORMAT_BYEAR:
+        return scan_epoch(s, 'B');
+    case ASDF_TIME_FORMAT_JYEAR:
+        return scan_epoch(s, 'J');
     default:
-        free(buf);
-        return -1;
+        return false;
     }
+}
 
-    if (!rest) {
-        free(buf);
-        return -1;
+
+static bool time_format_is_auto(asdf_time_base_format_t type) {
+    for (size_t idx = 0; idx < TIME_AUTO_COUNT; idx++) {
+        if (time_auto_formats[idx] == type)
+            return true;
     }
+    return false;
+}
 
-    /* Handle optional fractional seconds */
-    if (has_time) {
-        const char *dot = strchr(rest, '.');
-        if (dot) {
-            double frac = 0;
-            sscanf(dot, "%lf", &frac);
-            nsec = (long)((frac - (int)frac) * 1e9);
-        }
 
-        /* Handle timezone offsets (Z/z = Zulu is ignored, just don't add any offset) */
-        const char *tz = strpbrk(rest, "+-");
-        if (tz && (*tz == '+' || *tz == '-')) {
-            tz_sign = *tz == '-' ? -1 : 1;
-            if (sscanf(tz + 1, "%2d:%2d", &tz_hour, &tz_min) < 1)
-                sscanf(tz + 1, "%2d", &tz_hour);
-        }
+static inline bool is_leap_year(int year) {
+    return year % 4 == 0 && ((year % 100 != 0) || (year % 400 == 0));
+}
+
+
+/** Number of days from 1970-01-01 to a date in the proleptic Gregorian calendar */
+static int64_t days_from_civil(int year, int month, int day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t year_of_era = year - era * 400;
+    const int64_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const int64_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 +
+                               day_of_year;
+    return era * 146097 + day_of_era - 719468;
+}
+
+
+/**
+ * Compute the time from the fields of a scanned ISO or yday time
+ *
+ * As with ``strptime``, which was used for this previously, out-of-range fields are an error.
+ */
+static int time_fields_to_info(
+    const time_fields_t *fields, bool is_yday, struct asdf_time_info_t *out) {
+    int64_t days = 0;
+
+    if (is_yday) {
+        if (fields->yday < 1 || fields->yday > (is_leap_year(fields->year) ? 366 : 365))
+            return -1;
+
+        days = days_from_civil(fields->year, 1, 1) + fields->yday - 1;
+    } else {
+        if (fields->month < 1 || fields->month > 12 || fields->day < 1 || fields->day > 31)
+            return -1;
+
+        days = days_from_civil(fields->year, fields->month, fields->day);
     }
 
-    /* Convert to time_t and adjust for time zone */
-    time_t t = timegm(&tm);
-    if (t == (time_t)-1) {
-        free(buf);
+    if (fields->hour > 23 || fields->minute > 59 || fields->second > 60)
         return -1;
-    }
 
-    t -= tz_sign * (tz_hour * SECONDS_PER_HOUR + tz_min * SECONDS_PER_MINUTE);
+    time_t t = (time_t)(days * SECONDS_PER_DAY + (int64_t)fields->hour * SECONDS_PER_HOUR +
+                        (int64_t)fields->minute * SECONDS_PER_MINUTE + fields->second -
+                        fields->utc_offset);
+
+    if (!gmtime_r(&t, &out->tm))
+        return -1;
 
-    out->tm = *gmtime(&t);
     out->ts.tv_sec = t;
-    out->ts.tv_nsec = nsec;
-    free(buf);
+    out->ts.tv_nsec = fields->nsec;
     return 0;
 }
 
 
-static int asdf_time_parse_jd(const char *s, struct asdf_time_info_t *out) {
-    const double jd = strtod(s, NULL);
-    struct tm jd_tm;
+/** Set the time from a Julian date */
+static void time_info_of_jd(const double jd, struct asdf_time_info_t *out) {
+    struct tm tm = {0};
     time_t nsec = 0;
-    julian_to_tm(jd, &jd_tm, &nsec);
-    const time_t t = timegm(&jd_tm);
+    julian_to_tm(jd, &tm, &nsec);
+    // timegm also normalizes the remaining fields of tm
+    out->ts.tv_sec = timegm(&tm);
+    out->ts.tv_nsec = nsec;
+    out->tm = tm;
+}
 
-    if (out) {
-        out->tm = jd_tm;
-        out->ts.tv_sec = t;
-        out->ts.tv_nsec = nsec;
-    } else {
+
+/** Set the time from a number of seconds since the Unix epoch */
+static void time_info_of_unix(int64_t sec, long nsec, struct asdf_time_info_t *out) {
+    time_t t = (time_t)sec;
+    gmtime_r(&t, &out->tm);
+    out->ts.tv_sec = t;
+    out->ts.tv_nsec = nsec;
+}
+
+
+static int asdf_time_parse_unix(const char *s, struct asdf_time_info_t *out) {
+    char *end = NULL;
+    long long sec = strtoll(s, &end, 10);
+    long nsec = 0;
+
+    if (end == s)
         return -1;
+
+    scan_fraction(end, &nsec);
+
+    // Fractions of negative times count backwards too
+    if (nsec > 0 && *s == '-') {
+        sec--;
+        nsec = 1000000000L - nsec;
     }
+
+    time_info_of_unix(sec, nsec, out);
     return 0;
 }
 
 
-static int asdf_time_parse_mjd(const char *s, struct asdf_time_info_t *out) {
-    const double mjd = strtod(s, NULL);
-    struct tm mjd_tm;
-    time_t nsec = 0;
-    mjd_to_tm(mjd, &mjd_tm, &nsec);
-    const time_t t = timegm(&mjd_tm);
+int asdf_time_parse_std(
+    const char *s, const asdf_time_format_t *format, struct asdf_time_info_t *out) {
+    if (!s || !format || !out) {
+        return -1;
+    }
 
-    if (out) {
-        out->tm = mjd_tm;
-        out->ts.tv_sec = t;
-        out->ts.tv_nsec = nsec;
-    } else {
+    time_fields_t fields;
+
+    switch (format->type) {
+    case ASDF_TIME_FORMAT_DATETIME:
+    case ASDF_TIME_FORMAT_ISO_TIME:
+        if (!scan_iso_time(s, &fields))
+            return -1;
+        return time_fields_to_info(&fields, false, out);
+    case ASDF_TIME_FORMAT_YDAY:
+        if (!scan_yday(s, &fields))
+            return -1;
+        return time_fields_to_info(&fields, true, out);
+    case ASDF_TIME_FORMAT_UNIX:
+        return asdf_time_parse_unix(s, out);
+    default:
         return -1;
     }
+}
+
+
+static int asdf_time_parse_jd(const char *s, struct asdf_time_info_t *out) {
+    char *end = NULL;
+    const double jd = strtod(s, &end);
+
+    if (!out || end == s)
+        return -1;
+
+    time_info_of_jd(jd, out);
+    return 0;
+}
+
+
+static int asdf_time_parse_mjd(const char *s, struct asdf_time_info_t *out) {
+    char *end = NULL;
+    const double mjd = strtod(s, &end);
+
+    if (!out || end == s)
+        return -1;
+
+    time_info_of_jd(mjd + JD_MJD, out);
     return 0;
 }
 
@@ -307,21 +435,13 @@ static int asdf_time_parse_mjd(const char *s, struct asdf_time_info_t *out) {
 int asdf_time_parse_byear(const char *s, struct asdf_time_info_t *out) {
     if (s && (*s == 'B' || *s == 'b'))
         s++; /* strip optional B prefix from bare-scalar Besselian epoch notation */
-    const double byear = strtod(s, NULL);
-    const double jd = besselian_to_julian(byear);
-    struct tm tm;
-    time_t nsec = 0;
-
-    julian_to_tm(jd, &tm, &nsec);
-    const time_t t = timegm(&tm);
+    char *end = NULL;
+    const double byear = strtod(s, &end);
 
-    if (out) {
-        out->tm = *gmtime(&t);
-        out->ts.tv_sec = t;
-        out->ts.tv_nsec = nsec;
-    } else {
+    if (!out || end == s)
         return -1;
-    }
+
+    time_info_of_jd(besselian_to_julian(byear), out);
     return 0;
 }
 
@@ -331,17 +451,6 @@ int asdf_time_parse_yday(const char *s, struct asdf_time_info_t *out) {
     return asdf_time_parse_std(s, &fmt, out);
 }
 
-#else
-#warning "strptime() not available, times will not be parsed"
-static int asdf_time_parse_std(UNUSED(const char *s), struct timespec *out) {
-    if (out) {
-        out->tv_sec = 0;
-        out->tv_nsec = 0;
-    }
-    return 0;
-}
-#endif
-
 
 static int asdf_time_parse_time(
     const char *s, const asdf_time_format_t *format, struct asdf_time_info_t *out) {
@@ -369,6 +478,30 @@ static int asdf_time_parse_time(
 }
 
 
+/**
+ * Like `asdf_time_parse_time` but reusing the fields of an ISO or yday time if they were
+ * already scanned when checking its format
+ */
+static int asdf_time_parse_scanned(
+    const char *s,
+    const asdf_time_format_t *format,
+    const time_fields_t *fields,
+    struct asdf_time_info_t *out) {
+    if (fields) {
+        switch (format->type) {
+        case ASDF_TIME_FORMAT_ISO_TIME:
+            return time_fields_to_info(fields, false, out);
+        case ASDF_TIME_FORMAT_YDAY:
+            return time_fields_to_info(fields, true, out);
+        default:
+            break;
+        }
+    }
+
+    return asdf_time_parse_time(s, format, out);
+}
+
+
 /*
  * Lookup table: asdf_time_base_format_t enum value -> YAML format name string
  *
@@ -429,106 +562,63 @@ static bool format_name_to_type(const char *name, asdf_time_base_format_t *out)
 }
 
 
-/* Return the auto-detect pattern index whose type matches, or -1 if none. */
-static int find_auto_pattern_idx(asdf_time_base_format_t type) {
-    for (size_t idx = 0; idx < TIME_AUTO_COUNT; idx++) {
-        if (time_auto_patterns[idx].type == type)
-            return (int)idx;
-    }
-    return -1;
-}
-
-
-/* Actually should be 10 but use 16 to be word-aligned */
-#define MAX_INT_DIGITS 16
-
-
-/* Extract an integer from a non-null-terminated csview. */
-static inline int csview_to_int(csview csv) {
-    char buf[MAX_INT_DIGITS];
-    size_t n = csv.size < (int)sizeof(buf) - 1 ? csv.size : (int)sizeof(buf) - 1;
-    memcpy(buf, csv.buf, n);
-    buf[n] = '\0';
-    // Should be able to get away with atoi here since already checked by
-    // the regexps
-    return atoi(buf);
-}
+static void validate_iso_time_ranges(asdf_file_t *file, const char *cvs, const time_fields_t *f) {
+    if (f->month < 1 || f->month > 12)
+        ASDF_LOG(
+            file,
+            ASDF_LOG_WARN,
+            "iso_time value '%s': month %d out of range [01,12]",
+            cvs,
+            f->month);
 
+    // TODO: More calendar logic?
+    if (f->day < 1 || f->day > 31)
+        ASDF_LOG(
+            file, ASDF_LOG_WARN, "iso_time value '%s': day %d out of range [01,31]", cvs, f->day);
 
-static void validate_iso_time_ranges(asdf_file_t *file, const char *cvs, csview *mat) {
-    /* m[2]=month, m[3]=day, m[5]=hour, m[6]=minute, m[7]=second */
-    if (mat[2].buf) {
-        int mon = csview_to_int(mat[2]);
-        if (mon < 1 || mon > 12)
-            ASDF_LOG(
-                file,
-                ASDF_LOG_WARN,
-                "iso_time value '%s': month %d out of range [01,12]",
-                cvs,
-                mon);
-    }
-
-    if (mat[3].buf) {
-        // TODO: More calendar logic?
-        int day = csview_to_int(mat[3]);
-        if (day < 1 || day > 31)
-            ASDF_LOG(
-                file, ASDF_LOG_WARN, "iso_time value '%s': day %d out of range [01,31]", cvs, day);
-    }
+    if (!f->has_time)
+        return;
 
-    if (mat[5].buf && csview_to_int(mat[5]) > 23)
+    if (f->hour > 23)
         ASDF_LOG(file, ASDF_LOG_WARN, "iso_time value '%s': hour out of range [00,23]", cvs);
 
-    if (mat[6].buf && csview_to_int(mat[6]) > 59)
+    if (f->minute > 59)
         ASDF_LOG(file, ASDF_LOG_WARN, "iso_time value '%s': minute out of range [00,59]", cvs);
 
-    if (mat[7].buf && csview_to_int(mat[7]) > 60)
+    if (f->second > 60)
         ASDF_LOG(file, ASDF_LOG_WARN, "iso_time value '%s': second out of range [00,60]", cvs);
 }
 
 
-static inline bool is_leap_year(int year) {
-    return year % 4 == 0 && ((year % 100 != 0) || (year % 400 == 0));
-}
-
-
-static void validate_yday_ranges(asdf_file_t *file, const char *cvs, csview *mat) {
-    /* m[1]=year, m[2]=day-of-year, m[3]=hour, m[4]=minute, m[5]=second */
-    int year = 0;
-
-    if (mat[1].buf)
-        year = csview_to_int(mat[1]);
+static void validate_yday_ranges(asdf_file_t *file, const char *cvs, const time_fields_t *f) {
+    if (f->yday < 1 || (is_leap_year(f->year) ? f->yday > 366 : f->yday > 365))
+        ASDF_LOG(
+            file,
+            ASDF_LOG_WARN,
+            "yday value '%s': day-of-year %d out of range [001,366]",
+            cvs,
+            f->yday);
 
-    if (mat[2].buf) {
-        int yday = csview_to_int(mat[2]);
-        if (yday < 1 || (is_leap_year(year) ? yday > 366 : yday > 365))
-            ASDF_LOG(
-                file,
-                ASDF_LOG_WARN,
-                "yday value '%s': day-of-year %d out of range [001,366]",
-                cvs,
-                yday);
-    }
-
-    if (mat[3].buf && csview_to_int(mat[3]) > 23)
+    if (f->hour > 23)
         ASDF_LOG(file, ASDF_LOG_WARN, "yday value '%s': hour out of range [00,23]", cvs);
 
-    if (mat[4].buf && csview_to_int(mat[4]) > 59)
+    if (f->minute > 59)
         ASDF_LOG(file, ASDF_LOG_WARN, "yday value '%s': minute out of range [00,59]", cvs);
 
-    if (mat[5].buf && csview_to_int(mat[5]) > 60)
+    if (f->second > 60)
         ASDF_LOG(file, ASDF_LOG_WARN, "yday value '%s': second out of range [00,60]", cvs);
 }
 
 
-/* Run capture-group range checks for patterns that support them. */
-static void validate_datetime_ranges(asdf_file_t *file, int pat_idx, const char *vs, csview *m) {
-    switch (pat_idx) {
-    case TIME_AUTO_IDX_ISO_TIME:
-        validate_iso_time_ranges(file, vs, m);
+/** Run range checks on the scanned fields for formats that have them */
+static void validate_datetime_ranges(
+    asdf_file_t *file, asdf_time_base_format_t type, const char *vs, const time_fields_t *f) {
+    switch (type) {
+    case ASDF_TIME_FORMAT_ISO_TIME:
+        validate_iso_time_ranges(file, vs, f);
         break;
-    case TIME_AUTO_IDX_YDAY:
-        validate_yday_ranges(file, vs, m);
+    case ASDF_TIME_FORMAT_YDAY:
+        validate_yday_ranges(file, vs, f);
         break;
     default:
         break;
@@ -619,22 +709,30 @@ cleanup:
 }
 
 
+/**
+ * Check the time value string against its explicit format, or guess its format if none
+ *
+ * If the string had to be scanned for its date and time fields to check it, they are returned
+ * in ``fields`` and ``*scanned`` is set, so they need not be parsed again.
+ */
 static asdf_time_base_format_t validate_or_guess_time_base_format(
-    asdf_value_t *value, const char *time_s, const char *format_s) {
+    asdf_value_t *value,
+    const char *time_s,
+    const char *format_s,
+    time_fields_t *fields,
+    bool *scanned) {
 
     asdf_time_base_format_t format = -1;
-    compile_time_auto_regexes();
+    *scanned = false;
 
     if (!format_s) {
         /* No explicit format: auto-detect from the value string. */
         for (size_t idx = 0; idx < TIME_AUTO_COUNT; idx++) {
-            if (UNLIKELY(time_auto_regexes[idx].error != CREG_OK))
-                continue;
-            csview match[CREG_MAX_CAPTURES] = {0};
-            if (cregex_match(&time_auto_regexes[idx], time_s, match) != CREG_OK)
+            if (!time_scan(time_auto_formats[idx], time_s, fields))
                 continue;
-            validate_datetime_ranges(value->file, (int)idx, time_s, match);
-            format = time_auto_patterns[idx].type;
+            format = time_auto_formats[idx];
+            validate_datetime_ranges(value->file, format, time_s, fields);
+            *scanned = true;
             break;
         }
 
@@ -652,21 +750,20 @@ static asdf_time_base_format_t validate_or_guess_time_base_format(
     if (!format_name_to_type(format_s, &format))
         ASDF_LOG(value->file, ASDF_LOG_WARN, "unrecognized time format '%s'", format_s);
 
-    /* Validate the value string against the format's auto-detect pattern,
-     * if one exists.  This is informational only -- a mismatch is a
-     * warning, not an error. */
-    int pat_idx = find_auto_pattern_idx(format);
-    if (pat_idx >= 0 && time_auto_regexes[pat_idx].error == CREG_OK) {
-        csview match[CREG_MAX_CAPTURES] = {0};
-        if (cregex_match(&time_auto_regexes[pat_idx], time_s, match) != CREG_OK)
+    /* Validate the value string against the format, if it is one that can be recognized.  This
+     * is informational only -- a mismatch is a warning, not an error. */
+    if (time_format_is_auto(format)) {
+        if (!time_scan(format, time_s, fields)) {
             ASDF_LOG(
                 value->file,
                 ASDF_LOG_WARN,
                 "time value '%s' does not match expected format '%s'",
                 time_s,
                 format_s);
-        else
-            validate_datetime_ranges(value->file, pat_idx, time_s, match);
+        } else {
+            validate_datetime_ranges(value->file, format, time_s, fields);
+            *scanned = true;
+        }
     }
 
     return format;
@@ -750,8 +847,10 @@ static asdf_value_err_t asdf_time_deserialize(
         }
     }
 
+    time_fields_t fields;
+    bool scanned = false;
     asdf_time_base_format_t format = validate_or_guess_time_base_format(
-        value, time->value, format_s);
+        value, time->value, format_s, &fields, &scanned);
 
     if (format < 0) {
         err = ASDF_VALUE_ERR_PARSE_FAILURE;
@@ -762,7 +861,7 @@ static asdf_value_err_t asdf_time_deserialize(
     time->format.is_base_format = (time->format.type <= ASDF_TIME_FORMAT_RESERVED1);
     time->scale = ASDF_TIME_SCALE_UTC;
 
-    asdf_time_parse_time(time->value, &time->format, &time->info);
+    asdf_time_parse_scanned(time->value, &time->format, scanned ? &fields : NULL, &time->info);
 
     *out = time;
 
@@ -775,6 +874,292 @@ failure:
 }
 
 
+/** Batch conversion of sequences and ndarrays of times */
+
+/** Convert one time string for `asdf_value_as_timespec_array` */
+static int time_string_to_timespec(
+    const char *s, const asdf_time_format_t *format, struct timespec *out) {
+    asdf_time_format_t guessed = {.is_base_format = true, .type = ASDF_TIME_FORMAT_JD};
+    struct asdf_time_info_t info;
+    time_fields_t fields;
+    bool scanned = false;
+
+    if (!format) {
+        for (size_t idx = 0; idx < TIME_AUTO_COUNT; idx++) {
+            if (time_scan(time_auto_formats[idx], s, &fields)) {
+                guessed.type = time_auto_formats[idx];
+                scanned = true;
+                break;
+            }
+        }
+        format = &guessed;
+    }
+
+    if (asdf_time_parse_scanned(s, format, scanned ? &fields : NULL, &info) != 0)
+        return -1;
+
+    *out = info.ts;
+    return 0;
+}
+
+
+/** Convert one numeric time for `asdf_value_as_timespec_array` */
+static int time_number_to_timespec(
+    double val, const asdf_time_format_t *format, struct timespec *out) {
+    struct asdf_time_info_t info;
+    asdf_time_base_format_t type = format ? format->type : ASDF_TIME_FORMAT_JD;
+
+    switch (type) {
+    case ASDF_TIME_FORMAT_JD:
+        time_info_of_jd(val, &info);
+        break;
+    case ASDF_TIME_FORMAT_MJD:
+        time_info_of_jd(val + JD_MJD, &info);
+        break;
+    case ASDF_TIME_FORMAT_BYEAR:
+        time_info_of_jd(besselian_to_julian(val), &info);
+        break;
+    case ASDF_TIME_FORMAT_UNIX: {
+        int64_t sec = (int64_t)val;
+        sec -= (double)sec > val;
+        // Round to the nearest nanosecond, carrying into the seconds if the fraction rounds up
+        // to a whole second (e.g. for tiny negative times)
+        int64_t nsec = (int64_t)((val - (double)sec) * 1e9 + 0.5);
+
+        if (nsec >= 1000000000) {
+            sec++;
+            nsec -= 1000000000;
+        }
+
+        time_info_of_unix(sec, (long)nsec, &info);
+        break;
+    }
+    default:
+        return -1;
+    }
+
+    *out = info.ts;
+    return 0;
+}
+
+
+static asdf_value_err_t time_sequence_as_timespec_array(
+    asdf_sequence_t *sequence,
+    const asdf_time_format_t *format,
+    struct timespec *arr,
+    int size,
+    int *count) {
+    struct fy_node *node_seq = sequence->value.node;
+    int n_items = fy_node_sequence_item_count(node_seq);
+
+    if (count)
+        *count = n_items;
+
+    if (!arr)
+        return ASDF_VALUE_OK;
+
+    if (n_items > size)
+        return ASDF_VALUE_ERR_OVERFLOW;
+
+    char buf[ASDF_TIME_TIMESTR_MAXLEN];
+    struct fy_node *node = NULL;
+    void *iter = NULL;
+
+    // Read the scalars directly rather than creating a value for each item
+    while ((node = fy_node_sequence_iterate(node_seq, &iter))) {
+        size_t len = 0;
+        const char *text = fy_node_is_scalar(node) ? fy_node_get_scalar(node, &len) : NULL;
+
+        if (!text)
+            return ASDF_VALUE_ERR_TYPE_MISMATCH;
+
+        if (len >= sizeof(buf))
+            return ASDF_VALUE_ERR_PARSE_FAILURE;
+
+        memcpy(buf, text, len);
+        buf[len] = '\0';
+
+        if (time_string_to_timespec(buf, format, arr++) != 0) {
+            ASDF_LOG(sequence->value.file, ASDF_LOG_WARN, "could not parse time '%s'", buf);
+            return ASDF_VALUE_ERR_PARSE_FAILURE;
+        }
+    }
+
+    return ASDF_VALUE_OK;
+}
+
+
+/** Copy a fixed-width ``ascii`` or ``ucs4`` string element into a null-terminated buffer */
+static bool time_string_element(
+    const uint8_t *elem, const asdf_ndarray_t *ndarray, char *buf, size_t buf_size) {
+    size_t elsize = ndarray->datatype.size;
+    size_t len = 0;
+
+    if (ndarray->datatype.type == ASDF_DATATYPE_ASCII) {
+        while (len < elsize && elem[len])
+            len++;
+
+        if (len >= buf_size)
+            return false;
+
+        memcpy(buf, elem, len);
+    } else {
+        bool big = ndarray->byteorder == ASDF_BYTEORDER_BIG;
+
+        for (size_t pos = 0; pos + 4 <= elsize; pos += 4, len++) {
+            const uint8_t *c = elem + pos;
+            uint32_t code = big ? ((uint32_t)c[0] << 24 | (uint32_t)c[1] << 16 |
+                                   (uint32_t)c[2] << 8 | c[3])
+                                : ((uint32_t)c[3] << 24 | (uint32_t)c[2] << 16 |
+                                   (uint32_t)c[1] << 8 | c[0]);
+
+            if (code == 0)
+                break;
+
+            // Time strings are plain ASCII
+            if (code > 0x7f || len + 1 >= buf_size)
+                return false;
+
+            buf[len] = (char)code;
+        }
+    }
+
+    buf[len] = '\0';
+    return true;
+}
+
+
+static asdf_value_err_t time_ndarray_strings_as_timespec_array(
+    asdf_ndarray_t *ndarray, const asdf_time_format_t *format, struct timespec *arr, size_t n) {
+    size_t nbytes = 0;
+    size_t elsize = ndarray->datatype.size;
+    const uint8_t *data = asdf_ndarray_data_raw(ndarray, &nbytes);
+
+    if (!data || elsize == 0 || nbytes < n * elsize)
+        return ASDF_VALUE_ERR_PARSE_FAILURE;
+
+    char buf[ASDF_TIME_TIMESTR_MAXLEN];
+
+    for (size_t idx = 0; idx < n; idx++) {
+        if (!time_string_element(data + idx * elsize, ndarray, buf, sizeof(buf)) ||
+            time_string_to_timespec(buf, format, &arr[idx]) != 0) {
+            ASDF_LOG(
+                ndarray->internal->file, ASDF_LOG_WARN, "could not parse time at index %zu", idx);
+            return ASDF_VALUE_ERR_PARSE_FAILURE;
+        }
+    }
+
+    return ASDF_VALUE_OK;
+}
+
+
+static asdf_value_err_t time_ndarray_numbers_as_timespec_array(
+    asdf_ndarray_t *ndarray, const asdf_time_format_t *format, struct timespec *arr, size_t n) {
+    double *vals = NULL;
+    asdf_ndarray_err_t nd_err = asdf_ndarray_read_all(
+        ndarray, ASDF_DATATYPE_FLOAT64, (void **)&vals);
+
+    if (nd_err != ASDF_NDARRAY_OK && nd_err != ASDF_NDARRAY_ERR_OVERFLOW) {
+        free(vals);
+        return nd_err == ASDF_NDARRAY_ERR_OOM ? ASDF_VALUE_ERR_OOM : ASDF_VALUE_ERR_PARSE_FAILURE;
+    }
+
+    asdf_value_err_t err = ASDF_VALUE_OK;
+
+    for (size_t idx = 0; idx < n; idx++) {
+        if (time_number_to_timespec(vals[idx], format, &arr[idx]) != 0) {
+            err = ASDF_VALUE_ERR_TYPE_MISMATCH;
+            break;
+        }
+    }
+
+    free(vals);
+    return err;
+}
+
+
+static asdf_value_err_t time_ndarray_as_timespec_array(
+    asdf_value_t *value,
+    const asdf_time_format_t *format,
+    struct timespec *arr,
+    int size,
+    int *count) {
+    asdf_ndarray_t *ndarray = NULL;
+    asdf_value_err_t err = asdf_value_as_ndarray(value, &ndarray);
+
+    if (err != ASDF_VALUE_OK)
+        return err;
+
+    uint64_t n_elems = asdf_ndarray_size(ndarray);
+
+    // Counts are ints, as for asdf_sequence_as_<type>_array
+    if (n_elems > INT_MAX) {
+        err = ASDF_VALUE_ERR_OVERFLOW;
+        goto cleanup;
+    }
+
+    size_t n = (size_t)n_elems;
+
+    if (count)
+        *count = (int)n;
+
+    if (!arr)
+        goto cleanup;
+
+    if ((int)n > size) {
+        err = ASDF_VALUE_ERR_OVERFLOW;
+        goto cleanup;
+    }
+
+    switch (ndarray->datatype.type) {
+    case ASDF_DATATYPE_ASCII:
+    case ASDF_DATATYPE_UCS4:
+        err = time_ndarray_strings_as_timespec_array(ndarray, format, arr, n);
+        break;
+    case ASDF_DATATYPE_INT8:
+    case ASDF_DATATYPE_UINT8:
+    case ASDF_DATATYPE_INT16:
+    case ASDF_DATATYPE_UINT16:
+    case ASDF_DATATYPE_INT32:
+    case ASDF_DATATYPE_UINT32:
+    case ASDF_DATATYPE_INT64:
+    case ASDF_DATATYPE_UINT64:
+    case ASDF_DATATYPE_FLOAT32:
+    case ASDF_DATATYPE_FLOAT64:
+        err = time_ndarray_numbers_as_timespec_array(ndarray, format, arr, n);
+        break;
+    default:
+        err = ASDF_VALUE_ERR_TYPE_MISMATCH;
+        break;
+    }
+
+cleanup:
+    asdf_ndarray_destroy(ndarray);
+    return err;
+}
+
+
+asdf_value_err_t asdf_value_as_timespec_array(
+    asdf_value_t *value,
+    const asdf_time_format_t *format,
+    struct timespec *arr,
+    int size,
+    int *count) {
+    if (UNLIKELY(!value))
+        return ASDF_VALUE_ERR_UNKNOWN;
+
+    asdf_sequence_t *sequence = NULL;
+
+    if (asdf_value_as_sequence(value, &sequence) == ASDF_VALUE_OK)
+        return time_sequence_as_timespec_array(sequence, format, arr, size, count);
+
+    if (asdf_value_is_ndarray(value))
+        return time_ndarray_as_timespec_array(value, format, arr, size, count);
+
+    return ASDF_VALUE_ERR_TYPE_MISMATCH;
+}
+
+
 static void *asdf_time_copy(const void *obj) {
     if (!obj)
         return NULL;
@@ -407,6 +407,7 @@ static int emit_prepare_tree(asdf_emitter_t *emitter, struct fy_document *tree)
         if (UNLIKELY(fy_document_set_root(tree, new_root) != 0))
             goto cleanup;
 
+        asdf_file_path_cache_clear(emitter->file);
         root = new_root;
     }
 
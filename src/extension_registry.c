@@ -1,37 +1,78 @@
 #include <stdatomic.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "context.h"
 #include "error.h"
 #include "file.h"
 #include "log.h"
 #include "types/asdf_extension_map.h"
+#include "util.h"
 #include "yaml.h"
 
 
+/** Size of the stack buffer used to canonicalize tags for lookup */
+#define ASDF_EXTENSION_TAG_BUF_SIZE 256
+
+
 static asdf_extension_map_t extension_map = {0};
 static atomic_bool extension_map_initialized = false;
 
 
-const asdf_extension_t *asdf_extension_get(asdf_file_t *file, const char *tag) {
-    const asdf_extension_map_value *ext = NULL;
-    char *full_tag = asdf_yaml_tag_canonicalize(tag);
-
-    if (!full_tag) {
-        ASDF_ERROR_OOM(file);
-        return NULL;
+/**
+ * Look up a tag in the extension registry without allocating
+ *
+ * Tags not already starting with ``tag:`` are canonicalized in a stack buffer unless they are
+ * unusually long.
+ */
+static asdf_extension_t *asdf_extension_lookup(asdf_file_t *file, const char *tag) {
+    char buf[ASDF_EXTENSION_TAG_BUF_SIZE];
+    const char *full_tag = tag;
+    char *heap_tag = NULL;
+
+    if (0 != strncmp(tag, asdf_yaml_tag_prefix, ASDF_YAML_TAG_PREFIX_SIZE)) {
+        size_t taglen = strlen(tag);
+
+        if (LIKELY(ASDF_YAML_TAG_PREFIX_SIZE + taglen < sizeof(buf))) {
+            memcpy(buf, asdf_yaml_tag_prefix, ASDF_YAML_TAG_PREFIX_SIZE);
+            memcpy(buf + ASDF_YAML_TAG_PREFIX_SIZE, tag, taglen + 1);
+            full_tag = buf;
+        } else {
+            heap_tag = asdf_yaml_tag_canonicalize(tag);
+
+            if (!heap_tag) {
+                ASDF_ERROR_OOM(file);
+                return NULL;
+            }
+
+            full_tag = heap_tag;
+        }
     }
 
-    ext = asdf_extension_map_get(&extension_map, full_tag);
+    const asdf_extension_map_value *ext = asdf_extension_map_get(&extension_map, full_tag);
 
-    if (!ext) {
+    if (!ext)
         ASDF_LOG(file, ASDF_LOG_TRACE, "no extension registered for tag %s", full_tag);
-        free(full_tag);
-        return NULL;
-    }
 
-    free(full_tag);
-    return (const asdf_extension_t *)ext->second;
+    free(heap_tag);
+    return ext ? ext->second : NULL;
+}
+
+
+const asdf_extension_t *asdf_extension_get(asdf_file_t *file, const char *tag) {
+    if (!file)
+        return asdf_extension_lookup(file, tag);
+
+    // Tags are looked up again for every tagged value in the tree, so remember the result for
+    // each distinct tag (including tags with no extension) the first time it is seen
+    const asdf_extension_map_value *cached = asdf_extension_map_get(&file->extension_cache, tag);
+
+    if (cached)
+        return cached->second;
+
+    asdf_extension_t *ext = asdf_extension_lookup(file, tag);
+    asdf_extension_map_emplace(&file->extension_cache, tag, ext);
+    return ext;
 }
 
 
@@ -1,5 +1,6 @@
 #include <limits.h>
 #include <math.h>
+#include <pthread.h>
 #include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
@@ -19,9 +20,12 @@
 #include "error.h"
 #include "event.h"
 #include "file.h"
+#include "index_cache.h"
 #include "log.h"
+#include "object_cache.h"
 #include "parser.h"
 #include "stream.h"
+#include "thread_pool.h"
 #include "types/asdf_block_info_vec.h"
 #include "util.h"
 #include "value.h"
@@ -79,6 +83,16 @@ static asdf_config_t *asdf_config_build(asdf_config_t *user_config) {
         ASDF_CONFIG_OVERRIDE(config, user_config, decomp.max_memory_threshold, 0.0);
         ASDF_CONFIG_OVERRIDE(config, user_config, decomp.chunk_size, 0);
         ASDF_CONFIG_OVERRIDE(config, user_config, decomp.tmp_dir, NULL);
+        ASDF_CONFIG_OVERRIDE(config, user_config, io.mode, ASDF_FILE_IO_MODE_AUTO);
+        ASDF_CONFIG_OVERRIDE(config, user_config, io.mmap_window_size, 0);
+        ASDF_CONFIG_OVERRIDE(config, user_config, io.access_hint, ASDF_ACCESS_HINT_NONE);
+        ASDF_CONFIG_OVERRIDE(config, user_config, io.mmap_cache_max_mappings, 0);
+        ASDF_CONFIG_OVERRIDE(config, user_config, io.mmap_cache_granularity, 0);
+        ASDF_CONFIG_OVERRIDE(config, user_config, io.index_cache, ASDF_INDEX_CACHE_NONE);
+        ASDF_CONFIG_OVERRIDE(config, user_config, io.index_cache_dir, NULL);
+        ASDF_CONFIG_OVERRIDE(config, user_config, io.background_blocks, false);
+        ASDF_CONFIG_OVERRIDE(config, user_config, threads.n_threads, 0);
+        ASDF_CONFIG_OVERRIDE(config, user_config, threads.min_task_bytes, 0);
     }
 
     // The parser config has its own log config internally; this is used mostly just
@@ -157,6 +171,7 @@ static asdf_file_t *asdf_file_create(asdf_config_t *user_config, asdf_file_mode_
     asdf_config_validate(file);
     // Initialize the tag map
     asdf_str_map_reserve(&file->tag_map, ASDF_FILE_TAG_MAP_DEFAULT_SIZE);
+    asdf_value_pools_init(file);
     /* Now we can start cooking */
     return file;
 }
@@ -173,8 +188,16 @@ static asdf_parser_t *asdf_file_parser(asdf_file_t *file) {
         return file->parser;
 
     asdf_parser_t *parser = asdf_parser_create_ctx(file->base.ctx, &file->config->parser);
+    asdf_stream_set_mmap_cache_limits(
+        file->stream,
+        file->config->io.mmap_cache_max_mappings,
+        file->config->io.mmap_cache_granularity);
     asdf_parser_set_input_stream(parser, file->stream);
     file->parser = parser;
+
+    if (file->index_cache)
+        asdf_index_cache_load(file->index_cache, file);
+
     return parser;
 }
 
@@ -211,6 +234,41 @@ static asdf_file_mode_t asdf_file_mode_parse(const char *mode) {
 }
 
 
+/**
+ * Open the input stream for a file opened by filename
+ *
+ * Read-only files are memory-mapped unless configured otherwise, falling back to a buffered
+ * stream if that is not possible.
+ */
+static asdf_stream_t *asdf_file_stream_open(asdf_file_t *file, const char *filename) {
+    bool is_writeable = file->mode != ASDF_FILE_MODE_READ_ONLY;
+    asdf_file_io_mode_t io_mode = file->config->io.mode;
+
+    if (!is_writeable && io_mode != ASDF_FILE_IO_MODE_BUFFERED) {
+        asdf_stream_t *stream = asdf_stream_from_file_mmap(
+            file->base.ctx, filename, file->config->io.mmap_window_size);
+
+        if (stream || ASDF_ERROR_GET(file))
+            return stream;
+
+        if (io_mode == ASDF_FILE_IO_MODE_MMAP)
+            ASDF_LOG(
+                file,
+                ASDF_LOG_WARN,
+                "%s could not be memory-mapped; falling back to buffered reads",
+                filename);
+    } else if (io_mode == ASDF_FILE_IO_MODE_MMAP) {
+        ASDF_LOG(
+            file,
+            ASDF_LOG_WARN,
+            "io.mode is set to mmap but this is only supported for read-only files; buffered "
+            "reads will be used instead");
+    }
+
+    return asdf_stream_from_file(file->base.ctx, filename, is_writeable);
+}
+
+
 // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
 asdf_file_t *asdf_open_file_ex(const char *filename, const char *mode, asdf_config_t *config) {
     asdf_file_t *file = asdf_file_create(config, asdf_file_mode_parse(mode));
@@ -219,8 +277,7 @@ asdf_file_t *asdf_open_file_ex(const char *filename, const char *mode, asdf_conf
         return NULL;
 
     if (file->mode != ASDF_FILE_MODE_WRITE_ONLY) {
-        asdf_stream_t *stream = asdf_stream_from_file(
-            file->base.ctx, filename, file->mode != ASDF_FILE_MODE_READ_ONLY);
+        asdf_stream_t *stream = asdf_file_stream_open(file, filename);
 
         if (!stream) {
             // Copy the stream error to the global context
@@ -231,6 +288,9 @@ asdf_file_t *asdf_open_file_ex(const char *filename, const char *mode, asdf_conf
         file->stream = stream;
     }
 
+    if (file->mode == ASDF_FILE_MODE_READ_ONLY)
+        file->index_cache = asdf_index_cache_open(file, filename);
+
     return file;
 
 failure:
@@ -486,11 +546,19 @@ void asdf_close(asdf_file_t *file) {
         return;
 
     asdf_file_run_write_cleanups(file);
+    // Release cached objects first, while any blocks they reference are still open
+    asdf_object_cache_clear(file);
+    asdf_object_map_drop(&file->object_cache);
     fy_document_destroy(file->tree);
     asdf_emitter_destroy(file->emitter);
     asdf_parser_destroy(file->parser);
+    asdf_index_cache_close(file->index_cache);
     asdf_block_info_vec_drop(&file->blocks);
     asdf_str_map_drop(&file->tag_map);
+    asdf_extension_map_drop(&file->extension_cache);
+    asdf_node_map_drop(&file->path_cache);
+    asdf_tag_index_destroy(file->tag_index);
+    asdf_thread_pool_destroy(file->thread_pool);
     asdf_stream_close(file->stream);
     // Clean up the asdf_library override if any
     asdf_software_destroy(file->asdf_library);
@@ -503,6 +571,10 @@ void asdf_close(asdf_file_t *file) {
         }
         free((void *)file->history_entries);
     }
+    // Any values or iterators the user has not destroyed are released here
+    asdf_pool_drop(&file->value_pool);
+    asdf_pool_drop(&file->iter_pool);
+    asdf_pool_drop(&file->path_pool);
     asdf_context_release(file->base.ctx);
     /* Clean up */
     free(file->config);
@@ -588,6 +660,19 @@ failure:
 }
 
 
+/**
+ * Parses the rest of the file following the tree, for use with ``io.background_blocks``
+ *
+ * Only the parser, its stream and the file's block list are touched here, none of which are
+ * used while the tree document is built from the parser's copy of the tree.
+ */
+static void *asdf_file_block_discovery_worker(void *arg) {
+    asdf_file_t *file = arg;
+    asdf_block_count(file);
+    return NULL;
+}
+
+
 struct fy_document *asdf_file_tree_document(asdf_file_t *file) {
     if (!file)
         return NULL;
@@ -641,9 +726,17 @@ has_tree:
         return NULL;
     }
 
+    pthread_t worker;
+    bool background = file->config->io.background_blocks && !parser->done &&
+                      0 == pthread_create(&worker, NULL, asdf_file_block_discovery_worker, file);
+
     size_t size = parser->tree.size;
     const char *buf = (const char *)parser->tree.buf;
     file->tree = fy_document_build_from_string(NULL, buf, size);
+
+    if (background)
+        pthread_join(worker, NULL);
+
     return file->tree;
 }
 
@@ -666,18 +759,146 @@ const char *asdf_file_tag_normalize(asdf_file_t *file, const char *tag) {
 }
 
 
-asdf_value_t *asdf_get_value(asdf_file_t *file, const char *path) {
+/** Compiled paths; see asdf_path_compile */
+struct asdf_path {
+    char *path;
+    asdf_yaml_path_t yaml_path;
+};
+
+
+asdf_path_t *asdf_path_compile(const char *path) {
+    asdf_path_t *compiled = calloc(1, sizeof(asdf_path_t));
+
+    if (!compiled)
+        return NULL;
+
+    compiled->path = strdup(path ? path : "");
+    compiled->yaml_path = asdf_yaml_path_init();
+
+    if (!compiled->path || !asdf_yaml_path_parse(path, &compiled->yaml_path)) {
+        asdf_path_destroy(compiled);
+        return NULL;
+    }
+
+    return compiled;
+}
+
+
+const char *asdf_path_str(const asdf_path_t *path) {
+    return path ? path->path : NULL;
+}
+
+
+void asdf_path_destroy(asdf_path_t *path) {
+    if (!path)
+        return;
+
+    asdf_yaml_path_drop(&path->yaml_path);
+    free(path->path);
+    free(path);
+}
+
+
+void asdf_file_path_cache_clear(asdf_file_t *file) {
+    if (!file)
+        return;
+
+    asdf_node_map_clear(&file->path_cache);
+    // Nodes that were removed may be freed and their addresses reused
+    asdf_object_cache_clear(file);
+    asdf_file_tag_index_clear(file);
+}
+
+
+asdf_tag_index_t *asdf_file_tag_index(asdf_file_t *file) {
+    if (UNLIKELY(!file))
+        return NULL;
+
+    if (file->tag_index)
+        return file->tag_index;
+
+    struct fy_document *tree = asdf_file_tree_document(file);
+
+    if (!tree)
+        return NULL;
+
+    file->tag_index = asdf_tag_index_build(file, fy_document_root(tree));
+    return file->tag_index;
+}
+
+
+void asdf_file_tag_index_clear(asdf_file_t *file) {
+    if (!file || !file->tag_index)
+        return;
+
+    asdf_tag_index_destroy(file->tag_index);
+    file->tag_index = NULL;
+}
+
+
+asdf_thread_pool_t *asdf_file_thread_pool(asdf_file_t *file) {
+    if (UNLIKELY(!file))
+        return NULL;
+
+    if (file->thread_pool || file->thread_pool_failed || file->config->threads.n_threads < 2)
+        return file->thread_pool;
+
+    file->thread_pool = asdf_thread_pool_create(file->config->threads.n_threads);
+    file->thread_pool_failed = !file->thread_pool;
+
+    if (file->thread_pool_failed)
+        ASDF_LOG(
+            file,
+            ASDF_LOG_WARN,
+            "could not start worker threads; ndarray data will be read on a single thread");
+
+    return file->thread_pool;
+}
+
+
+/**
+ * Look up the node at ``path`` in the tree, going through the file's path cache
+ *
+ * If ``yaml_path`` is given it should be ``path`` already parsed, and is used to walk the tree on
+ * a cache miss rather than parsing the path again.
+ */
+static struct fy_node *asdf_file_node_at(
+    asdf_file_t *file, const char *path, const asdf_yaml_path_t *yaml_path) {
     struct fy_document *tree = asdf_file_tree_document(file);
 
     if (UNLIKELY(!tree))
         return NULL;
 
+    if (path) {
+        const asdf_node_map_value *cached = asdf_node_map_get(&file->path_cache, path);
+
+        if (cached)
+            return cached->second;
+    }
+
     struct fy_node *root = fy_document_root(tree);
 
     if (UNLIKELY(!root))
         return NULL;
 
-    struct fy_node *node = fy_node_by_path(root, path, -1, FYNWF_PTR_DEFAULT);
+    struct fy_node *node = yaml_path ? asdf_yaml_path_resolve(root, yaml_path) : NULL;
+
+    // Fall back on libfyaml's own path resolution for anything the pre-parsed path does not
+    // find, so that both kinds of lookup always agree
+    if (!node)
+        node = fy_node_by_path(root, path, -1, FYNWF_PTR_DEFAULT);
+
+    // Failing to cache the node is harmless, so allocation failures are ignored here
+    if (node && path)
+        asdf_node_map_emplace(&file->path_cache, path, node);
+
+    return node;
+}
+
+
+static asdf_value_t *asdf_file_value_at(
+    asdf_file_t *file, const char *path, const asdf_yaml_path_t *yaml_path) {
+    struct fy_node *node = asdf_file_node_at(file, path, yaml_path);
 
     if (!node)
         return NULL;
@@ -693,14 +914,42 @@ asdf_value_t *asdf_get_value(asdf_file_t *file, const char *path) {
 }
 
 
+asdf_value_t *asdf_get_value(asdf_file_t *file, const char *path) {
+    return asdf_file_value_at(file, path, NULL);
+}
+
+
+asdf_value_t *asdf_get_value_path(asdf_file_t *file, const asdf_path_t *path) {
+    if (!path)
+        return NULL;
+
+    return asdf_file_value_at(file, path->path, &path->yaml_path);
+}
+
+
+/**
+ * Set up a temporary value on the stack for the node at ``path``, for the shortcuts below
+ *
+ * Returns false if there is no such node; otherwise release it with `asdf_value_clear`.
+ */
+static bool asdf_file_value_init_at(asdf_file_t *file, const char *path, asdf_value_t *value) {
+    struct fy_node *node = asdf_file_node_at(file, path, NULL);
+
+    if (!node)
+        return false;
+
+    return asdf_value_init(value, file, node);
+}
+
+
 /* asdf_is_(type), asdf_get_(type) shortcuts */
 #define ASDF_IS_TYPE(type) \
     bool asdf_is_##type(asdf_file_t *file, const char *path) { \
-        asdf_value_t *value = asdf_get_value(file, path); \
-        if (!value) \
+        asdf_value_t value; \
+        if (!asdf_file_value_init_at(file, path, &value)) \
             return false; \
-        bool ret = asdf_value_is_##type(value); \
-        asdf_value_destroy(value); \
+        bool ret = asdf_value_is_##type(&value); \
+        asdf_value_clear(&value); \
         return ret; \
     }
 
@@ -758,50 +1007,50 @@ asdf_value_err_t asdf_get_sequence(asdf_file_t *file, const char *path, asdf_seq
 
 asdf_value_err_t asdf_get_string(
     asdf_file_t *file, const char *path, const char **out, size_t *out_len) {
-    asdf_value_t *value = asdf_get_value(file, path);
+    asdf_value_t value;
 
-    if (!value)
+    if (!asdf_file_value_init_at(file, path, &value))
         return ASDF_VALUE_ERR_NOT_FOUND;
 
-    asdf_value_err_t err = asdf_value_as_string(value, out, out_len);
-    asdf_value_destroy(value);
+    asdf_value_err_t err = asdf_value_as_string(&value, out, out_len);
+    asdf_value_clear(&value);
     return err;
 }
 
 
 asdf_value_err_t asdf_get_string0(asdf_file_t *file, const char *path, const char **out) {
-    asdf_value_t *value = asdf_get_value(file, path);
+    asdf_value_t value;
 
-    if (!value)
+    if (!asdf_file_value_init_at(file, path, &value))
         return ASDF_VALUE_ERR_NOT_FOUND;
 
-    asdf_value_err_t err = asdf_value_as_string0(value, out);
-    asdf_value_destroy(value);
+    asdf_value_err_t err = asdf_value_as_string0(&value, out);
+    asdf_value_clear(&value);
     return err;
 }
 
 
 asdf_value_err_t asdf_get_scalar(
     asdf_file_t *file, const char *path, const char **out, size_t *out_len) {
-    asdf_value_t *value = asdf_get_value(file, path);
+    asdf_value_t value;
 
-    if (!value)
+    if (!asdf_file_value_init_at(file, path, &value))
         return ASDF_VALUE_ERR_NOT_FOUND;
 
-    asdf_value_err_t err = asdf_value_as_scalar(value, out, out_len);
-    asdf_value_destroy(value);
+    asdf_value_err_t err = asdf_value_as_scalar(&value, out, out_len);
+    asdf_value_clear(&value);
     return err;
 }
 
 
 asdf_value_err_t asdf_get_scalar0(asdf_file_t *file, const char *path, const char **out) {
-    asdf_value_t *value = asdf_get_value(file, path);
+    asdf_value_t value;
 
-    if (!value)
+    if (!asdf_file_value_init_at(file, path, &value))
         return ASDF_VALUE_ERR_NOT_FOUND;
 
-    asdf_value_err_t err = asdf_value_as_scalar0(value, out);
-    asdf_value_destroy(value);
+    asdf_value_err_t err = asdf_value_as_scalar0(&value, out);
+    asdf_value_clear(&value);
     return err;
 }
 
@@ -809,22 +1058,22 @@ asdf_value_err_t asdf_get_scalar0(asdf_file_t *file, const char *path, const cha
 #define ASDF_GET_TYPE(type) \
     /* NOLINTNEXTLINE(bugprone-macro-parentheses) */ \
     asdf_value_err_t asdf_get_##type(asdf_file_t *file, const char *path, type *out) { \
-        asdf_value_t *value = asdf_get_value(file, path); \
-        if (!value) \
+        asdf_value_t value; \
+        if (!asdf_file_value_init_at(file, path, &value)) \
             return ASDF_VALUE_ERR_NOT_FOUND; \
-        asdf_value_err_t err = asdf_value_as_##type(value, out); \
-        asdf_value_destroy(value); \
+        asdf_value_err_t err = asdf_value_as_##type(&value, out); \
+        asdf_value_clear(&value); \
         return err; \
     }
 
 
 #define ASDF_GET_INT_TYPE(type) \
     asdf_value_err_t asdf_get_##type(asdf_file_t *file, const char *path, type##_t *out) { \
-        asdf_value_t *value = asdf_get_value(file, path); \
-        if (!value) \
+        asdf_value_t value; \
+        if (!asdf_file_value_init_at(file, path, &value)) \
             return ASDF_VALUE_ERR_NOT_FOUND; \
-        asdf_value_err_t err = asdf_value_as_##type(value, out); \
-        asdf_value_destroy(value); \
+        asdf_value_err_t err = asdf_value_as_##type(&value, out); \
+        asdf_value_clear(&value); \
         return err; \
     }
 
@@ -842,6 +1091,35 @@ ASDF_GET_TYPE(float);
 ASDF_GET_TYPE(double);
 
 
+#define ASDF_GET_TYPE_ARRAY(type, ctype) \
+    asdf_value_err_t asdf_get_##type##_array( \
+        asdf_file_t *file, const char *path, ctype *arr, int size, int *count) { \
+        asdf_value_t value; \
+        if (!asdf_file_value_init_at(file, path, &value)) \
+            return ASDF_VALUE_ERR_NOT_FOUND; \
+        asdf_sequence_t *sequence = NULL; \
+        asdf_value_err_t err = asdf_value_as_sequence(&value, &sequence); \
+        if (err == ASDF_VALUE_OK) \
+            err = asdf_sequence_as_##type##_array(sequence, arr, size, count); \
+        asdf_value_clear(&value); \
+        return err; \
+    }
+
+#define ASDF_GET_INT_TYPE_ARRAY(type) ASDF_GET_TYPE_ARRAY(type, type##_t)
+
+
+ASDF_GET_INT_TYPE_ARRAY(int8);
+ASDF_GET_INT_TYPE_ARRAY(int16);
+ASDF_GET_INT_TYPE_ARRAY(int32);
+ASDF_GET_INT_TYPE_ARRAY(int64);
+ASDF_GET_INT_TYPE_ARRAY(uint8);
+ASDF_GET_INT_TYPE_ARRAY(uint16);
+ASDF_GET_INT_TYPE_ARRAY(uint32);
+ASDF_GET_INT_TYPE_ARRAY(uint64);
+ASDF_GET_TYPE_ARRAY(float, float);
+ASDF_GET_TYPE_ARRAY(double, double);
+
+
 bool asdf_is_extension_type(asdf_file_t *file, const char *path, asdf_extension_t *ext) {
     asdf_value_t *value = asdf_get_value(file, path);
     if (!value)
@@ -887,6 +1165,8 @@ static asdf_value_err_t asdf_set_node(asdf_file_t *file, const char *path, struc
     if (!tree)
         return ASDF_VALUE_ERR_OOM;
 
+    // Any existing node at the path is replaced
+    asdf_file_path_cache_clear(file);
     return asdf_node_insert_at(tree, path, node, true);
 }
 
@@ -1033,6 +1313,9 @@ size_t asdf_block_count(asdf_file_t *file) {
 
         // Copy the parser's block info into the file's
         asdf_block_info_vec_copy(&file->blocks, parser->block.infos);
+
+        if (file->index_cache)
+            asdf_index_cache_save(file->index_cache, file);
     }
 
     return (size_t)asdf_block_info_vec_size(&file->blocks);
@@ -1042,16 +1325,30 @@ asdf_block_t *asdf_block_open(asdf_file_t *file, size_t index) {
     if (!file)
         return NULL;
 
-    size_t n_blocks = asdf_block_count(file);
+    const asdf_block_info_t *info = NULL;
+    asdf_parser_t *parser = asdf_file_parser(file);
 
-    if (index >= n_blocks) {
-        ASDF_LOG(
-            file,
-            ASDF_LOG_WARN,
-            "block index %zu does not exist (the file contains %zu blocks)",
-            index,
-            n_blocks);
-        return NULL;
+    /* If the file has not been fully parsed yet try going straight to the block through the
+     * block index, which only requires reading that one block's header; this is what keeps
+     * opening a single block of a file with very many blocks cheap.  Otherwise (no block
+     * index, or the index entry turns out to be bogus) fall back to parsing all blocks */
+    if (parser && !parser->done && asdf_block_info_vec_size(&file->blocks) == 0)
+        info = asdf_parser_block_info_indexed(parser, index);
+
+    if (!info) {
+        size_t n_blocks = asdf_block_count(file);
+
+        if (index >= n_blocks) {
+            ASDF_LOG(
+                file,
+                ASDF_LOG_WARN,
+                "block index %zu does not exist (the file contains %zu blocks)",
+                index,
+                n_blocks);
+            return NULL;
+        }
+
+        info = asdf_block_info_vec_at(&file->blocks, (isize)index);
     }
 
     asdf_block_t *block = calloc(1, sizeof(asdf_block_t));
@@ -1061,8 +1358,6 @@ asdf_block_t *asdf_block_open(asdf_file_t *file, size_t index) {
         return NULL;
     }
 
-    asdf_block_info_vec_t *blocks = &file->blocks;
-    const asdf_block_info_t *info = asdf_block_info_vec_at(blocks, (isize)index);
     block->file = file;
     block->data = NULL;
     block->should_close = false;
@@ -1121,7 +1416,39 @@ size_t asdf_block_data_size(asdf_block_t *block) {
 }
 
 
-const void *asdf_block_data_impl(asdf_block_t *block, size_t *size, bool decompress) {
+/**
+ * Apply the block's effective access hint to its mapped data
+ *
+ * The block's own hint takes precedence over the file's ``io.access_hint``, which takes
+ * precedence over the default for the access method.  Compressed data is always read from
+ * the start by the decompressor, so random access defaults do not apply to it.
+ */
+static void asdf_block_advise(asdf_block_t *block, asdf_access_hint_t default_hint) {
+    if (!block->data || !block->should_close)
+        return;
+
+    asdf_access_hint_t hint = block->access_hint;
+
+    if (hint == ASDF_ACCESS_HINT_NONE)
+        hint = block->file->config->io.access_hint;
+
+    if (hint == ASDF_ACCESS_HINT_NONE) {
+        hint = default_hint;
+
+        if (hint != ASDF_ACCESS_HINT_NONE && block->info.header.compression[0] != '\0')
+            hint = ASDF_ACCESS_HINT_SEQUENTIAL;
+    }
+
+    if (hint == ASDF_ACCESS_HINT_NONE)
+        return;
+
+    asdf_stream_t *stream = block->file->parser->stream;
+    asdf_stream_advise_mem(stream, block->data, block->avail_size, hint);
+}
+
+
+static const void *asdf_block_data_impl(
+    asdf_block_t *block, size_t *size, bool decompress, asdf_access_hint_t default_hint) {
     if (!block)
         return NULL;
 
@@ -1148,6 +1475,7 @@ const void *asdf_block_data_impl(asdf_block_t *block, size_t *size, bool decompr
     block->data = data;
     block->should_close = true;
     block->avail_size = avail;
+    asdf_block_advise(block, default_hint);
 
     // Open compressed data if applicable
     if (decompress) {
@@ -1174,12 +1502,60 @@ const void *asdf_block_data_impl(asdf_block_t *block, size_t *size, bool decompr
 
 
 const void *asdf_block_data(asdf_block_t *block, size_t *size) {
-    return asdf_block_data_impl(block, size, true);
+    return asdf_block_data_impl(block, size, true, ASDF_ACCESS_HINT_NONE);
+}
+
+
+const void *asdf_block_data_hinted(
+    asdf_block_t *block, size_t *size, asdf_access_hint_t default_hint) {
+    return asdf_block_data_impl(block, size, true, default_hint);
 }
 
 
 const void *asdf_block_data_raw(asdf_block_t *block, size_t *size) {
-    return asdf_block_data_impl(block, size, false);
+    return asdf_block_data_impl(block, size, false, ASDF_ACCESS_HINT_NONE);
+}
+
+
+void asdf_block_prefetch(asdf_block_t *block, const void *addr, size_t size) {
+    if (!block || !block->data || size == 0)
+        return;
+
+    asdf_block_comp_state_t *comp_state = block->comp_state;
+    const uint8_t *start = comp_state ? comp_state->dest : block->data;
+    size_t avail = comp_state ? comp_state->dest_size : block->avail_size;
+    const uint8_t *first = addr;
+
+    if (first < start || size > avail || (size_t)(first - start) > avail - size)
+        return;
+
+    if (comp_state) {
+        // Touch each page of the range in order, so that lazily decompressed data is produced
+        // in one forward pass rather than in whatever order the readers fault pages in
+        size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+        const volatile uint8_t *page = first;
+
+        for (size_t pos = 0; pos < size; pos += page_size - ((uintptr_t)(first + pos) % page_size))
+            (void)page[pos];
+
+        return;
+    }
+
+    if (!block->should_close)
+        return;
+
+    asdf_stream_t *stream = block->file->parser->stream;
+    asdf_stream_advise_mem(stream, (void *)addr, size, ASDF_ACCESS_HINT_WILLNEED);
+}
+
+
+int asdf_block_access_hint(asdf_block_t *block, asdf_access_hint_t hint) {
+    if (!block)
+        return -1;
+
+    block->access_hint = hint;
+    asdf_block_advise(block, ASDF_ACCESS_HINT_NONE);
+    return 0;
 }
 
 
@@ -1222,7 +1598,11 @@ int asdf_block_compression_set(asdf_block_t *block, const char *compression) {
     if (ret != 0)
         return ret;
 
-    /* Propagate to file->blocks so the emitter sees the change */
+    /* Propagate to file->blocks so the emitter sees the change; a block opened through the
+     * block index may have been opened before file->blocks was populated */
+    if ((size_t)asdf_block_info_vec_size(&block->file->blocks) <= block->info.index)
+        (void)asdf_block_count(block->file);
+
     asdf_block_info_t *file_block = asdf_block_info_vec_at_mut(
         &block->file->blocks, (isize)block->info.index);
 
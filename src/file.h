@@ -13,8 +13,15 @@
 #include "context.h"
 #include "core/history_entry.h"
 #include "emitter.h"
+#include "index_cache.h"
 #include "parser.h"
+#include "pool.h"
+#include "tag_index.h"
+#include "thread_pool.h"
 #include "types/asdf_block_info_vec.h"
+#include "types/asdf_extension_map.h"
+#include "types/asdf_node_map.h"
+#include "types/asdf_object_map.h"
 #include "types/asdf_str_map.h"
 
 
@@ -57,6 +64,8 @@ typedef struct asdf_file {
     asdf_file_mode_t mode;
     asdf_stream_t *stream;
     asdf_parser_t *parser;
+    /** Block index cache, if enabled with ``io.index_cache`` */
+    asdf_index_cache_t *index_cache;
     asdf_emitter_t *emitter;
     struct fy_document *tree;
     asdf_block_info_vec_t blocks;
@@ -77,6 +86,53 @@ typedef struct asdf_file {
      *   once in the file, but may have some benefit for frequently used tags.
      */
     asdf_str_map_t tag_map;
+    /**
+     * Cache of tags looked up with `asdf_extension_get` to the extension registered for them
+     *
+     * Tags with no registered extension are cached too (mapped to ``NULL``), so an extension
+     * registered after a tag was first looked up in this file is not seen by it.
+     */
+    asdf_extension_map_t extension_cache;
+    /**
+     * Cache of paths looked up in the tree (by ``asdf_get_*`` and friends) to the nodes they
+     * were found at
+     *
+     * Only paths that exist are cached.  Adding nodes to the tree leaves the cache valid, but
+     * anything that replaces or removes existing nodes must call `asdf_file_path_cache_clear`.
+     */
+    asdf_node_map_t path_cache;
+    /**
+     * Extension objects deserialized from nodes in the tree, keyed by node; see
+     * object_cache.h
+     *
+     * Invalidated along with the path cache by `asdf_file_path_cache_clear`.
+     */
+    asdf_object_map_t object_cache;
+    /**
+     * Index of the tree's nodes by tag and key, built on first use by `asdf_find_by_tag` and
+     * `asdf_find_by_key`
+     *
+     * Dropped by `asdf_file_path_cache_clear` and `asdf_file_tag_index_clear` whenever the tree
+     * changes.
+     */
+    asdf_tag_index_t *tag_index;
+    /**
+     * Worker threads for reading ndarray data, started by `asdf_file_thread_pool` the first time
+     * they are needed if ``threads.n_threads`` is configured
+     */
+    asdf_thread_pool_t *thread_pool;
+    /** Set if the thread pool could not be started, so reads stay on the calling thread */
+    bool thread_pool_failed;
+    /**
+     * Pools for the `asdf_value_t`, container iterator and value path objects handed out for
+     * this file
+     *
+     * These are all released when the file is closed, so no value or iterator from the file may
+     * be used (or destroyed) after `asdf_close`.
+     */
+    asdf_pool_t value_pool;
+    asdf_pool_t iter_pool;
+    asdf_pool_t path_pool;
     /**
      * Optional override of the asdf_library software to set in the file
      * metadata on output
@@ -102,6 +158,25 @@ ASDF_LOCAL void asdf_file_write_cleanup_add(
 /** Internal helper to run and free all registered write cleanup callbacks */
 ASDF_LOCAL void asdf_file_run_write_cleanups(asdf_file_t *file);
 
+/**
+ * Internal helper to invalidate the path and object caches after nodes have been replaced or
+ * removed
+ */
+ASDF_LOCAL void asdf_file_path_cache_clear(asdf_file_t *file);
+
+/** Internal helper to get the file's tag index, building it if needed */
+ASDF_LOCAL asdf_tag_index_t *asdf_file_tag_index(asdf_file_t *file);
+
+/** Internal helper to invalidate the tag index after nodes have been added to the tree */
+ASDF_LOCAL void asdf_file_tag_index_clear(asdf_file_t *file);
+
+/**
+ * Internal helper to get the file's thread pool, starting it if needed
+ *
+ * Returns NULL if the file is configured to use a single thread, or the pool could not be started.
+ */
+ASDF_LOCAL asdf_thread_pool_t *asdf_file_thread_pool(asdf_file_t *file);
+
 /** Internal helper to set and/or retrieve a normalized tag */
 ASDF_LOCAL const char *asdf_file_tag_normalize(asdf_file_t *file, const char *tag);
 
@@ -122,8 +197,27 @@ typedef struct asdf_block {
 
     const char *compression;
     asdf_block_comp_state_t *comp_state;
+
+    // Access hint set with asdf_block_access_hint; overrides the file's io.access_hint
+    asdf_access_hint_t access_hint;
 } asdf_block_t;
 
 
 /** Internal block methods */
 ASDF_LOCAL const char *asdf_block_compression_orig(asdf_block_t *block);
+
+/**
+ * Like `asdf_block_data` but with the access hint to apply to the mapping if neither the
+ * block nor the file has one set
+ */
+ASDF_LOCAL const void *asdf_block_data_hinted(
+    asdf_block_t *block, size_t *size, asdf_access_hint_t default_hint);
+
+/**
+ * Ask for ``size`` bytes of the block's data starting at ``addr`` to be read in ahead of use
+ *
+ * For memory-mapped data this only advises the kernel, and returns without waiting for the read;
+ * decompressed data is faulted in immediately.  Does nothing if the range is not within the
+ * block's (decompressed, if applicable) data.
+ */
+ASDF_LOCAL void asdf_block_prefetch(asdf_block_t *block, const void *addr, size_t size);
@@ -0,0 +1,450 @@
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "format.h"
+
+
+static const char digit_pairs[] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+
+size_t asdf_format_uint64(char *buf, uint64_t val) {
+    char tmp[20];
+    char *p = tmp + sizeof(tmp);
+
+    while (val >= 100) {
+        unsigned int idx = (unsigned int)(val % 100) * 2;
+        val /= 100;
+        *--p = digit_pairs[idx + 1];
+        *--p = digit_pairs[idx];
+    }
+
+    if (val >= 10) {
+        unsigned int idx = (unsigned int)val * 2;
+        *--p = digit_pairs[idx + 1];
+        *--p = digit_pairs[idx];
+    } else {
+        *--p = (char)('0' + val);
+    }
+
+    size_t len = (size_t)(tmp + sizeof(tmp) - p);
+    memcpy(buf, p, len);
+    return len;
+}
+
+
+size_t asdf_format_int64(char *buf, int64_t val) {
+    if (val < 0) {
+        buf[0] = '-';
+        return 1 + asdf_format_uint64(buf + 1, -(uint64_t)val);
+    }
+
+    return asdf_format_uint64(buf, (uint64_t)val);
+}
+
+
+/**
+ * Grisu2 shortest float formatting
+ *
+ * See Florian Loitsch, "Printing Floating-Point Numbers Quickly and Accurately with Integers"
+ * (PLDI 2010).  The produced digits always read back as the original value, and are the
+ * shortest such digits in all but a tiny fraction of cases, where one extra digit is written.
+ */
+
+/** A floating point number ``f * 2^e`` with a 64-bit significand */
+typedef struct {
+    uint64_t f;
+    int e;
+} diy_fp_t;
+
+
+/** Normalized powers of ten 10^-348, 10^-340, ..., 10^340 */
+#define CACHED_POWERS_MIN_EXP10 -348
+#define CACHED_POWERS_STEP 8
+
+static const diy_fp_t cached_powers[] = {
+    {UINT64_C(0xfa8fd5a0081c0288), -1220}, {UINT64_C(0xbaaee17fa23ebf76), -1193},
+    {UINT64_C(0x8b16fb203055ac76), -1166}, {UINT64_C(0xcf42894a5dce35ea), -1140},
+    {UINT64_C(0x9a6bb0aa55653b2d), -1113}, {UINT64_C(0xe61acf033d1a45df), -1087},
+    {UINT64_C(0xab70fe17c79ac6ca), -1060}, {UINT64_C(0xff77b1fcbebcdc4f), -1034},
+    {UINT64_C(0xbe5691ef416bd60c), -1007}, {UINT64_C(0x8dd01fad907ffc3c), -980},
+    {UINT64_C(0xd3515c2831559a83), -954}, {UINT64_C(0x9d71ac8fada6c9b5), -927},
+    {UINT64_C(0xea9c227723ee8bcb), -901}, {UINT64_C(0xaecc49914078536d), -874},
+    {UINT64_C(0x823c12795db6ce57), -847}, {UINT64_C(0xc21094364dfb5637), -821},
+    {UINT64_C(0x9096ea6f3848984f), -794}, {UINT64_C(0xd77485cb25823ac7), -768},
+    {UINT64_C(0xa086cfcd97bf97f4), -741}, {UINT64_C(0xef340a98172aace5), -715},
+    {UINT64_C(0xb23867fb2a35b28e), -688}, {UINT64_C(0x84c8d4dfd2c63f3b), -661},
+    {UINT64_C(0xc5dd44271ad3cdba), -635}, {UINT64_C(0x936b9fcebb25c996), -608},
+    {UINT64_C(0xdbac6c247d62a584), -582}, {UINT64_C(0xa3ab66580d5fdaf6), -555},
+    {UINT64_C(0xf3e2f893dec3f126), -529}, {UINT64_C(0xb5b5ada8aaff80b8), -502},
+    {UINT64_C(0x87625f056c7c4a8b), -475}, {UINT64_C(0xc9bcff6034c13053), -449},
+    {UINT64_C(0x964e858c91ba2655), -422}, {UINT64_C(0xdff9772470297ebd), -396},
+    {UINT64_C(0xa6dfbd9fb8e5b88f), -369}, {UINT64_C(0xf8a95fcf88747d94), -343},
+    {UINT64_C(0xb94470938fa89bcf), -316}, {UINT64_C(0x8a08f0f8bf0f156b), -289},
+    {UINT64_C(0xcdb02555653131b6), -263}, {UINT64_C(0x993fe2c6d07b7fac), -236},
+    {UINT64_C(0xe45c10c42a2b3b06), -210}, {UINT64_C(0xaa242499697392d3), -183},
+    {UINT64_C(0xfd87b5f28300ca0e), -157}, {UINT64_C(0xbce5086492111aeb), -130},
+    {UINT64_C(0x8cbccc096f5088cc), -103}, {UINT64_C(0xd1b71758e219652c), -77},
+    {UINT64_C(0x9c40000000000000), -50}, {UINT64_C(0xe8d4a51000000000), -24},
+    {UINT64_C(0xad78ebc5ac620000), 3}, {UINT64_C(0x813f3978f8940984), 30},
+    {UINT64_C(0xc097ce7bc90715b3), 56}, {UINT64_C(0x8f7e32ce7bea5c70), 83},
+    {UINT64_C(0xd5d238a4abe98068), 109}, {UINT64_C(0x9f4f2726179a2245), 136},
+    {UINT64_C(0xed63a231d4c4fb27), 162}, {UINT64_C(0xb0de65388cc8ada8), 189},
+    {UINT64_C(0x83c7088e1aab65db), 216}, {UINT64_C(0xc45d1df942711d9a), 242},
+    {UINT64_C(0x924d692ca61be758), 269}, {UINT64_C(0xda01ee641a708dea), 295},
+    {UINT64_C(0xa26da3999aef774a), 322}, {UINT64_C(0xf209787bb47d6b85), 348},
+    {UINT64_C(0xb454e4a179dd1877), 375}, {UINT64_C(0x865b86925b9bc5c2), 402},
+    {UINT64_C(0xc83553c5c8965d3d), 428}, {UINT64_C(0x952ab45cfa97a0b3), 455},
+    {UINT64_C(0xde469fbd99a05fe3), 481}, {UINT64_C(0xa59bc234db398c25), 508},
+    {UINT64_C(0xf6c69a72a3989f5c), 534}, {UINT64_C(0xb7dcbf5354e9bece), 561},
+    {UINT64_C(0x88fcf317f22241e2), 588}, {UINT64_C(0xcc20ce9bd35c78a5), 614},
+    {UINT64_C(0x98165af37b2153df), 641}, {UINT64_C(0xe2a0b5dc971f303a), 667},
+    {UINT64_C(0xa8d9d1535ce3b396), 694}, {UINT64_C(0xfb9b7cd9a4a7443c), 720},
+    {UINT64_C(0xbb764c4ca7a44410), 747}, {UINT64_C(0x8bab8eefb6409c1a), 774},
+    {UINT64_C(0xd01fef10a657842c), 800}, {UINT64_C(0x9b10a4e5e9913129), 827},
+    {UINT64_C(0xe7109bfba19c0c9d), 853}, {UINT64_C(0xac2820d9623bf429), 880},
+    {UINT64_C(0x80444b5e7aa7cf85), 907}, {UINT64_C(0xbf21e44003acdd2d), 933},
+    {UINT64_C(0x8e679c2f5e44ff8f), 960}, {UINT64_C(0xd433179d9c8cb841), 986},
+    {UINT64_C(0x9e19db92b4e31ba9), 1013}, {UINT64_C(0xeb96bf6ebadf77d9), 1039},
+    {UINT64_C(0xaf87023b9bf0ee6b), 1066},
+};
+
+
+static const uint64_t pow10_u64[] = {
+    UINT64_C(1),
+    UINT64_C(10),
+    UINT64_C(100),
+    UINT64_C(1000),
+    UINT64_C(10000),
+    UINT64_C(100000),
+    UINT64_C(1000000),
+    UINT64_C(10000000),
+    UINT64_C(100000000),
+    UINT64_C(1000000000),
+    UINT64_C(10000000000),
+    UINT64_C(100000000000),
+    UINT64_C(1000000000000),
+    UINT64_C(10000000000000),
+    UINT64_C(100000000000000),
+    UINT64_C(1000000000000000),
+    UINT64_C(10000000000000000),
+    UINT64_C(100000000000000000),
+    UINT64_C(1000000000000000000),
+    UINT64_C(10000000000000000000),
+};
+
+
+#define POW10_U64_COUNT ((int)(sizeof(pow10_u64) / sizeof(pow10_u64[0])))
+
+
+static diy_fp_t diy_fp_normalize(diy_fp_t x) {
+    while (!(x.f & (UINT64_C(1) << 63))) {
+        x.f <<= 1;
+        x.e--;
+    }
+
+    return x;
+}
+
+
+/** Multiply two numbers, keeping the (rounded) upper 64 bits of the product */
+static diy_fp_t diy_fp_mul(diy_fp_t x, diy_fp_t y) {
+    const uint64_t mask32 = UINT64_C(0xffffffff);
+    uint64_t a = x.f >> 32;
+    uint64_t b = x.f & mask32;
+    uint64_t c = y.f >> 32;
+    uint64_t d = y.f & mask32;
+    uint64_t ac = a * c;
+    uint64_t bc = b * c;
+    uint64_t ad = a * d;
+    uint64_t bd = b * d;
+    uint64_t tmp = (bd >> 32) + (ad & mask32) + (bc & mask32);
+    tmp += UINT64_C(1) << 31;
+    diy_fp_t res = {ac + (ad >> 32) + (bc >> 32) + (tmp >> 32), x.e + y.e + 64};
+    return res;
+}
+
+
+/**
+ * Return the cached power of ten ``c`` such that multiplying a normalized number with binary
+ * exponent ``e`` by it gives a binary exponent in the range [-60, -32]; ``*k`` receives the
+ * decimal exponent of ``1 / c``
+ */
+static diy_fp_t cached_power(int e, int *k) {
+    double dk = (-61 - e) * 0.30102999566398114 + 347;
+    int ik = (int)dk;
+
+    if (dk - ik > 0.0)
+        ik++;
+
+    unsigned int idx = (unsigned int)((ik >> 3) + 1);
+    *k = -(CACHED_POWERS_MIN_EXP10 + (int)(idx * CACHED_POWERS_STEP));
+    return cached_powers[idx];
+}
+
+
+static int count_decimal_digits32(uint32_t n) {
+    int digits = 1;
+
+    while (digits < 10 && n >= pow10_u64[digits])
+        digits++;
+
+    return digits;
+}
+
+
+static void grisu_round(
+    char *digits, int len, uint64_t delta, uint64_t rest, uint64_t ten_kappa, uint64_t wp_w) {
+    while (rest < wp_w && delta - rest >= ten_kappa &&
+           (rest + ten_kappa < wp_w || wp_w - rest > rest + ten_kappa - wp_w)) {
+        digits[len - 1]--;
+        rest += ten_kappa;
+    }
+}
+
+
+static void digit_gen(diy_fp_t w, diy_fp_t mp, uint64_t delta, char *digits, int *len, int *k) {
+    const int shift = -mp.e;
+    const uint64_t one = UINT64_C(1) << shift;
+    const uint64_t wp_w = mp.f - w.f;
+    uint32_t p1 = (uint32_t)(mp.f >> shift);
+    uint64_t p2 = mp.f & (one - 1);
+    int kappa = count_decimal_digits32(p1);
+    *len = 0;
+
+    while (kappa > 0) {
+        uint32_t div = (uint32_t)pow10_u64[kappa - 1];
+        uint32_t d = p1 / div;
+        p1 %= div;
+
+        if (d || *len)
+            digits[(*len)++] = (char)('0' + d);
+
+        kappa--;
+        uint64_t rest = ((uint64_t)p1 << shift) + p2;
+
+        if (rest <= delta) {
+            *k += kappa;
+            grisu_round(digits, *len, delta, rest, pow10_u64[kappa] << shift, wp_w);
+            return;
+        }
+    }
+
+    for (;;) {
+        p2 *= 10;
+        delta *= 10;
+        char d = (char)(p2 >> shift);
+
+        if (d || *len)
+            digits[(*len)++] = (char)('0' + d);
+
+        p2 &= one - 1;
+        kappa--;
+
+        if (p2 < delta) {
+            *k += kappa;
+            int idx = -kappa;
+            grisu_round(
+                digits, *len, delta, p2, one, wp_w * (idx < POW10_U64_COUNT ? pow10_u64[idx] : 0));
+            return;
+        }
+    }
+}
+
+
+/**
+ * Produce the digits of the positive number ``f * 2^e``, such that the number equals
+ * ``digits * 10^k``
+ *
+ * ``lower_closer`` is true when ``f`` is an exact power of two (other than the smallest normal
+ * number), in which case the next smaller number is closer than the next larger one.
+ */
+static void grisu2(uint64_t f, int e, bool lower_closer, char *digits, int *len, int *k) {
+    diy_fp_t v = {f, e};
+    diy_fp_t plus = diy_fp_normalize((diy_fp_t){(f << 1) + 1, e - 1});
+    diy_fp_t minus = lower_closer ? (diy_fp_t){(f << 2) - 1, e - 2}
+                                  : (diy_fp_t){(f << 1) - 1, e - 1};
+    minus.f <<= minus.e - plus.e;
+    minus.e = plus.e;
+
+    diy_fp_t c_mk = cached_power(plus.e, k);
+    diy_fp_t w = diy_fp_mul(diy_fp_normalize(v), c_mk);
+    diy_fp_t wp = diy_fp_mul(plus, c_mk);
+    diy_fp_t wm = diy_fp_mul(minus, c_mk);
+    wm.f++;
+    wp.f--;
+    digit_gen(w, wp, wp.f - wm.f, digits, len, k);
+}
+
+
+/**
+ * Lay out ``digits * 10^k`` like ``printf("%.<precision>g")`` would, but with only the given
+ * digits
+ */
+static size_t format_digits(char *buf, const char *digits, int len, int k, int precision) {
+    int exp10 = len + k - 1;
+    char *p = buf;
+
+    if (exp10 >= -4 && exp10 < precision) {
+        if (k >= 0) {
+            /* Integer: digits followed by zeros */
+            memcpy(p, digits, len);
+            p += len;
+            memset(p, '0', k);
+            p += k;
+        } else if (exp10 >= 0) {
+            /* Decimal point within the digits */
+            memcpy(p, digits, exp10 + 1);
+            p += exp10 + 1;
+            *p++ = '.';
+            memcpy(p, digits + exp10 + 1, len - exp10 - 1);
+            p += len - exp10 - 1;
+        } else {
+            /* Leading zeros after the decimal point */
+            *p++ = '0';
+            *p++ = '.';
+            memset(p, '0', -exp10 - 1);
+            p += -exp10 - 1;
+            memcpy(p, digits, len);
+            p += len;
+        }
+
+        return (size_t)(p - buf);
+    }
+
+    *p++ = digits[0];
+
+    if (len > 1) {
+        *p++ = '.';
+        memcpy(p, digits + 1, len - 1);
+        p += len - 1;
+    }
+
+    *p++ = 'e';
+
+    if (exp10 < 0) {
+        *p++ = '-';
+        exp10 = -exp10;
+    } else {
+        *p++ = '+';
+    }
+
+    if (exp10 < 10)
+        *p++ = '0';
+
+    p += asdf_format_uint64(p, (uint64_t)exp10);
+    return (size_t)(p - buf);
+}
+
+
+/** Common handling of the sign and special values; returns 0 if ``val`` is a finite non-zero */
+static size_t format_special(char *buf, double val, bool *negative) {
+    *negative = signbit(val);
+
+    if (isnan(val)) {
+        memcpy(buf, ".nan", 4);
+        return 4;
+    }
+
+    if (isinf(val)) {
+        if (*negative) {
+            memcpy(buf, "-.inf", 5);
+            return 5;
+        }
+
+        memcpy(buf, ".inf", 4);
+        return 4;
+    }
+
+    if (val == 0.0) {
+        if (*negative) {
+            memcpy(buf, "-0", 2);
+            return 2;
+        }
+
+        buf[0] = '0';
+        return 1;
+    }
+
+    return 0;
+}
+
+
+#define DOUBLE_SIGNIFICAND_BITS 52
+#define DOUBLE_EXPONENT_BIAS 1075
+#define DOUBLE_PRECISION 17
+#define FLOAT_SIGNIFICAND_BITS 23
+#define FLOAT_EXPONENT_BIAS 150
+#define FLOAT_PRECISION 9
+
+
+size_t asdf_format_double(char *buf, double val) {
+    bool negative = false;
+    size_t len = format_special(buf, val, &negative);
+
+    if (len > 0)
+        return len;
+
+    uint64_t bits = 0;
+    memcpy(&bits, &val, sizeof(bits));
+    int biased_e = (int)((bits >> DOUBLE_SIGNIFICAND_BITS) & 0x7ff);
+    uint64_t significand = bits & ((UINT64_C(1) << DOUBLE_SIGNIFICAND_BITS) - 1);
+    uint64_t f = significand;
+    int e = 1 - DOUBLE_EXPONENT_BIAS;
+
+    if (biased_e != 0) {
+        f |= UINT64_C(1) << DOUBLE_SIGNIFICAND_BITS;
+        e = biased_e - DOUBLE_EXPONENT_BIAS;
+    }
+
+    char digits[ASDF_FORMAT_NUMBER_MAX];
+    int n_digits = 0;
+    int k = 0;
+    grisu2(f, e, significand == 0 && biased_e > 1, digits, &n_digits, &k);
+
+    char *p = buf;
+
+    if (negative)
+        *p++ = '-';
+
+    return (size_t)(p - buf) + format_digits(p, digits, n_digits, k, DOUBLE_PRECISION);
+}
+
+
+size_t asdf_format_float(char *buf, float val) {
+    bool negative = false;
+    size_t len = format_special(buf, (double)val, &negative);
+
+    if (len > 0)
+        return len;
+
+    uint32_t bits = 0;
+    memcpy(&bits, &val, sizeof(bits));
+    int biased_e = (int)((bits >> FLOAT_SIGNIFICAND_BITS) & 0xff);
+    uint32_t significand = bits & ((UINT32_C(1) << FLOAT_SIGNIFICAND_BITS) - 1);
+    uint64_t f = significand;
+    int e = 1 - FLOAT_EXPONENT_BIAS;
+
+    if (biased_e != 0) {
+        f |= UINT64_C(1) << FLOAT_SIGNIFICAND_BITS;
+        e = biased_e - FLOAT_EXPONENT_BIAS;
+    }
+
+    char digits[ASDF_FORMAT_NUMBER_MAX];
+    int n_digits = 0;
+    int k = 0;
+    grisu2(f, e, significand == 0 && biased_e > 1, digits, &n_digits, &k);
+
+    char *p = buf;
+
+    if (negative)
+        *p++ = '-';
+
+    return (size_t)(p - buf) + format_digits(p, digits, n_digits, k, FLOAT_PRECISION);
+}
@@ -0,0 +1,49 @@
+/**
+ * Fast formatting of numbers as YAML scalars
+ *
+ * Used when writing large numbers of values at once (e.g. inline ndarray data), where going
+ * through printf for each value dominates the cost of emitting them.  Floating point values are
+ * written with the fewest digits that still read back as exactly the same value, using the
+ * Grisu2 algorithm.
+ */
+#pragma once
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "util.h"
+
+
+/** Size of a buffer large enough for any number written by the ``asdf_format_*`` functions */
+#define ASDF_FORMAT_NUMBER_MAX 32
+
+
+/**
+ * Write the decimal representation of an integer to ``buf``
+ *
+ * The output is not null-terminated.
+ *
+ * :return: The number of characters written
+ */
+ASDF_LOCAL size_t asdf_format_int64(char *buf, int64_t val);
+ASDF_LOCAL size_t asdf_format_uint64(char *buf, uint64_t val);
+
+/**
+ * Write the shortest decimal representation of a double that reads back as the same value
+ *
+ * Numbers are written like ``printf("%.17g")`` would write them, but without any superfluous
+ * trailing digits; e.g. ``0.1`` rather than ``0.10000000000000001``.  NaN and infinities are
+ * written as the YAML ``.nan``, ``.inf`` and ``-.inf``.  The output is not null-terminated.
+ *
+ * :return: The number of characters written
+ */
+ASDF_LOCAL size_t asdf_format_double(char *buf, double val);
+
+/**
+ * Like `asdf_format_double` but with just enough digits to read back as the same float
+ */
+ASDF_LOCAL size_t asdf_format_float(char *buf, float val);
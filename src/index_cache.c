@@ -0,0 +1,559 @@
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <inttypes.h>
+#include <limits.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "block.h"
+#include "file.h"
+#include "index_cache.h"
+#include "log.h"
+#include "parser.h"
+#include "stream.h"
+#include "types/asdf_block_index.h"
+#include "types/asdf_block_info_vec.h"
+#include "util.h"
+
+
+#ifdef __APPLE__
+#define STAT_MTIME_NSEC(st) ((st).st_mtimespec.tv_nsec)
+#else
+#define STAT_MTIME_NSEC(st) ((st).st_mtim.tv_nsec)
+#endif
+
+
+/** Used to detect caches written on a machine with different byte order */
+#define ASDF_INDEX_CACHE_BYTE_ORDER_MARK 0x01020304U
+
+
+/** Size of each block record in the cache file */
+#define ASDF_INDEX_CACHE_BLOCK_RECORD_SIZE \
+    (2 * sizeof(int64_t) + sizeof(uint16_t) + sizeof(uint32_t) + \
+     ASDF_BLOCK_COMPRESSION_FIELD_SIZE + 3 * sizeof(uint64_t) + ASDF_BLOCK_CHECKSUM_FIELD_SIZE)
+
+
+/**
+ * Cursor for (de)serializing the cache file contents
+ *
+ * All values are stored with their native size and byte order; the cache is only meant to be
+ * read back on the same machine.
+ */
+typedef struct {
+    uint8_t *buf;
+    size_t size;
+    size_t pos;
+} cache_buf_t;
+
+
+static void cache_put(cache_buf_t *cbuf, const void *data, size_t size) {
+    assert(cbuf->size - cbuf->pos >= size);
+    memcpy(cbuf->buf + cbuf->pos, data, size);
+    cbuf->pos += size;
+}
+
+
+static bool cache_get(cache_buf_t *cbuf, void *data, size_t size) {
+    if (cbuf->size - cbuf->pos < size)
+        return false;
+
+    memcpy(data, cbuf->buf + cbuf->pos, size);
+    cbuf->pos += size;
+    return true;
+}
+
+
+#define CACHE_PUT(cbuf, value) cache_put((cbuf), &(value), sizeof(value))
+#define CACHE_GET(cbuf, value) cache_get((cbuf), &(value), sizeof(value))
+
+
+/** 64-bit FNV-1a hash, used to name cache files in the user cache directory */
+static uint64_t index_cache_hash(const char *str) {
+    uint64_t hash = 0xcbf29ce484222325ULL;
+
+    for (const unsigned char *ch = (const unsigned char *)str; *ch; ch++) {
+        hash ^= *ch;
+        hash *= 0x100000001b3ULL;
+    }
+
+    return hash;
+}
+
+
+/** Create a directory and any missing parents, like ``mkdir -p`` */
+static int index_cache_mkdirs(const char *dir) {
+    char path[PATH_MAX];
+    size_t len = strlen(dir);
+
+    if (len == 0 || len >= sizeof(path))
+        return -1;
+
+    memcpy(path, dir, len + 1);
+
+    for (char *sep = strchr(path + 1, '/'); sep; sep = strchr(sep + 1, '/')) {
+        *sep = '\0';
+
+        if (mkdir(path, 0777) != 0 && errno != EEXIST)
+            return -1;
+
+        *sep = '/';
+    }
+
+    if (mkdir(path, 0777) != 0 && errno != EEXIST)
+        return -1;
+
+    return 0;
+}
+
+
+static char *index_cache_user_path(asdf_file_t *file, const char *source) {
+    const char *cache_dir = file->config->io.index_cache_dir;
+    char *dir = NULL;
+    char *path = NULL;
+
+    if (cache_dir && cache_dir[0]) {
+        dir = strdup(cache_dir);
+    } else {
+        const char *xdg_cache_home = getenv("XDG_CACHE_HOME");
+        const char *home = getenv("HOME");
+        int ret = -1;
+
+        // Per the XDG base directory spec relative paths are invalid and should be ignored
+        if (xdg_cache_home && xdg_cache_home[0] == '/')
+            ret = asprintf(&dir, "%s/%s", xdg_cache_home, ASDF_INDEX_CACHE_USER_SUBDIR);
+        else if (home && home[0])
+            ret = asprintf(&dir, "%s/.cache/%s", home, ASDF_INDEX_CACHE_USER_SUBDIR);
+
+        if (ret == -1)
+            dir = NULL;
+    }
+
+    if (!dir) {
+        ASDF_LOG(file, ASDF_LOG_DEBUG, "could not determine the block index cache directory");
+        return NULL;
+    }
+
+    if (asprintf(&path, "%s/%016" PRIx64 ".index", dir, index_cache_hash(source)) == -1)
+        path = NULL;
+
+    free(dir);
+    return path;
+}
+
+
+asdf_index_cache_t *asdf_index_cache_open(asdf_file_t *file, const char *filename) {
+    asdf_index_cache_mode_t mode = file->config->io.index_cache;
+
+    if (mode == ASDF_INDEX_CACHE_NONE)
+        return NULL;
+
+    // Validate against the descriptor the file was actually opened with, so that the cache
+    // describes that file even if the path is replaced in the meantime
+    int fd = asdf_stream_fd(file->stream);
+    struct stat st;
+
+    if (fd < 0 || fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        ASDF_LOG(
+            file,
+            ASDF_LOG_DEBUG,
+            "%s is not a regular file; the block index cache will not be used",
+            filename);
+        return NULL;
+    }
+
+    char *source = realpath(filename, NULL);
+    char *path = NULL;
+
+    if (!source)
+        return NULL;
+
+    switch (mode) {
+    case ASDF_INDEX_CACHE_SIDECAR:
+        if (asprintf(&path, "%s%s", source, ASDF_INDEX_CACHE_SIDECAR_SUFFIX) == -1)
+            path = NULL;
+        break;
+    case ASDF_INDEX_CACHE_USER:
+        path = index_cache_user_path(file, source);
+        break;
+    default:
+        ASDF_LOG(
+            file,
+            ASDF_LOG_WARN,
+            "invalid config value for io.index_cache (%d); the block index cache will not be "
+            "used",
+            mode);
+        break;
+    }
+
+    if (!path) {
+        free(source);
+        return NULL;
+    }
+
+    asdf_index_cache_t *cache = calloc(1, sizeof(asdf_index_cache_t));
+
+    if (!cache) {
+        free(path);
+        free(source);
+        return NULL;
+    }
+
+    cache->path = path;
+    cache->source = source;
+    cache->dev = (uint64_t)st.st_dev;
+    cache->ino = (uint64_t)st.st_ino;
+    cache->size = (uint64_t)st.st_size;
+    cache->mtime_sec = (int64_t)st.st_mtime;
+    cache->mtime_nsec = (int64_t)STAT_MTIME_NSEC(st);
+    return cache;
+}
+
+
+/** Read the full contents of the cache file, if it exists */
+static uint8_t *index_cache_read(const char *path, size_t *size_out) {
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0)
+        return NULL;
+
+    struct stat st;
+    uint8_t *buf = NULL;
+
+    if (fstat(fd, &st) != 0 || st.st_size <= 0)
+        goto cleanup;
+
+    size_t size = (size_t)st.st_size;
+    buf = malloc(size);
+
+    if (!buf)
+        goto cleanup;
+
+    size_t nread = 0;
+
+    while (nread < size) {
+        ssize_t ret = read(fd, buf + nread, size - nread);
+
+        if (ret < 0 && errno == EINTR)
+            continue;
+
+        if (ret <= 0) {
+            free(buf);
+            buf = NULL;
+            goto cleanup;
+        }
+
+        nread += (size_t)ret;
+    }
+
+    *size_out = size;
+cleanup:
+    close(fd);
+    return buf;
+}
+
+
+/** Check that the cache header matches the file as it was opened */
+static bool index_cache_check_header(asdf_index_cache_t *cache, cache_buf_t *cbuf) {
+    char magic[ASDF_INDEX_CACHE_MAGIC_SIZE];
+    uint32_t version = 0;
+    uint32_t bom = 0;
+    uint64_t dev = 0;
+    uint64_t ino = 0;
+    uint64_t size = 0;
+    int64_t mtime_sec = 0;
+    int64_t mtime_nsec = 0;
+    uint64_t source_len = 0;
+
+    if (!CACHE_GET(cbuf, magic) || memcmp(magic, ASDF_INDEX_CACHE_MAGIC, sizeof(magic)) != 0)
+        return false;
+
+    if (!CACHE_GET(cbuf, version) || version != ASDF_INDEX_CACHE_VERSION)
+        return false;
+
+    if (!CACHE_GET(cbuf, bom) || bom != ASDF_INDEX_CACHE_BYTE_ORDER_MARK)
+        return false;
+
+    if (!CACHE_GET(cbuf, dev) || !CACHE_GET(cbuf, ino) || !CACHE_GET(cbuf, size) ||
+        !CACHE_GET(cbuf, mtime_sec) || !CACHE_GET(cbuf, mtime_nsec))
+        return false;
+
+    if (dev != cache->dev || ino != cache->ino || size != cache->size ||
+        mtime_sec != cache->mtime_sec || mtime_nsec != cache->mtime_nsec)
+        return false;
+
+    if (!CACHE_GET(cbuf, source_len) || source_len != strlen(cache->source) ||
+        cbuf->size - cbuf->pos < source_len)
+        return false;
+
+    if (memcmp(cbuf->buf + cbuf->pos, cache->source, source_len) != 0)
+        return false;
+
+    cbuf->pos += source_len;
+    return true;
+}
+
+
+static bool index_cache_get_block(cache_buf_t *cbuf, asdf_block_info_t *block_info) {
+    asdf_block_header_t *header = &block_info->header;
+    int64_t header_pos = 0;
+    int64_t data_pos = 0;
+
+    if (!CACHE_GET(cbuf, header_pos) || !CACHE_GET(cbuf, data_pos))
+        return false;
+
+    block_info->header_pos = (off_t)header_pos;
+    block_info->data_pos = (off_t)data_pos;
+    return CACHE_GET(cbuf, header->header_size) && CACHE_GET(cbuf, header->flags) &&
+           CACHE_GET(cbuf, header->compression) && CACHE_GET(cbuf, header->allocated_size) &&
+           CACHE_GET(cbuf, header->used_size) && CACHE_GET(cbuf, header->data_size) &&
+           CACHE_GET(cbuf, header->checksum);
+}
+
+
+static void index_cache_put_block(cache_buf_t *cbuf, const asdf_block_info_t *block_info) {
+    const asdf_block_header_t *header = &block_info->header;
+    int64_t header_pos = (int64_t)block_info->header_pos;
+    int64_t data_pos = (int64_t)block_info->data_pos;
+    CACHE_PUT(cbuf, header_pos);
+    CACHE_PUT(cbuf, data_pos);
+    CACHE_PUT(cbuf, header->header_size);
+    CACHE_PUT(cbuf, header->flags);
+    CACHE_PUT(cbuf, header->compression);
+    CACHE_PUT(cbuf, header->allocated_size);
+    CACHE_PUT(cbuf, header->used_size);
+    CACHE_PUT(cbuf, header->data_size);
+    CACHE_PUT(cbuf, header->checksum);
+}
+
+
+/**
+ * Read the block records from the cache onto the parser
+ *
+ * The records are sanity checked against each other and the file size, but not against the
+ * file contents; that the file is unmodified is taken from the cache key.
+ */
+static bool index_cache_load_blocks(
+    asdf_index_cache_t *cache, cache_buf_t *cbuf, asdf_parser_t *parser, uint64_t n_blocks) {
+    if (n_blocks > PTRDIFF_MAX ||
+        (cbuf->size - cbuf->pos) / ASDF_INDEX_CACHE_BLOCK_RECORD_SIZE < n_blocks)
+        return false;
+
+    asdf_block_index_t *block_index = &parser->block.index;
+    asdf_block_info_vec_t *block_infos = &parser->block.infos;
+
+    if (!asdf_block_index_reserve(block_index, (isize)n_blocks) ||
+        !asdf_block_info_vec_reserve(block_infos, (isize)n_blocks))
+        return false;
+
+    off_t prev_end = 0;
+
+    for (uint64_t idx = 0; idx < n_blocks; idx++) {
+        asdf_block_info_t block_info = {.index = (size_t)idx};
+
+        if (!index_cache_get_block(cbuf, &block_info))
+            return false;
+
+        const asdf_block_header_t *header = &block_info.header;
+        bool streamed = header->flags & ASDF_BLOCK_FLAG_STREAMED;
+
+        if (block_info.header_pos < prev_end || block_info.data_pos <= block_info.header_pos ||
+            header->allocated_size > cache->size ||
+            (uint64_t)block_info.data_pos > cache->size - header->allocated_size ||
+            (streamed && idx != n_blocks - 1))
+            return false;
+
+        prev_end = block_info.data_pos + (off_t)header->allocated_size;
+        asdf_block_index_push(block_index, (isize)block_info.header_pos);
+        asdf_block_info_vec_push(block_infos, block_info);
+    }
+
+    return true;
+}
+
+
+bool asdf_index_cache_load(asdf_index_cache_t *cache, asdf_file_t *file) {
+    asdf_parser_t *parser = file->parser;
+
+    if (!cache || !parser)
+        return false;
+
+    assert(asdf_block_info_vec_size(&parser->block.infos) == 0);
+    assert(asdf_block_index_size(&parser->block.index) == 0);
+
+    size_t size = 0;
+    uint8_t *buf = index_cache_read(cache->path, &size);
+
+    if (!buf)
+        return false;
+
+    cache_buf_t cbuf = {.buf = buf, .size = size, .pos = 0};
+    int64_t has_tree = 0;
+    int64_t tree_start = 0;
+    int64_t tree_end = 0;
+    uint64_t n_blocks = 0;
+    bool valid = index_cache_check_header(cache, &cbuf) && CACHE_GET(&cbuf, has_tree) &&
+                 CACHE_GET(&cbuf, tree_start) && CACHE_GET(&cbuf, tree_end) &&
+                 CACHE_GET(&cbuf, n_blocks);
+
+    if (valid)
+        valid = index_cache_load_blocks(cache, &cbuf, parser, n_blocks);
+
+    free(buf);
+
+    if (!valid) {
+        ASDF_LOG(
+            file,
+            ASDF_LOG_DEBUG,
+            "block index cache %s is stale or invalid and will be ignored",
+            cache->path);
+        asdf_block_index_clear(&parser->block.index);
+        asdf_block_info_vec_clear(&parser->block.infos);
+        return false;
+    }
+
+    // From here the parser uses the cached blocks as if they were from a validated block index
+    parser->block.count = (size_t)n_blocks;
+    parser->block.has_index = true;
+
+    if (has_tree > 0 && tree_start > 0 && tree_end > tree_start &&
+        (uint64_t)tree_end <= cache->size) {
+        parser->tree.known_start = (off_t)tree_start;
+        parser->tree.known_end = (off_t)tree_end;
+    }
+
+    cache->loaded = true;
+    ASDF_LOG(file, ASDF_LOG_DEBUG, "loaded %" PRIu64 " blocks from %s", n_blocks, cache->path);
+    return true;
+}
+
+
+/** Write the cache file atomically, by way of a temporary file in the same directory */
+static bool index_cache_write(asdf_index_cache_t *cache, const uint8_t *buf, size_t size) {
+    char *tmp_path = NULL;
+
+    if (asprintf(&tmp_path, "%s.XXXXXX", cache->path) == -1)
+        return false;
+
+    int fd = mkstemp(tmp_path);
+
+    if (fd < 0) {
+        free(tmp_path);
+        return false;
+    }
+
+    bool ok = fchmod(fd, 0644) == 0;
+    size_t nwritten = 0;
+
+    while (ok && nwritten < size) {
+        ssize_t ret = write(fd, buf + nwritten, size - nwritten);
+
+        if (ret < 0 && errno == EINTR)
+            continue;
+
+        ok = ret > 0;
+
+        if (ok)
+            nwritten += (size_t)ret;
+    }
+
+    ok = (close(fd) == 0) && ok;
+    ok = ok && rename(tmp_path, cache->path) == 0;
+
+    if (!ok)
+        unlink(tmp_path);
+
+    free(tmp_path);
+    return ok;
+}
+
+
+bool asdf_index_cache_save(asdf_index_cache_t *cache, asdf_file_t *file) {
+    asdf_parser_t *parser = file->parser;
+
+    if (!cache || cache->loaded || !parser)
+        return false;
+
+    // Only a complete, successful parse gives the full layout; files with a valid block index
+    // of their own can already be opened without scanning
+    if (parser->state != ASDF_PARSER_STATE_END || parser->block.has_index)
+        return false;
+
+    const asdf_block_info_vec_t *block_infos = &parser->block.infos;
+    uint64_t n_blocks = (uint64_t)asdf_block_info_vec_size(block_infos);
+
+    if (n_blocks == 0)
+        return false;
+
+    uint64_t source_len = strlen(cache->source);
+    size_t size = ASDF_INDEX_CACHE_MAGIC_SIZE + 2 * sizeof(uint32_t) + 3 * sizeof(uint64_t) +
+                  2 * sizeof(int64_t) + sizeof(uint64_t) + source_len + 3 * sizeof(int64_t) +
+                  sizeof(uint64_t) + n_blocks * ASDF_INDEX_CACHE_BLOCK_RECORD_SIZE;
+    uint8_t *buf = malloc(size);
+
+    if (!buf)
+        return false;
+
+    cache_buf_t cbuf = {.buf = buf, .size = size, .pos = 0};
+    uint32_t version = ASDF_INDEX_CACHE_VERSION;
+    uint32_t bom = ASDF_INDEX_CACHE_BYTE_ORDER_MARK;
+    int64_t has_tree = parser->tree.has_tree;
+    int64_t tree_start = (int64_t)parser->tree.start;
+    int64_t tree_end = (int64_t)parser->tree.end;
+    cache_put(&cbuf, ASDF_INDEX_CACHE_MAGIC, ASDF_INDEX_CACHE_MAGIC_SIZE);
+    CACHE_PUT(&cbuf, version);
+    CACHE_PUT(&cbuf, bom);
+    CACHE_PUT(&cbuf, cache->dev);
+    CACHE_PUT(&cbuf, cache->ino);
+    CACHE_PUT(&cbuf, cache->size);
+    CACHE_PUT(&cbuf, cache->mtime_sec);
+    CACHE_PUT(&cbuf, cache->mtime_nsec);
+    CACHE_PUT(&cbuf, source_len);
+    cache_put(&cbuf, cache->source, source_len);
+    CACHE_PUT(&cbuf, has_tree);
+    CACHE_PUT(&cbuf, tree_start);
+    CACHE_PUT(&cbuf, tree_end);
+    CACHE_PUT(&cbuf, n_blocks);
+
+    for (isize idx = 0; idx < (isize)n_blocks; idx++)
+        index_cache_put_block(&cbuf, asdf_block_info_vec_at(block_infos, idx));
+
+    assert(cbuf.pos == size);
+
+    bool ok = true;
+
+    if (file->config->io.index_cache == ASDF_INDEX_CACHE_USER) {
+        char *sep = strrchr(cache->path, '/');
+        *sep = '\0';
+        ok = index_cache_mkdirs(cache->path) == 0;
+        *sep = '/';
+    }
+
+    ok = ok && index_cache_write(cache, buf, size);
+    free(buf);
+
+    if (!ok) {
+        // Commonly the directory is simply not writeable, which is not worth a warning
+        ASDF_LOG(
+            file, ASDF_LOG_DEBUG, "failed to write the block index cache to %s", cache->path);
+        return false;
+    }
+
+    ASDF_LOG(file, ASDF_LOG_DEBUG, "saved %" PRIu64 " blocks to %s", n_blocks, cache->path);
+    return true;
+}
+
+
+void asdf_index_cache_close(asdf_index_cache_t *cache) {
+    if (!cache)
+        return;
+
+    free(cache->path);
+    free(cache->source);
+    free(cache);
+}
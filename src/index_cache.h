@@ -0,0 +1,79 @@
+/**
+ * Persistent block index cache
+ *
+ * Saves the layout of a file (the extent of its YAML tree and the positions and headers of
+ * its blocks) after it has been parsed in full, so that later opens of the same unmodified file
+ * can skip scanning for its blocks.  This is mostly useful for files written without a block
+ * index; see `asdf_index_cache_mode_t`.
+ */
+#pragma once
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+#include "util.h"
+
+
+/** Suffix appended to the filename for ``ASDF_INDEX_CACHE_SIDECAR`` caches */
+#define ASDF_INDEX_CACHE_SIDECAR_SUFFIX ".index"
+
+/** Subdirectory of the user's cache directory used by ``ASDF_INDEX_CACHE_USER`` */
+#define ASDF_INDEX_CACHE_USER_SUBDIR "libasdf/index"
+
+#define ASDF_INDEX_CACHE_MAGIC "ASDFIDX\n"
+#define ASDF_INDEX_CACHE_MAGIC_SIZE 8
+#define ASDF_INDEX_CACHE_VERSION 1
+
+
+// Forward-declarations
+typedef struct asdf_file asdf_file_t;
+
+
+typedef struct asdf_index_cache {
+    /** Path to the cache file */
+    char *path;
+    /** Canonical path to the ASDF file, as stored in the cache */
+    char *source;
+    /** Identity of the ASDF file when it was opened; any change invalidates the cache */
+    uint64_t dev;
+    uint64_t ino;
+    uint64_t size;
+    int64_t mtime_sec;
+    int64_t mtime_nsec;
+    /** Whether the file's layout was loaded from the cache (so there is no need to save it) */
+    bool loaded;
+} asdf_index_cache_t;
+
+
+/**
+ * Set up the block index cache for a file opened by ``filename`` according to its config
+ *
+ * Must be called after ``file->stream`` is opened; the cache is keyed on the resolved
+ * ``filename`` but validated against the stream's open file descriptor.
+ *
+ * Returns NULL if the cache is disabled or cannot be used for this file; this is never an
+ * error, the file is simply parsed without the cache.
+ */
+ASDF_LOCAL asdf_index_cache_t *asdf_index_cache_open(asdf_file_t *file, const char *filename);
+
+/**
+ * Pre-load the file's parser with the layout saved in the cache, if there is a valid entry
+ *
+ * Should be called on a freshly created parser before it has produced any events.
+ */
+ASDF_LOCAL bool asdf_index_cache_load(asdf_index_cache_t *cache, asdf_file_t *file);
+
+/**
+ * Save the layout of the file to the cache once its parser has completed
+ *
+ * Does nothing if the layout was itself loaded from the cache, or if the file has a valid block
+ * index of its own (in which case the cache would not help).
+ */
+ASDF_LOCAL bool asdf_index_cache_save(asdf_index_cache_t *cache, asdf_file_t *file);
+
+ASDF_LOCAL void asdf_index_cache_close(asdf_index_cache_t *cache);
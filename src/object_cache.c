@@ -0,0 +1,198 @@
+#include <pthread.h>
+#include <stdlib.h>
+
+#include "file.h"
+#include "log.h"
+#include "object_cache.h"
+#include "types/asdf_object_map.h"
+#include "util.h"
+
+
+/**
+ * Map of every cached object to its reference, used to find the reference again when an
+ * object is destroyed
+ *
+ * Objects may be destroyed from any thread, so this and the files' ``object_cache`` maps are
+ * only accessed while holding ``object_registry_lock``.
+ */
+static asdf_object_map_t object_registry = {0};
+static pthread_mutex_t object_registry_lock = PTHREAD_MUTEX_INITIALIZER;
+
+
+ASDF_DESTRUCTOR static void asdf_object_registry_destroy(void) {
+    pthread_mutex_lock(&object_registry_lock);
+    for (asdf_object_map_iter_t it = asdf_object_map_begin(&object_registry); it.ref;
+         asdf_object_map_next(&it))
+        free(it.ref->second);
+
+    asdf_object_map_drop(&object_registry);
+    pthread_mutex_unlock(&object_registry_lock);
+}
+
+
+void *asdf_object_cache_get(
+    asdf_file_t *file, struct fy_node *node, const asdf_extension_t *ext) {
+    void *object = NULL;
+
+    if (UNLIKELY(!file || !node))
+        return NULL;
+
+    pthread_mutex_lock(&object_registry_lock);
+    const asdf_object_map_value *cached = asdf_object_map_get(&file->object_cache, node);
+
+    if (cached && cached->second->ext == ext) {
+        cached->second->refcount++;
+        object = cached->second->object;
+    }
+
+    pthread_mutex_unlock(&object_registry_lock);
+    return object;
+}
+
+
+void asdf_object_cache_add(
+    asdf_file_t *file, struct fy_node *node, const asdf_extension_t *ext, void *object) {
+    if (UNLIKELY(!file || !node || !object))
+        return;
+
+    asdf_object_ref_t *ref = malloc(sizeof(asdf_object_ref_t));
+
+    if (UNLIKELY(!ref))
+        return;
+
+    ref->file = file;
+    ref->node = node;
+    ref->ext = ext;
+    ref->object = object;
+    // One reference for the caller and one for the file
+    ref->refcount = 2;
+    ref->borrowed = false;
+
+    pthread_mutex_lock(&object_registry_lock);
+
+    if (asdf_object_map_contains(&file->object_cache, node) ||
+        asdf_object_map_contains(&object_registry, object)) {
+        pthread_mutex_unlock(&object_registry_lock);
+        free(ref);
+        return;
+    }
+
+    asdf_object_map_insert(&file->object_cache, node, ref);
+    asdf_object_map_insert(&object_registry, object, ref);
+    pthread_mutex_unlock(&object_registry_lock);
+}
+
+
+void *asdf_object_retain(const asdf_extension_t *ext, void *object, bool borrowed) {
+    if (UNLIKELY(!ext || !object))
+        return NULL;
+
+    pthread_mutex_lock(&object_registry_lock);
+    const asdf_object_map_value *cached = asdf_object_map_get(&object_registry, object);
+
+    if (cached) {
+        cached->second->refcount++;
+        pthread_mutex_unlock(&object_registry_lock);
+        return object;
+    }
+
+    asdf_object_ref_t *ref = malloc(sizeof(asdf_object_ref_t));
+
+    if (UNLIKELY(!ref)) {
+        pthread_mutex_unlock(&object_registry_lock);
+        return NULL;
+    }
+
+    ref->file = NULL;
+    ref->node = NULL;
+    ref->ext = ext;
+    ref->object = object;
+    ref->refcount = 1;
+    ref->borrowed = borrowed;
+    asdf_object_map_insert(&object_registry, object, ref);
+    pthread_mutex_unlock(&object_registry_lock);
+    return object;
+}
+
+
+/** Drop one reference; returns true if it was the last one (must hold the lock) */
+static bool asdf_object_ref_release(asdf_object_ref_t *ref) {
+    if (--ref->refcount > 0)
+        return false;
+
+    if (ref->file)
+        asdf_object_map_erase(&ref->file->object_cache, ref->node);
+
+    asdf_object_map_erase(&object_registry, ref->object);
+    return true;
+}
+
+
+static void asdf_object_dealloc(const asdf_extension_t *ext, void *object) {
+    if (ext->dealloc)
+        ext->dealloc(object);
+}
+
+
+void asdf_object_cache_clear(asdf_file_t *file) {
+    if (!file)
+        return;
+
+    pthread_mutex_lock(&object_registry_lock);
+    size_t n_refs = asdf_object_map_size(&file->object_cache);
+
+    if (n_refs == 0) {
+        pthread_mutex_unlock(&object_registry_lock);
+        return;
+    }
+
+    // Collect the objects freed here to deallocate them outside the lock, since deallocating an
+    // object may destroy other cached objects it holds
+    asdf_object_ref_t **freed = malloc(n_refs * sizeof(asdf_object_ref_t *));
+    size_t n_freed = 0;
+
+    for (asdf_object_map_iter_t it = asdf_object_map_begin(&file->object_cache); it.ref;
+         asdf_object_map_next(&it)) {
+        asdf_object_ref_t *ref = it.ref->second;
+        ref->file = NULL;
+
+        if (LIKELY(freed) && --ref->refcount == 0) {
+            asdf_object_map_erase(&object_registry, ref->object);
+            freed[n_freed++] = ref;
+        }
+    }
+
+    asdf_object_map_clear(&file->object_cache);
+    pthread_mutex_unlock(&object_registry_lock);
+
+    if (UNLIKELY(!freed))
+        ASDF_LOG(file, ASDF_LOG_WARN, "out of memory releasing cached objects; leaking them");
+
+    for (size_t idx = 0; idx < n_freed; idx++) {
+        asdf_object_dealloc(freed[idx]->ext, freed[idx]->object);
+        free(freed[idx]);
+    }
+
+    free((void *)freed);
+}
+
+
+void asdf_extension_object_destroy(const asdf_extension_t *ext, void *object) {
+    if (!ext || !object)
+        return;
+
+    pthread_mutex_lock(&object_registry_lock);
+    const asdf_object_map_value *cached = asdf_object_map_get(&object_registry, object);
+    asdf_object_ref_t *ref = cached ? cached->second : NULL;
+    bool last = !ref || asdf_object_ref_release(ref);
+    pthread_mutex_unlock(&object_registry_lock);
+
+    if (!last)
+        return;
+
+    bool borrowed = ref && ref->borrowed;
+    free(ref);
+
+    if (!borrowed)
+        asdf_object_dealloc(ext, object);
+}
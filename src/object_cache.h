@@ -0,0 +1,76 @@
+/**
+ * Reference counted cache of deserialized extension objects
+ *
+ * Objects returned by `asdf_value_as_extension_type` are cached per file by the node they were
+ * read from, so reading the same node again returns the same object instead of running the
+ * extension's deserializer again.  Every object handed out counts as one reference, released
+ * with the extension's ``asdf_<name>_destroy``; the file holds one more reference until it is
+ * closed or the node is replaced.  Objects may refer to the file's blocks and tree, so every
+ * reference handed out must be released before the file is closed.
+ *
+ * Objects read from detached nodes are not cached by the file but by their value, which holds a
+ * reference to the object until it is destroyed, and objects passed to
+ * `asdf_value_of_extension_type` are handed out as borrowed references that never free them.
+ */
+#pragma once
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#include <libfyaml.h>
+
+#include "asdf/extension.h"
+
+#include "util.h"
+
+
+typedef struct asdf_object_ref {
+    /** The file caching the object, or ``NULL`` once the file has dropped its reference */
+    asdf_file_t *file;
+    struct fy_node *node;
+    const asdf_extension_t *ext;
+    void *object;
+    size_t refcount;
+    /** Whether the object belongs to someone else and is not freed with its last reference */
+    bool borrowed;
+} asdf_object_ref_t;
+
+
+/**
+ * Get a new reference to the object cached for ``node``, if any
+ *
+ * :return: The cached object, or ``NULL`` if there is none for the given extension
+ */
+ASDF_LOCAL void *asdf_object_cache_get(
+    asdf_file_t *file, struct fy_node *node, const asdf_extension_t *ext);
+
+/**
+ * Cache a newly deserialized object for ``node``
+ *
+ * The caller keeps the reference it already holds to ``object``.  If the object can't be
+ * cached it is simply left uncached and owned by the caller alone.
+ */
+ASDF_LOCAL void asdf_object_cache_add(
+    asdf_file_t *file, struct fy_node *node, const asdf_extension_t *ext, void *object);
+
+/**
+ * Get a new reference to ``object``, which need not have been read from a file
+ *
+ * Objects not yet registered are registered with this as their only reference.  A ``borrowed``
+ * object (such as one passed to `asdf_value_of_extension_type`) belongs to its caller, and
+ * releasing its last reference only unregisters it instead of freeing it.
+ *
+ * :return: ``object``, or ``NULL`` if it could not be registered
+ */
+ASDF_LOCAL void *asdf_object_retain(const asdf_extension_t *ext, void *object, bool borrowed);
+
+/**
+ * Drop the file's references to all its cached objects
+ *
+ * Objects no longer referenced by anyone else are freed.
+ */
+ASDF_LOCAL void asdf_object_cache_clear(asdf_file_t *file);
@@ -1,5 +1,7 @@
 #include <assert.h>
 #include <ctype.h>
+#include <stdbool.h>
+#include <string.h>
 
 #include "block.h"
 #include "event.h"
@@ -106,6 +108,146 @@ bool is_generic_yaml_directive(const char *buf, size_t len) {
 }
 
 
+/* Block index parsing */
+
+typedef struct {
+    const char *pos;
+    const char *end;
+} block_index_cursor_t;
+
+
+static void block_index_skip_space(block_index_cursor_t *cur, bool newlines) {
+    while (cur->pos < cur->end) {
+        char ch = *cur->pos;
+
+        if (ch != ' ' && ch != '\t' && (!newlines || (ch != '\r' && ch != '\n')))
+            break;
+
+        cur->pos++;
+    }
+}
+
+
+static bool block_index_at_line_end(block_index_cursor_t *cur) {
+    return cur->pos == cur->end || *cur->pos == '\r' || *cur->pos == '\n';
+}
+
+
+/** Returns `true` if the cursor is at ``marker`` followed by whitespace or the end of input */
+static bool block_index_accept_marker(block_index_cursor_t *cur, const char *marker) {
+    size_t len = strlen(marker);
+
+    if ((size_t)(cur->end - cur->pos) < len || strncmp(cur->pos, marker, len) != 0)
+        return false;
+
+    const char *next = cur->pos + len;
+
+    if (next < cur->end && *next != ' ' && *next != '\t' && *next != '\r' && *next != '\n')
+        return false;
+
+    cur->pos = next;
+    return true;
+}
+
+
+static bool block_index_push_offset(block_index_cursor_t *cur, asdf_block_index_t *block_index) {
+    off_t offset = 0;
+    const char *start = cur->pos;
+
+    while (cur->pos < cur->end && isdigit((unsigned char)*cur->pos)) {
+        int digit = *cur->pos - '0';
+
+        if (offset > ((off_t)ASDF_OFF_MAX - digit) / 10)
+            return false;
+
+        offset = offset * 10 + digit;
+        cur->pos++;
+    }
+
+    if (cur->pos == start)
+        return false;
+
+    return asdf_block_index_push(block_index, offset) != NULL;
+}
+
+
+/**
+ * Parse the list of block offsets in a block index
+ *
+ * ``buf`` should point just past the ``#ASDF BLOCK INDEX`` header.  Rather than building a full
+ * YAML document this understands only the subset of YAML used for block indices: an optional
+ * ``%YAML`` directive, the ``---`` document start marker, a block sequence (``- 123`` on each
+ * line) or flow sequence (``[123, 456]``) of non-negative integers, and an optional ``...``
+ * document end marker.  Returns false for anything else, leaving ``block_index`` empty.
+ */
+bool asdf_parse_block_index(const char *buf, size_t len, asdf_block_index_t *block_index) {
+    block_index_cursor_t cur = {buf, buf + len};
+    block_index_skip_space(&cur, true);
+
+    if (is_yaml_directive(cur.pos, cur.end - cur.pos)) {
+        while (!block_index_at_line_end(&cur))
+            cur.pos++;
+
+        block_index_skip_space(&cur, true);
+    }
+
+    if (!block_index_accept_marker(&cur, "---"))
+        goto invalid;
+
+    block_index_skip_space(&cur, true);
+
+    if (cur.pos < cur.end && *cur.pos == '[') {
+        cur.pos++;
+        block_index_skip_space(&cur, true);
+
+        while (cur.pos < cur.end && *cur.pos != ']') {
+            if (!block_index_push_offset(&cur, block_index))
+                goto invalid;
+
+            block_index_skip_space(&cur, true);
+
+            if (cur.pos < cur.end && *cur.pos == ',') {
+                cur.pos++;
+                block_index_skip_space(&cur, true);
+            } else if (cur.pos < cur.end && *cur.pos != ']') {
+                goto invalid;
+            }
+        }
+
+        if (cur.pos == cur.end)
+            goto invalid;
+
+        cur.pos++;
+    } else {
+        while (block_index_accept_marker(&cur, "-")) {
+            block_index_skip_space(&cur, false);
+
+            if (!block_index_push_offset(&cur, block_index))
+                goto invalid;
+
+            block_index_skip_space(&cur, false);
+
+            if (!block_index_at_line_end(&cur))
+                goto invalid;
+
+            block_index_skip_space(&cur, true);
+        }
+    }
+
+    block_index_skip_space(&cur, true);
+
+    if (block_index_accept_marker(&cur, "..."))
+        block_index_skip_space(&cur, true);
+
+    if (cur.pos == cur.end)
+        return true;
+
+invalid:
+    asdf_block_index_clear(block_index);
+    return false;
+}
+
+
 /**
  * asdf_event_t allocation helpers
  */
@@ -56,6 +56,8 @@ ASDF_LOCAL int asdf_parser_scan_tokens(
 
 /* Additional helper functions */
 ASDF_LOCAL bool is_generic_yaml_directive(const char *buf, size_t len);
+ASDF_LOCAL bool asdf_parse_block_index(
+    const char *buf, size_t len, asdf_block_index_t *block_index);
 
 
 /* Inline helper functions */
@@ -102,6 +104,35 @@ static inline bool is_yaml_directive(const char *buf, size_t len) {
 }
 
 
+/**
+ * Returns `true` if the byte can appear in a block index following its header line
+ *
+ * Block indices written by ASDF libraries consist of a ``%YAML`` directive and a YAML sequence
+ * of integers, so this is all that is allowed for.
+ */
+static inline bool is_block_index_char(uint8_t ch) {
+    switch (ch) {
+    case ' ':
+    case '\t':
+    case '\r':
+    case '\n':
+    case '-':
+    case '.':
+    case ',':
+    case '[':
+    case ']':
+    case '%':
+    case 'Y':
+    case 'A':
+    case 'M':
+    case 'L':
+        return true;
+    default:
+        return ch >= '0' && ch <= '9';
+    }
+}
+
+
 /**
  * Is the given buffer pointing to a line beginning with "\n...\r?\n" (including the preceding
  * newline)
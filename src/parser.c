@@ -6,6 +6,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <unistd.h>
 
 #include "asdf/version.h"
@@ -346,6 +347,62 @@ static int parse_tree_fast(asdf_parser_t *parser) {
 }
 
 
+/**
+ * Skip scanning for the end of the tree if its extent is already known
+ *
+ * If the tree is being buffered it is copied to the tree buffer in one go.  Returns false if
+ * the tree extent is not known (or does not match where the tree actually starts), in which
+ * case the tree should be parsed as usual.
+ */
+static bool parse_tree_known(asdf_parser_t *parser, bool buffer_tree) {
+    off_t start = parser->tree.start;
+    off_t end = parser->tree.known_end;
+
+    if (parser->tree.known_start != start || end <= start)
+        return false;
+
+    size_t size = (size_t)(end - start);
+
+    if (buffer_tree) {
+        const uint8_t *view = asdf_stream_view(parser->stream, start, size);
+
+        if (view) {
+            parser->tree.buf = (uint8_t *)view;
+            parser->tree.buf_borrowed = true;
+        } else {
+            size_t avail = 0;
+            const uint8_t *buf = asdf_stream_next(parser->stream, size, &avail);
+
+            if (!buf || avail < size)
+                return false;
+
+            parser->tree.buf = malloc(size);
+
+            if (!parser->tree.buf)
+                return false;
+
+            memcpy(parser->tree.buf, buf, size);
+        }
+
+        parser->tree.size = size;
+    }
+
+    if (asdf_stream_seek(parser->stream, end, SEEK_SET) != 0) {
+        if (!parser->tree.buf_borrowed)
+            free(parser->tree.buf);
+
+        parser->tree.buf = NULL;
+        parser->tree.size = 0;
+        parser->tree.buf_borrowed = false;
+        return false;
+    }
+
+    parser->tree.end = end;
+    parser->tree.found = true;
+    return true;
+}
+
+
 /**
  * Default libfyaml parser configuration
  *
@@ -421,7 +478,17 @@ static parse_result_t parse_tree(asdf_parser_t *parser, asdf_event_t *event) {
         buffer_tree |= emit_yaml_events;
     }
 
-    if (buffer_tree) {
+    if (!emit_yaml_events && parse_tree_known(parser, buffer_tree)) {
+        parser->state = ASDF_PARSER_STATE_PADDING;
+        return emit_tree_end_event(parser, event);
+    }
+
+    // If the stream's contents are directly addressable there is no need to copy the tree out
+    // of the stream as it is read; just point at it once its extent is known
+    off_t tree_start = asdf_stream_tell(parser->stream);
+    bool view_tree = buffer_tree && asdf_stream_view(parser->stream, tree_start, 0) != NULL;
+
+    if (buffer_tree && !view_tree) {
         // Initialize the tree buffer and set up the stream to capture to it
         ASDF_LOG(
             parser,
@@ -449,6 +516,21 @@ static parse_result_t parse_tree(asdf_parser_t *parser, asdf_event_t *event) {
 
         if (0 != res)
             return ASDF_PARSE_ERROR;
+
+        if (view_tree) {
+            // Everything consumed by parse_tree_fast, as would have been captured
+            size_t size = (size_t)(asdf_stream_tell(parser->stream) - tree_start);
+            const uint8_t *view = asdf_stream_view(parser->stream, tree_start, size);
+
+            if (UNLIKELY(!view)) {
+                ASDF_ERROR_COMMON(parser, ASDF_ERR_UNKNOWN_STATE);
+                return ASDF_PARSE_ERROR;
+            }
+
+            parser->tree.buf = (uint8_t *)view;
+            parser->tree.size = size;
+            parser->tree.buf_borrowed = true;
+        }
     }
 
     // Continue to generating YAML events
@@ -701,9 +783,40 @@ static bool validate_block_index(asdf_parser_t *parser) {
 }
 
 
-// TODO: Per @braingram they have already encountered some ASDF files in the wild (catalogs?)
-// that have as many as 10000 blocks, so this might not even search backwards far enough.
-// Have to take a look at how other libraries are handling this.
+/**
+ * Check whether the block index header line ends at ``header_end``, and if so leave the stream
+ * positioned at the start of the header
+ */
+static parse_result_t check_block_index_header(asdf_parser_t *parser, off_t header_end) {
+    off_t header_start = header_end - ASDF_BLOCK_INDEX_HEADER_SIZE;
+
+    if (header_start < 0)
+        return ASDF_PARSE_CONTINUE;
+
+    TRY_SEEK(parser, header_start, SEEK_SET, ASDF_PARSE_ERROR);
+    size_t avail = 0;
+    const uint8_t *buf = asdf_stream_peek(
+        parser->stream, ASDF_BLOCK_INDEX_HEADER_SIZE + 2, &avail);
+    const asdf_parse_token_t *token = &asdf_parse_tokens[ASDF_BLOCK_INDEX_HEADER_TOK];
+
+    if (!is_string_with_newline((const char *)buf, avail, (const char *)token->tok, token->tok_len))
+        return ASDF_PARSE_CONTINUE;
+
+    return ASDF_PARSE_EVENT;
+}
+
+
+/**
+ * Search backwards from the end of the file for the block index header
+ *
+ * The file is read backwards in windows, starting from a single page and doubling in size up to
+ * ``ASDF_BLOCK_INDEX_MAX_SEARCH_WINDOW``, so that the index is found however many blocks it
+ * lists.  Since the block index is the last thing in the file and its body only contains a
+ * small set of characters (see `is_block_index_char`), the search stops at the first byte from
+ * the end that cannot be part of the index body.  That byte has to be the end of the
+ * ``#ASDF BLOCK INDEX`` header line; otherwise there is no block index, which is then also
+ * determined without reading any more of the file than the trailing index-like bytes.
+ */
 static parse_result_t parse_find_block_index(asdf_parser_t *parser, off_t file_size) {
     assert(parser);
     asdf_stream_t *stream = parser->stream;
@@ -719,31 +832,33 @@ static parse_result_t parse_find_block_index(asdf_parser_t *parser, off_t file_s
         return ASDF_PARSE_ERROR;
     }
 
-    off_t aligned_offset = (file_size > page_size)
-                               ? (file_size - page_size - (file_size % page_size))
-                               : 0;
-
-    TRY_SEEK(parser, aligned_offset, SEEK_SET, ASDF_PARSE_ERROR);
+    off_t window = (off_t)page_size;
+    off_t end = file_size;
 
-    const asdf_parse_token_id_t tokens[] = {ASDF_BLOCK_INDEX_HEADER_TOK, ASDF_LAST_TOK};
-    asdf_parse_token_id_t match_token = ASDF_LAST_TOK;
-    size_t match_offset = 0;
-
-    while (0 == asdf_parser_scan_tokens(parser, tokens, &match_offset, &match_token)) {
+    while (end > 0) {
+        // Align the window start to a page boundary where possible
+        off_t start = end > window ? end - window : 0;
+        start -= start % (off_t)page_size;
+        size_t len = (size_t)(end - start);
+        TRY_SEEK(parser, start, SEEK_SET, ASDF_PARSE_ERROR);
         size_t avail = 0;
-        const uint8_t *buf = asdf_stream_peek(stream, ASDF_BLOCK_INDEX_HEADER_SIZE + 1, &avail);
+        const uint8_t *buf = asdf_stream_next(stream, len, &avail);
 
-        if (buf == NULL || avail < ASDF_BLOCK_INDEX_HEADER_SIZE + 1)
+        if (!buf || avail < len)
             return ASDF_PARSE_CONTINUE;
 
-        if (ends_with_newline((const char *)buf, avail, ASDF_BLOCK_INDEX_HEADER_SIZE))
-            break;
-    }
+        for (size_t idx = len; idx > 0; idx--) {
+            if (!is_block_index_char(buf[idx - 1]))
+                return check_block_index_header(parser, start + (off_t)idx);
+        }
 
-    if (match_token != ASDF_BLOCK_INDEX_HEADER_TOK)
-        return ASDF_PARSE_CONTINUE;
+        end = start;
 
-    return ASDF_PARSE_EVENT;
+        if (window < ASDF_BLOCK_INDEX_MAX_SEARCH_WINDOW)
+            window *= 2;
+    }
+
+    return ASDF_PARSE_CONTINUE;
 }
 
 
@@ -755,7 +870,11 @@ static parse_result_t parse_block_index(asdf_parser_t *parser, asdf_event_t *eve
         goto next_state;
     }
 
-    struct fy_document *doc = NULL;
+    if (parser->block.has_index) {
+        // Block positions were already supplied before parsing (by the block index cache)
+        goto next_state;
+    }
+
     asdf_stream_t *stream = parser->stream;
     off_t cur_offset = asdf_stream_tell(stream);
     TRY_SEEK(parser, 0, SEEK_END, ASDF_PARSE_ERROR);
@@ -765,15 +884,15 @@ static parse_result_t parse_block_index(asdf_parser_t *parser, asdf_event_t *eve
     if (res != ASDF_PARSE_EVENT)
         goto cleanup;
 
-    // Block index found (assuming it's valid YAML)
+    // Block index found (assuming it's valid)
     off_t block_index_offset = asdf_stream_tell(stream);
-    off_t block_index_len = file_size - block_index_offset;
+    size_t block_index_len = (size_t)(file_size - block_index_offset);
 
     // Ensure the full block index is available to the stream
     size_t avail = 0;
     const uint8_t *buf = asdf_stream_next(stream, block_index_len, &avail);
 
-    if (UNLIKELY(!buf)) {
+    if (UNLIKELY(!buf || avail < block_index_len)) {
         // TODO: (#5) Not necessarily an unrecoverable error but should produce a log message
         ASDF_ERROR_COMMON(parser, ASDF_ERR_UNEXPECTED_EOF);
         res = ASDF_PARSE_ERROR;
@@ -782,33 +901,17 @@ static parse_result_t parse_block_index(asdf_parser_t *parser, asdf_event_t *eve
 
     asdf_block_index_t *block_index = &parser->block.index;
 
-    // Try to read the block index document
-    doc = fy_document_build_from_string(NULL, (const char *)buf, block_index_len);
-    struct fy_node *root = fy_document_root(doc);
-
-    if (!doc || !root || !fy_node_is_sequence(root)) {
+    // Parse the offsets following the header line
+    if (!asdf_parse_block_index(
+            (const char *)buf + ASDF_BLOCK_INDEX_HEADER_SIZE,
+            block_index_len - ASDF_BLOCK_INDEX_HEADER_SIZE,
+            block_index)) {
         // Invalid / corrupt block index
+        ASDF_LOG(parser, ASDF_LOG_DEBUG, "could not parse the block index; it will be ignored");
+        res = ASDF_PARSE_CONTINUE;
         goto cleanup;
     }
 
-    size_t count = fy_node_sequence_item_count(root);
-
-    if (UNLIKELY(!asdf_block_index_reserve(block_index, count))) {
-        ASDF_ERROR_OOM(parser);
-        res = ASDF_PARSE_ERROR;
-        goto cleanup;
-    }
-
-    struct fy_node *item = NULL;
-    void *iter = NULL;
-    while ((item = fy_node_sequence_iterate(root, &iter))) {
-        long long offset = 0;
-        if (UNLIKELY(1 != fy_node_scanf(item, "/ %lld", (long long *)&offset))) {
-            goto cleanup;
-        }
-        asdf_block_index_push(block_index, (isize)offset);
-    }
-
     if (!validate_block_index(parser)) {
         // Inconsistent/invalid block index, so discard
         res = ASDF_PARSE_CONTINUE;
@@ -822,7 +925,6 @@ static parse_result_t parse_block_index(asdf_parser_t *parser, asdf_event_t *eve
     goto cleanup;
 
 cleanup:
-    fy_document_destroy(doc);
     TRY_SEEK(parser, cur_offset, SEEK_SET, ASDF_PARSE_ERROR);
 next_state:
     parser->state = ASDF_PARSER_STATE_TREE_OR_BLOCK;
@@ -1068,6 +1170,72 @@ asdf_event_t *asdf_parser_parse(asdf_parser_t *parser) {
 }
 
 
+/**
+ * Return true while the parser has not yet had a chance to read the block index
+ */
+static bool parser_before_block_index(asdf_parser_t *parser) {
+    switch (parser->state) {
+    case ASDF_PARSER_STATE_INITIAL:
+    case ASDF_PARSER_STATE_ASDF_VERSION:
+    case ASDF_PARSER_STATE_STANDARD_VERSION:
+    case ASDF_PARSER_STATE_COMMENT:
+    case ASDF_PARSER_STATE_BLOCK_INDEX:
+        return !parser->done;
+    default:
+        return false;
+    }
+}
+
+
+const asdf_block_info_t *asdf_parser_block_info_indexed(asdf_parser_t *parser, size_t idx) {
+    assert(parser);
+
+    // The block index is read right after the header comments, so this only ever needs to
+    // produce a handful of events
+    while (parser_before_block_index(parser)) {
+        if (!asdf_event_iterate(parser))
+            return NULL;
+    }
+
+    if (!parser->block.has_index || idx >= parser->block.count || idx > PTRDIFF_MAX)
+        return NULL;
+
+    asdf_block_info_t *block_info = asdf_block_info_vec_at_mut(&parser->block.infos, (isize)idx);
+
+    if (!BLOCK_INFO_IS_EMPTY(block_info))
+        return block_info;
+
+    // Read into a temporary so that a bad entry does not leave a partially read block info
+    // behind for the sequential parser to trust later
+    asdf_block_info_t new_block_info = {.index = idx};
+    off_t cur_offset = asdf_stream_tell(parser->stream);
+    bool valid = validate_block(parser, idx, &new_block_info);
+
+    if (valid && idx + 1 < parser->block.count) {
+        // Only the first and last index entries are validated up front; here additionally
+        // make sure this block does not run into the next one
+        off_t next_offset = *asdf_block_index_at(&parser->block.index, (isize)idx + 1);
+        valid = new_block_info.data_pos + (off_t)new_block_info.header.allocated_size <=
+                next_offset;
+    }
+
+    TRY_SEEK(parser, cur_offset, SEEK_SET, NULL);
+
+    if (!valid) {
+        ASDF_LOG(
+            parser,
+            ASDF_LOG_DEBUG,
+            "block index entry %zu does not point to a valid block; falling back to a "
+            "sequential scan",
+            idx);
+        return NULL;
+    }
+
+    *block_info = new_block_info;
+    return block_info;
+}
+
+
 /**
  * Default libasdf parser configuration
  */
@@ -1202,7 +1370,9 @@ void asdf_parser_destroy(asdf_parser_t *parser) {
     if (parser->should_close && parser->stream)
         parser->stream->close(parser->stream);
 
-    free(parser->tree.buf);
+    if (!parser->tree.buf_borrowed)
+        free(parser->tree.buf);
+
     asdf_parse_event_freelist_free(parser);
     asdf_block_index_drop(&parser->block.index);
     asdf_block_info_vec_drop(&parser->block.infos);
@@ -24,6 +24,9 @@
 
 #define ASDF_DEFAULT_BLOCK_INDEX_SIZE 8
 
+/** Largest window (in bytes) read at a time when searching backwards for the block index */
+#define ASDF_BLOCK_INDEX_MAX_SEARCH_WINDOW (1 << 20)
+
 
 typedef enum {
     ASDF_PARSER_STATE_INITIAL,
@@ -50,6 +53,9 @@ typedef struct asdf_parser_tree_info {
     off_t end;
     uint8_t *buf;
     size_t size;
+    // The tree buffer points directly into the stream's memory (see asdf_stream_view) instead
+    // of being a copy owned by the parser; it must then never be written to or freed
+    bool buf_borrowed;
     // Found the full YAML tree
     bool found;
     // Done YAML parsing
@@ -58,6 +64,11 @@ typedef struct asdf_parser_tree_info {
     // in the case of exploded files.  This is a trinary value with a negative indicating
     // unknown, 0 false, >= 1 true.
     int8_t has_tree;
+    // Extent of the tree if already known before parsing (e.g. from the block index cache), in
+    // which case there is no need to scan for its end; ignored if the tree turns out not to start
+    // at ``known_start``
+    off_t known_start;
+    off_t known_end;
 } asdf_parser_tree_info_t;
 
 
@@ -109,3 +120,15 @@ static inline bool asdf_parser_has_opt(asdf_parser_t *parser, asdf_parser_opt_t
 ASDF_LOCAL asdf_parser_t *asdf_parser_create_ctx(
     asdf_context_t *ctx, const asdf_parser_cfg_t *config);
 ASDF_EXPORT int asdf_parser_set_input_stream(asdf_parser_t *parser, asdf_stream_t *stream);
+
+
+/**
+ * Look up a single block through the block index without parsing the rest of the file
+ *
+ * Only the header of the requested block is read (if it was not already read while
+ * validating the block index), and the stream position is left unchanged.  Returns NULL if
+ * the file has no usable block index or the entry does not point to a valid block, in which
+ * case the caller should fall back to parsing the file sequentially.
+ */
+ASDF_LOCAL const asdf_block_info_t *asdf_parser_block_info_indexed(
+    asdf_parser_t *parser, size_t idx);
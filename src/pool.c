@@ -0,0 +1,97 @@
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "pool.h"
+#include "util.h"
+
+
+struct asdf_pool_slab {
+    asdf_pool_slab_t *next;
+    alignas(max_align_t) unsigned char data[];
+};
+
+
+void asdf_pool_init(asdf_pool_t *pool, size_t obj_size) {
+    assert(pool);
+    const size_t align = alignof(max_align_t);
+
+    // Every object must be large enough to hold the freelist link
+    if (obj_size < sizeof(void *))
+        obj_size = sizeof(void *);
+
+    ZERO_MEMORY(pool, sizeof(asdf_pool_t));
+    pool->obj_size = (obj_size + align - 1) & ~(align - 1);
+}
+
+
+static bool asdf_pool_grow(asdf_pool_t *pool) {
+    size_t n_objects = pool->slab_objects * 2;
+
+    if (n_objects < ASDF_POOL_SLAB_MIN_OBJECTS)
+        n_objects = ASDF_POOL_SLAB_MIN_OBJECTS;
+
+    if (n_objects > ASDF_POOL_SLAB_MAX_OBJECTS)
+        n_objects = ASDF_POOL_SLAB_MAX_OBJECTS;
+
+    asdf_pool_slab_t *slab = malloc(sizeof(asdf_pool_slab_t) + n_objects * pool->obj_size);
+
+    if (UNLIKELY(!slab))
+        return false;
+
+    slab->next = pool->slabs;
+    pool->slabs = slab;
+    pool->slab_objects = n_objects;
+    pool->slab_remaining = n_objects;
+    return true;
+}
+
+
+void *asdf_pool_alloc(asdf_pool_t *pool) {
+    assert(pool);
+    assert(pool->obj_size > 0);
+    void *obj = pool->free_list;
+
+    if (obj) {
+        memcpy(&pool->free_list, obj, sizeof(void *));
+    } else {
+        if (pool->slab_remaining == 0 && !asdf_pool_grow(pool))
+            return NULL;
+
+        size_t idx = pool->slab_objects - pool->slab_remaining--;
+        obj = pool->slabs->data + (idx * pool->obj_size);
+    }
+
+    memset(obj, 0, pool->obj_size);
+    return obj;
+}
+
+
+void asdf_pool_free(asdf_pool_t *pool, void *obj) {
+    assert(pool);
+
+    if (!obj)
+        return;
+
+    memcpy(obj, &pool->free_list, sizeof(void *));
+    pool->free_list = obj;
+}
+
+
+void asdf_pool_drop(asdf_pool_t *pool) {
+    if (!pool)
+        return;
+
+    asdf_pool_slab_t *slab = pool->slabs;
+
+    while (slab) {
+        asdf_pool_slab_t *next = slab->next;
+        free(slab);
+        slab = next;
+    }
+
+    size_t obj_size = pool->obj_size;
+    ZERO_MEMORY(pool, sizeof(asdf_pool_t));
+    pool->obj_size = obj_size;
+}
@@ -0,0 +1,56 @@
+/**
+ * Fixed-size object pools
+ *
+ * Used for the small, short-lived objects that are allocated in large numbers while reading a
+ * file, such as `asdf_value_t` and the container iterators.  Objects are carved out of larger
+ * slabs, and freed objects are kept on a freelist for reuse rather than being returned to the
+ * system allocator.  All slabs are released at once when the pool is dropped.
+ */
+#pragma once
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stddef.h>
+
+#include "util.h"
+
+
+/** Number of objects in the first slab allocated for a pool */
+#define ASDF_POOL_SLAB_MIN_OBJECTS 64
+
+/** Maximum number of objects per slab; slabs double in size up to this many objects */
+#define ASDF_POOL_SLAB_MAX_OBJECTS 4096
+
+
+typedef struct asdf_pool_slab asdf_pool_slab_t;
+
+
+typedef struct asdf_pool {
+    /** Size of each object, rounded up to keep them all suitably aligned */
+    size_t obj_size;
+    /** Number of objects in the most recently allocated slab */
+    size_t slab_objects;
+    /** Number of objects not yet handed out from the most recently allocated slab */
+    size_t slab_remaining;
+    asdf_pool_slab_t *slabs;
+    /** Singly-linked list of freed objects, linked through their first bytes */
+    void *free_list;
+} asdf_pool_t;
+
+
+ASDF_LOCAL void asdf_pool_init(asdf_pool_t *pool, size_t obj_size);
+
+/**
+ * Return a zeroed object from the pool
+ *
+ * Returns NULL if a new slab was needed and could not be allocated.
+ */
+ASDF_LOCAL void *asdf_pool_alloc(asdf_pool_t *pool);
+
+/** Return an object allocated with `asdf_pool_alloc` to the pool for reuse */
+ASDF_LOCAL void asdf_pool_free(asdf_pool_t *pool, void *obj);
+
+/** Release all memory held by the pool, including any objects not yet freed */
+ASDF_LOCAL void asdf_pool_drop(asdf_pool_t *pool);
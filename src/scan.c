@@ -0,0 +1,339 @@
+/**
+ * Multi-token byte scanning
+ *
+ * The vectorized kernels use the "generic SIMD" substring search approach: for every token
+ * compare a vector of candidate start positions against the token's first byte, and the
+ * same positions shifted by ``token_len - 1`` against its last byte.  Positions where both
+ * match for any token are candidates, which are then verified with `memcmp` in increasing
+ * order so that the result is identical to a naive scan.
+ */
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "scan.h"
+#include "util.h"
+
+#ifdef ASDF_X86_DISPATCH
+#include <immintrin.h>
+#endif
+
+
+/**
+ * Check all tokens in order at ``offset``; return true if one matched
+ */
+static inline bool scan_verify(
+    const uint8_t *buf,
+    size_t len,
+    size_t offset,
+    const uint8_t **tokens,
+    const size_t *token_lens,
+    size_t n_tokens,
+    size_t *match_token_idx) {
+    for (size_t tdx = 0; tdx < n_tokens; tdx++) {
+        size_t tok_len = token_lens[tdx];
+        if (tok_len <= len - offset && memcmp(buf + offset, tokens[tdx], tok_len) == 0) {
+            *match_token_idx = tdx;
+            return true;
+        }
+    }
+    return false;
+}
+
+
+static inline int scan_match(
+    size_t offset, size_t tdx, size_t *match_offset, size_t *match_token_idx) {
+    if (match_offset)
+        *match_offset = offset;
+
+    if (match_token_idx)
+        *match_token_idx = tdx;
+
+    return 0;
+}
+
+
+/**
+ * Portable scan starting from ``start``
+ *
+ * Only offsets whose byte is the first byte of some token are verified; when all tokens
+ * share the same first byte (common for the parser's tokens) `memchr` is used to skip
+ * ahead.
+ */
+static int scan_tokens_generic_from(
+    const uint8_t *buf,
+    size_t len,
+    size_t start,
+    const uint8_t **tokens,
+    const size_t *token_lens,
+    size_t n_tokens,
+    size_t *match_offset,
+    size_t *match_token_idx) {
+    bool first_bytes[256] = {false};
+    size_t n_first_bytes = 0;
+    uint8_t single_first_byte = 0;
+    size_t tdx = 0;
+
+    for (size_t idx = 0; idx < n_tokens; idx++) {
+        if (token_lens[idx] == 0) {
+            // An empty token matches anywhere, so the earliest position is a match
+            if (start < len && scan_verify(buf, len, start, tokens, token_lens, n_tokens, &tdx))
+                return scan_match(start, tdx, match_offset, match_token_idx);
+
+            return 1;
+        }
+
+        uint8_t first = tokens[idx][0];
+
+        if (!first_bytes[first]) {
+            first_bytes[first] = true;
+            single_first_byte = first;
+            n_first_bytes++;
+        }
+    }
+
+    if (n_first_bytes == 1) {
+        const uint8_t *pos = buf + start;
+        const uint8_t *end = buf + len;
+
+        while (pos < end && (pos = memchr(pos, single_first_byte, end - pos))) {
+            size_t offset = pos - buf;
+            if (scan_verify(buf, len, offset, tokens, token_lens, n_tokens, &tdx))
+                return scan_match(offset, tdx, match_offset, match_token_idx);
+            pos++;
+        }
+
+        return 1;
+    }
+
+    for (size_t idx = start; idx < len; idx++) {
+        if (!first_bytes[buf[idx]])
+            continue;
+
+        if (scan_verify(buf, len, idx, tokens, token_lens, n_tokens, &tdx))
+            return scan_match(idx, tdx, match_offset, match_token_idx);
+    }
+
+    return 1;
+}
+
+
+static int scan_tokens_generic(
+    const uint8_t *buf,
+    size_t len,
+    const uint8_t **tokens,
+    const size_t *token_lens,
+    size_t n_tokens,
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    size_t *match_offset,
+    size_t *match_token_idx) {
+    if (!buf || len == 0 || n_tokens == 0)
+        return 1;
+
+    return scan_tokens_generic_from(
+        buf, len, 0, tokens, token_lens, n_tokens, match_offset, match_token_idx);
+}
+
+
+/**
+ * Common preamble for the vector kernels
+ *
+ * Returns false if the vector kernels cannot handle this set of tokens, in which case
+ * the caller should defer to the generic kernel.
+ */
+static inline bool scan_vector_prepare(
+    const size_t *token_lens, size_t n_tokens, size_t *max_token_len) {
+    if (n_tokens > ASDF_SCAN_MAX_VECTOR_TOKENS)
+        return false;
+
+    size_t max_len = 0;
+
+    for (size_t idx = 0; idx < n_tokens; idx++) {
+        if (token_lens[idx] == 0)
+            return false;
+
+        if (token_lens[idx] > max_len)
+            max_len = token_lens[idx];
+    }
+
+    *max_token_len = max_len;
+    return true;
+}
+
+
+#ifdef ASDF_X86_DISPATCH
+__attribute__((target("sse2"))) static int scan_tokens_sse2(
+    const uint8_t *buf,
+    size_t len,
+    const uint8_t **tokens,
+    const size_t *token_lens,
+    size_t n_tokens,
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    size_t *match_offset,
+    size_t *match_token_idx) {
+    const size_t width = sizeof(__m128i);
+    size_t max_token_len = 0;
+
+    if (!buf || len == 0 || n_tokens == 0)
+        return 1;
+
+    if (!scan_vector_prepare(token_lens, n_tokens, &max_token_len))
+        return scan_tokens_generic_from(
+            buf, len, 0, tokens, token_lens, n_tokens, match_offset, match_token_idx);
+
+    __m128i firsts[ASDF_SCAN_MAX_VECTOR_TOKENS];
+    __m128i lasts[ASDF_SCAN_MAX_VECTOR_TOKENS];
+
+    for (size_t tdx = 0; tdx < n_tokens; tdx++) {
+        firsts[tdx] = _mm_set1_epi8((char)tokens[tdx][0]);
+        lasts[tdx] = _mm_set1_epi8((char)tokens[tdx][token_lens[tdx] - 1]);
+    }
+
+    size_t idx = 0;
+    size_t tdx = 0;
+
+    while (len - idx >= width + max_token_len - 1) {
+        const uint8_t *ptr = buf + idx;
+        __m128i block_first = _mm_loadu_si128((const __m128i *)ptr);
+        __m128i candidates = _mm_setzero_si128();
+
+        for (size_t jdx = 0; jdx < n_tokens; jdx++) {
+            __m128i block_last = _mm_loadu_si128((const __m128i *)(ptr + token_lens[jdx] - 1));
+            __m128i eq_first = _mm_cmpeq_epi8(block_first, firsts[jdx]);
+            __m128i eq_last = _mm_cmpeq_epi8(block_last, lasts[jdx]);
+            candidates = _mm_or_si128(candidates, _mm_and_si128(eq_first, eq_last));
+        }
+
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(candidates);
+
+        while (mask) {
+            size_t offset = idx + (size_t)__builtin_ctz(mask);
+
+            if (scan_verify(buf, len, offset, tokens, token_lens, n_tokens, &tdx))
+                return scan_match(offset, tdx, match_offset, match_token_idx);
+
+            mask &= mask - 1;
+        }
+
+        idx += width;
+    }
+
+    return scan_tokens_generic_from(
+        buf, len, idx, tokens, token_lens, n_tokens, match_offset, match_token_idx);
+}
+
+
+__attribute__((target("avx2"))) static int scan_tokens_avx2(
+    const uint8_t *buf,
+    size_t len,
+    const uint8_t **tokens,
+    const size_t *token_lens,
+    size_t n_tokens,
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    size_t *match_offset,
+    size_t *match_token_idx) {
+    const size_t width = sizeof(__m256i);
+    size_t max_token_len = 0;
+
+    if (!buf || len == 0 || n_tokens == 0)
+        return 1;
+
+    if (!scan_vector_prepare(token_lens, n_tokens, &max_token_len))
+        return scan_tokens_generic_from(
+            buf, len, 0, tokens, token_lens, n_tokens, match_offset, match_token_idx);
+
+    __m256i firsts[ASDF_SCAN_MAX_VECTOR_TOKENS];
+    __m256i lasts[ASDF_SCAN_MAX_VECTOR_TOKENS];
+
+    for (size_t tdx = 0; tdx < n_tokens; tdx++) {
+        firsts[tdx] = _mm256_set1_epi8((char)tokens[tdx][0]);
+        lasts[tdx] = _mm256_set1_epi8((char)tokens[tdx][token_lens[tdx] - 1]);
+    }
+
+    size_t idx = 0;
+    size_t tdx = 0;
+
+    while (len - idx >= width + max_token_len - 1) {
+        const uint8_t *ptr = buf + idx;
+        __m256i block_first = _mm256_loadu_si256((const __m256i *)ptr);
+        __m256i candidates = _mm256_setzero_si256();
+
+        for (size_t jdx = 0; jdx < n_tokens; jdx++) {
+            __m256i block_last = _mm256_loadu_si256(
+                (const __m256i *)(ptr + token_lens[jdx] - 1));
+            __m256i eq_first = _mm256_cmpeq_epi8(block_first, firsts[jdx]);
+            __m256i eq_last = _mm256_cmpeq_epi8(block_last, lasts[jdx]);
+            candidates = _mm256_or_si256(candidates, _mm256_and_si256(eq_first, eq_last));
+        }
+
+        unsigned int mask = (unsigned int)_mm256_movemask_epi8(candidates);
+
+        while (mask) {
+            size_t offset = idx + (size_t)__builtin_ctz(mask);
+
+            if (scan_verify(buf, len, offset, tokens, token_lens, n_tokens, &tdx))
+                return scan_match(offset, tdx, match_offset, match_token_idx);
+
+            mask &= mask - 1;
+        }
+
+        idx += width;
+    }
+
+    return scan_tokens_generic_from(
+        buf, len, idx, tokens, token_lens, n_tokens, match_offset, match_token_idx);
+}
+#endif /* ASDF_X86_DISPATCH */
+
+
+asdf_scan_tokens_fn asdf_scan_kernel_get(asdf_scan_kernel_t kernel) {
+    switch (kernel) {
+    case ASDF_SCAN_KERNEL_AUTO:
+        if (asdf_scan_kernel_get(ASDF_SCAN_KERNEL_AVX2))
+            return asdf_scan_kernel_get(ASDF_SCAN_KERNEL_AVX2);
+        if (asdf_scan_kernel_get(ASDF_SCAN_KERNEL_SSE2))
+            return asdf_scan_kernel_get(ASDF_SCAN_KERNEL_SSE2);
+        return scan_tokens_generic;
+    case ASDF_SCAN_KERNEL_GENERIC:
+        return scan_tokens_generic;
+#ifdef ASDF_X86_DISPATCH
+    case ASDF_SCAN_KERNEL_SSE2:
+        return asdf_util_cpu_has(ASDF_CPU_FEATURE_SSE2) ? scan_tokens_sse2 : NULL;
+    case ASDF_SCAN_KERNEL_AVX2:
+        return asdf_util_cpu_has(ASDF_CPU_FEATURE_AVX2) ? scan_tokens_avx2 : NULL;
+#endif
+    default:
+        return NULL;
+    }
+}
+
+
+static asdf_scan_tokens_fn scan_impl = NULL;
+static atomic_bool scan_impl_initialized = false;
+
+
+ASDF_CONSTRUCTOR static void asdf_scan_kernel_init() {
+    if (atomic_load_explicit(&scan_impl_initialized, memory_order_acquire))
+        return;
+
+    scan_impl = asdf_scan_kernel_get(ASDF_SCAN_KERNEL_AUTO);
+    atomic_store_explicit(&scan_impl_initialized, true, memory_order_release);
+}
+
+
+int asdf_scan_tokens(
+    const uint8_t *buf,
+    size_t len,
+    const uint8_t **tokens,
+    const size_t *token_lens,
+    size_t n_tokens,
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    size_t *match_offset,
+    size_t *match_token_idx) {
+    if (UNLIKELY(!atomic_load_explicit(&scan_impl_initialized, memory_order_acquire)))
+        asdf_scan_kernel_init();
+
+    return scan_impl(buf, len, tokens, token_lens, n_tokens, match_offset, match_token_idx);
+}
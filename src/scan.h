@@ -0,0 +1,77 @@
+/**
+ * Multi-token byte scanning used by the stream ``scan`` implementations
+ *
+ * The public entry point is `asdf_scan_tokens`, which dispatches at runtime to the fastest
+ * kernel supported by the CPU.  The individual kernels are also accessible through
+ * `asdf_scan_kernel_get`, mainly for testing and benchmarking.
+ */
+#pragma once
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "util.h"
+
+
+/**
+ * Maximum number of tokens handled by the vectorized kernels
+ *
+ * Scans with more tokens than this (rare; the parser uses at most a handful) fall back
+ * to the generic kernel.
+ */
+#define ASDF_SCAN_MAX_VECTOR_TOKENS 8
+
+
+typedef enum {
+    ASDF_SCAN_KERNEL_AUTO = 0,
+    ASDF_SCAN_KERNEL_GENERIC,
+    ASDF_SCAN_KERNEL_SSE2,
+    ASDF_SCAN_KERNEL_AVX2,
+} asdf_scan_kernel_t;
+
+
+typedef int (*asdf_scan_tokens_fn)(
+    const uint8_t *buf,
+    size_t len,
+    const uint8_t **tokens,
+    const size_t *token_lens,
+    size_t n_tokens,
+    size_t *match_offset,
+    size_t *match_token_idx);
+
+
+/**
+ * Find the earliest occurrence of any of ``tokens`` in ``buf``
+ *
+ * If two tokens match at the same offset the one with the lower index wins.
+ *
+ * :param buf: Buffer to scan
+ * :param len: Length of ``buf``
+ * :param tokens: Array of ``n_tokens`` tokens to search for
+ * :param token_lens: Length of each token
+ * :param n_tokens: Number of tokens
+ * :param match_offset: If non-NULL, set to the offset of the match in ``buf``
+ * :param match_token_idx: If non-NULL, set to the index of the matched token
+ * :return: 0 if a match was found, 1 otherwise
+ */
+ASDF_LOCAL int asdf_scan_tokens(
+    const uint8_t *buf,
+    size_t len,
+    const uint8_t **tokens,
+    const size_t *token_lens,
+    size_t n_tokens,
+    size_t *match_offset,
+    size_t *match_token_idx);
+
+
+/**
+ * Return the scan implementation for the given kernel
+ *
+ * `ASDF_SCAN_KERNEL_AUTO` returns the kernel selected for the current CPU.  Returns
+ * `NULL` if the requested kernel is not supported by the build or the CPU.
+ */
+ASDF_LOCAL asdf_scan_tokens_fn asdf_scan_kernel_get(asdf_scan_kernel_t kernel);
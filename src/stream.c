@@ -1,10 +1,12 @@
 #include <assert.h>
 #include <errno.h>
+#include <fcntl.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
+#include <unistd.h>
 
 #include "context.h"
 #include "error.h"
@@ -14,53 +16,6 @@
 #include "util.h"
 
 
-/**
- * Helper for token scan methods
- *
- * Worth exposing publicly if we later want to make the stream interface available
- * to users to implement their own.
- *
- * NOTE: This is dog**** performance though; spend more time optimizing later, could use SIMD
- */
-int asdf_scan_tokens(
-    const uint8_t *buf,
-    size_t len,
-    const uint8_t **tokens,
-    const size_t *token_lens,
-    size_t n_tokens,
-    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-    size_t *match_offset,
-    size_t *match_token_idx) {
-
-    if (!buf || len == 0 || n_tokens == 0)
-        return 1;
-
-    size_t max_token_len = 0;
-
-    for (size_t idx = 0; idx < n_tokens; idx++) {
-        if (token_lens[idx] > max_token_len)
-            max_token_len = token_lens[idx];
-    }
-
-    for (size_t idx = 0; idx < len; idx++) {
-        for (size_t tdx = 0; tdx < n_tokens; tdx++) {
-            size_t tok_len = token_lens[tdx];
-            if (tok_len <= len - idx && memcmp(buf + idx, tokens[tdx], tok_len) == 0) {
-                if (match_offset)
-                    *match_offset = idx;
-
-                if (match_token_idx)
-                    *match_token_idx = tdx;
-
-                return 0;
-            }
-        }
-    }
-
-    return 1;
-}
-
-
 static void stream_capture(asdf_stream_t *stream, const uint8_t *buf, size_t size) {
     if (LIKELY(!stream->capture_buf))
         return;
@@ -108,6 +63,20 @@ void asdf_stream_set_capture(asdf_stream_t *stream, uint8_t **buf, size_t *size,
 }
 
 
+static void stream_mmap_cache_evict(asdf_stream_t *stream, stream_mmap_cache_t *cache);
+
+
+void asdf_stream_set_mmap_cache_limits(
+    asdf_stream_t *stream, size_t max_mappings, size_t granularity) {
+    if (!stream || !stream->mmap_cache)
+        return;
+
+    stream->mmap_cache->max_mappings = max_mappings;
+    stream->mmap_cache->granularity = granularity;
+    stream_mmap_cache_evict(stream, stream->mmap_cache);
+}
+
+
 /**
  * Allows seeking forward unseekable files but only with ``SEEK_CUR`` with a positive offset,
  * otherwise returns an error.
@@ -403,150 +372,341 @@ static int file_flush(asdf_stream_t *stream) {
 }
 
 
-// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
-static void *file_open_mem(asdf_stream_t *stream, off_t offset, size_t size, size_t *avail) {
-    /* TODO: open_mem not supported yet for non-seekable streams (which are not fully supported
-     * yet in general).  Idea would be when reading from a stream there will be option flags
-     * whether or not to buffer block data, and thresholds controlling whether blocks should be
-     * buffered in-memory or to a temp file
-     */
-    assert(stream->is_seekable && "open_mem not supported yet on non-seekable streams");
-    file_userdata_t *data = stream->userdata;
-    int fd = fileno(data->file);
+/**
+ * Cache of file mappings handed out by ``stream->open_mem``
+ *
+ * Shared by the buffered file and windowed mmap stream backends.  Requests are rounded out
+ * to ``granularity``-aligned ranges of the file, so nearby blocks (e.g. the many small
+ * blocks of a catalog-style file) share a single mapping instead of each getting their own
+ * VMA.  Mappings are refcounted by the regions handed out from them; when no longer in use
+ * they are kept around for reuse and only unmapped, least recently used first, when the
+ * cache holds more than ``max_mappings`` of them.
+ *
+ * Mappings are indexed both by file offset (to find one covering a requested range) and by
+ * address (to find the one a region returned by ``open_mem`` belongs to), so that both
+ * lookups are a binary search.
+ */
+static size_t stream_mmap_cache_granularity(const stream_mmap_cache_t *cache) {
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t granularity = cache->granularity;
 
-    if (fd < 0) {
-        ASDF_ERROR_SYSTEM(stream, errno);
-        return NULL;
-    }
+    if (granularity == 0)
+        granularity = ASDF_STREAM_MMAP_CACHE_DEFAULT_GRANULARITY;
 
-    struct stat st;
+    return ((granularity + page_size - 1) / page_size) * page_size;
+}
 
-    if (fstat(fd, &st) != 0) {
-        ASDF_ERROR_SYSTEM(stream, errno);
-        return NULL;
-    }
 
-    size_t file_size = st.st_size;
+static size_t stream_mmap_cache_max_mappings(const stream_mmap_cache_t *cache) {
+    return cache->max_mappings ? cache->max_mappings : ASDF_STREAM_MMAP_CACHE_DEFAULT_MAX_MAPPINGS;
+}
 
-    if ((size_t)offset > file_size) {
-        ASDF_ERROR_SYSTEM(stream, EINVAL);
-        return NULL;
+
+/** Index of the last mapping starting at or before ``offset``, or -1 */
+static ssize_t stream_mmap_cache_bisect_offset(const stream_mmap_cache_t *cache, size_t offset) {
+    ssize_t lo = 0;
+    ssize_t hi = (ssize_t)cache->count;
+
+    while (lo < hi) {
+        ssize_t mid = lo + ((hi - lo) / 2);
+        if (cache->by_offset[mid]->offset <= offset)
+            lo = mid + 1;
+        else
+            hi = mid;
     }
 
-    // Ensure availability in the mmap_info array
-    if (!data->mmaps) {
-        file_mmap_info_t *mmaps = calloc(ASDF_FILE_STREAM_INITIAL_MMAPS, sizeof(file_mmap_info_t));
+    return lo - 1;
+}
 
-        if (!mmaps) {
-            ASDF_ERROR_OOM(stream);
-            return NULL;
-        }
 
-        data->mmaps = mmaps;
-        data->mmaps_size = ASDF_FILE_STREAM_INITIAL_MMAPS;
+/** Index of the last mapping starting at or before ``addr``, or -1 */
+static ssize_t stream_mmap_cache_bisect_addr(const stream_mmap_cache_t *cache, const void *addr) {
+    ssize_t lo = 0;
+    ssize_t hi = (ssize_t)cache->count;
+
+    while (lo < hi) {
+        ssize_t mid = lo + ((hi - lo) / 2);
+        if ((const void *)cache->by_addr[mid]->addr <= addr)
+            lo = mid + 1;
+        else
+            hi = mid;
     }
 
-    // Find free mmap info or allocate more
-    file_mmap_info_t *mmap_info = NULL;
+    return lo - 1;
+}
+
 
-    for (size_t idx = 0; idx < data->mmaps_size; idx++) {
-        file_mmap_info_t *tmp = &data->mmaps[idx];
-        if (NULL == tmp->addr) {
-            mmap_info = tmp;
+/** Find a mapping covering the file range ``[offset, end)``, or NULL */
+static stream_mapping_t *stream_mmap_cache_find_range(
+    const stream_mmap_cache_t *cache, size_t offset, size_t end) {
+    // No mapping is larger than max_size, so only those starting after end - max_size can
+    // cover the range; with mostly non-overlapping mappings this is usually just one
+    for (ssize_t idx = stream_mmap_cache_bisect_offset(cache, offset); idx >= 0; idx--) {
+        stream_mapping_t *mapping = cache->by_offset[idx];
+
+        if (mapping->offset + cache->max_size < end)
             break;
-        }
+
+        if (offset < mapping->offset + mapping->size && end <= mapping->offset + mapping->size)
+            return mapping;
     }
 
-    if (!mmap_info && data->mmaps_size) {
-        size_t new_size = data->mmaps_size * 2;
-        file_mmap_info_t *mmaps = realloc(data->mmaps, new_size * sizeof(*mmaps));
+    return NULL;
+}
 
-        if (!mmaps) {
-            ASDF_ERROR_OOM(stream);
-            return NULL;
-        }
 
-        memset(mmaps + data->mmaps_size, 0, (new_size - data->mmaps_size) * sizeof(*mmaps));
-        data->mmaps = mmaps;
-        mmap_info = &mmaps[data->mmaps_size];
-        data->mmaps_size = new_size;
-    }
+/** Find the mapping containing ``addr``, or NULL */
+static stream_mapping_t *stream_mmap_cache_find_addr(
+    const stream_mmap_cache_t *cache, const void *addr) {
+    ssize_t idx = stream_mmap_cache_bisect_addr(cache, addr);
 
-    if (!mmap_info) {
-        ASDF_ERROR_OOM(stream);
+    if (idx < 0)
         return NULL;
-    }
 
-    size_t max_avail = file_size - offset;
-    size_t map_size = size < max_avail ? size : max_avail;
-    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    stream_mapping_t *mapping = cache->by_addr[idx];
 
-    // Align size and offset to page boundary
-    off_t offset_aligned = offset & ~((off_t)page_size - 1);
-    off_t offset_delta = offset - offset_aligned;
-    size_t map_size_aligned = map_size + offset_delta;
+    if ((const uint8_t *)addr >= mapping->addr + mapping->size)
+        return NULL;
 
-    // TODO: Read-only for now; obviously when writing is introduced this will be passed the
-    // appropriate flags, also need options for copy-on-write behavior etc.
-    void *addr = mmap(NULL, map_size_aligned, PROT_READ, MAP_PRIVATE, fd, offset_aligned);
+    return mapping;
+}
 
-    if (MAP_FAILED == addr) {
-        ASDF_ERROR_SYSTEM(stream, errno);
-        return NULL;
-    }
 
-    // TODO: The ability to pass madvise flags would also be useful esp. for random vs seq access
+static void stream_mmap_cache_lru_remove(stream_mmap_cache_t *cache, stream_mapping_t *mapping) {
+    if (mapping->lru_prev)
+        mapping->lru_prev->lru_next = mapping->lru_next;
+    else
+        cache->lru_head = mapping->lru_next;
 
-    addr += offset_delta;
-    mmap_info->addr = addr;
-    mmap_info->size = map_size_aligned;
-    mmap_info->offset = offset;
+    if (mapping->lru_next)
+        mapping->lru_next->lru_prev = mapping->lru_prev;
+    else
+        cache->lru_tail = mapping->lru_prev;
 
-    if (avail)
-        *avail = map_size;
+    mapping->lru_prev = NULL;
+    mapping->lru_next = NULL;
+}
+
+
+static void stream_mmap_cache_lru_push(stream_mmap_cache_t *cache, stream_mapping_t *mapping) {
+    mapping->lru_prev = cache->lru_tail;
+    mapping->lru_next = NULL;
 
-    return addr;
+    if (cache->lru_tail)
+        cache->lru_tail->lru_next = mapping;
+    else
+        cache->lru_head = mapping;
+
+    cache->lru_tail = mapping;
 }
 
 
-static int file_close_mem_impl(asdf_stream_t *stream, file_mmap_info_t *mmap_info) {
-    int ret = 0;
+static int stream_mmap_cache_insert(
+    asdf_stream_t *stream, stream_mmap_cache_t *cache, stream_mapping_t *mapping) {
+    if (cache->count == cache->capacity) {
+        size_t new_capacity = cache->capacity ? cache->capacity * 2
+                                              : ASDF_FILE_STREAM_INITIAL_MMAPS;
+        stream_mapping_t **by_offset = realloc(
+            cache->by_offset, new_capacity * sizeof(stream_mapping_t *));
 
-    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+        if (!by_offset) {
+            ASDF_ERROR_OOM(stream);
+            return -1;
+        }
 
-    // Align size and offset to page boundary
-    off_t offset = mmap_info->offset;
-    size_t offset_aligned = offset & ~(page_size - 1);
-    size_t offset_delta = offset - offset_aligned;
-    void *aligned_addr = mmap_info->addr - offset_delta;
+        cache->by_offset = by_offset;
+        stream_mapping_t **by_addr = realloc(
+            cache->by_addr, new_capacity * sizeof(stream_mapping_t *));
+
+        if (!by_addr) {
+            ASDF_ERROR_OOM(stream);
+            return -1;
+        }
+
+        cache->by_addr = by_addr;
+        cache->capacity = new_capacity;
+    }
+
+    size_t idx = (size_t)(stream_mmap_cache_bisect_offset(cache, mapping->offset) + 1);
+    memmove(
+        &cache->by_offset[idx + 1],
+        &cache->by_offset[idx],
+        (cache->count - idx) * sizeof(stream_mapping_t *));
+    cache->by_offset[idx] = mapping;
+
+    idx = (size_t)(stream_mmap_cache_bisect_addr(cache, mapping->addr) + 1);
+    memmove(
+        &cache->by_addr[idx + 1],
+        &cache->by_addr[idx],
+        (cache->count - idx) * sizeof(stream_mapping_t *));
+    cache->by_addr[idx] = mapping;
+
+    cache->count++;
 
-    if (0 != munmap(aligned_addr, mmap_info->size)) {
+    if (mapping->size > cache->max_size)
+        cache->max_size = mapping->size;
+
+    return 0;
+}
+
+
+/** Remove a mapping from the cache, unmap and free it */
+static int stream_mmap_cache_unmap(
+    asdf_stream_t *stream, stream_mmap_cache_t *cache, stream_mapping_t *mapping) {
+    int ret = 0;
+    ssize_t idx = stream_mmap_cache_bisect_addr(cache, mapping->addr);
+    assert(idx >= 0 && cache->by_addr[idx] == mapping);
+    memmove(
+        &cache->by_addr[idx],
+        &cache->by_addr[idx + 1],
+        (cache->count - (size_t)idx - 1) * sizeof(stream_mapping_t *));
+
+    // Mappings may share a file offset, so search around the bisection point
+    idx = stream_mmap_cache_bisect_offset(cache, mapping->offset);
+    while (idx >= 0 && cache->by_offset[idx] != mapping)
+        idx--;
+
+    assert(idx >= 0);
+    memmove(
+        &cache->by_offset[idx],
+        &cache->by_offset[idx + 1],
+        (cache->count - (size_t)idx - 1) * sizeof(stream_mapping_t *));
+    cache->count--;
+
+    if (mapping->refcount == 0) {
+        stream_mmap_cache_lru_remove(cache, mapping);
+        cache->n_idle--;
+    }
+
+    if (0 != munmap(mapping->addr, mapping->size)) {
         ASDF_ERROR_SYSTEM(stream, errno);
         ret = -1;
     }
 
-    mmap_info->addr = NULL;
-    mmap_info->size = 0;
-    mmap_info->offset = 0;
+    free(mapping);
     return ret;
 }
 
 
-static int file_close_mem(asdf_stream_t *stream, void *addr) {
-    file_userdata_t *data = stream->userdata;
-    file_mmap_info_t *mmap_info = NULL;
+/** Unmap idle mappings, least recently used first, until the cache is within budget */
+static void stream_mmap_cache_evict(asdf_stream_t *stream, stream_mmap_cache_t *cache) {
+    size_t max_mappings = stream_mmap_cache_max_mappings(cache);
+
+    while (cache->count > max_mappings && cache->lru_head)
+        stream_mmap_cache_unmap(stream, cache, cache->lru_head);
+}
+
+
+/**
+ * Return a pointer to the file range ``[offset, offset + size)``, mapping it if it is not
+ * already covered by a cached mapping
+ */
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+static void *stream_mmap_cache_open(
+    asdf_stream_t *stream,
+    stream_mmap_cache_t *cache,
+    int fd,
+    size_t file_size,
+    off_t offset,
+    size_t size,
+    size_t *avail) {
+    if (offset < 0 || (size_t)offset > file_size) {
+        ASDF_ERROR_SYSTEM(stream, EINVAL);
+        return NULL;
+    }
 
-    if (data->mmaps) {
-        for (size_t idx = 0; idx < data->mmaps_size; idx++) {
-            file_mmap_info_t *tmp = &data->mmaps[idx];
-            if (addr == tmp->addr) {
-                mmap_info = tmp;
+    size_t max_avail = file_size - (size_t)offset;
+    size_t map_size = size < max_avail ? size : max_avail;
+    size_t start = (size_t)offset;
+    size_t end = start + map_size;
+    stream_mapping_t *mapping = stream_mmap_cache_find_range(cache, start, end);
+
+    if (!mapping) {
+        size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+        size_t granularity = stream_mmap_cache_granularity(cache);
+        size_t map_offset = start - (start % granularity);
+        // Round out to the granularity, but not past the page containing the end of the file;
+        // always map at least one byte so that the returned address lies strictly inside the
+        // mapping even for empty regions
+        size_t min_end = end > start ? end : start + 1;
+        size_t map_end = ((min_end + granularity - 1) / granularity) * granularity;
+        size_t file_end = ((file_size + page_size - 1) / page_size) * page_size;
+
+        if (map_end > file_end)
+            map_end = file_end;
+
+        if (map_end <= start)
+            map_end = ((start / page_size) + 1) * page_size;
+
+        // Absorb any idle mappings overlapping the new one; it supersedes them
+        for (ssize_t idx = stream_mmap_cache_bisect_offset(cache, map_end - 1); idx >= 0;
+             idx--) {
+            stream_mapping_t *tmp = cache->by_offset[idx];
+
+            if (tmp->offset + cache->max_size <= map_offset)
                 break;
-            }
+
+            if (tmp->refcount > 0 || tmp->offset + tmp->size <= map_offset)
+                continue;
+
+            if (tmp->offset < map_offset)
+                map_offset = tmp->offset;
+
+            if (tmp->offset + tmp->size > map_end)
+                map_end = tmp->offset + tmp->size;
+
+            stream_mmap_cache_unmap(stream, cache, tmp);
+            // The arrays shifted down; resume the scan from the new end
+            idx = stream_mmap_cache_bisect_offset(cache, map_end - 1) + 1;
+        }
+
+        mapping = calloc(1, sizeof(stream_mapping_t));
+
+        if (!mapping) {
+            ASDF_ERROR_OOM(stream);
+            return NULL;
+        }
+
+        // TODO: Read-only for now; obviously when writing is introduced this will be passed the
+        // appropriate flags, also need options for copy-on-write behavior etc.
+        void *addr = mmap(
+            NULL, map_end - map_offset, PROT_READ, MAP_PRIVATE, fd, (off_t)map_offset);
+
+        if (MAP_FAILED == addr) {
+            ASDF_ERROR_SYSTEM(stream, errno);
+            free(mapping);
+            return NULL;
+        }
+
+        mapping->addr = addr;
+        mapping->offset = map_offset;
+        mapping->size = map_end - map_offset;
+
+        if (stream_mmap_cache_insert(stream, cache, mapping) != 0) {
+            munmap(addr, mapping->size);
+            free(mapping);
+            return NULL;
         }
+    } else if (mapping->refcount == 0) {
+        stream_mmap_cache_lru_remove(cache, mapping);
+        cache->n_idle--;
     }
 
-    if (!mmap_info) {
+    mapping->refcount++;
+    stream_mmap_cache_evict(stream, cache);
+
+    if (avail)
+        *avail = map_size;
+
+    return mapping->addr + (start - mapping->offset);
+}
+
+
+/** Release a region returned by `stream_mmap_cache_open` */
+static int stream_mmap_cache_close(asdf_stream_t *stream, stream_mmap_cache_t *cache, void *addr) {
+    stream_mapping_t *mapping = stream_mmap_cache_find_addr(cache, addr);
+
+    if (!mapping || mapping->refcount == 0) {
         ASDF_LOG(
             stream,
             ASDF_LOG_WARN,
@@ -557,7 +717,189 @@ static int file_close_mem(asdf_stream_t *stream, void *addr) {
         return -1;
     }
 
-    return file_close_mem_impl(stream, mmap_info);
+    if (--mapping->refcount == 0) {
+        stream_mmap_cache_lru_push(cache, mapping);
+        cache->n_idle++;
+        stream_mmap_cache_evict(stream, cache);
+    }
+
+    return 0;
+}
+
+
+/** Unmap all mappings, including any still open when the stream is closed */
+static void stream_mmap_cache_destroy(asdf_stream_t *stream, stream_mmap_cache_t *cache) {
+    while (cache->count > 0)
+        stream_mmap_cache_unmap(stream, cache, cache->by_offset[cache->count - 1]);
+
+    free(cache->by_offset);
+    free(cache->by_addr);
+    ZERO_MEMORY(cache, sizeof(stream_mmap_cache_t));
+}
+
+
+#ifdef HAVE_MADVISE
+static int stream_madvise(asdf_stream_t *stream, void *addr, size_t size, int advice) {
+    if (madvise(addr, size, advice) == 0)
+        return 0;
+
+    ASDF_LOG(
+        stream,
+        ASDF_LOG_DEBUG,
+        "madvise(%p, %zu, %d) failed: %s",
+        addr,
+        size,
+        advice,
+        strerror(errno));
+    return -1;
+}
+#endif
+
+
+#ifdef HAVE_POSIX_FADVISE
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+static int stream_fadvise(asdf_stream_t *stream, int fd, off_t offset, size_t size, int advice) {
+    int err = posix_fadvise(fd, offset, (off_t)size, advice);
+
+    if (err == 0)
+        return 0;
+
+    ASDF_LOG(
+        stream,
+        ASDF_LOG_DEBUG,
+        "posix_fadvise(%d, %lld, %zu, %d) failed: %s",
+        fd,
+        (long long)offset,
+        size,
+        advice,
+        strerror(err));
+    return -1;
+}
+#endif
+
+
+/**
+ * Apply access hints to a region mapped from ``fd`` at file offset ``offset``
+ *
+ * Each hint is passed on to ``madvise`` for the mapping itself and, where it has an
+ * equivalent, to ``posix_fadvise`` for the underlying file range (which also informs the
+ * page cache read-ahead).  Hints are advisory so failures are only logged at debug level.
+ */
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+static int stream_advise_region(
+    asdf_stream_t *stream,
+    int fd,
+    void *addr,
+    off_t offset,
+    size_t size,
+    asdf_access_hint_t hint) {
+    int ret = 0;
+
+    if (!addr || size == 0 || hint == ASDF_ACCESS_HINT_NONE)
+        return 0;
+
+#ifdef HAVE_MADVISE
+    // madvise requires a page-aligned address
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t addr_delta = (uintptr_t)addr & (page_size - 1);
+    void *addr_aligned = (uint8_t *)addr - addr_delta;
+    size_t size_aligned = size + addr_delta;
+
+    if (hint & ASDF_ACCESS_HINT_NORMAL)
+        ret |= stream_madvise(stream, addr_aligned, size_aligned, MADV_NORMAL);
+
+    if (hint & ASDF_ACCESS_HINT_SEQUENTIAL)
+        ret |= stream_madvise(stream, addr_aligned, size_aligned, MADV_SEQUENTIAL);
+
+    if (hint & ASDF_ACCESS_HINT_RANDOM)
+        ret |= stream_madvise(stream, addr_aligned, size_aligned, MADV_RANDOM);
+
+    if (hint & ASDF_ACCESS_HINT_WILLNEED)
+        ret |= stream_madvise(stream, addr_aligned, size_aligned, MADV_WILLNEED);
+
+    if (hint & ASDF_ACCESS_HINT_HUGEPAGE) {
+#ifdef MADV_HUGEPAGE
+        ret |= stream_madvise(stream, addr_aligned, size_aligned, MADV_HUGEPAGE);
+#else
+        ret = -1;
+#endif
+    }
+
+    // Safe for our read-only private mappings: dropped pages are re-read from the file
+    if (hint & ASDF_ACCESS_HINT_DONTNEED)
+        ret |= stream_madvise(stream, addr_aligned, size_aligned, MADV_DONTNEED);
+#else
+    (void)addr;
+    ret = -1;
+#endif
+
+#ifdef HAVE_POSIX_FADVISE
+    if (hint & ASDF_ACCESS_HINT_NORMAL)
+        ret |= stream_fadvise(stream, fd, offset, size, POSIX_FADV_NORMAL);
+
+    if (hint & ASDF_ACCESS_HINT_SEQUENTIAL)
+        ret |= stream_fadvise(stream, fd, offset, size, POSIX_FADV_SEQUENTIAL);
+
+    if (hint & ASDF_ACCESS_HINT_RANDOM)
+        ret |= stream_fadvise(stream, fd, offset, size, POSIX_FADV_RANDOM);
+
+    if (hint & ASDF_ACCESS_HINT_WILLNEED)
+        ret |= stream_fadvise(stream, fd, offset, size, POSIX_FADV_WILLNEED);
+
+    if (hint & ASDF_ACCESS_HINT_DONTNEED)
+        ret |= stream_fadvise(stream, fd, offset, size, POSIX_FADV_DONTNEED);
+#else
+    (void)fd;
+    (void)offset;
+#endif
+
+    return ret ? -1 : 0;
+}
+
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+static void *file_open_mem(asdf_stream_t *stream, off_t offset, size_t size, size_t *avail) {
+    /* TODO: open_mem not supported yet for non-seekable streams (which are not fully supported
+     * yet in general).  Idea would be when reading from a stream there will be option flags
+     * whether or not to buffer block data, and thresholds controlling whether blocks should be
+     * buffered in-memory or to a temp file
+     */
+    assert(stream->is_seekable && "open_mem not supported yet on non-seekable streams");
+    file_userdata_t *data = stream->userdata;
+    int fd = fileno(data->file);
+
+    if (fd < 0) {
+        ASDF_ERROR_SYSTEM(stream, errno);
+        return NULL;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0) {
+        ASDF_ERROR_SYSTEM(stream, errno);
+        return NULL;
+    }
+
+    return stream_mmap_cache_open(stream, &data->mmaps, fd, st.st_size, offset, size, avail);
+}
+
+
+static int file_close_mem(asdf_stream_t *stream, void *addr) {
+    file_userdata_t *data = stream->userdata;
+    return stream_mmap_cache_close(stream, &data->mmaps, addr);
+}
+
+
+static int file_advise_mem(
+    asdf_stream_t *stream, void *addr, size_t size, asdf_access_hint_t hint) {
+    file_userdata_t *data = stream->userdata;
+    stream_mapping_t *mapping = stream_mmap_cache_find_addr(&data->mmaps, addr);
+
+    if (!mapping)
+        return -1;
+
+    off_t offset = (off_t)(mapping->offset + ((uint8_t *)addr - mapping->addr));
+    return stream_advise_region(stream, fileno(data->file), addr, offset, size, hint);
 }
 
 
@@ -570,15 +912,7 @@ static void file_close(asdf_stream_t *stream) {
     free(data->buf);
 
     // If there are open mmaps close them too
-    if (data->mmaps) {
-        for (size_t idx = 0; idx < data->mmaps_size; idx++) {
-            file_mmap_info_t mmap_info = data->mmaps[idx];
-            if (mmap_info.addr)
-                file_close_mem_impl(stream, &mmap_info);
-        }
-        free(data->mmaps);
-    }
-
+    stream_mmap_cache_destroy(stream, &data->mmaps);
     free(data);
     asdf_context_release(stream->base.ctx);
     free(stream);
@@ -664,6 +998,7 @@ asdf_stream_t *asdf_stream_from_fp(
     stream->is_seekable = file_is_seekable(file);
     stream->is_writeable = is_writeable;
     stream->userdata = data;
+    stream->mmap_cache = &data->mmaps;
     stream->next = file_next;
     stream->consume = file_consume;
     stream->readline = file_readline;
@@ -675,6 +1010,8 @@ asdf_stream_t *asdf_stream_from_fp(
     stream->seek = file_seek;
     stream->open_mem = file_open_mem;
     stream->close_mem = file_close_mem;
+    stream->advise_mem = file_advise_mem;
+    stream->view = NULL;
     stream->close = file_close;
     stream->fy_parser_set_input = file_fy_parser_set_input;
     asdf_stream_set_capture(stream, NULL, NULL, 0);
@@ -710,13 +1047,549 @@ asdf_stream_t *asdf_stream_from_file(asdf_context_t *ctx, const char *filename,
 
 
 /**
- * Memory-backed read handling
+ * Memory-mapped file read handling
+ *
+ * Maps the file once (or, for huge files and small address spaces, a sliding window over
+ * it) so that next/readline/scan/open_mem all return pointers directly into the mapping
+ * rather than copying through a read buffer.
  */
-static const uint8_t *mem_next(asdf_stream_t *stream, UNUSED(size_t count), size_t *avail) {
-    assert(stream);
-    assert(avail);
-    mem_userdata_t *data = stream->userdata;
-    if (data->pos >= data->size) {
+static int mmap_window_remap(asdf_stream_t *stream, size_t offset, size_t min_len) {
+    mmap_userdata_t *data = stream->userdata;
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t offset_aligned = offset & ~(page_size - 1);
+    size_t len = (offset - offset_aligned) + min_len;
+
+    assert(offset < data->file_size);
+
+    if (len < data->window_size)
+        len = data->window_size;
+
+    if (len > data->file_size - offset_aligned)
+        len = data->file_size - offset_aligned;
+
+    if (data->win) {
+        munmap(data->win, data->win_len);
+        data->win = NULL;
+        data->win_offset = 0;
+        data->win_len = 0;
+    }
+
+    void *addr = mmap(NULL, len, PROT_READ, MAP_PRIVATE, data->fd, (off_t)offset_aligned);
+
+    if (MAP_FAILED == addr) {
+        ASDF_ERROR_SYSTEM(stream, errno);
+        return -1;
+    }
+
+    data->win = addr;
+    data->win_offset = offset_aligned;
+    data->win_len = len;
+    return 0;
+}
+
+
+static const uint8_t *mmap_next(asdf_stream_t *stream, size_t count, size_t *avail) {
+    assert(stream);
+    assert(avail);
+    mmap_userdata_t *data = stream->userdata;
+
+    if (data->pos >= data->file_size) {
+        *avail = 0;
+        return NULL;
+    }
+
+    size_t remaining = data->file_size - data->pos;
+    size_t need = count < remaining ? count : remaining;
+
+    if (need == 0)
+        need = 1;
+
+    // Only ever true in windowed mode; when the whole file is mapped the window always
+    // covers the requested range
+    if (!data->win || data->pos < data->win_offset ||
+        data->pos + need > data->win_offset + data->win_len) {
+        if (0 != mmap_window_remap(stream, data->pos, need)) {
+            *avail = 0;
+            return NULL;
+        }
+    }
+
+    *avail = data->win_offset + data->win_len - data->pos;
+    return data->win + (data->pos - data->win_offset);
+}
+
+
+static void mmap_consume(asdf_stream_t *stream, size_t count) {
+    assert(stream);
+    mmap_userdata_t *data = stream->userdata;
+
+    if (count > 0 && data->win && data->pos >= data->win_offset) {
+        size_t win_avail = data->win_offset + data->win_len - data->pos;
+        stream_capture(
+            stream,
+            data->win + (data->pos - data->win_offset),
+            count < win_avail ? count : win_avail);
+    }
+
+    data->pos += count;
+
+    if (data->pos > data->file_size)
+        data->pos = data->file_size;
+}
+
+
+static const uint8_t *mmap_readline(asdf_stream_t *stream, size_t *len) {
+    mmap_userdata_t *data = stream->userdata;
+    size_t want = 0;
+
+    while (true) {
+        size_t avail = 0;
+        const uint8_t *buf = mmap_next(stream, want, &avail);
+
+        if (!buf || avail == 0) {
+            *len = 0;
+            return NULL;
+        }
+
+        const uint8_t *newline = memchr(buf, '\n', avail);
+
+        if (newline || data->pos + avail >= data->file_size) {
+            size_t line_len = newline ? (size_t)(newline - buf) + 1 : avail;
+            mmap_consume(stream, line_len);
+            *len = line_len;
+            return buf;
+        }
+
+        // The line runs past the end of the current window; remap a larger one starting
+        // at the beginning of the line
+        want = avail * 2;
+    }
+}
+
+
+static int mmap_scan(
+    struct asdf_stream *stream,
+    const uint8_t **tokens,
+    const size_t *token_lens,
+    size_t n_tokens,
+    // NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+    size_t *match_offset,
+    size_t *match_token_idx) {
+    mmap_userdata_t *data = stream->userdata;
+    size_t max_token_len = 0;
+
+    for (size_t idx = 0; idx < n_tokens; idx++) {
+        if (token_lens[idx] > max_token_len)
+            max_token_len = token_lens[idx];
+    }
+
+    if (max_token_len == 0)
+        return 1;
+
+    while (true) {
+        size_t avail = 0;
+        size_t offset = 0;
+        size_t token_idx = 0;
+        const uint8_t *buf = mmap_next(stream, max_token_len, &avail);
+
+        if (!buf)
+            return 1;
+
+        int res = asdf_scan_tokens(buf, avail, tokens, token_lens, n_tokens, &offset, &token_idx);
+
+        if (0 == res) {
+            if (match_offset)
+                *match_offset = data->pos + offset;
+
+            if (match_token_idx)
+                *match_token_idx = token_idx;
+
+            mmap_consume(stream, offset);
+            return res;
+        }
+
+        if (data->pos + avail >= data->file_size) {
+            mmap_consume(stream, avail);
+            return 1;
+        }
+
+        // Not at EOF so the window holds at least max_token_len bytes; keep the last
+        // (max_token_len - 1) of them in case a token straddles the window boundary
+        mmap_consume(stream, avail - (max_token_len - 1));
+    }
+}
+
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+static int mmap_seek(asdf_stream_t *stream, off_t offset, int whence) {
+    mmap_userdata_t *data = stream->userdata;
+    off_t base = 0;
+
+    switch (whence) {
+    case SEEK_SET:
+        base = 0;
+        break;
+    case SEEK_CUR:
+        base = (off_t)data->pos;
+        break;
+    case SEEK_END:
+        base = (off_t)data->file_size;
+        break;
+    default:
+        ASDF_ERROR_SYSTEM(stream, EINVAL);
+        return -1;
+    }
+
+    if ((offset < 0 && -offset > base) || (offset > 0 && offset > (off_t)ASDF_OFF_MAX - base)) {
+        ASDF_ERROR_SYSTEM(stream, EINVAL);
+        return -1;
+    }
+
+    data->pos = (size_t)(base + offset);
+    return 0;
+}
+
+
+static off_t mmap_tell(asdf_stream_t *stream) {
+    mmap_userdata_t *data = stream->userdata;
+
+    if (data->pos > ASDF_OFF_MAX)
+        return -1;
+
+    return (off_t)data->pos;
+}
+
+
+static size_t mmap_write(
+    asdf_stream_t *stream, UNUSED(const void *buf), UNUSED(size_t count)) {
+    ASDF_ERROR_COMMON(stream, ASDF_ERR_STREAM_READ_ONLY);
+    return 0;
+}
+
+
+static int mmap_flush(asdf_stream_t *stream) {
+    ASDF_ERROR_COMMON(stream, ASDF_ERR_STREAM_READ_ONLY);
+    return -1;
+}
+
+
+// NOLINTNEXTLINE(bugprone-easily-swappable-parameters)
+static void *mmap_open_mem(asdf_stream_t *stream, off_t offset, size_t size, size_t *avail) {
+    mmap_userdata_t *data = stream->userdata;
+
+    if (data->window_size > 0)
+        // The window may be remapped at any time so hand out an independent mapping
+        return stream_mmap_cache_open(
+            stream, &data->mmaps, data->fd, data->file_size, offset, size, avail);
+
+    // The whole file is mapped; just return a pointer into it
+    if (offset < 0 || (size_t)offset > data->file_size || !data->win) {
+        if (avail)
+            *avail = 0;
+
+        ASDF_ERROR_SYSTEM(stream, EINVAL);
+        return NULL;
+    }
+
+    if (avail) {
+        size_t remaining = data->file_size - (size_t)offset;
+        *avail = (size <= remaining) ? size : remaining;
+    }
+
+    return data->win + offset;
+}
+
+
+static int mmap_close_mem(asdf_stream_t *stream, void *addr) {
+    mmap_userdata_t *data = stream->userdata;
+
+    if (data->window_size > 0)
+        return stream_mmap_cache_close(stream, &data->mmaps, addr);
+
+    if ((uint8_t *)addr < data->win || (uint8_t *)addr > data->win + data->file_size) {
+        ASDF_LOG(
+            stream,
+            ASDF_LOG_WARN,
+            "stream->close_mem on memory address not belonging to this stream's mapping (%p)",
+            addr);
+        ASDF_ERROR_SYSTEM(stream, EINVAL);
+        return -1;
+    }
+
+    // Released along with the rest of the mapping when the stream is closed
+    return 0;
+}
+
+
+static int mmap_advise_mem(
+    asdf_stream_t *stream, void *addr, size_t size, asdf_access_hint_t hint) {
+    mmap_userdata_t *data = stream->userdata;
+    off_t offset = 0;
+
+    if (data->window_size > 0) {
+        stream_mapping_t *mapping = stream_mmap_cache_find_addr(&data->mmaps, addr);
+
+        if (!mapping)
+            return -1;
+
+        offset = (off_t)(mapping->offset + ((uint8_t *)addr - mapping->addr));
+    } else {
+        if ((uint8_t *)addr < data->win || (uint8_t *)addr > data->win + data->file_size)
+            return -1;
+
+        offset = (uint8_t *)addr - data->win;
+    }
+
+    return stream_advise_region(stream, data->fd, addr, offset, size, hint);
+}
+
+
+static const uint8_t *mmap_view(asdf_stream_t *stream, off_t offset, size_t size) {
+    mmap_userdata_t *data = stream->userdata;
+
+    // In windowed mode the window may be remapped at any time
+    if (data->window_size > 0 || !data->win)
+        return NULL;
+
+    if (offset < 0 || (size_t)offset > data->file_size || size > data->file_size - (size_t)offset)
+        return NULL;
+
+    return data->win + offset;
+}
+
+
+static void mmap_close(asdf_stream_t *stream) {
+    mmap_userdata_t *data = stream->userdata;
+
+    if (data->win)
+        munmap(data->win, data->win_len);
+
+    stream_mmap_cache_destroy(stream, &data->mmaps);
+
+    if (data->file)
+        fclose(data->file);
+
+    close(data->fd);
+    free(data);
+    asdf_context_release(stream->base.ctx);
+    free(stream);
+}
+
+
+static int mmap_fy_parser_set_input(asdf_stream_t *stream, struct fy_parser *fyp) {
+    mmap_userdata_t *data = stream->userdata;
+
+    if (data->window_size == 0) {
+        if (!data->win || data->pos >= data->file_size)
+            return -1;
+
+        return fy_parser_set_string(
+            fyp, (const char *)data->win + data->pos, data->file_size - data->pos);
+    }
+
+    // In windowed mode libfyaml reads the rest of the file through its own FILE * (on a
+    // duplicate of our descriptor) since the window can be remapped under it
+    if (!data->file) {
+        int fd = dup(data->fd);
+
+        if (fd < 0) {
+            ASDF_ERROR_SYSTEM(stream, errno);
+            return -1;
+        }
+
+        data->file = fdopen(fd, "rb");
+
+        if (!data->file) {
+            ASDF_ERROR_SYSTEM(stream, errno);
+            close(fd);
+            return -1;
+        }
+    }
+
+    if (fseeko(data->file, (off_t)data->pos, SEEK_SET) != 0) {
+        ASDF_ERROR_SYSTEM(stream, errno);
+        return -1;
+    }
+
+    return fy_parser_set_input_fp(fyp, data->filename, data->file);
+}
+
+
+int asdf_stream_fd(asdf_stream_t *stream) {
+    if (!stream)
+        return -1;
+
+    if (stream->close == mmap_close) {
+        mmap_userdata_t *data = stream->userdata;
+        return data->fd;
+    }
+
+    if (stream->close == file_close) {
+        file_userdata_t *data = stream->userdata;
+        return fileno(data->file);
+    }
+
+    return -1;
+}
+
+
+/**
+ * Map the whole file if the address space allows it, otherwise set up windowed mode
+ *
+ * Returns non-zero if even the first window could not be mapped.
+ */
+static int mmap_stream_map_initial(asdf_stream_t *stream) {
+    mmap_userdata_t *data = stream->userdata;
+
+    if (data->file_size == 0)
+        return 0;
+
+    if (data->window_size == 0) {
+        void *addr = mmap(NULL, data->file_size, PROT_READ, MAP_PRIVATE, data->fd, 0);
+
+        if (MAP_FAILED != addr) {
+            data->win = addr;
+            data->win_offset = 0;
+            data->win_len = data->file_size;
+            return 0;
+        }
+
+        if (errno != ENOMEM)
+            return -1;
+
+        // Not enough contiguous address space; fall back to a window
+        data->window_size = ASDF_MMAP_STREAM_DEFAULT_WINDOW_SIZE;
+    }
+
+    return mmap_window_remap(stream, 0, 1);
+}
+
+
+asdf_stream_t *asdf_stream_from_file_mmap(
+    asdf_context_t *ctx, const char *filename, size_t window_size) {
+    int fd = open(filename, O_RDONLY | O_CLOEXEC);
+
+    if (fd < 0) {
+        asdf_context_error_set_system(ctx, errno, __FILE__, __LINE__);
+        return NULL;
+    }
+
+    struct stat st;
+
+    if (fstat(fd, &st) != 0) {
+        asdf_context_error_set_system(ctx, errno, __FILE__, __LINE__);
+        close(fd);
+        return NULL;
+    }
+
+    if (!S_ISREG(st.st_mode) || st.st_size < 0) {
+        // Not an error as such, but the caller should fall back to a buffered stream
+        ASDF_LOG_CTX(ctx, ASDF_LOG_DEBUG, "%s is not a regular file; cannot mmap", filename);
+        close(fd);
+        return NULL;
+    }
+
+    size_t file_size = (size_t)st.st_size;
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+
+    // On 32-bit address spaces only map the whole file if it is reasonably small
+    if (window_size == 0 && SIZE_MAX <= UINT32_MAX &&
+        file_size > ASDF_MMAP_STREAM_DEFAULT_WINDOW_SIZE)
+        window_size = ASDF_MMAP_STREAM_DEFAULT_WINDOW_SIZE;
+
+    if (window_size > 0) {
+        window_size = (window_size + page_size - 1) & ~(page_size - 1);
+
+        // A window at least as large as the file is the same as mapping the whole thing
+        if (window_size >= file_size)
+            window_size = 0;
+    }
+
+    mmap_userdata_t *data = calloc(1, sizeof(mmap_userdata_t));
+
+    if (!data) {
+        asdf_context_error_set_oom(ctx ? ctx : asdf_get_context_helper(NULL), __FILE__, __LINE__);
+        close(fd);
+        return NULL;
+    }
+
+    data->fd = fd;
+    data->filename = filename;
+    data->file_size = file_size;
+    data->window_size = window_size;
+
+    asdf_stream_t *stream = calloc(1, sizeof(asdf_stream_t));
+
+    if (!stream) {
+        asdf_context_error_set_oom(ctx ? ctx : asdf_get_context_helper(NULL), __FILE__, __LINE__);
+        free(data);
+        close(fd);
+        return NULL;
+    }
+
+    if (!ctx) {
+        ctx = asdf_context_create(NULL);
+
+        if (!ctx) {
+            ASDF_ERROR_OOM(NULL);
+            free(data);
+            free(stream);
+            close(fd);
+            return NULL;
+        }
+    } else {
+        // Share an existing reference to the context
+        asdf_context_retain(ctx);
+    }
+
+    stream->base.ctx = ctx;
+    stream->is_seekable = true;
+    stream->is_writeable = false;
+    stream->userdata = data;
+    // Only used in windowed mode, but harmless to configure otherwise
+    stream->mmap_cache = &data->mmaps;
+    stream->next = mmap_next;
+    stream->consume = mmap_consume;
+    stream->readline = mmap_readline;
+    stream->scan = mmap_scan;
+    stream->seek = mmap_seek;
+    stream->tell = mmap_tell;
+    stream->write = mmap_write;
+    stream->flush = mmap_flush;
+    stream->open_mem = mmap_open_mem;
+    stream->close_mem = mmap_close_mem;
+    stream->advise_mem = mmap_advise_mem;
+    stream->view = mmap_view;
+    stream->close = mmap_close;
+    stream->fy_parser_set_input = mmap_fy_parser_set_input;
+    asdf_stream_set_capture(stream, NULL, NULL, 0);
+
+#if DEBUG
+    stream->last_next_size = 0;
+    stream->last_next_ptr = NULL;
+    stream->unconsumed_next_count = 0;
+#endif
+
+    if (0 != mmap_stream_map_initial(stream)) {
+        ASDF_LOG(stream, ASDF_LOG_DEBUG, "failed to mmap %s", filename);
+        // Drop any error set by the failed mapping; the caller falls back to buffered reads
+        ASDF_ERROR_COMMON(stream, ASDF_ERR_NONE);
+        mmap_close(stream);
+        return NULL;
+    }
+
+    return stream;
+}
+
+
+/**
+ * Memory-backed read handling
+ */
+static const uint8_t *mem_next(asdf_stream_t *stream, UNUSED(size_t count), size_t *avail) {
+    assert(stream);
+    assert(avail);
+    mem_userdata_t *data = stream->userdata;
+    if (data->pos >= data->size) {
         *avail = 0;
         return NULL;
     }
@@ -906,6 +1779,33 @@ static int mem_close_mem(asdf_stream_t *stream, void *addr) {
 }
 
 
+/**
+ * No-op: the buffer is not a file mapping owned by the stream (and hints like
+ * ``MADV_DONTNEED`` would discard anonymous memory outright)
+ */
+static int mem_advise_mem(
+    UNUSED(asdf_stream_t *stream),
+    UNUSED(void *addr),
+    UNUSED(size_t size),
+    UNUSED(asdf_access_hint_t hint)) {
+    return 0;
+}
+
+
+static const uint8_t *mem_view(asdf_stream_t *stream, off_t offset, size_t size) {
+    mem_userdata_t *data = stream->userdata;
+
+    // A resizeable buffer may be reallocated by subsequent writes
+    if (data->is_resizeable)
+        return NULL;
+
+    if (offset < 0 || (size_t)offset > data->size || size > data->size - (size_t)offset)
+        return NULL;
+
+    return data->buf + offset;
+}
+
+
 static void mem_close(asdf_stream_t *stream) {
     free(stream->userdata);
     asdf_context_release(stream->base.ctx);
@@ -958,6 +1858,7 @@ asdf_stream_t *asdf_stream_from_memory(asdf_context_t *ctx, const void *buf, siz
     stream->is_writeable = true;
     stream->is_seekable = true;
     stream->userdata = data;
+    stream->mmap_cache = NULL;
     stream->next = mem_next;
     stream->consume = mem_consume;
     stream->readline = mem_readline;
@@ -968,6 +1869,8 @@ asdf_stream_t *asdf_stream_from_memory(asdf_context_t *ctx, const void *buf, siz
     stream->flush = mem_flush;
     stream->open_mem = mem_open_mem;
     stream->close_mem = mem_close_mem;
+    stream->advise_mem = mem_advise_mem;
+    stream->view = mem_view;
     stream->close = mem_close;
     stream->fy_parser_set_input = mem_fy_parser_set_input;
     asdf_stream_set_capture(stream, NULL, NULL, 0);
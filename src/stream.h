@@ -12,11 +12,17 @@
 
 #include <libfyaml.h>
 
+#include "asdf/file.h"
 #include "context.h"
 #include "log.h"
+#include "scan.h" // IWYU pragma: export
 #include "util.h"
 
 
+// Forward-declaration; see stream_intern.h
+struct stream_mmap_cache;
+
+
 // TODO: Document this once things shake out
 typedef struct asdf_stream {
     asdf_base_t base;
@@ -25,6 +31,9 @@ typedef struct asdf_stream {
 
     void *userdata;
 
+    /* Cache of mappings for open_mem, for backends that map the file; otherwise NULL */
+    struct stream_mmap_cache *mmap_cache;
+
     /* Optional stream capture buffer */
     uint8_t **capture_buf;
     size_t *capture_size;
@@ -46,6 +55,10 @@ typedef struct asdf_stream {
     int (*flush)(struct asdf_stream *stream);
     void *(*open_mem)(struct asdf_stream *stream, off_t offset, size_t size, size_t *avail);
     int (*close_mem)(struct asdf_stream *stream, void *addr);
+    int (*advise_mem)(
+        struct asdf_stream *stream, void *addr, size_t size, asdf_access_hint_t hint);
+    /* Optional; NULL for backends whose contents are not all addressable in memory */
+    const uint8_t *(*view)(struct asdf_stream *stream, off_t offset, size_t size);
     void (*close)(struct asdf_stream *stream);
     int (*fy_parser_set_input)(struct asdf_stream *stream, struct fy_parser *fyp);
 
@@ -157,6 +170,34 @@ static inline int asdf_stream_flush(asdf_stream_t *stream) {
 }
 
 
+/**
+ * Pass access-pattern hints for memory returned by ``stream->open_mem`` on to the OS
+ *
+ * Hints are advisory, so failures are logged but never set an error.  Returns 0 if all
+ * hints were applied.
+ */
+static inline int asdf_stream_advise_mem(
+    asdf_stream_t *stream, void *addr, size_t size, asdf_access_hint_t hint) {
+    return stream->advise_mem(stream, addr, size, hint);
+}
+
+
+/**
+ * Return a pointer directly to ``size`` bytes of the stream's contents at ``offset``
+ *
+ * Unlike ``stream->open_mem`` this is only supported where the stream's full contents stay
+ * addressable, unchanged, for as long as the stream is open (a read-only memory buffer, or a
+ * file mapped in full), so the pointer needs no release.  Returns NULL otherwise, or if the
+ * range is out of bounds, in which case the bytes have to be read through the stream.
+ */
+static inline const uint8_t *asdf_stream_view(asdf_stream_t *stream, off_t offset, size_t size) {
+    if (!stream->view)
+        return NULL;
+
+    return stream->view(stream, offset, size);
+}
+
+
 static inline void asdf_stream_close(asdf_stream_t *stream) {
     if (!stream)
         return;
@@ -169,20 +210,42 @@ ASDF_LOCAL int asdf_stream_seek(asdf_stream_t *stream, off_t offset, int whence)
 
 ASDF_LOCAL asdf_stream_t *asdf_stream_from_file(
     asdf_context_t *ctx, const char *filename, bool is_writeable);
+/**
+ * Open a read-only stream backed by a memory mapping of ``filename``
+ *
+ * If ``window_size`` is 0 the whole file is mapped at once where the address space allows;
+ * otherwise (or if mapping the whole file fails) a sliding window of roughly
+ * ``window_size`` bytes is mapped and moved as the stream advances.
+ *
+ * Returns `NULL` with an error set if the file could not be opened.  Returns `NULL`
+ * *without* an error set if the file cannot be memory-mapped (e.g. it is not a regular
+ * file), in which case callers should fall back to `asdf_stream_from_file`.
+ */
+ASDF_LOCAL asdf_stream_t *asdf_stream_from_file_mmap(
+    asdf_context_t *ctx, const char *filename, size_t window_size);
 ASDF_LOCAL asdf_stream_t *asdf_stream_from_fp(
     asdf_context_t *ctx, FILE *file, const char *filename, bool is_writeable);
 ASDF_LOCAL asdf_stream_t *asdf_stream_from_memory(
     asdf_context_t *ctx, const void *buf, size_t size);
 ASDF_LOCAL asdf_stream_t *asdf_stream_from_malloc(asdf_context_t *ctx, void **buf, size_t *size);
 
+/**
+ * Set the limits of the cache of mappings used by ``open_mem``
+ *
+ * Up to ``max_mappings`` mappings are kept before idle ones are unmapped, and mappings are
+ * aligned to ``granularity`` bytes so that nearby regions share one.  Either may be 0 for
+ * the default.  Has no effect on streams that do not map the file.
+ */
+ASDF_LOCAL void asdf_stream_set_mmap_cache_limits(
+    asdf_stream_t *stream, size_t max_mappings, size_t granularity);
+
+/**
+ * Return the file descriptor of the file underlying the stream
+ *
+ * Returns -1 for streams not backed by a file, such as in-memory streams.  The descriptor
+ * is still owned by the stream and must not be closed by the caller.
+ */
+ASDF_LOCAL int asdf_stream_fd(asdf_stream_t *stream);
+
 ASDF_LOCAL void asdf_stream_set_capture(
     asdf_stream_t *stream, uint8_t **buf, size_t *size, size_t capacity);
-
-ASDF_LOCAL int asdf_scan_tokens(
-    const uint8_t *buf,
-    size_t len,
-    const uint8_t **tokens,
-    const size_t *token_lens,
-    size_t n_tokens,
-    size_t *match_offset,
-    size_t *match_token_idx);
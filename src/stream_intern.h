@@ -8,15 +8,61 @@
 #include <stdio.h>
 
 
-/* Should be more than enough for most ASDF files, though some extreme ones will need many more */
+/* Initial capacity of the mmap cache index; grows as needed */
 #define ASDF_FILE_STREAM_INITIAL_MMAPS 256
 
 
-typedef struct {
-    void *addr;
+/**
+ * Default maximum number of mappings kept by the mmap cache (in use or idle) before idle
+ * ones are unmapped
+ */
+#define ASDF_STREAM_MMAP_CACHE_DEFAULT_MAX_MAPPINGS 1024
+
+
+/**
+ * Default granularity to which mmap cache mappings are aligned, so that nearby regions
+ * share a mapping
+ */
+#define ASDF_STREAM_MMAP_CACHE_DEFAULT_GRANULARITY (1024 * 1024)
+
+
+/**
+ * Default window size for the mmap stream when the whole file cannot (or should not) be
+ * mapped at once, e.g. on 32-bit address spaces
+ */
+#define ASDF_MMAP_STREAM_DEFAULT_WINDOW_SIZE (64 * 1024 * 1024)
+
+
+/** A mapping of a range of the file, shared by all ``open_mem`` regions within it */
+typedef struct stream_mapping {
+    uint8_t *addr;
+    // Page-aligned file offset and length of the mapping
+    size_t offset;
     size_t size;
-    off_t offset;
-} file_mmap_info_t;
+    // Number of regions handed out by open_mem not yet closed
+    size_t refcount;
+    // Links in the LRU list of idle (refcount == 0) mappings
+    struct stream_mapping *lru_prev;
+    struct stream_mapping *lru_next;
+} stream_mapping_t;
+
+
+typedef struct stream_mmap_cache {
+    // All mappings sorted by file offset, and by address
+    stream_mapping_t **by_offset;
+    stream_mapping_t **by_addr;
+    size_t count;
+    size_t capacity;
+    // Size of the largest mapping, which bounds lookups by file offset
+    size_t max_size;
+    // Idle mappings, least recently used first
+    stream_mapping_t *lru_head;
+    stream_mapping_t *lru_tail;
+    size_t n_idle;
+    // Limits; 0 for the defaults
+    size_t max_mappings;
+    size_t granularity;
+} stream_mmap_cache_t;
 
 
 typedef struct {
@@ -29,14 +75,31 @@ typedef struct {
     size_t buf_pos;
     size_t file_pos;
 
-    // Array of pointers to mmap'd memory regions
-    // Realistically these are for (non-overlapping) block data, so we simply track an
-    // Array of addresses and their sizes
-    file_mmap_info_t *mmaps;
-    size_t mmaps_size;
+    // Mappings of block data handed out by open_mem
+    stream_mmap_cache_t mmaps;
 } file_userdata_t;
 
 
+typedef struct {
+    int fd;
+    const char *filename;
+    size_t file_size;
+    size_t pos;
+    // Size of the sliding window; 0 if the whole file is mapped at once
+    size_t window_size;
+    // Current mapping (page-aligned) and the file offset and length it covers
+    uint8_t *win;
+    size_t win_offset;
+    size_t win_len;
+    // Only used by fy_parser_set_input in windowed mode
+    FILE *file;
+
+    // Independent mappings handed out by open_mem in windowed mode, where the window itself
+    // may be remapped at any time
+    stream_mmap_cache_t mmaps;
+} mmap_userdata_t;
+
+
 typedef struct {
     const uint8_t *buf;
     size_t size;
@@ -0,0 +1,345 @@
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <libfyaml.h>
+
+#include "file.h"
+#include "log.h"
+#include "tag_index.h"
+#include "types/asdf_tag_index_links.h"
+#include "types/asdf_tag_index_map.h"
+#include "util.h"
+#include "yaml.h"
+
+
+/** Size of the stack buffer used to null-terminate tags and keys; longer ones go on the heap */
+#define ASDF_TAG_INDEX_NAME_BUF_SIZE 256
+
+/** Initial size of the stack of nodes remaining to visit when building the index */
+#define ASDF_TAG_INDEX_STACK_MIN_CAPACITY 64
+
+
+struct asdf_tag_index {
+    asdf_tag_index_map_t tags;
+    asdf_tag_index_map_t keys;
+    asdf_tag_index_links_t links;
+};
+
+
+/** Append ``node`` to the chain for ``name`` (not necessarily null-terminated) in ``map`` */
+static bool asdf_tag_index_add(
+    asdf_tag_index_t *index,
+    asdf_tag_index_map_t *map,
+    const char *name,
+    size_t len,
+    struct fy_node *node) {
+    char buf[ASDF_TAG_INDEX_NAME_BUF_SIZE];
+    char *name0 = buf;
+
+    if (UNLIKELY(len >= sizeof(buf))) {
+        name0 = malloc(len + 1);
+
+        if (!name0)
+            return false;
+    }
+
+    memcpy(name0, name, len);
+    name0[len] = '\0';
+
+    ssize_t idx = (ssize_t)asdf_tag_index_links_size(&index->links);
+    asdf_tag_index_link_t link = {.node = node, .next = -1};
+    asdf_tag_index_chain_t empty = {.head = idx, .tail = -1, .count = 0};
+    asdf_tag_index_map_result res = asdf_tag_index_map_emplace(map, name0, empty);
+
+    if (name0 != buf)
+        free(name0);
+
+    if (UNLIKELY(!res.ref || !asdf_tag_index_links_push(&index->links, link)))
+        return false;
+
+    asdf_tag_index_chain_t *chain = &res.ref->second;
+
+    if (chain->tail >= 0)
+        asdf_tag_index_links_at_mut(&index->links, chain->tail)->next = idx;
+
+    chain->tail = idx;
+    chain->count++;
+    return true;
+}
+
+
+/** A node remaining to visit, and the key it is the value of if it is in a mapping */
+typedef struct {
+    struct fy_node *node;
+    struct fy_node *key;
+} asdf_tag_index_visit_t;
+
+
+/** Push a node onto the stack of nodes to visit, growing it as needed */
+static bool asdf_tag_index_push(
+    asdf_tag_index_visit_t **stack,
+    size_t *size,
+    size_t *cap,
+    struct fy_node *node,
+    struct fy_node *key) {
+    if (*size == *cap) {
+        size_t new_cap = *cap * 2;
+        asdf_tag_index_visit_t *new_stack = realloc(
+            *stack, new_cap * sizeof(asdf_tag_index_visit_t));
+
+        if (!new_stack)
+            return false;
+
+        *stack = new_stack;
+        *cap = new_cap;
+    }
+
+    (*stack)[(*size)++] = (asdf_tag_index_visit_t){.node = node, .key = key};
+    return true;
+}
+
+
+/** Reverse the top ``count`` nodes on the stack, so that children are visited in order */
+static void asdf_tag_index_reverse(asdf_tag_index_visit_t *stack, size_t size, size_t count) {
+    if (count < 2)
+        return;
+
+    for (size_t lo = size - count, hi = size - 1; lo < hi; lo++, hi--) {
+        asdf_tag_index_visit_t tmp = stack[lo];
+        stack[lo] = stack[hi];
+        stack[hi] = tmp;
+    }
+}
+
+
+asdf_tag_index_t *asdf_tag_index_build(asdf_file_t *file, struct fy_node *root) {
+    asdf_tag_index_t *index = calloc(1, sizeof(asdf_tag_index_t));
+    size_t cap = ASDF_TAG_INDEX_STACK_MIN_CAPACITY;
+    size_t size = 0;
+    asdf_tag_index_visit_t *stack = malloc(cap * sizeof(asdf_tag_index_visit_t));
+
+    if (!index || !stack)
+        goto failure;
+
+    if (root && !asdf_tag_index_push(&stack, &size, &cap, root, NULL))
+        goto failure;
+
+    // Depth-first, pre-order walk so each chain lists its nodes in document order.  Aliases are
+    // not followed; the nodes they refer to are indexed where they are anchored.
+    while (size > 0) {
+        asdf_tag_index_visit_t visit = stack[--size];
+        struct fy_node *node = visit.node;
+        size_t len = 0;
+        const char *tag = fy_node_get_tag(node, &len);
+
+        if (tag && !asdf_tag_index_add(index, &index->tags, tag, len, node))
+            goto failure;
+
+        const char *key = NULL;
+
+        if (visit.key && fy_node_is_scalar(visit.key))
+            key = fy_node_get_scalar(visit.key, &len);
+
+        if (key && !asdf_tag_index_add(index, &index->keys, key, len, node))
+            goto failure;
+
+        void *iter = NULL;
+        size_t n_children = 0;
+
+        switch (fy_node_get_type(node)) {
+        case FYNT_MAPPING: {
+            struct fy_node_pair *pair = NULL;
+
+            while ((pair = fy_node_mapping_iterate(node, &iter))) {
+                struct fy_node *value = fy_node_pair_value(pair);
+
+                if (!value || fy_node_is_alias(value))
+                    continue;
+
+                if (!asdf_tag_index_push(&stack, &size, &cap, value, fy_node_pair_key(pair)))
+                    goto failure;
+
+                n_children++;
+            }
+            break;
+        }
+        case FYNT_SEQUENCE: {
+            struct fy_node *item = NULL;
+
+            while ((item = fy_node_sequence_iterate(node, &iter))) {
+                if (fy_node_is_alias(item))
+                    continue;
+
+                if (!asdf_tag_index_push(&stack, &size, &cap, item, NULL))
+                    goto failure;
+
+                n_children++;
+            }
+            break;
+        }
+        case FYNT_SCALAR:
+            break;
+        }
+
+        asdf_tag_index_reverse(stack, size, n_children);
+    }
+
+    free(stack);
+    ASDF_LOG(
+        file,
+        ASDF_LOG_DEBUG,
+        "indexed %zu tagged nodes and mapping values",
+        (size_t)asdf_tag_index_links_size(&index->links));
+    return index;
+failure:
+    ASDF_ERROR_OOM(file);
+    free(stack);
+    asdf_tag_index_destroy(index);
+    return NULL;
+}
+
+
+void asdf_tag_index_destroy(asdf_tag_index_t *index) {
+    if (!index)
+        return;
+
+    asdf_tag_index_map_drop(&index->tags);
+    asdf_tag_index_map_drop(&index->keys);
+    asdf_tag_index_links_drop(&index->links);
+    free(index);
+}
+
+
+static int asdf_tag_index_link_cmp(const void *a, const void *b) {
+    ssize_t lhs = *(const ssize_t *)a;
+    ssize_t rhs = *(const ssize_t *)b;
+    return (lhs > rhs) - (lhs < rhs);
+}
+
+
+/**
+ * Collect the nodes of the given chains into a new array, in document order
+ *
+ * Links are numbered in document order, so merging several chains is just a matter of sorting
+ * their link numbers.
+ */
+static struct fy_node **asdf_tag_index_collect(
+    asdf_tag_index_t *index,
+    const asdf_tag_index_chain_t **chains,
+    size_t n_chains,
+    size_t *count) {
+    size_t total = 0;
+
+    for (size_t idx = 0; idx < n_chains; idx++)
+        total += chains[idx]->count;
+
+    *count = 0;
+
+    if (total == 0)
+        return NULL;
+
+    ssize_t *links = malloc(total * sizeof(ssize_t));
+    struct fy_node **nodes = (struct fy_node **)malloc(total * sizeof(struct fy_node *));
+
+    if (!links || !nodes) {
+        free(links);
+        free((void *)nodes);
+        return NULL;
+    }
+
+    size_t n_links = 0;
+
+    for (size_t idx = 0; idx < n_chains; idx++) {
+        for (ssize_t link = chains[idx]->head; link >= 0;
+             link = asdf_tag_index_links_at(&index->links, link)->next)
+            links[n_links++] = link;
+    }
+
+    if (n_chains > 1)
+        qsort(links, n_links, sizeof(ssize_t), asdf_tag_index_link_cmp);
+
+    for (size_t idx = 0; idx < n_links; idx++)
+        nodes[idx] = asdf_tag_index_links_at(&index->links, links[idx])->node;
+
+    free(links);
+    *count = n_links;
+    return nodes;
+}
+
+
+/**
+ * Whether ``tag`` is ``name`` followed by a version, following the convention in
+ * `asdf_tag_parse` that the version is separated from the name by a ``-``
+ */
+static bool asdf_tag_index_is_version_of(const char *tag, const char *name, size_t name_len) {
+    return strncmp(tag, name, name_len) == 0 && tag[name_len] == '-' &&
+           isdigit((unsigned char)tag[name_len + 1]);
+}
+
+
+struct fy_node **asdf_tag_index_find_tag(
+    asdf_tag_index_t *index, const char *tag, size_t *count) {
+    assert(count);
+    *count = 0;
+
+    if (UNLIKELY(!index || !tag))
+        return NULL;
+
+    char *full_tag = asdf_yaml_tag_canonicalize(tag);
+
+    if (!full_tag)
+        return NULL;
+
+    struct fy_node **nodes = NULL;
+    const asdf_tag_index_map_value *exact = asdf_tag_index_map_get(&index->tags, full_tag);
+
+    if (exact) {
+        const asdf_tag_index_chain_t *chain = &exact->second;
+        nodes = asdf_tag_index_collect(index, &chain, 1, count);
+        free(full_tag);
+        return nodes;
+    }
+
+    // Otherwise match any version of the tag; there are normally few enough distinct tags in a
+    // file that scanning them all is cheap
+    size_t n_tags = (size_t)asdf_tag_index_map_size(&index->tags);
+    size_t n_chains = 0;
+    size_t tag_len = strlen(full_tag);
+    const asdf_tag_index_chain_t **chains = (const asdf_tag_index_chain_t **)malloc(
+        (n_tags ? n_tags : 1) * sizeof(asdf_tag_index_chain_t *));
+
+    if (!chains) {
+        free(full_tag);
+        return NULL;
+    }
+
+    for (asdf_tag_index_map_iter_t it = asdf_tag_index_map_begin(&index->tags); it.ref;
+         asdf_tag_index_map_next(&it)) {
+        if (asdf_tag_index_is_version_of(cstr_str(&it.ref->first), full_tag, tag_len))
+            chains[n_chains++] = &it.ref->second;
+    }
+
+    nodes = asdf_tag_index_collect(index, chains, n_chains, count);
+    free((void *)chains);
+    free(full_tag);
+    return nodes;
+}
+
+
+struct fy_node **asdf_tag_index_find_key(
+    asdf_tag_index_t *index, const char *key, size_t *count) {
+    assert(count);
+    *count = 0;
+
+    if (UNLIKELY(!index || !key))
+        return NULL;
+
+    const asdf_tag_index_map_value *found = asdf_tag_index_map_get(&index->keys, key);
+
+    if (!found)
+        return NULL;
+
+    const asdf_tag_index_chain_t *chain = &found->second;
+    return asdf_tag_index_collect(index, &chain, 1, count);
+}
@@ -0,0 +1,71 @@
+/**
+ * Index of the nodes in a file's tree by tag and by mapping key
+ *
+ * Built lazily in a single pass over the tree the first time it is queried (see
+ * `asdf_find_by_tag` and `asdf_find_by_key`), so that repeated queries cost time proportional to
+ * the number of results rather than the size of the tree.  The index is dropped whenever the
+ * tree is modified and rebuilt on the next query.
+ */
+#pragma once
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stddef.h>
+#include <sys/types.h>
+
+#include <libfyaml.h>
+
+#include "asdf/file.h"
+
+#include "util.h"
+
+
+/** A node in the index, and the position in the index of the next node with the same tag/key */
+typedef struct {
+    struct fy_node *node;
+    ssize_t next;
+} asdf_tag_index_link_t;
+
+
+/** First and last links of the nodes with a given tag/key, in document order */
+typedef struct {
+    ssize_t head;
+    ssize_t tail;
+    size_t count;
+} asdf_tag_index_chain_t;
+
+
+typedef struct asdf_tag_index asdf_tag_index_t;
+
+
+/**
+ * Index all the nodes in the tree under ``root``
+ *
+ * :return: The new index, or ``NULL`` on allocation failure
+ */
+ASDF_LOCAL asdf_tag_index_t *asdf_tag_index_build(asdf_file_t *file, struct fy_node *root);
+ASDF_LOCAL void asdf_tag_index_destroy(asdf_tag_index_t *index);
+
+/**
+ * Get the nodes having the given tag, in document order
+ *
+ * The tag is canonicalized like in `asdf_extension_get`.  If no node has exactly that tag, tags
+ * differing only by their version are matched, so e.g. a tag with no version matches all
+ * versions of that tag.
+ *
+ * :param count: Set to the number of nodes returned
+ * :return: A newly allocated array of nodes to be freed by the caller, or ``NULL`` if there are
+ *   none (or on allocation failure, in which case ``count`` is also set to ``0``)
+ */
+ASDF_LOCAL struct fy_node **asdf_tag_index_find_tag(
+    asdf_tag_index_t *index, const char *tag, size_t *count);
+
+/**
+ * Get the value nodes of all mapping entries with the given key, in document order
+ *
+ * Returns the same as `asdf_tag_index_find_tag`.
+ */
+ASDF_LOCAL struct fy_node **asdf_tag_index_find_key(
+    asdf_tag_index_t *index, const char *key, size_t *count);
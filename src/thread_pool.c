@@ -0,0 +1,167 @@
+#include <pthread.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+
+#include "thread_pool.h"
+#include "util.h"
+
+
+struct asdf_thread_pool {
+    /** Protects everything below, and is held by workers only while picking up tasks */
+    pthread_mutex_t lock;
+    /** Signalled when a job is submitted or the pool is shutting down */
+    pthread_cond_t job_cond;
+    /** Signalled when the last task of a job finishes */
+    pthread_cond_t done_cond;
+    /** Held for the duration of each job, so that only one job runs at a time */
+    pthread_mutex_t job_lock;
+    pthread_t *threads;
+    unsigned int n_workers;
+    bool shutdown;
+    /** The current job */
+    asdf_thread_pool_task_fn_t fn;
+    uint8_t *tasks;
+    size_t task_size;
+    size_t n_tasks;
+    /** Index of the next task not yet picked up by any thread */
+    size_t next_task;
+    /** Number of tasks that have finished */
+    size_t n_done;
+};
+
+
+/**
+ * Pick up and run tasks of the current job until none are left
+ *
+ * Must be called with ``pool->lock`` held, and returns with it held.
+ */
+static void asdf_thread_pool_work(asdf_thread_pool_t *pool) {
+    while (pool->next_task < pool->n_tasks) {
+        void *task = pool->tasks + (pool->next_task++ * pool->task_size);
+        pthread_mutex_unlock(&pool->lock);
+        pool->fn(task);
+        pthread_mutex_lock(&pool->lock);
+
+        if (++pool->n_done == pool->n_tasks)
+            pthread_cond_broadcast(&pool->done_cond);
+    }
+}
+
+
+static void *asdf_thread_pool_worker(void *arg) {
+    asdf_thread_pool_t *pool = arg;
+
+    pthread_mutex_lock(&pool->lock);
+
+    while (!pool->shutdown) {
+        if (pool->next_task < pool->n_tasks)
+            asdf_thread_pool_work(pool);
+        else
+            pthread_cond_wait(&pool->job_cond, &pool->lock);
+    }
+
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+
+
+asdf_thread_pool_t *asdf_thread_pool_create(unsigned int n_threads) {
+    if (n_threads < 2)
+        return NULL;
+
+    asdf_thread_pool_t *pool = calloc(1, sizeof(asdf_thread_pool_t));
+
+    if (UNLIKELY(!pool))
+        return NULL;
+
+    pool->threads = malloc((n_threads - 1) * sizeof(pthread_t));
+
+    if (UNLIKELY(!pool->threads)) {
+        free(pool);
+        return NULL;
+    }
+
+    pthread_mutex_init(&pool->lock, NULL);
+    pthread_mutex_init(&pool->job_lock, NULL);
+    pthread_cond_init(&pool->job_cond, NULL);
+    pthread_cond_init(&pool->done_cond, NULL);
+
+    for (unsigned int idx = 0; idx < n_threads - 1; idx++) {
+        if (0 != pthread_create(&pool->threads[idx], NULL, asdf_thread_pool_worker, pool))
+            break;
+
+        pool->n_workers++;
+    }
+
+    // Make do with however many workers could be started, unless there are none at all
+    if (pool->n_workers == 0) {
+        asdf_thread_pool_destroy(pool);
+        return NULL;
+    }
+
+    return pool;
+}
+
+
+void asdf_thread_pool_destroy(asdf_thread_pool_t *pool) {
+    if (!pool)
+        return;
+
+    pthread_mutex_lock(&pool->lock);
+    pool->shutdown = true;
+    pthread_cond_broadcast(&pool->job_cond);
+    pthread_mutex_unlock(&pool->lock);
+
+    for (unsigned int idx = 0; idx < pool->n_workers; idx++)
+        pthread_join(pool->threads[idx], NULL);
+
+    pthread_cond_destroy(&pool->done_cond);
+    pthread_cond_destroy(&pool->job_cond);
+    pthread_mutex_destroy(&pool->job_lock);
+    pthread_mutex_destroy(&pool->lock);
+    free(pool->threads);
+    free(pool);
+}
+
+
+unsigned int asdf_thread_pool_size(const asdf_thread_pool_t *pool) {
+    return pool ? pool->n_workers + 1 : 1;
+}
+
+
+void asdf_thread_pool_run(
+    asdf_thread_pool_t *pool,
+    asdf_thread_pool_task_fn_t fn,
+    void *tasks,
+    size_t task_size,
+    size_t n_tasks) {
+    // Nothing to gain from the pool for a single task, or if it is busy with another job
+    if (!pool || n_tasks < 2 || 0 != pthread_mutex_trylock(&pool->job_lock)) {
+        for (size_t idx = 0; idx < n_tasks; idx++)
+            fn((uint8_t *)tasks + (idx * task_size));
+
+        return;
+    }
+
+    pthread_mutex_lock(&pool->lock);
+    pool->fn = fn;
+    pool->tasks = tasks;
+    pool->task_size = task_size;
+    pool->n_tasks = n_tasks;
+    pool->next_task = 0;
+    pool->n_done = 0;
+    pthread_cond_broadcast(&pool->job_cond);
+    asdf_thread_pool_work(pool);
+
+    while (pool->n_done < pool->n_tasks)
+        pthread_cond_wait(&pool->done_cond, &pool->lock);
+
+    pool->fn = NULL;
+    pool->tasks = NULL;
+    pool->n_tasks = 0;
+    pool->next_task = 0;
+    pthread_mutex_unlock(&pool->lock);
+    pthread_mutex_unlock(&pool->job_lock);
+}
@@ -0,0 +1,54 @@
+/**
+ * A small pool of worker threads for splitting a job into independent tasks
+ *
+ * The threads are started once, when the pool is created, and then sleep until a job is
+ * submitted with `asdf_thread_pool_run`.  The thread submitting the job works on its tasks too,
+ * so a pool of ``n_threads`` runs up to that many tasks at once with ``n_threads - 1`` workers.
+ *
+ * Only one job runs on a pool at a time; a job submitted while another is running is run
+ * entirely on the submitting thread instead of waiting for the pool.
+ */
+#pragma once
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stddef.h>
+
+#include "util.h"
+
+
+typedef struct asdf_thread_pool asdf_thread_pool_t;
+
+
+/** Function run for each task of a job, given a pointer to the task's element of the array */
+typedef void (*asdf_thread_pool_task_fn_t)(void *task);
+
+
+/**
+ * Create a pool that runs up to ``n_threads`` tasks at once (including on the calling thread)
+ *
+ * Returns NULL if ``n_threads`` is less than 2, or if no worker threads could be started.
+ */
+ASDF_LOCAL asdf_thread_pool_t *asdf_thread_pool_create(unsigned int n_threads);
+
+/** Stop the pool's worker threads and free the pool */
+ASDF_LOCAL void asdf_thread_pool_destroy(asdf_thread_pool_t *pool);
+
+/** Return the number of tasks the pool can run at once, or 1 if ``pool`` is NULL */
+ASDF_LOCAL unsigned int asdf_thread_pool_size(const asdf_thread_pool_t *pool);
+
+/**
+ * Run ``fn`` on each of the ``n_tasks`` elements of the ``tasks`` array (each of ``task_size``
+ * bytes), returning once all of them have finished
+ *
+ * Tasks may run in any order and on any thread.  If ``pool`` is NULL all tasks are run in order
+ * on the calling thread.
+ */
+ASDF_LOCAL void asdf_thread_pool_run(
+    asdf_thread_pool_t *pool,
+    asdf_thread_pool_task_fn_t fn,
+    void *tasks,
+    size_t task_size,
+    size_t n_tasks);
@@ -0,0 +1,14 @@
+/**
+ * STC hash map of paths in a YAML tree to the nodes they resolve to
+ */
+#pragma once
+
+#include <libfyaml.h>
+#include <stc/cstr.h>
+
+#define i_type asdf_node_map
+#define i_keypro cstr
+#define i_val struct fy_node *
+#include <stc/hmap.h>
+
+typedef asdf_node_map asdf_node_map_t;
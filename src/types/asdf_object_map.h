@@ -0,0 +1,14 @@
+/**
+ * STC hash map of pointers (YAML nodes or deserialized objects) to cached extension objects
+ */
+#pragma once
+
+#include "../object_cache.h"
+
+#define i_type asdf_object_map
+#define i_key const void *
+#define i_val asdf_object_ref_t *
+#include <stc/hmap.h>
+
+typedef asdf_object_map asdf_object_map_t;
+typedef asdf_object_map_iter asdf_object_map_iter_t;
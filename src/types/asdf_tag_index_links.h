@@ -0,0 +1,12 @@
+/**
+ * Vector of all the nodes recorded in the tag index, each linked to the next node with the
+ * same tag or key
+ */
+#pragma once
+
+#include "../tag_index.h"
+
+#define i_type asdf_tag_index_links, asdf_tag_index_link_t
+#include <stc/vec.h>
+
+typedef asdf_tag_index_links asdf_tag_index_links_t;
@@ -0,0 +1,16 @@
+/**
+ * STC hash map of tags (or mapping keys) to the chain of nodes in the tag index having them
+ */
+#pragma once
+
+#include <stc/cstr.h>
+
+#include "../tag_index.h"
+
+#define i_type asdf_tag_index_map
+#define i_keypro cstr
+#define i_val asdf_tag_index_chain_t
+#include <stc/hmap.h>
+
+typedef asdf_tag_index_map asdf_tag_index_map_t;
+typedef asdf_tag_index_map_iter asdf_tag_index_map_iter_t;
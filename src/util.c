@@ -28,6 +28,33 @@ size_t asdf_util_get_total_memory(void) {
 }
 
 
+unsigned int asdf_util_cpu_features(void) {
+#ifdef ASDF_X86_DISPATCH
+    unsigned int features = 0;
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("sse2"))
+        features |= ASDF_CPU_FEATURE_SSE2;
+
+    if (__builtin_cpu_supports("sse4.1"))
+        features |= ASDF_CPU_FEATURE_SSE41;
+
+    if (__builtin_cpu_supports("avx2"))
+        features |= ASDF_CPU_FEATURE_AVX2;
+
+    if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw"))
+        features |= ASDF_CPU_FEATURE_AVX512;
+
+    if (__builtin_cpu_supports("f16c"))
+        features |= ASDF_CPU_FEATURE_F16C;
+
+    return features;
+#else
+    return 0;
+#endif
+}
+
+
 void **asdf_array_concat(void **dst, const void **src) {
     size_t dst_len = 0;
     size_t src_len = 0;
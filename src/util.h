@@ -2,6 +2,7 @@
 
 #include <assert.h>
 #include <limits.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdint.h>
 #include <string.h>
@@ -49,6 +50,37 @@
 ASDF_LOCAL size_t asdf_util_get_total_memory(void);
 
 
+/**
+ * Runtime CPU feature detection for the vectorized code paths
+ *
+ * ``ASDF_X86_DISPATCH`` is defined when building for x86 with a compiler that supports
+ * per-function ``target`` attributes, in which case SIMD kernels can be compiled in
+ * unconditionally and selected at runtime based on `asdf_util_cpu_features`.
+ */
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+#define ASDF_X86_DISPATCH 1
+#endif
+
+
+typedef enum {
+    ASDF_CPU_FEATURE_SSE2 = 1U << 0,
+    ASDF_CPU_FEATURE_AVX2 = 1U << 1,
+    ASDF_CPU_FEATURE_SSE41 = 1U << 2,
+    /** AVX-512 Foundation plus the byte and word instructions (AVX512BW) */
+    ASDF_CPU_FEATURE_AVX512 = 1U << 3,
+    /** Half-precision float conversion instructions */
+    ASDF_CPU_FEATURE_F16C = 1U << 4,
+} asdf_cpu_feature_t;
+
+
+ASDF_LOCAL unsigned int asdf_util_cpu_features(void);
+
+
+static inline bool asdf_util_cpu_has(asdf_cpu_feature_t feature) {
+    return (asdf_util_cpu_features() & feature) == feature;
+}
+
+
 /**
  * Concatenate two NULL-terminated arrays returning a new array.
  *
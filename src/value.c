@@ -6,6 +6,7 @@
 #include <ctype.h>
 #include <errno.h>
 #include <limits.h>
+#include <locale.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -13,17 +14,224 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined(HAVE_STRTOD_L) && defined(__APPLE__)
+#include <xlocale.h>
+#endif
+
 #include <libfyaml.h>
 
 #include "error.h"
 #include "file.h"
 #include "log.h"
+#include "object_cache.h"
 #include "util.h"
 #include "value.h"
 #include "value_util.h"
 #include "yaml.h"
 
 
+#define ASDF_MAX(a, b) ((a) > (b) ? (a) : (b))
+
+
+void asdf_value_pools_init(asdf_file_t *file) {
+    size_t iter_size = ASDF_MAX(
+        sizeof(asdf_mapping_iter_impl_t),
+        ASDF_MAX(sizeof(asdf_sequence_iter_impl_t), sizeof(asdf_container_iter_impl_t)));
+    asdf_pool_init(&file->value_pool, sizeof(asdf_value_t));
+    asdf_pool_init(&file->iter_pool, iter_size);
+    asdf_pool_init(&file->path_pool, sizeof(asdf_value_path_node_t));
+}
+
+
+/**
+ * Allocate a zeroed `asdf_value_t` from the file's pool
+ *
+ * Values not associated with any file fall back on the system allocator.
+ */
+static asdf_value_t *asdf_value_alloc(asdf_file_t *file) {
+    if (UNLIKELY(!file))
+        return calloc(1, sizeof(asdf_value_t));
+
+    return asdf_pool_alloc(&file->value_pool);
+}
+
+
+static void asdf_value_free(asdf_file_t *file, asdf_value_t *value) {
+    if (UNLIKELY(!file)) {
+        free(value);
+        return;
+    }
+
+    asdf_pool_free(&file->value_pool, value);
+}
+
+
+/** Same as `asdf_value_alloc` but for the container iterators */
+static void *asdf_iter_alloc(asdf_file_t *file, size_t size) {
+    if (UNLIKELY(!file))
+        return calloc(1, size);
+
+    assert(size <= file->iter_pool.obj_size);
+    return asdf_pool_alloc(&file->iter_pool);
+}
+
+
+static void asdf_iter_free(asdf_file_t *file, void *iter) {
+    if (UNLIKELY(!file)) {
+        free(iter);
+        return;
+    }
+
+    asdf_pool_free(&file->iter_pool, iter);
+}
+
+
+/** Value paths; see `asdf_value_path_node_t` */
+static asdf_value_path_node_t *asdf_value_path_node_create(
+    asdf_file_t *file, asdf_value_path_node_t *parent, const char *key, int index) {
+    asdf_value_path_node_t *node = NULL;
+
+    if (LIKELY(file))
+        node = asdf_pool_alloc(&file->path_pool);
+    else
+        node = calloc(1, sizeof(asdf_value_path_node_t));
+
+    if (UNLIKELY(!node))
+        return NULL;
+
+    if (key) {
+        size_t len = strlen(key);
+
+        if (len < ASDF_VALUE_PATH_KEY_INLINE) {
+            memcpy(node->key_buf, key, len + 1);
+            node->key = node->key_buf;
+        } else {
+            node->key = strdup(key);
+
+            if (UNLIKELY(!node->key)) {
+                if (LIKELY(file))
+                    asdf_pool_free(&file->path_pool, node);
+                else
+                    free(node);
+                return NULL;
+            }
+        }
+    }
+
+    node->refcount = 1;
+    node->index = index;
+    node->parent = parent;
+
+    if (parent)
+        parent->refcount++;
+
+    return node;
+}
+
+
+static asdf_value_path_node_t *asdf_value_path_node_ref(asdf_value_path_node_t *node) {
+    if (node)
+        node->refcount++;
+
+    return node;
+}
+
+
+static void asdf_value_path_node_release(asdf_file_t *file, asdf_value_path_node_t *node) {
+    while (node && --node->refcount == 0) {
+        asdf_value_path_node_t *parent = node->parent;
+
+        if (node->key != node->key_buf)
+            free(node->key);
+
+        free(node->path);
+
+        if (LIKELY(file))
+            asdf_pool_free(&file->path_pool, node);
+        else
+            free(node);
+
+        node = parent;
+    }
+}
+
+
+/**
+ * Build (and memoize) the full path for a path node and any of its ancestors that have not been
+ * built yet
+ *
+ * Done iteratively rather than recursively since trees may be arbitrarily deep.
+ */
+static const char *asdf_value_path_node_path(asdf_value_path_node_t *node) {
+    if (node->path)
+        return node->path;
+
+    size_t n_unbuilt = 0;
+
+    for (asdf_value_path_node_t *anc = node; anc && !anc->path; anc = anc->parent)
+        n_unbuilt++;
+
+    asdf_value_path_node_t **chain = malloc(n_unbuilt * sizeof(asdf_value_path_node_t *));
+
+    if (UNLIKELY(!chain))
+        return NULL;
+
+    size_t idx = n_unbuilt;
+
+    for (asdf_value_path_node_t *anc = node; anc && !anc->path; anc = anc->parent)
+        chain[--idx] = anc;
+
+    for (idx = 0; idx < n_unbuilt; idx++) {
+        asdf_value_path_node_t *anc = chain[idx];
+        int ret = -1;
+
+        // Only nodes created from a known path lack a parent, and they always have their path
+        if (UNLIKELY(!anc->parent))
+            break;
+
+        if (anc->key)
+            ret = asprintf(&anc->path, "%s/%s", anc->parent->path, anc->key);
+        else
+            ret = asprintf(&anc->path, "%s/%d", anc->parent->path, anc->index);
+
+        if (UNLIKELY(ret == -1)) {
+            anc->path = NULL;
+            break;
+        }
+    }
+
+    free((void *)chain);
+    return node->path;
+}
+
+
+/**
+ * Return the path node that a value's children should refer to, if its path is known
+ *
+ * If the value already has its full path (and no path node) one is created for it here, so
+ * all its children can share it.
+ */
+static asdf_value_path_node_t *asdf_value_path_node_of(asdf_value_t *value) {
+    if (value->path_node || !value->path)
+        return value->path_node;
+
+    asdf_value_path_node_t *node = asdf_value_path_node_create(value->file, NULL, NULL, -1);
+
+    if (UNLIKELY(!node))
+        return NULL;
+
+    node->path = strdup(value->path);
+
+    if (UNLIKELY(!node->path)) {
+        asdf_value_path_node_release(value->file, node);
+        return NULL;
+    }
+
+    value->path_node = node;
+    return node;
+}
+
+
 static asdf_value_type_t asdf_value_type_from_node(struct fy_node *node) {
     assert(node);
     enum fy_node_type node_type = fy_node_get_type(node);
@@ -41,46 +249,30 @@ static asdf_value_type_t asdf_value_type_from_node(struct fy_node *node) {
 
 
 /**
- * Internal asdf_value_create that also takes the value's parent value
+ * Fill in an `asdf_value_t` for the given node, taking ownership of ``path_node``
  *
- * This is needed to work around issues with value path resolution discussed
- * in #69.  This workaround is hopefully not permanent; I need to think of a
- * better solution to the problem.
+ * Aliases are resolved immediately.  Returns `false` (leaving ``path_node`` to the caller) if
+ * the alias could not be resolved.
  */
-static asdf_value_t *asdf_value_create_ex(
-    asdf_file_t *file, struct fy_node *node, asdf_value_t *parent, const char *key, int index) {
-    assert(node);
-    asdf_value_t *value = calloc(1, sizeof(asdf_value_t));
-    char *path = NULL;
-
-    if (!value) {
-        ASDF_ERROR_OOM(file);
-        return NULL;
-    }
-
-    if (parent && parent->path) {
-        if (key) {
-            if (asprintf(&path, "%s/%s", parent->path, key) == -1) {
-                ASDF_LOG(file, ASDF_LOG_WARN, "failure to build value path for %s (OOM?)", key);
-            }
-        } else if (index >= 0) {
-            if (asprintf(&path, "%s/%d", parent->path, index) == -1) {
-                ASDF_LOG(file, ASDF_LOG_WARN, "failure to build value path for %d (OOM?)", index);
-            }
-        }
-    }
-
+static bool asdf_value_init_ex(
+    asdf_value_t *value,
+    asdf_file_t *file,
+    struct fy_node *node,
+    asdf_value_path_node_t *path_node) {
     // Check if the node is an alias -- if so resolve it immediately
     // More fine-grained control over aliases isn't supported yet so for now
     // we just treat them transparently
     if (fy_node_is_alias(node)) {
 #ifdef ASDF_LOG_ENABLED
         const char *anchor = fy_node_get_scalar0(node);
-        char *value_path = path ? path : fy_node_get_path(node);
-        ASDF_LOG(file, ASDF_LOG_DEBUG, "value at %s is an alias for %s", value_path, anchor);
+        const char *value_path = path_node ? asdf_value_path_node_path(path_node) : NULL;
+        char *node_path = NULL;
 
-        if (!path)
-            free(value_path);
+        if (!value_path)
+            value_path = node_path = fy_node_get_path(node);
+
+        ASDF_LOG(file, ASDF_LOG_DEBUG, "value at %s is an alias for %s", value_path, anchor);
+        free(node_path);
 #endif
         node = fy_node_resolve_alias(node);
 
@@ -88,8 +280,7 @@ static asdf_value_t *asdf_value_create_ex(
             // May be null if the node led to a graph cycle, but not clear if we
             // can distinguish that case from a genuine OOM
             ASDF_ERROR_OOM(file);
-            free(value);
-            return NULL;
+            return false;
         }
     }
 
@@ -102,17 +293,65 @@ static asdf_value_t *asdf_value_create_ex(
     value->shallow = false;
     value->explicit_tag_checked = false;
     value->extension_checked = false;
-    value->path = path;
+    value->path = NULL;
+    value->path_node = path_node;
+    return true;
+}
+
+
+/**
+ * Internal asdf_value_create that also takes the value's parent value
+ *
+ * This is needed to work around issues with value path resolution discussed
+ * in #69.  This workaround is hopefully not permanent; I need to think of a
+ * better solution to the problem.
+ */
+static asdf_value_t *asdf_value_create_ex(
+    asdf_file_t *file, struct fy_node *node, asdf_value_t *parent, const char *key, int index) {
+    assert(node);
+    asdf_value_t *value = asdf_value_alloc(file);
+    asdf_value_path_node_t *path_node = NULL;
+
+    if (!value) {
+        ASDF_ERROR_OOM(file);
+        return NULL;
+    }
+
+    // The path itself is only built if asked for; see asdf_value_path
+    if (parent && (key || index >= 0)) {
+        asdf_value_path_node_t *parent_node = asdf_value_path_node_of(parent);
+
+        if (parent_node) {
+            path_node = asdf_value_path_node_create(file, parent_node, key, index);
+
+            if (!path_node)
+                ASDF_LOG(file, ASDF_LOG_WARN, "failure to record value path (OOM?)");
+        }
+    }
+
+    if (!asdf_value_init_ex(value, file, node, path_node)) {
+        asdf_value_path_node_release(file, path_node);
+        asdf_value_free(file, value);
+        return NULL;
+    }
+
     return value;
 }
 
 
-/* TODO: Create or return from a freelist that lives on the file */
 asdf_value_t *asdf_value_create(asdf_file_t *file, struct fy_node *node) {
     return asdf_value_create_ex(file, node, NULL, NULL, -1);
 }
 
 
+bool asdf_value_init(asdf_value_t *value, asdf_file_t *file, struct fy_node *node) {
+    assert(value);
+    assert(node);
+    ZERO_MEMORY(value, sizeof(asdf_value_t));
+    return asdf_value_init_ex(value, file, node, NULL);
+}
+
+
 /**
  * Helper to check if a node is the root node of the document it belongs to (if any)
  *
@@ -128,7 +367,7 @@ static bool is_root_node(struct fy_node *node) {
 }
 
 
-void asdf_value_destroy(asdf_value_t *value) {
+void asdf_value_clear(asdf_value_t *value) {
     if (!value)
         return;
 
@@ -140,17 +379,31 @@ void asdf_value_destroy(asdf_value_t *value) {
 
     free((char *)value->path);
     free((char *)value->tag);
+    asdf_value_path_node_release(value->file, value->path_node);
 
     // Free the extension data
-    // The extension object itself must be freed by the user for now, which is less than ideal.
-    // In #34 let's consider some kind of reference counting mechanism for them.
+    // Objects deserialized from the value are owned by whoever asked for them (and by the file's
+    // object cache, or the value itself for detached nodes); see object_cache.h
     if (ASDF_VALUE_EXTENSION == value->type) {
         asdf_extension_value_t *extval = value->scalar.ext;
+
+        if (extval && extval->owns_object)
+            asdf_extension_object_destroy(extval->ext, (void *)extval->object);
+
         free(extval);
     }
 
     ZERO_MEMORY(value, sizeof(asdf_value_t));
-    free(value);
+}
+
+
+void asdf_value_destroy(asdf_value_t *value) {
+    if (!value)
+        return;
+
+    asdf_file_t *file = value->file;
+    asdf_value_clear(value);
+    asdf_value_free(file, value);
 }
 
 
@@ -159,7 +412,7 @@ static asdf_value_t *asdf_value_clone_impl(asdf_value_t *value, bool raw_shallow
     if (!value)
         return NULL;
 
-    asdf_value_t *new_value = malloc(sizeof(asdf_value_t));
+    asdf_value_t *new_value = asdf_value_alloc(value->file);
 
     if (!new_value) {
         ASDF_ERROR_OOM(value->file);
@@ -180,7 +433,7 @@ static asdf_value_t *asdf_value_clone_impl(asdf_value_t *value, bool raw_shallow
 
     if (value->path)
         new_value->path = strdup(value->path);
-    else
+    else if (!value->path_node)
         // We must look up the full path of the node to store on the clone or
         // else it will be lost; see issue #69
         new_value->path = fy_node_get_path(value->node);
@@ -197,7 +450,9 @@ static asdf_value_t *asdf_value_clone_impl(asdf_value_t *value, bool raw_shallow
         new_node = fy_node_copy(tree, value->node);
 
         if (!new_node) {
-            free(new_value);
+            free((char *)new_value->path);
+            free((char *)new_value->tag);
+            asdf_value_free(value->file, new_value);
             ASDF_ERROR_OOM(value->file);
             return NULL;
         }
@@ -211,6 +466,9 @@ static asdf_value_t *asdf_value_clone_impl(asdf_value_t *value, bool raw_shallow
         new_value->shallow = false;
     }
 
+    if (!new_value->path)
+        new_value->path_node = asdf_value_path_node_ref(value->path_node);
+
     return new_value;
 }
 
@@ -236,7 +494,7 @@ static asdf_value_t *asdf_value_clone_shallow(asdf_value_t *value) {
     if (!value)
         return NULL;
 
-    asdf_value_t *new_value = malloc(sizeof(asdf_value_t));
+    asdf_value_t *new_value = asdf_value_alloc(value->file);
     if (!new_value) {
         ASDF_ERROR_OOM(value->file);
         return NULL;
@@ -251,23 +509,31 @@ static asdf_value_t *asdf_value_clone_shallow(asdf_value_t *value) {
     new_value->explicit_tag_checked = value->explicit_tag_checked;
     new_value->extension_checked = value->extension_checked;
     new_value->tag = value->tag ? strdup(value->tag) : NULL;
-    new_value->path = value->path ? strdup(value->path) : fy_node_get_path(value->node);
+    // The clone shares the same node, so its path can be looked up later just the same if needed
+    new_value->path = value->path ? strdup(value->path) : NULL;
 
     if (value->type == ASDF_VALUE_EXTENSION && value->scalar.ext) {
         asdf_extension_value_t *new_ext = malloc(sizeof(asdf_extension_value_t));
         if (!new_ext) {
             free((char *)new_value->path);
             free((char *)new_value->tag);
-            free(new_value);
+            asdf_value_free(value->file, new_value);
             ASDF_ERROR_OOM(value->file);
             return NULL;
         }
         *new_ext = *value->scalar.ext;
         new_value->scalar.ext = new_ext;
+
+        // Already registered, so taking another reference can't fail
+        if (new_ext->owns_object)
+            asdf_object_retain(new_ext->ext, (void *)new_ext->object, false);
     } else {
         new_value->scalar = value->scalar;
     }
 
+    if (!new_value->path)
+        new_value->path_node = asdf_value_path_node_ref(value->path_node);
+
     return new_value;
 }
 
@@ -298,11 +564,20 @@ const char *asdf_value_path(asdf_value_t *value) {
     if (!value)
         return NULL;
 
-    if (NULL == value->path) {
-        // Get the path and memoize it; it can be freed when the value is freed
-        value->path = fy_node_get_path(value->node);
+    if (value->path)
+        return value->path;
+
+    // Values created from a parent value build their path from the parent's (memoized on the
+    // path node, which is freed along with the value)
+    if (value->path_node) {
+        const char *path = asdf_value_path_node_path(value->path_node);
+
+        if (path)
+            return path;
     }
 
+    // Get the path and memoize it; it can be freed when the value is freed
+    value->path = fy_node_get_path(value->node);
     return value->path;
 }
 
@@ -514,6 +789,7 @@ static inline asdf_value_err_t asdf_mapping_set_node(
     // If the key already exists in the mapping, replace its value
     if (pair) {
         fy_node_free(key_node);
+        asdf_file_path_cache_clear(mapping->value.file);
 
         if (fy_node_pair_set_value(pair, value) != 0) {
             return ASDF_VALUE_ERR_OOM;
@@ -523,6 +799,7 @@ static inline asdf_value_err_t asdf_mapping_set_node(
         return ASDF_VALUE_ERR_OOM;
     }
 
+    asdf_file_tag_index_clear(mapping->value.file);
     return ASDF_VALUE_OK;
 }
 
@@ -621,13 +898,15 @@ ASDF_MAPPING_SET_CONTAINER_TYPE(sequence);
 
 
 asdf_mapping_iter_t *asdf_mapping_iter_init(asdf_mapping_t *mapping) {
-    asdf_mapping_iter_impl_t *impl = calloc(1, sizeof(asdf_mapping_iter_impl_t));
+    asdf_file_t *file = mapping->value.file;
+    asdf_mapping_iter_impl_t *impl = asdf_iter_alloc(file, sizeof(asdf_mapping_iter_impl_t));
 
     if (!impl) {
-        ASDF_ERROR_OOM(mapping->value.file);
+        ASDF_ERROR_OOM(file);
         return NULL;
     }
 
+    impl->file = file;
     impl->mapping = mapping;
     return (asdf_mapping_iter_t *)impl;
 }
@@ -639,7 +918,7 @@ void asdf_mapping_iter_destroy(asdf_mapping_iter_t *iter) {
 
     asdf_mapping_iter_impl_t *impl = (asdf_mapping_iter_impl_t *)iter;
     asdf_value_destroy(impl->pub.value);
-    free(impl);
+    asdf_iter_free(impl->file, impl);
 }
 
 
@@ -747,6 +1026,8 @@ asdf_value_t *asdf_mapping_pop(asdf_mapping_t *mapping, const char *key) {
     if (!node)
         return NULL;
 
+    asdf_file_path_cache_clear(value->file);
+
     return asdf_value_create(value->file, node);
 }
 
@@ -841,13 +1122,15 @@ void asdf_sequence_destroy(asdf_sequence_t *sequence) {
 
 
 asdf_sequence_iter_t *asdf_sequence_iter_init(asdf_sequence_t *sequence) {
-    asdf_sequence_iter_impl_t *impl = calloc(1, sizeof(asdf_sequence_iter_impl_t));
+    asdf_file_t *file = sequence->value.file;
+    asdf_sequence_iter_impl_t *impl = asdf_iter_alloc(file, sizeof(asdf_sequence_iter_impl_t));
 
     if (UNLIKELY(!impl)) {
-        ASDF_ERROR_OOM(sequence->value.file);
+        ASDF_ERROR_OOM(file);
         return NULL;
     }
 
+    impl->file = file;
     impl->sequence = sequence;
     impl->pub.index = -1;
     return (asdf_sequence_iter_t *)impl;
@@ -860,7 +1143,7 @@ void asdf_sequence_iter_destroy(asdf_sequence_iter_t *iter) {
 
     asdf_sequence_iter_impl_t *impl = (asdf_sequence_iter_impl_t *)iter;
     asdf_value_destroy(impl->pub.value);
-    free(impl);
+    asdf_iter_free(impl->file, impl);
 }
 
 
@@ -928,6 +1211,7 @@ asdf_value_err_t asdf_sequence_append_string(
         return ASDF_VALUE_ERR_OOM;
     }
 
+    asdf_file_tag_index_clear(sequence->value.file);
     return ASDF_VALUE_OK;
 }
 
@@ -949,6 +1233,7 @@ asdf_value_err_t asdf_sequence_append_string0(asdf_sequence_t *sequence, const c
         return ASDF_VALUE_ERR_OOM;
     }
 
+    asdf_file_tag_index_clear(sequence->value.file);
     return ASDF_VALUE_OK;
 }
 
@@ -969,6 +1254,7 @@ asdf_value_err_t asdf_sequence_append_null(asdf_sequence_t *sequence) {
         return ASDF_VALUE_ERR_OOM;
     }
 
+    asdf_file_tag_index_clear(sequence->value.file);
     return ASDF_VALUE_OK;
 }
 
@@ -986,6 +1272,7 @@ asdf_value_err_t asdf_sequence_append_null(asdf_sequence_t *sequence) {
             ASDF_ERROR_OOM(sequence->value.file); \
             return ASDF_VALUE_ERR_OOM; \
         } \
+        asdf_file_tag_index_clear(sequence->value.file); \
         return ASDF_VALUE_OK; \
     }
 
@@ -1002,6 +1289,7 @@ asdf_value_err_t asdf_sequence_append_null(asdf_sequence_t *sequence) {
             ASDF_ERROR_OOM(sequence->value.file); \
             return ASDF_VALUE_ERR_OOM; \
         } \
+        asdf_file_tag_index_clear(sequence->value.file); \
         return ASDF_VALUE_OK; \
     }
 
@@ -1025,6 +1313,7 @@ asdf_value_err_t asdf_sequence_append(asdf_sequence_t *sequence, asdf_value_t *v
         err = ASDF_VALUE_ERR_OOM;
         goto cleanup;
     }
+    asdf_file_tag_index_clear(sequence->value.file);
     err = ASDF_VALUE_OK;
 cleanup:
     /* fy_node_sequence_append implicitly frees the original node, so here set it
@@ -1185,6 +1474,69 @@ ASDF_SEQUENCE_OF_TYPE(float, float)
 ASDF_SEQUENCE_OF_TYPE(double, double)
 
 
+/** Common checks for asdf_sequence_as_<type>_array */
+static asdf_value_err_t sequence_as_array_begin(
+    asdf_sequence_t *sequence, const void *arr, int size, int *count) {
+    if (UNLIKELY(!sequence))
+        return ASDF_VALUE_ERR_UNKNOWN;
+
+    if (sequence->value.raw_type != ASDF_VALUE_SEQUENCE)
+        return ASDF_VALUE_ERR_TYPE_MISMATCH;
+
+    int n_items = fy_node_sequence_item_count(sequence->value.node);
+
+    if (count)
+        *count = n_items;
+
+    if (arr && n_items > size)
+        return ASDF_VALUE_ERR_OVERFLOW;
+
+    return ASDF_VALUE_OK;
+}
+
+
+/*
+ * Macro to generate asdf_sequence_as_<type>_array
+ *
+ * The items are converted through a temporary value on the stack, so they go through exactly
+ * the same type inference as `asdf_value_as_<type>` on each item, but without allocating a
+ * new value (or iterator) for each one.
+ */
+#define ASDF_SEQUENCE_AS_TYPE_ARRAY(type, ctype) \
+    asdf_value_err_t asdf_sequence_as_##type##_array( \
+        asdf_sequence_t *sequence, ctype *arr, int size, int *count) { \
+        asdf_value_err_t err = sequence_as_array_begin(sequence, arr, size, count); \
+        if (err != ASDF_VALUE_OK || !arr) \
+            return err; \
+        struct fy_node *node = NULL; \
+        void *iter = NULL; \
+        asdf_value_t item; \
+        while ((node = fy_node_sequence_iterate(sequence->value.node, &iter))) { \
+            if (UNLIKELY(!asdf_value_init(&item, sequence->value.file, node))) \
+                return ASDF_VALUE_ERR_OOM; \
+            err = asdf_value_as_##type(&item, arr++); \
+            asdf_value_clear(&item); \
+            if (err != ASDF_VALUE_OK) \
+                return err; \
+        } \
+        return ASDF_VALUE_OK; \
+    }
+
+#define ASDF_SEQUENCE_AS_INT_TYPE_ARRAY(type) ASDF_SEQUENCE_AS_TYPE_ARRAY(type, type##_t)
+
+
+ASDF_SEQUENCE_AS_INT_TYPE_ARRAY(int8)
+ASDF_SEQUENCE_AS_INT_TYPE_ARRAY(int16)
+ASDF_SEQUENCE_AS_INT_TYPE_ARRAY(int32)
+ASDF_SEQUENCE_AS_INT_TYPE_ARRAY(int64)
+ASDF_SEQUENCE_AS_INT_TYPE_ARRAY(uint8)
+ASDF_SEQUENCE_AS_INT_TYPE_ARRAY(uint16)
+ASDF_SEQUENCE_AS_INT_TYPE_ARRAY(uint32)
+ASDF_SEQUENCE_AS_INT_TYPE_ARRAY(uint64)
+ASDF_SEQUENCE_AS_TYPE_ARRAY(float, float)
+ASDF_SEQUENCE_AS_TYPE_ARRAY(double, double)
+
+
 asdf_value_t *asdf_sequence_pop(asdf_sequence_t *sequence, int index) {
     if (UNLIKELY(!sequence))
         return NULL;
@@ -1200,6 +1552,8 @@ asdf_value_t *asdf_sequence_pop(asdf_sequence_t *sequence, int index) {
     if (!node)
         return NULL;
 
+    asdf_file_path_cache_clear(value->file);
+
     return asdf_value_create(value->file, node);
 }
 
@@ -1217,13 +1571,15 @@ asdf_container_iter_t *asdf_container_iter_init(asdf_value_t *container) {
         return NULL;
     }
 
-    asdf_container_iter_impl_t *impl = calloc(1, sizeof(asdf_container_iter_impl_t));
+    asdf_file_t *file = container->file;
+    asdf_container_iter_impl_t *impl = asdf_iter_alloc(file, sizeof(asdf_container_iter_impl_t));
 
     if (!impl) {
-        ASDF_ERROR_OOM(container->file);
+        ASDF_ERROR_OOM(file);
         return NULL;
     }
 
+    impl->file = file;
     impl->container = container;
     impl->is_mapping = (container->raw_type == ASDF_VALUE_MAPPING);
     impl->pub.index = -1;
@@ -1231,13 +1587,13 @@ asdf_container_iter_t *asdf_container_iter_init(asdf_value_t *container) {
     if (impl->is_mapping) {
         impl->iter.mapping = asdf_mapping_iter_init((asdf_mapping_t *)container);
         if (!impl->iter.mapping) {
-            free(impl);
+            asdf_iter_free(file, impl);
             return NULL;
         }
     } else {
         impl->iter.sequence = asdf_sequence_iter_init((asdf_sequence_t *)container);
         if (!impl->iter.sequence) {
-            free(impl);
+            asdf_iter_free(file, impl);
             return NULL;
         }
     }
@@ -1258,7 +1614,7 @@ void asdf_container_iter_destroy(asdf_container_iter_t *iter) {
         asdf_sequence_iter_destroy(impl->iter.sequence);
 
     /* pub.value aliases the sub-iter's value; not independently freed */
-    free(impl);
+    asdf_iter_free(impl->file, impl);
 }
 
 
@@ -1288,7 +1644,7 @@ bool asdf_container_iter_next(asdf_container_iter_t **iter_ptr) {
 
 cleanup:
     /* sub-iter already freed and nulled by its _next(); just free our wrapper */
-    free(impl);
+    asdf_iter_free(impl->file, impl);
     *iter_ptr = NULL;
     return false;
 }
@@ -1376,9 +1732,34 @@ asdf_value_err_t asdf_value_as_extension_type(
 
     asdf_extension_value_t *extval = value->scalar.ext;
 
+    // Objects passed to asdf_value_of_extension_type, or already read from a detached node, are
+    // handed out as a new reference too; the former are only borrowed and never freed by it
     if (extval->object) {
+        if (LIKELY(out)) {
+            void *object = asdf_object_retain(ext, (void *)extval->object, !extval->owns_object);
+
+            if (UNLIKELY(!object)) {
+                ASDF_ERROR_OOM(value->file);
+                return ASDF_VALUE_ERR_OOM;
+            }
+
+            *out = object;
+        }
+
+        return ASDF_VALUE_OK;
+    }
+
+    // Objects already read from the same node are shared rather than deserialized again.  Only
+    // nodes in the tree are cached by the file; detached nodes may be freed along with their
+    // value, so their object is kept on the value instead.
+    bool cacheable = fy_node_is_attached(value->node) || is_root_node(value->node);
+    void *object = cacheable ? asdf_object_cache_get(value->file, value->node, ext) : NULL;
+
+    if (object) {
         if (LIKELY(out))
-            *out = (void *)extval->object;
+            *out = object;
+        else
+            asdf_extension_object_destroy(ext, object);
 
         return ASDF_VALUE_OK;
     }
@@ -1393,11 +1774,30 @@ asdf_value_err_t asdf_value_as_extension_type(
         return ASDF_VALUE_ERR_OOM;
     }
 
-    asdf_value_err_t err = ext->deserialize(raw_value, ext->userdata, out);
+    asdf_value_err_t err = ext->deserialize(raw_value, ext->userdata, &object);
     asdf_value_destroy(raw_value);
 
-    if (ASDF_VALUE_OK == err)
-        extval->object = *out;
+    if (ASDF_VALUE_OK == err) {
+        if (cacheable) {
+            asdf_object_cache_add(value->file, value->node, ext, object);
+        } else if (asdf_object_retain(ext, object, false)) {
+            // The reference just registered becomes the value's own; the object is left
+            // unregistered and owned by the caller alone if it couldn't be registered
+            extval->object = object;
+            extval->owns_object = true;
+
+            if (LIKELY(out))
+                *out = asdf_object_retain(ext, object, false);
+
+            value->err = err;
+            return err;
+        }
+
+        if (LIKELY(out))
+            *out = object;
+        else
+            asdf_extension_object_destroy(ext, object);
+    }
 
     value->err = err;
     return err;
@@ -1507,28 +1907,240 @@ static bool is_yaml_bool(const char *scalar, size_t len, bool *value) {
 }
 
 
+/*
+ * Number parsing helpers
+ *
+ * Scalars are not null-terminated in the YAML tree, so the libc parsers need a copy of them.
+ * Nearly all numbers in real files are short, plain decimals, which are parsed here directly
+ * without making a copy; anything else (hex/octal integers, inf/nan, numbers too long or
+ * with too large an exponent to be converted exactly) still goes through strtoll/strtoull, or
+ * strtod in the C locale so that the decimal separator is always ``.``.
+ */
+#define SCALAR_BUF_SIZE 64
+
+/** Enough decimal digits to never overflow a uint64_t or an int64_t magnitude */
+#define MAX_FAST_INT_DIGITS 18
+
+/** Largest power of ten exactly representable as a double */
+#define MAX_FAST_POW10 22
+
+/** Largest mantissa (2^53) that is exactly representable as a double */
+#define MAX_FAST_MANTISSA (UINT64_C(1) << 53)
+
+
+static const double fast_pow10[MAX_FAST_POW10 + 1] = {
+    1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+
+#ifdef HAVE_STRTOD_L
+/** The C locale, for parsing floats independently of the application's locale */
+static locale_t asdf_c_locale = (locale_t)0;
+
+
+ASDF_CONSTRUCTOR static void asdf_c_locale_create() {
+    asdf_c_locale = newlocale(LC_ALL_MASK, "C", (locale_t)0);
+}
+
+
+ASDF_DESTRUCTOR static void asdf_c_locale_destroy(void) {
+    if (asdf_c_locale)
+        freelocale(asdf_c_locale);
+
+    asdf_c_locale = (locale_t)0;
+}
+#endif
+
+
+/** `strtod` in the C locale, where available */
+static double strtod_c(const char *s, char **end) {
+#ifdef HAVE_STRTOD_L
+    if (LIKELY(asdf_c_locale))
+        return strtod_l(s, end, asdf_c_locale);
+#endif
+    return strtod(s, end);
+}
+
+
+/**
+ * Copy a scalar to a null-terminated string, using ``buf`` if it is large enough
+ *
+ * Free the result with `scalar_copy_free`.
+ */
+static char *scalar_copy(const char *scalar, size_t len, char buf[SCALAR_BUF_SIZE]) {
+    if (len >= SCALAR_BUF_SIZE)
+        return strndup(scalar, len);
+
+    memcpy(buf, scalar, len);
+    buf[len] = '\0';
+    return buf;
+}
+
+
+static void scalar_copy_free(char *copy, char buf[SCALAR_BUF_SIZE]) {
+    if (copy != buf)
+        free(copy);
+}
+
+
+/**
+ * Parse a plain decimal integer such as ``-123`` or ``+45``
+ *
+ * Returns false, without parsing anything, for any other syntax strtoll would accept (leading
+ * whitespace, leading zeros which are parsed as octal, hex) or if the number may not fit.
+ */
+static bool parse_decimal_fast(const char *scalar, size_t len, bool *negative, uint64_t *value) {
+    const char *p = scalar;
+    const char *end = scalar + len;
+
+    *negative = false;
+
+    if (p < end && (*p == '-' || *p == '+')) {
+        *negative = *p == '-';
+        p++;
+    }
+
+    size_t n_digits = end - p;
+
+    if (n_digits == 0 || n_digits > MAX_FAST_INT_DIGITS || (*p == '0' && n_digits > 1))
+        return false;
+
+    uint64_t val = 0;
+
+    for (; p < end; p++) {
+        unsigned digit = (unsigned char)*p - '0';
+
+        if (digit > 9)
+            return false;
+
+        val = val * 10 + digit;
+    }
+
+    *value = val;
+    return true;
+}
+
+
+/**
+ * Parse a decimal float such as ``-1.5``, ``.25`` or ``6.02e23``
+ *
+ * This only handles the case where the digits fit exactly in a double's mantissa and the power
+ * of ten is itself exact, so that a single multiplication or division gives the correctly
+ * rounded result.  Returns false for anything else so that the caller can fall back to strtod.
+ */
+static bool parse_float_fast(const char *scalar, size_t len, double *value) {
+    const char *p = scalar;
+    const char *end = scalar + len;
+    bool negative = false;
+
+    if (p < end && (*p == '-' || *p == '+')) {
+        negative = *p == '-';
+        p++;
+    }
+
+    uint64_t mantissa = 0;
+    int exp10 = 0;
+    size_t n_digits = 0;
+    bool seen_point = false;
+
+    for (; p < end; p++) {
+        if (*p == '.' && !seen_point) {
+            seen_point = true;
+            continue;
+        }
+
+        unsigned digit = (unsigned char)*p - '0';
+
+        if (digit > 9)
+            break;
+
+        if (mantissa > (MAX_FAST_MANTISSA - digit) / 10)
+            return false;
+
+        mantissa = mantissa * 10 + digit;
+        n_digits++;
+
+        if (seen_point)
+            exp10--;
+    }
+
+    if (n_digits == 0)
+        return false;
+
+    if (p < end) {
+        if (*p != 'e' && *p != 'E')
+            return false;
+
+        p++;
+        bool exp_negative = false;
+
+        if (p < end && (*p == '-' || *p == '+')) {
+            exp_negative = *p == '-';
+            p++;
+        }
+
+        if (p == end)
+            return false;
+
+        int exp = 0;
+
+        for (; p < end; p++) {
+            unsigned digit = (unsigned char)*p - '0';
+
+            if (digit > 9 || exp > MAX_FAST_POW10 * 2)
+                return false;
+
+            exp = exp * 10 + (int)digit;
+        }
+
+        exp10 += exp_negative ? -exp : exp;
+    }
+
+    if (exp10 < -MAX_FAST_POW10 || exp10 > MAX_FAST_POW10)
+        return false;
+
+    double val = (double)mantissa;
+
+    if (exp10 < 0)
+        val /= fast_pow10[-exp10];
+    else
+        val *= fast_pow10[exp10];
+
+    *value = negative ? -val : val;
+    return true;
+}
+
+
 static asdf_value_err_t is_yaml_signed_int(
     const char *scalar, size_t len, int64_t *value, asdf_value_type_t *type) {
     if (!scalar)
         return ASDF_VALUE_ERR_UNKNOWN;
 
-    char *int_s = strndup(scalar, len);
+    bool negative = false;
+    uint64_t mag = 0;
+    int64_t val = 0;
 
-    if (!int_s)
-        return ASDF_VALUE_ERR_UNKNOWN;
+    if (parse_decimal_fast(scalar, len, &negative, &mag)) {
+        val = negative ? -(int64_t)mag : (int64_t)mag;
+    } else {
+        char buf[SCALAR_BUF_SIZE];
+        char *int_s = scalar_copy(scalar, len, buf);
 
-    errno = 0;
-    char *end = NULL;
-    int64_t val = strtoll(int_s, &end, 0);
+        if (!int_s)
+            return ASDF_VALUE_ERR_UNKNOWN;
 
-    if (errno == ERANGE) {
-        free(int_s);
-        return ASDF_VALUE_ERR_OVERFLOW;
-    }
+        errno = 0;
+        char *end = NULL;
+        val = strtoll(int_s, &end, 0);
+        bool parsed = *end == '\0';
+        scalar_copy_free(int_s, buf);
 
-    if (errno || *end) {
-        free(int_s);
-        return ASDF_VALUE_ERR_PARSE_FAILURE;
+        if (errno == ERANGE)
+            return ASDF_VALUE_ERR_OVERFLOW;
+
+        if (errno || !parsed)
+            return ASDF_VALUE_ERR_PARSE_FAILURE;
     }
 
     /* choose smallest int that fits */
@@ -1542,7 +2154,6 @@ static asdf_value_err_t is_yaml_signed_int(
         *type = ASDF_VALUE_INT64;
 
     *value = val;
-    free(int_s);
     return ASDF_VALUE_OK;
 }
 
@@ -1550,13 +2161,9 @@ static asdf_value_err_t is_yaml_signed_int(
 #define MAX_UINT64_DIGITS 20
 
 
-static asdf_value_err_t is_yaml_unsigned_int(
-    const char *scalar, size_t len, uint64_t *value, asdf_value_type_t *type) {
-    if (!scalar)
-        return ASDF_VALUE_ERR_UNKNOWN;
-
+static asdf_value_err_t parse_unsigned_slow(const char *scalar, size_t len, uint64_t *value) {
     const char *stmp = scalar;
-    char *end = (char *)scalar + len;
+    const char *end = scalar + len;
 
     /**
      * TIL: strtoull is stupid--it will happily parse negative signs and even
@@ -1566,29 +2173,50 @@ static asdf_value_err_t is_yaml_unsigned_int(
      * Hence we do the whitespace skipping and check ourselves for a negative
      * sign.
      */
-    while (isspace(*stmp) && stmp <= end)
+    while (stmp < end && isspace(*stmp))
         stmp++;
 
-    if (stmp > end || (!isdigit(*stmp) && *stmp != '+'))
+    if (stmp >= end || (!isdigit(*stmp) && *stmp != '+'))
         return ASDF_VALUE_ERR_PARSE_FAILURE;
 
+    size_t remaining = end - stmp;
     size_t maxlen = MAX_UINT64_DIGITS + 1; // Allow for an optional + sign
-    char *uint_s = strndup(stmp, len < maxlen ? len : maxlen);
+    char buf[SCALAR_BUF_SIZE];
+    char *uint_s = scalar_copy(stmp, remaining < maxlen ? remaining : maxlen, buf);
 
     if (!uint_s)
         return ASDF_VALUE_ERR_OOM;
 
     errno = 0;
-    uint64_t val = strtoull(uint_s, &end, 0);
+    char *uint_end = NULL;
+    uint64_t val = strtoull(uint_s, &uint_end, 0);
+    bool parsed = *uint_end == '\0';
+    scalar_copy_free(uint_s, buf);
 
-    if (errno == ERANGE) {
-        free(uint_s);
+    if (errno == ERANGE)
         return ASDF_VALUE_ERR_OVERFLOW;
-    }
 
-    if (errno || *end) {
-        free(uint_s);
+    if (errno || !parsed)
         return ASDF_VALUE_ERR_PARSE_FAILURE;
+
+    *value = val;
+    return ASDF_VALUE_OK;
+}
+
+
+static asdf_value_err_t is_yaml_unsigned_int(
+    const char *scalar, size_t len, uint64_t *value, asdf_value_type_t *type) {
+    if (!scalar)
+        return ASDF_VALUE_ERR_UNKNOWN;
+
+    bool negative = false;
+    uint64_t val = 0;
+
+    if (!parse_decimal_fast(scalar, len, &negative, &val) || negative) {
+        asdf_value_err_t err = parse_unsigned_slow(scalar, len, &val);
+
+        if (err != ASDF_VALUE_OK)
+            return err;
     }
 
     /* choose smallest int that fits */
@@ -1602,7 +2230,6 @@ static asdf_value_err_t is_yaml_unsigned_int(
         *type = ASDF_VALUE_UINT64;
 
     *value = val;
-    free(uint_s);
     return ASDF_VALUE_OK;
 }
 
@@ -1613,29 +2240,32 @@ static asdf_value_err_t is_yaml_float(
     if (!scalar)
         return ASDF_VALUE_ERR_UNKNOWN;
 
-    char *double_s = strndup(scalar, len);
+    double val = 0.0;
 
-    if (!double_s)
-        return ASDF_VALUE_ERR_UNKNOWN;
+    if (!parse_float_fast(scalar, len, &val)) {
+        char buf[SCALAR_BUF_SIZE];
+        char *double_s = scalar_copy(scalar, len, buf);
 
-    errno = 0;
-    char *end = NULL;
-    double val = strtod(double_s, &end);
+        if (!double_s)
+            return ASDF_VALUE_ERR_UNKNOWN;
 
-    if (errno == ERANGE) {
-        free(double_s);
-        *type = ASDF_VALUE_DOUBLE;
-        return ASDF_VALUE_ERR_OVERFLOW;
-    }
+        errno = 0;
+        char *end = NULL;
+        val = strtod_c(double_s, &end);
+        bool parsed = *end == '\0';
+        scalar_copy_free(double_s, buf);
 
-    if (errno || *end) {
-        free(double_s);
-        return ASDF_VALUE_ERR_PARSE_FAILURE;
+        if (errno == ERANGE) {
+            *type = ASDF_VALUE_DOUBLE;
+            return ASDF_VALUE_ERR_OVERFLOW;
+        }
+
+        if (errno || !parsed)
+            return ASDF_VALUE_ERR_PARSE_FAILURE;
     }
 
     *value = val;
     *type = ASDF_VALUE_DOUBLE;
-    free(double_s);
     return ASDF_VALUE_OK;
 }
 
@@ -3010,16 +3640,42 @@ void asdf_find_iter_destroy(asdf_find_iter_t *iter) {
     while (impl->frame_count > 0)
         asdf_find_iter_pop_frame(impl, impl->frame_count - 1);
 
+    if (impl->nodes)
+        asdf_value_destroy(impl->pub.value);
+
+    free((void *)impl->nodes);
     free(impl->frames);
     free(impl);
 }
 
 
+/** Step an iterator over nodes from the tag index */
+static asdf_value_t *asdf_find_iter_next_indexed(asdf_find_iter_impl_t *iter) {
+    if (iter->node_idx >= iter->node_count)
+        return NULL;
+
+    return asdf_value_create(iter->file, iter->nodes[iter->node_idx++]);
+}
+
+
 bool asdf_value_find_iter_next(asdf_find_iter_t **iter_ptr) {
     if (!iter_ptr || !*iter_ptr)
         return false;
 
     asdf_find_iter_impl_t *impl = (asdf_find_iter_impl_t *)*iter_ptr;
+
+    if (impl->nodes) {
+        asdf_value_destroy(impl->pub.value);
+        impl->pub.value = asdf_find_iter_next_indexed(impl);
+
+        if (impl->pub.value)
+            return true;
+
+        asdf_find_iter_destroy((asdf_find_iter_t *)impl);
+        *iter_ptr = NULL;
+        return false;
+    }
+
     impl->pub.value = NULL;
 
     asdf_value_t *current = NULL;
@@ -3069,6 +3725,41 @@ asdf_value_t *asdf_value_find(asdf_value_t *root, asdf_value_pred_t pred) {
 }
 
 
+/** Create an iterator over nodes found in the tag index; takes ownership of ``nodes`` */
+static asdf_find_iter_t *asdf_find_iter_create_indexed(
+    asdf_file_t *file, struct fy_node **nodes, size_t count) {
+    if (!nodes)
+        return NULL;
+
+    asdf_find_iter_impl_t *impl = calloc(1, sizeof(asdf_find_iter_impl_t));
+
+    if (!impl) {
+        ASDF_ERROR_OOM(file);
+        free((void *)nodes);
+        return NULL;
+    }
+
+    impl->file = file;
+    impl->nodes = nodes;
+    impl->node_count = count;
+    return (asdf_find_iter_t *)impl;
+}
+
+
+asdf_find_iter_t *asdf_find_by_tag(asdf_file_t *file, const char *tag) {
+    size_t count = 0;
+    struct fy_node **nodes = asdf_tag_index_find_tag(asdf_file_tag_index(file), tag, &count);
+    return asdf_find_iter_create_indexed(file, nodes, count);
+}
+
+
+asdf_find_iter_t *asdf_find_by_key(asdf_file_t *file, const char *key) {
+    size_t count = 0;
+    struct fy_node **nodes = asdf_tag_index_find_key(asdf_file_tag_index(file), key, &count);
+    return asdf_find_iter_create_indexed(file, nodes, count);
+}
+
+
 /** Value insertions */
 
 
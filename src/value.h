@@ -17,9 +17,41 @@
 typedef struct {
     const asdf_extension_t *ext;
     const void *object;
+    /**
+     * Whether the value holds a reference to ``object``, deserialized from its detached node,
+     * rather than borrowing it from the caller of `asdf_value_of_extension_type`
+     */
+    bool owns_object;
 } asdf_extension_value_t;
 
 
+/** Keys up to this length are stored inline in `asdf_value_path_node_t` */
+#define ASDF_VALUE_PATH_KEY_INLINE 32
+
+
+/**
+ * Node in the tree of paths of values created from their parent values
+ *
+ * Values created from a parent value (by mapping and sequence lookups and iteration) only record
+ * their key or index in the parent and a reference to the parent's node.  The path string is only
+ * built when first asked for by `asdf_value_path`, and is memoized on each node along the way so
+ * that siblings share the work of building their parent's path.
+ *
+ * A node with no parent holds the full path of a value whose path was already known.
+ */
+typedef struct asdf_value_path_node {
+    unsigned int refcount;
+    /** Index in the parent sequence if there is no key */
+    int index;
+    struct asdf_value_path_node *parent;
+    /** Key in the parent mapping; points either to ``key_buf`` or to a heap copy */
+    char *key;
+    /** The full path, once built */
+    char *path;
+    char key_buf[ASDF_VALUE_PATH_KEY_INLINE];
+} asdf_value_path_node_t;
+
+
 typedef struct asdf_value {
     asdf_file_t *file;
     asdf_value_type_t type;
@@ -38,7 +70,12 @@ typedef struct asdf_value {
         double d;
         asdf_extension_value_t *ext;
     } scalar;
+    /**
+     * The value's path, if known; otherwise it is built from ``path_node`` if set, or else looked
+     * up from the node itself, by `asdf_value_path`
+     */
     const char *path;
+    asdf_value_path_node_t *path_node;
     asdf_yaml_node_style_t style;
 } asdf_value_t;
 
@@ -51,6 +88,8 @@ typedef struct asdf_mapping {
 typedef struct asdf_mapping_iter_impl {
     /** Must first member -- cast to/from asdf_mapping_iter_t * is valid */
     asdf_mapping_iter_t pub;
+    /** File whose iterator pool this was allocated from */
+    asdf_file_t *file;
     asdf_mapping_t *mapping;
     void *fy_iter;
 } asdf_mapping_iter_impl_t;
@@ -64,6 +103,8 @@ typedef struct asdf_sequence {
 typedef struct asdf_sequence_iter_impl {
     /** Must first member -- cast to/from asdf_sequence_iter_t * is valid */
     asdf_sequence_iter_t pub;
+    /** File whose iterator pool this was allocated from */
+    asdf_file_t *file;
     asdf_sequence_t *sequence;
     void *fy_iter;
 } asdf_sequence_iter_impl_t;
@@ -72,6 +113,8 @@ typedef struct asdf_sequence_iter_impl {
 typedef struct asdf_container_iter_impl {
     /** Must first member -- cast to/from asdf_container_iter_t * is valid */
     asdf_container_iter_t pub;
+    /** File whose iterator pool this was allocated from */
+    asdf_file_t *file;
     asdf_value_t *container;
     bool is_mapping;
     union {
@@ -81,8 +124,23 @@ typedef struct asdf_container_iter_impl {
 } asdf_container_iter_impl_t;
 
 
+/** Set up the file's pools for values, iterators and value paths; see `asdf_file_t` */
+ASDF_LOCAL void asdf_value_pools_init(asdf_file_t *file);
+
 ASDF_LOCAL asdf_value_t *asdf_value_create(asdf_file_t *file, struct fy_node *node);
 
+/**
+ * Initialize a caller-allocated `asdf_value_t` wrapping ``node``
+ *
+ * For values that are only needed briefly, such as by the ``asdf_is_*`` and ``asdf_get_*``
+ * shortcuts, to save allocating them.  Release with `asdf_value_clear` instead of
+ * `asdf_value_destroy`.
+ */
+ASDF_LOCAL bool asdf_value_init(asdf_value_t *value, asdf_file_t *file, struct fy_node *node);
+
+/** Release the resources held by a value without freeing the value itself */
+ASDF_LOCAL void asdf_value_clear(asdf_value_t *value);
+
 
 typedef struct asdf_find_frame {
     asdf_value_t *container;
@@ -104,6 +162,14 @@ typedef struct asdf_find_iter_impl {
     asdf_find_frame_t *frames;
     size_t frame_count;
     size_t frame_cap;
+    /**
+     * Nodes to yield when the iterator comes from the tag index (`asdf_find_by_tag` and
+     * `asdf_find_by_key`) instead of traversing the tree
+     */
+    asdf_file_t *file;
+    struct fy_node **nodes;
+    size_t node_count;
+    size_t node_idx;
 } asdf_find_iter_impl_t;
 
 
@@ -3,6 +3,7 @@
 #endif
 #include <assert.h>
 #include <ctype.h>
+#include <limits.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include <string.h>
@@ -567,3 +568,53 @@ invalid:
     asdf_yaml_path_clear(out_path);
     return false;
 }
+
+
+static struct fy_node *yaml_path_component_resolve(
+    struct fy_node *parent, const asdf_yaml_path_component_t *comp) {
+    bool is_mapping = fy_node_is_mapping(parent);
+    bool is_sequence = fy_node_is_sequence(parent);
+
+    switch (comp->target) {
+    case ASDF_YAML_PC_TARGET_ANY:
+        break;
+    case ASDF_YAML_PC_TARGET_MAP:
+        is_sequence = false;
+        break;
+    case ASDF_YAML_PC_TARGET_SEQ:
+        is_mapping = false;
+        break;
+    }
+
+    if (is_mapping)
+        return fy_node_mapping_lookup_by_string(parent, comp->key, FY_NT);
+
+    // libfyaml only supports ``int`` for sequence indices
+    if (is_sequence && comp->index <= INT_MAX && comp->index >= INT_MIN)
+        return fy_node_sequence_get_by_index(parent, (int)comp->index);
+
+    return NULL;
+}
+
+
+struct fy_node *asdf_yaml_path_resolve(struct fy_node *root, const asdf_yaml_path_t *path) {
+    if (!root || !path)
+        return NULL;
+
+    isize n_components = asdf_yaml_path_size(path);
+    const asdf_yaml_path_component_t *comp = asdf_yaml_path_at(path, 0);
+
+    if (n_components < 1)
+        return NULL;
+
+    // The empty path (represented by a single empty mapping key) refers to the root
+    if (n_components == 1 && comp->target == ASDF_YAML_PC_TARGET_MAP && comp->key[0] == '\0')
+        return root;
+
+    struct fy_node *node = root;
+
+    for (isize idx = 0; node && idx < n_components; idx++)
+        node = yaml_path_component_resolve(node, asdf_yaml_path_at(path, idx));
+
+    return node;
+}
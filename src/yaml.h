@@ -135,3 +135,11 @@ typedef asdf_yaml_path_iter asdf_yaml_path_iter_t;
 ASDF_LOCAL char *asdf_yaml_tag_canonicalize(const char *tag);
 ASDF_LOCAL char *asdf_yaml_tag_normalize(const char *tag, const asdf_yaml_tag_handle_t *handles);
 ASDF_LOCAL bool asdf_yaml_path_parse(const char *path, asdf_yaml_path_t *out_path);
+
+/**
+ * Find the node at a path parsed with `asdf_yaml_path_parse`, starting from ``root``
+ *
+ * Returns NULL if there is no node at that path.  Alias nodes are not followed along the way.
+ */
+ASDF_LOCAL struct fy_node *asdf_yaml_path_resolve(
+    struct fy_node *root, const asdf_yaml_path_t *path);
@@ -157,6 +157,28 @@ MU_TEST(extension_get_unregistered) {
 }
 
 
+MU_TEST(extension_get_cached) {
+    const char *path = get_fixture_file_path("trivial-extension.asdf");
+    asdf_file_t *file = asdf_open(path, "r");
+    assert_not_null(file);
+
+    // Repeated lookups, with or without the tag: prefix, resolve to the same extension
+    for (int idx = 0; idx < 3; idx++) {
+        const asdf_extension_t *ext = asdf_extension_get(file, "stsci.edu:asdf/tests/foo-1.0.0");
+        assert_ptr_equal(ext, &asdf_foo_extension);
+        ext = asdf_extension_get(file, "tag:stsci.edu:asdf/tests/foo-1.0.0");
+        assert_ptr_equal(ext, &asdf_foo_extension);
+        assert_null(asdf_extension_get(file, "unregistered-tag"));
+    }
+
+    // Lookups without a file bypass the cache
+    assert_ptr_equal(
+        asdf_extension_get(NULL, "stsci.edu:asdf/tests/foo-1.0.0"), &asdf_foo_extension);
+    asdf_close(file);
+    return MUNIT_OK;
+}
+
+
 MU_TEST(test_asdf_value_is_foo) {
     const char *path = get_fixture_file_path("trivial-extension.asdf");
     asdf_file_t *file = asdf_open(path, "r");
@@ -182,7 +204,6 @@ MU_TEST(test_asdf_value_as_foo) {
     assert_not_null(foo->foo);
     assert_string_equal(foo->foo, "foo:foo");
     asdf_value_destroy(value);
-    // TODO: User has to destroy the asdf_foo_t object for now; consider fixing this in #34
     asdf_foo_destroy(foo);
     asdf_close(file);
     return MUNIT_OK;
@@ -209,6 +230,31 @@ MU_TEST(test_asdf_value_of_foo) {
 }
 
 
+/**
+ * Objects read back from a value built with `asdf_value_of_foo` are references to the original,
+ * which releasing them does not free
+ */
+MU_TEST(test_asdf_value_of_foo_as_foo) {
+    asdf_file_t *file = asdf_open(NULL);
+    assert_not_null(file);
+    asdf_foo_t foo = {.foo = "foo:foo"};
+    asdf_value_t *value = asdf_value_of_foo(file, &foo);
+    assert_not_null(value);
+    asdf_foo_t *foo1 = NULL;
+    asdf_foo_t *foo2 = NULL;
+    assert_int(asdf_value_as_foo(value, &foo1), ==, ASDF_VALUE_OK);
+    assert_int(asdf_value_as_foo(value, &foo2), ==, ASDF_VALUE_OK);
+    assert_ptr_equal(foo1, &foo);
+    assert_ptr_equal(foo2, &foo);
+    asdf_foo_destroy(foo1);
+    asdf_foo_destroy(foo2);
+    assert_string_equal(foo.foo, "foo:foo");
+    asdf_value_destroy(value);
+    asdf_close(file);
+    return MUNIT_OK;
+}
+
+
 MU_TEST(test_asdf_is_foo) {
     const char *path = get_fixture_file_path("trivial-extension.asdf");
     asdf_file_t *file = asdf_open(path, "r");
@@ -228,7 +274,25 @@ MU_TEST(test_asdf_get_foo) {
     assert_not_null(foo);
     assert_not_null(foo->foo);
     assert_string_equal(foo->foo, "foo:foo");
-    // TODO: User has to destroy the asdf_foo_t object for now; consider fixing this in #34
+    asdf_foo_destroy(foo);
+    asdf_close(file);
+    return MUNIT_OK;
+}
+
+
+MU_TEST(test_asdf_get_foo_shared) {
+    const char *path = get_fixture_file_path("trivial-extension.asdf");
+    asdf_file_t *file = asdf_open(path, "r");
+    assert_not_null(file);
+    asdf_foo_t *foo = NULL;
+    asdf_foo_t *foo2 = NULL;
+    assert_int(asdf_get_foo(file, "foo", &foo), ==, ASDF_VALUE_OK);
+    assert_int(asdf_get_foo(file, "foo", &foo2), ==, ASDF_VALUE_OK);
+    // Reading the same value twice returns the same object
+    assert_ptr_equal(foo, foo2);
+    // The object stays valid until its last reference is released
+    asdf_foo_destroy(foo2);
+    assert_string_equal(foo->foo, "foo:foo");
     asdf_foo_destroy(foo);
     asdf_close(file);
     return MUNIT_OK;
@@ -267,11 +331,14 @@ MU_TEST_SUITE(
     extension,
     MU_RUN_TEST(extension_registered),
     MU_RUN_TEST(extension_get_unregistered),
+    MU_RUN_TEST(extension_get_cached),
     MU_RUN_TEST(test_asdf_value_is_foo),
     MU_RUN_TEST(test_asdf_value_as_foo),
     MU_RUN_TEST(test_asdf_value_of_foo),
+    MU_RUN_TEST(test_asdf_value_of_foo_as_foo),
     MU_RUN_TEST(test_asdf_is_foo),
     MU_RUN_TEST(test_asdf_get_foo),
+    MU_RUN_TEST(test_asdf_get_foo_shared),
     MU_RUN_TEST(test_asdf_foo_clone),
     MU_RUN_TEST(test_asdf_foo_array_clone)
 );
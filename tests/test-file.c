@@ -11,6 +11,9 @@
 #include <stc/cstr.h>
 
 #include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 #include "asdf/emitter.h"
 #include "asdf/error.h"
@@ -221,6 +224,56 @@ MU_TEST(test_asdf_get_sequence) {
 }
 
 
+/**
+ * Repeated lookups of the same path are served from the file's path cache, and
+ * compiled paths find the same nodes as plain string paths
+ */
+MU_TEST(path_cache) {
+    const char *filename = get_fixture_file_path("value-types.asdf");
+    asdf_file_t *file = asdf_open_file(filename, "r");
+    assert_not_null(file);
+    assert_int(asdf_node_map_size(&file->path_cache), ==, 0);
+
+    const char *s = NULL;
+    assert_int(asdf_get_string0(file, "mapping/foo", &s), ==, ASDF_VALUE_OK);
+    assert_string_equal(s, "foo");
+    assert_int(asdf_node_map_size(&file->path_cache), ==, 1);
+    assert_int(asdf_get_string0(file, "mapping/foo", &s), ==, ASDF_VALUE_OK);
+    assert_int(asdf_node_map_size(&file->path_cache), ==, 1);
+
+    // Paths that do not exist are not cached
+    assert_false(asdf_is_string(file, "mapping/baz"));
+    assert_int(asdf_node_map_size(&file->path_cache), ==, 1);
+
+    asdf_path_t *path = asdf_path_compile("sequence/1");
+    assert_not_null(path);
+    assert_string_equal(asdf_path_str(path), "sequence/1");
+    asdf_value_t *value = asdf_get_value_path(file, path);
+    assert_not_null(value);
+    int64_t i = 0;
+    assert_int(asdf_value_as_int64(value, &i), ==, ASDF_VALUE_OK);
+    assert_int(i, ==, 1);
+    asdf_value_destroy(value);
+    assert_int(asdf_node_map_size(&file->path_cache), ==, 2);
+    assert_int(asdf_get_int64(file, "sequence/1", &i), ==, ASDF_VALUE_OK);
+    assert_int(i, ==, 1);
+    asdf_path_destroy(path);
+
+    path = asdf_path_compile("mapping/baz");
+    assert_not_null(path);
+    assert_null(asdf_get_value_path(file, path));
+    asdf_path_destroy(path);
+
+    // Replacing a value invalidates the cache
+    assert_int(asdf_set_string0(file, "mapping/foo", "qux"), ==, ASDF_VALUE_OK);
+    assert_int(asdf_node_map_size(&file->path_cache), ==, 0);
+    assert_int(asdf_get_string0(file, "mapping/foo", &s), ==, ASDF_VALUE_OK);
+    assert_string_equal(s, "qux");
+    asdf_close(file);
+    return MUNIT_OK;
+}
+
+
 MU_TEST(test_asdf_set_mapping) {
     // TODO: Change this test to use an in-memory file
     asdf_file_t *file = asdf_open(NULL);
@@ -373,6 +426,222 @@ MU_TEST(invalid_block_index) {
 }
 
 
+static void assert_multi_block_data(asdf_block_t *block, int idx) {
+    size_t size = 0;
+    const uint8_t *data = asdf_block_data(block, &size);
+    assert_not_null(data);
+    assert_int(size, ==, 128);
+    for (int jdx = 0; jdx < 128; jdx++) {
+        assert_int(data[jdx], ==, jdx / idx);
+    }
+}
+
+
+/**
+ * Test that blocks can be opened through the block index without parsing the whole file,
+ * and that a bad block index entry falls back to parsing the file sequentially
+ */
+MU_TEST(lazy_block_open) {
+    const char *filename = get_fixture_file_path("multi-block.asdf");
+    asdf_file_t *file = asdf_open_file(filename, "r");
+    assert_not_null(file);
+
+    // Open the blocks out of order, including ones whose headers are not read when
+    // validating the block index
+    int order[] = {2, 1, 4, 3};
+    for (size_t idx = 0; idx < sizeof(order) / sizeof(order[0]); idx++) {
+        asdf_block_t *block = asdf_block_open(file, order[idx] - 1);
+        assert_not_null(block);
+        assert_multi_block_data(block, order[idx]);
+        asdf_block_close(block);
+    }
+
+    assert_false(file->parser->done);
+    test_multi_block_asdf_content(file);
+    asdf_close(file);
+
+    // Point the second block index entry one byte past the actual block
+    size_t len = 0;
+    char *contents = read_file(filename, &len);
+    assert_int(len, ==, 1746);  // Known size of the file
+    char *entry = memmem(contents, len, "- 1137\n", 7);
+    assert_not_null(entry);
+    memcpy(entry, "- 1138\n", 7);
+
+    file = asdf_open_mem(contents, len);
+    assert_not_null(file);
+    asdf_block_t *block = asdf_block_open(file, 1);
+    assert_not_null(block);
+    assert_multi_block_data(block, 2);
+    asdf_block_close(block);
+    assert_true(file->parser->done);
+    test_multi_block_asdf_content(file);
+    asdf_close(file);
+    free(contents);
+    return MUNIT_OK;
+}
+
+
+/**
+ * Test that a block index spanning many pages is found by searching backwards from the end of
+ * the file
+ */
+MU_TEST(large_block_index) {
+    const char *filename = get_temp_file_path(fixture->tempfile_prefix, ".asdf");
+    asdf_file_t *file = asdf_open(NULL);
+    assert_not_null(file);
+
+    const size_t n_blocks = 5000;
+    for (size_t idx = 0; idx < n_blocks; idx++) {
+        uint8_t data = idx % (UINT8_MAX + 1);
+        assert_int(asdf_block_append(file, &data, 1), ==, (ssize_t)idx);
+    }
+
+    assert_int(asdf_write_to(file, filename), ==, 0);
+    asdf_close(file);
+
+    file = asdf_open_file(filename, "r");
+    assert_not_null(file);
+    asdf_block_t *block = asdf_block_open(file, n_blocks - 2);
+    assert_not_null(block);
+    size_t size = 0;
+    const uint8_t *data = asdf_block_data(block, &size);
+    assert_not_null(data);
+    assert_int(size, ==, 1);
+    assert_int(data[0], ==, (n_blocks - 2) % (UINT8_MAX + 1));
+    asdf_block_close(block);
+
+    assert_true(file->parser->block.has_index);
+    assert_int(file->parser->block.count, ==, n_blocks);
+    assert_false(file->parser->done);
+    asdf_close(file);
+    return MUNIT_OK;
+}
+
+
+/**
+ * Test that with ``io.background_blocks`` the blocks have all been found once the tree is read
+ */
+MU_TEST(background_blocks) {
+    const char *filename = get_fixture_file_path("multi-block.asdf");
+    asdf_config_t config = {.io = {.background_blocks = true}};
+    asdf_file_t *file = asdf_open_file_ex(filename, "r", &config);
+    assert_not_null(file);
+
+    assert_true(asdf_is_mapping(file, "/"));
+    assert_true(file->parser->done);
+    assert_int(asdf_block_info_vec_size(&file->blocks), ==, 4);
+    test_multi_block_asdf_content(file);
+    asdf_close(file);
+    return MUNIT_OK;
+}
+
+
+/**
+ * Test the block index cache with a copy of multi-block.asdf without its block index
+ *
+ * Once the cache has been written opening a block should no longer require parsing the whole
+ * file, until the file is modified.
+ */
+MU_TEST(index_cache) {
+    const char *fixture_filename = get_fixture_file_path("multi-block.asdf");
+    size_t len = 0;
+    char *contents = read_file(fixture_filename, &len);
+    const char *block_index_magic = "#ASDF BLOCK INDEX";
+    void *block_index_addr = memmem(contents, len, block_index_magic, strlen(block_index_magic));
+    assert_not_null(block_index_addr);
+    len = (uintptr_t)block_index_addr - (uintptr_t)contents;
+
+    char *filename = strdup(get_temp_file_path(fixture->tempfile_prefix, ".asdf"));
+    FILE *fp = fopen(filename, "w");
+    assert_not_null(fp);
+    assert_size(fwrite(contents, 1, len, fp), ==, len);
+    fclose(fp);
+    free(contents);
+
+    char *source = realpath(filename, NULL);
+    assert_not_null(source);
+    char *sidecar = NULL;
+    assert_int(asprintf(&sidecar, "%s.index", source), >, 0);
+    unlink(sidecar);
+
+    char *cache_dir = strdup(get_temp_file_path(fixture->tempfile_prefix, "-cache"));
+    unlink(cache_dir);
+
+    asdf_config_t configs[] = {
+        {.io = {.index_cache = ASDF_INDEX_CACHE_SIDECAR}},
+        {.io = {.index_cache = ASDF_INDEX_CACHE_USER, .index_cache_dir = cache_dir}},
+    };
+
+    for (size_t idx = 0; idx < sizeof(configs) / sizeof(configs[0]); idx++) {
+        // First open parses the whole file and writes the cache
+        asdf_file_t *file = asdf_open_ex(filename, "r", &configs[idx]);
+        assert_not_null(file);
+        asdf_block_t *block = asdf_block_open(file, 2);
+        assert_not_null(block);
+        assert_multi_block_data(block, 3);
+        asdf_block_close(block);
+        assert_true(file->parser->done);
+        asdf_close(file);
+
+        if (configs[idx].io.index_cache == ASDF_INDEX_CACHE_SIDECAR)
+            assert_int(access(sidecar, R_OK), ==, 0);
+
+        // Second open uses the cache
+        file = asdf_open_ex(filename, "r", &configs[idx]);
+        assert_not_null(file);
+        block = asdf_block_open(file, 2);
+        assert_not_null(block);
+        assert_multi_block_data(block, 3);
+        asdf_block_close(block);
+        assert_false(file->parser->done);
+        test_multi_block_asdf_content(file);
+        asdf_close(file);
+
+        // Modifying the file invalidates the cache
+        struct timespec times[2] = {{.tv_nsec = UTIME_OMIT}, {.tv_sec = 1}};
+        assert_int(utimensat(AT_FDCWD, filename, times, 0), ==, 0);
+        file = asdf_open_ex(filename, "r", &configs[idx]);
+        assert_not_null(file);
+        block = asdf_block_open(file, 2);
+        assert_not_null(block);
+        assert_multi_block_data(block, 3);
+        asdf_block_close(block);
+        assert_true(file->parser->done);
+        asdf_close(file);
+    }
+
+    free(cache_dir);
+    free(sidecar);
+    free(source);
+    free(filename);
+    return MUNIT_OK;
+}
+
+
+/**
+ * Test that reading the same file gives the same results with buffered reads, mmap, and
+ * windowed mmap (with the smallest possible window)
+ */
+MU_TEST(file_io_modes) {
+    const char *filename = get_fixture_file_path("multi-block.asdf");
+    asdf_config_t configs[] = {
+        {.io = {.mode = ASDF_FILE_IO_MODE_BUFFERED}},
+        {.io = {.mode = ASDF_FILE_IO_MODE_MMAP}},
+        {.io = {.mode = ASDF_FILE_IO_MODE_MMAP, .mmap_window_size = 1}},
+    };
+
+    for (size_t idx = 0; idx < sizeof(configs) / sizeof(configs[0]); idx++) {
+        asdf_file_t *file = asdf_open_ex(filename, "r", &configs[idx]);
+        assert_not_null(file);
+        test_multi_block_asdf_content(file);
+        asdf_close(file);
+    }
+
+    return MUNIT_OK;
+}
+
+
 MU_TEST(test_asdf_block_checksum) {
     assert_null(asdf_block_checksum(NULL));
     const char *filename = get_fixture_file_path("255-invalid-checksum.asdf");
@@ -817,11 +1086,17 @@ MU_TEST_SUITE(
     MU_RUN_TEST(scalar_getters),
     MU_RUN_TEST(test_asdf_get_mapping),
     MU_RUN_TEST(test_asdf_get_sequence),
+    MU_RUN_TEST(path_cache),
     MU_RUN_TEST(test_asdf_set_mapping),
     MU_RUN_TEST(test_asdf_set_sequence),
     MU_RUN_TEST(test_asdf_block_count),
     MU_RUN_TEST(missing_block_index),
     MU_RUN_TEST(invalid_block_index),
+    MU_RUN_TEST(lazy_block_open),
+    MU_RUN_TEST(large_block_index),
+    MU_RUN_TEST(background_blocks),
+    MU_RUN_TEST(index_cache),
+    MU_RUN_TEST(file_io_modes),
     MU_RUN_TEST(test_asdf_block_checksum),
     MU_RUN_TEST(test_asdf_block_checksum_verify),
     MU_RUN_TEST(test_asdf_block_append),
@@ -0,0 +1,135 @@
+#include <float.h>
+#include <math.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "munit.h"
+#include "util.h"
+
+#include "format.h"
+
+
+#define FORMAT(fn, buf, val) \
+    do { \
+        size_t _len = fn((buf), (val)); \
+        assert_size(_len, <, ASDF_FORMAT_NUMBER_MAX); \
+        (buf)[_len] = '\0'; \
+    } while (0)
+
+
+MU_TEST(test_asdf_format_int) {
+    char buf[ASDF_FORMAT_NUMBER_MAX];
+    char expected[ASDF_FORMAT_NUMBER_MAX];
+    const int64_t ints[] = {0, 1, -1, 9, 10, 99, 100, -128, 65535, INT64_MIN, INT64_MAX};
+
+    for (size_t idx = 0; idx < sizeof(ints) / sizeof(ints[0]); idx++) {
+        FORMAT(asdf_format_int64, buf, ints[idx]);
+        snprintf(expected, sizeof(expected), "%lld", (long long)ints[idx]);
+        assert_string_equal(buf, expected);
+    }
+
+    FORMAT(asdf_format_uint64, buf, UINT64_MAX);
+    assert_string_equal(buf, "18446744073709551615");
+    return MUNIT_OK;
+}
+
+
+MU_TEST(test_asdf_format_double) {
+    char buf[ASDF_FORMAT_NUMBER_MAX];
+
+    // Shortest representations
+    FORMAT(asdf_format_double, buf, 0.0);
+    assert_string_equal(buf, "0");
+    FORMAT(asdf_format_double, buf, -0.0);
+    assert_string_equal(buf, "-0");
+    FORMAT(asdf_format_double, buf, 0.1);
+    assert_string_equal(buf, "0.1");
+    FORMAT(asdf_format_double, buf, -1.5);
+    assert_string_equal(buf, "-1.5");
+    FORMAT(asdf_format_double, buf, 100.0);
+    assert_string_equal(buf, "100");
+    FORMAT(asdf_format_double, buf, 0.0001);
+    assert_string_equal(buf, "0.0001");
+    FORMAT(asdf_format_double, buf, 1e-5);
+    assert_string_equal(buf, "1e-05");
+    FORMAT(asdf_format_double, buf, 1e17);
+    assert_string_equal(buf, "1e+17");
+    FORMAT(asdf_format_double, buf, DBL_MAX);
+    assert_string_equal(buf, "1.7976931348623157e+308");
+    FORMAT(asdf_format_double, buf, 5e-324);
+    assert_string_equal(buf, "5e-324");
+
+    // YAML special values
+    FORMAT(asdf_format_double, buf, NAN);
+    assert_string_equal(buf, ".nan");
+    FORMAT(asdf_format_double, buf, INFINITY);
+    assert_string_equal(buf, ".inf");
+    FORMAT(asdf_format_double, buf, -INFINITY);
+    assert_string_equal(buf, "-.inf");
+
+    // Random bit patterns must all read back as the same value
+    uint64_t state = 0x9e3779b97f4a7c15;
+
+    for (int idx = 0; idx < 100000; idx++) {
+        state ^= state << 13;
+        state ^= state >> 7;
+        state ^= state << 17;
+        double val = 0.0;
+        memcpy(&val, &state, sizeof(val));
+
+        if (!isfinite(val))
+            continue;
+
+        FORMAT(asdf_format_double, buf, val);
+        double read = strtod(buf, NULL);
+        assert_memory_equal(sizeof(val), &read, &val);
+    }
+
+    return MUNIT_OK;
+}
+
+
+MU_TEST(test_asdf_format_float) {
+    char buf[ASDF_FORMAT_NUMBER_MAX];
+
+    FORMAT(asdf_format_float, buf, 0.1f);
+    assert_string_equal(buf, "0.1");
+    FORMAT(asdf_format_float, buf, 3.14159f);
+    assert_string_equal(buf, "3.14159");
+    FORMAT(asdf_format_float, buf, FLT_MAX);
+    assert_string_equal(buf, "3.4028235e+38");
+    FORMAT(asdf_format_float, buf, -INFINITY);
+    assert_string_equal(buf, "-.inf");
+
+    uint32_t state = 0x9e3779b9;
+
+    for (int idx = 0; idx < 100000; idx++) {
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        float val = 0.0f;
+        memcpy(&val, &state, sizeof(val));
+
+        if (!isfinite(val))
+            continue;
+
+        FORMAT(asdf_format_float, buf, val);
+        float read = strtof(buf, NULL);
+        assert_memory_equal(sizeof(val), &read, &val);
+    }
+
+    return MUNIT_OK;
+}
+
+
+MU_TEST_SUITE(
+    format,
+    MU_RUN_TEST(test_asdf_format_int),
+    MU_RUN_TEST(test_asdf_format_double),
+    MU_RUN_TEST(test_asdf_format_float)
+);
+
+
+MU_RUN_SUITE(format);
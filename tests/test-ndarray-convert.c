@@ -0,0 +1,519 @@
+#include "munit.h"
+#include "util.h"
+
+#include <float.h>
+#include <math.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "core/ndarray_convert.h"
+
+
+static const asdf_ndarray_convert_kernel_t convert_kernels[] = {
+    ASDF_NDARRAY_CONVERT_KERNEL_AUTO,
+    ASDF_NDARRAY_CONVERT_KERNEL_SSE41,
+    ASDF_NDARRAY_CONVERT_KERNEL_AVX2,
+    ASDF_NDARRAY_CONVERT_KERNEL_AVX512,
+};
+
+
+static const char *convert_kernel_names[] = {"auto", "sse4.1", "avx2", "avx512"};
+
+
+#define N_CONVERT_KERNELS (sizeof(convert_kernels) / sizeof(convert_kernels[0]))
+
+
+typedef struct {
+    asdf_scalar_datatype_t src_t;
+    asdf_scalar_datatype_t dst_t;
+    size_t src_size;
+    size_t dst_size;
+} convert_pair_t;
+
+
+/** The conversions that have vectorized kernels */
+static const convert_pair_t convert_pairs[] = {
+    {ASDF_DATATYPE_INT16, ASDF_DATATYPE_INT16, 2, 2},
+    {ASDF_DATATYPE_UINT16, ASDF_DATATYPE_UINT16, 2, 2},
+    {ASDF_DATATYPE_INT32, ASDF_DATATYPE_INT32, 4, 4},
+    {ASDF_DATATYPE_UINT32, ASDF_DATATYPE_UINT32, 4, 4},
+    {ASDF_DATATYPE_INT64, ASDF_DATATYPE_INT64, 8, 8},
+    {ASDF_DATATYPE_UINT64, ASDF_DATATYPE_UINT64, 8, 8},
+    {ASDF_DATATYPE_FLOAT32, ASDF_DATATYPE_FLOAT32, 4, 4},
+    {ASDF_DATATYPE_FLOAT64, ASDF_DATATYPE_FLOAT64, 8, 8},
+    {ASDF_DATATYPE_INT16, ASDF_DATATYPE_FLOAT32, 2, 4},
+    {ASDF_DATATYPE_UINT16, ASDF_DATATYPE_FLOAT32, 2, 4},
+    {ASDF_DATATYPE_FLOAT64, ASDF_DATATYPE_FLOAT32, 8, 4},
+    {ASDF_DATATYPE_INT32, ASDF_DATATYPE_INT16, 4, 2},
+    {ASDF_DATATYPE_INT32, ASDF_DATATYPE_UINT16, 4, 2},
+    {ASDF_DATATYPE_INT16, ASDF_DATATYPE_INT8, 2, 1},
+    {ASDF_DATATYPE_INT16, ASDF_DATATYPE_UINT8, 2, 1},
+    {ASDF_DATATYPE_FLOAT16, ASDF_DATATYPE_FLOAT16, 2, 2},
+    {ASDF_DATATYPE_COMPLEX64, ASDF_DATATYPE_COMPLEX64, 8, 8},
+    {ASDF_DATATYPE_COMPLEX128, ASDF_DATATYPE_COMPLEX128, 16, 16},
+    {ASDF_DATATYPE_FLOAT16, ASDF_DATATYPE_FLOAT32, 2, 4},
+    {ASDF_DATATYPE_FLOAT32, ASDF_DATATYPE_FLOAT16, 4, 2},
+};
+
+
+#define N_CONVERT_PAIRS (sizeof(convert_pairs) / sizeof(convert_pairs[0]))
+
+
+/** Values that exercise the clamping of float64 to float32 (and float32 to float16) */
+static const double float64_edge_values[] = {
+    0.0,
+    -0.0,
+    1.5,
+    -1.5,
+    1e-300,
+    FLT_MAX,
+    -FLT_MAX,
+    (double)FLT_MAX * 2.0,
+    -(double)FLT_MAX * 2.0,
+    DBL_MAX,
+    -DBL_MAX,
+    65504.0,
+    65519.0,
+    -65520.0,
+    1e-7,
+    INFINITY,
+    -INFINITY,
+    NAN,
+};
+
+
+#define N_FLOAT64_EDGE_VALUES (sizeof(float64_edge_values) / sizeof(float64_edge_values[0]))
+
+
+static void reverse_bytes(uint8_t *buf, size_t count, size_t elsize) {
+    for (size_t idx = 0; idx < count; idx++) {
+        uint8_t *elem = buf + idx * elsize;
+        for (size_t jdx = 0; jdx < elsize / 2; jdx++) {
+            uint8_t tmp = elem[jdx];
+            elem[jdx] = elem[elsize - 1 - jdx];
+            elem[elsize - 1 - jdx] = tmp;
+        }
+    }
+}
+
+
+/**
+ * Fill ``src`` with ``count`` values of the pair's source type, in the source byte order
+ *
+ * ``in_range`` chooses small values that convert without overflow; otherwise the values are
+ * random bytes, mixed with the float64 edge values for float64 sources.
+ */
+static void fill_source(
+    uint8_t *src, size_t count, const convert_pair_t *pair, bool in_range, bool bswap) {
+    munit_rand_memory(count * pair->src_size, src);
+
+    for (size_t idx = 0; idx < count; idx++) {
+        uint8_t *elem = src + idx * pair->src_size;
+        int small = munit_rand_int_range(-100, 100);
+
+        if (pair->src_t == ASDF_DATATYPE_FLOAT64) {
+            double val = in_range ? small / 3.0
+                                  : float64_edge_values[munit_rand_int_range(
+                                        0, N_FLOAT64_EDGE_VALUES - 1)];
+            if (in_range || munit_rand_int_range(0, 1))
+                memcpy(elem, &val, sizeof(val));
+        } else if (pair->src_t == ASDF_DATATYPE_FLOAT32) {
+            float val = in_range ? (float)small / 3.0F
+                                 : (float)float64_edge_values[munit_rand_int_range(
+                                       0, N_FLOAT64_EDGE_VALUES - 1)];
+            if (in_range || munit_rand_int_range(0, 1))
+                memcpy(elem, &val, sizeof(val));
+        } else if (in_range && pair->src_size != pair->dst_size) {
+            int32_t val32 = small < 0 && pair->dst_t != ASDF_DATATYPE_INT8 &&
+                                    pair->dst_t != ASDF_DATATYPE_INT16
+                                ? -small
+                                : small;
+            int16_t val16 = (int16_t)val32;
+            if (pair->src_size == 2)
+                memcpy(elem, &val16, sizeof(val16));
+            else
+                memcpy(elem, &val32, sizeof(val32));
+        }
+    }
+
+    if (bswap)
+        reverse_bytes(src, count, pair->src_size);
+}
+
+
+/** Check every available kernel against the generic conversion on the same source */
+static void assert_kernels_match_generic(
+    const convert_pair_t *pair, const uint8_t *src, size_t count, bool bswap) {
+    size_t nbytes = count * pair->dst_size;
+    // Allocate at least one byte so empty conversions still get distinct buffers
+    uint8_t *expected = malloc(nbytes + 1);
+    uint8_t *actual = malloc(nbytes + 1);
+    assert_not_null(expected);
+    assert_not_null(actual);
+
+    asdf_ndarray_convert_fn_t generic = asdf_ndarray_get_convert_fn_kernel(
+        pair->src_t, pair->dst_t, bswap, ASDF_NDARRAY_CONVERT_KERNEL_GENERIC);
+    assert_not_null(generic);
+    int expected_ret = generic(expected, src, count, pair->dst_size);
+
+    for (size_t kdx = 0; kdx < N_CONVERT_KERNELS; kdx++) {
+        asdf_ndarray_convert_fn_t convert = asdf_ndarray_get_convert_fn_kernel(
+            pair->src_t, pair->dst_t, bswap, convert_kernels[kdx]);
+
+        if (!convert)
+            continue;
+
+        memset(actual, 0xa5, nbytes + 1);
+        int ret = convert(actual, src, count, pair->dst_size);
+
+        if (ret != expected_ret || memcmp(actual, expected, nbytes) != 0)
+            munit_errorf(
+                "%s kernel mismatch converting %zu items of datatype %d to %d (bswap: %d)",
+                convert_kernel_names[kdx],
+                count,
+                pair->src_t,
+                pair->dst_t,
+                bswap);
+
+        // Nothing written past the end
+        assert_uint8(actual[nbytes], ==, 0xa5);
+    }
+
+    free(expected);
+    free(actual);
+}
+
+
+MU_TEST(convert_kernels_available) {
+    for (size_t idx = 0; idx < N_CONVERT_PAIRS; idx++) {
+        const convert_pair_t *pair = &convert_pairs[idx];
+        assert_not_null(asdf_ndarray_get_convert_fn_kernel(
+            pair->src_t, pair->dst_t, true, ASDF_NDARRAY_CONVERT_KERNEL_AUTO));
+        assert_not_null(asdf_ndarray_get_convert_fn_kernel(
+            pair->src_t, pair->dst_t, true, ASDF_NDARRAY_CONVERT_KERNEL_GENERIC));
+        assert_ptr_equal(
+            asdf_ndarray_get_convert_fn_kernel(
+                pair->src_t, pair->dst_t, false, ASDF_NDARRAY_CONVERT_KERNEL_AUTO),
+            asdf_ndarray_get_convert_fn(pair->src_t, pair->dst_t, false));
+    }
+
+    // No vector kernel for this one
+    assert_null(asdf_ndarray_get_convert_fn_kernel(
+        ASDF_DATATYPE_INT8, ASDF_DATATYPE_INT64, false, ASDF_NDARRAY_CONVERT_KERNEL_AVX2));
+    assert_null(asdf_ndarray_get_convert_fn_kernel(
+        ASDF_DATATYPE_STRUCTURED, ASDF_DATATYPE_INT8, false, ASDF_NDARRAY_CONVERT_KERNEL_AUTO));
+    return MUNIT_OK;
+}
+
+
+MU_TEST(convert_float64_to_float32_clamp) {
+    const double src[] = {1.0, 1e39, -1e39, INFINITY, -INFINITY, NAN, 0.5, 2.0};
+    float dst[sizeof(src) / sizeof(src[0])];
+    asdf_ndarray_convert_fn_t convert = asdf_ndarray_get_convert_fn(
+        ASDF_DATATYPE_FLOAT64, ASDF_DATATYPE_FLOAT32, false);
+    assert_not_null(convert);
+    assert_int(convert(dst, src, 8, sizeof(float)), ==, 1);
+    assert_float(dst[0], ==, 1.0f);
+    assert_float(dst[1], ==, FLT_MAX);
+    assert_float(dst[2], ==, -FLT_MAX);
+    assert_true(isinf(dst[3]) && dst[3] > 0);
+    assert_true(isinf(dst[4]) && dst[4] < 0);
+    assert_true(isnan(dst[5]));
+    assert_float(dst[6], ==, 0.5f);
+    assert_float(dst[7], ==, 2.0f);
+
+    // Infinities alone do not overflow
+    assert_int(convert(dst + 3, src + 3, 3, sizeof(float)), ==, 0);
+    return MUNIT_OK;
+}
+
+
+/** Decode a float16 with the generic kernel; ``assert_kernels_match_generic`` covers the others */
+static float float16_decode(uint16_t half) {
+    float expected = 0;
+    asdf_ndarray_convert_fn_t generic = asdf_ndarray_get_convert_fn_kernel(
+        ASDF_DATATYPE_FLOAT16, ASDF_DATATYPE_FLOAT32, false, ASDF_NDARRAY_CONVERT_KERNEL_GENERIC);
+    assert_int(generic(&expected, &half, 1, sizeof(float)), ==, 0);
+    return expected;
+}
+
+
+MU_TEST(convert_float16) {
+    assert_float(float16_decode(0x3c00), ==, 1.0F);
+    assert_float(float16_decode(0xc000), ==, -2.0F);
+    assert_float(float16_decode(0x7bff), ==, 65504.0F);
+    assert_float(float16_decode(0x0001), ==, ldexpf(1.0F, -24));
+    assert_float(float16_decode(0x0400), ==, ldexpf(1.0F, -14));
+    assert_true(isinf(float16_decode(0xfc00)) && float16_decode(0xfc00) < 0);
+    assert_true(isnan(float16_decode(0x7e00)));
+
+    // Every float16 decodes identically with every kernel, in both byte orders
+    uint16_t *halves = malloc(65536 * sizeof(uint16_t));
+    assert_not_null(halves);
+
+    for (uint32_t idx = 0; idx < 65536; idx++)
+        halves[idx] = (uint16_t)idx;
+
+    assert_kernels_match_generic(&convert_pairs[18], (const uint8_t *)halves, 65536, false);
+    assert_kernels_match_generic(&convert_pairs[18], (const uint8_t *)halves, 65536, true);
+    free(halves);
+
+    const float src[] = {1.0F, -2.5F, 65504.0F, 1e6F, -1e6F, 0.1F, ldexpf(1.0F, -25), INFINITY};
+    uint16_t dst[8];
+    asdf_ndarray_convert_fn_t convert = asdf_ndarray_get_convert_fn(
+        ASDF_DATATYPE_FLOAT32, ASDF_DATATYPE_FLOAT16, false);
+    assert_int(convert(dst, src, 8, sizeof(uint16_t)), ==, 1);
+    assert_uint16(dst[0], ==, 0x3c00);
+    assert_uint16(dst[1], ==, 0xc100);
+    assert_uint16(dst[2], ==, 0x7bff);
+    assert_uint16(dst[3], ==, 0x7bff);
+    assert_uint16(dst[4], ==, 0xfbff);
+    assert_uint16(dst[5], ==, 0x2e66);
+    // Halfway to the smallest subnormal rounds to even (zero)
+    assert_uint16(dst[6], ==, 0x0000);
+    assert_uint16(dst[7], ==, 0x7c00);
+
+    // float64 rounds correctly, without first rounding to float32
+    const double dsrc[] = {1.0 + 0x1p-11 + 0x1p-40, 1.0 + 0x1p-11};
+    convert = asdf_ndarray_get_convert_fn(ASDF_DATATYPE_FLOAT64, ASDF_DATATYPE_FLOAT16, false);
+    assert_int(convert(dst, dsrc, 2, sizeof(uint16_t)), ==, 0);
+    assert_uint16(dst[0], ==, 0x3c01);
+    assert_uint16(dst[1], ==, 0x3c00);
+    return MUNIT_OK;
+}
+
+
+MU_TEST(convert_complex_bool) {
+    const float c64[] = {1.5F, -2.0F, 0.0F, 0.0F, 1e30F, 0.0F};
+    double f64[3];
+    asdf_ndarray_convert_fn_t convert = asdf_ndarray_get_convert_fn(
+        ASDF_DATATYPE_COMPLEX64, ASDF_DATATYPE_FLOAT64, false);
+    assert_not_null(convert);
+    assert_int(convert(f64, c64, 3, sizeof(double)), ==, 0);
+    assert_double(f64[0], ==, 1.5);
+    assert_double(f64[1], ==, 0.0);
+    assert_double(f64[2], ==, (double)1e30F);
+
+    // The imaginary part counts for bool8
+    uint8_t b8[3];
+    convert = asdf_ndarray_get_convert_fn(ASDF_DATATYPE_COMPLEX64, ASDF_DATATYPE_BOOL8, false);
+    assert_int(convert(b8, c64, 3, 1), ==, 0);
+    assert_uint8(b8[0], ==, 1);
+    assert_uint8(b8[1], ==, 0);
+    assert_uint8(b8[2], ==, 1);
+
+    int16_t i16[3];
+    convert = asdf_ndarray_get_convert_fn(ASDF_DATATYPE_COMPLEX64, ASDF_DATATYPE_INT16, false);
+    assert_int(convert(i16, c64, 3, sizeof(int16_t)), ==, 1);
+    assert_int16(i16[0], ==, 1);
+    assert_int16(i16[2], ==, INT16_MAX);
+
+    const double c128[] = {1e300, -1e300, 3.0, 4.0};
+    float c64_out[4];
+    convert = asdf_ndarray_get_convert_fn(ASDF_DATATYPE_COMPLEX128, ASDF_DATATYPE_COMPLEX64, true);
+    assert_not_null(convert);
+    convert = asdf_ndarray_get_convert_fn(ASDF_DATATYPE_COMPLEX128, ASDF_DATATYPE_COMPLEX64, false);
+    assert_int(convert(c64_out, c128, 2, 2 * sizeof(float)), ==, 1);
+    assert_float(c64_out[0], ==, FLT_MAX);
+    assert_float(c64_out[1], ==, -FLT_MAX);
+    assert_float(c64_out[2], ==, 3.0F);
+    assert_float(c64_out[3], ==, 4.0F);
+
+    const uint8_t bools[] = {0, 1, 2};
+    float f32[3];
+    convert = asdf_ndarray_get_convert_fn(ASDF_DATATYPE_BOOL8, ASDF_DATATYPE_FLOAT32, false);
+    assert_int(convert(f32, bools, 3, sizeof(float)), ==, 0);
+    assert_float(f32[0], ==, 0.0F);
+    assert_float(f32[1], ==, 1.0F);
+    assert_float(f32[2], ==, 1.0F);
+
+    const int32_t ints[] = {-7, 0};
+    double c128_out[4];
+    convert = asdf_ndarray_get_convert_fn(ASDF_DATATYPE_INT32, ASDF_DATATYPE_COMPLEX128, false);
+    assert_int(convert(c128_out, ints, 2, 2 * sizeof(double)), ==, 0);
+    assert_double(c128_out[0], ==, -7.0);
+    assert_double(c128_out[1], ==, 0.0);
+    assert_double(c128_out[2], ==, 0.0);
+    assert_double(c128_out[3], ==, 0.0);
+    return MUNIT_OK;
+}
+
+
+MU_TEST(convert_all_types_registered) {
+    static const asdf_scalar_datatype_t types[] = {
+        ASDF_DATATYPE_INT8,
+        ASDF_DATATYPE_UINT8,
+        ASDF_DATATYPE_INT16,
+        ASDF_DATATYPE_UINT16,
+        ASDF_DATATYPE_INT32,
+        ASDF_DATATYPE_UINT32,
+        ASDF_DATATYPE_INT64,
+        ASDF_DATATYPE_UINT64,
+        ASDF_DATATYPE_FLOAT16,
+        ASDF_DATATYPE_FLOAT32,
+        ASDF_DATATYPE_FLOAT64,
+        ASDF_DATATYPE_COMPLEX64,
+        ASDF_DATATYPE_COMPLEX128,
+        ASDF_DATATYPE_BOOL8,
+    };
+    size_t n_types = sizeof(types) / sizeof(types[0]);
+
+    for (size_t src = 0; src < n_types; src++) {
+        for (size_t dst = 0; dst < n_types; dst++) {
+            assert_not_null(asdf_ndarray_get_convert_fn(types[src], types[dst], false));
+            assert_not_null(asdf_ndarray_get_convert_fn(types[src], types[dst], true));
+        }
+    }
+
+    return MUNIT_OK;
+}
+
+
+MU_TEST(convert_kernels_match_generic) {
+    // All lengths up to a few AVX-512 vectors, to cover every tail length, then some longer
+    // random ones
+    uint8_t *src = malloc(4096 * 2 * sizeof(double));
+    assert_not_null(src);
+
+    for (size_t idx = 0; idx < N_CONVERT_PAIRS; idx++) {
+        const convert_pair_t *pair = &convert_pairs[idx];
+
+        for (int bswap = 0; bswap <= 1; bswap++) {
+            for (int in_range = 0; in_range <= 1; in_range++) {
+                for (size_t count = 0; count <= 160; count++) {
+                    fill_source(src, count, pair, in_range, bswap);
+                    assert_kernels_match_generic(pair, src, count, bswap);
+                }
+
+                for (int iter = 0; iter < 20; iter++) {
+                    size_t count = munit_rand_int_range(161, 4096);
+                    fill_source(src, count, pair, in_range, bswap);
+                    assert_kernels_match_generic(pair, src, count, bswap);
+                }
+            }
+        }
+    }
+
+    free(src);
+    return MUNIT_OK;
+}
+
+
+MU_TEST(convert_kernels_unaligned) {
+    // The kernels must not assume any alignment of the source or destination
+    const convert_pair_t *pair = &convert_pairs[10]; // float64 -> float32
+    uint8_t *src = malloc(1024 * sizeof(double) + 8);
+    uint8_t *dst = malloc(1024 * sizeof(float) + 8);
+    uint8_t *expected = malloc(1024 * sizeof(float));
+    assert_not_null(src);
+    assert_not_null(dst);
+    assert_not_null(expected);
+
+    asdf_ndarray_convert_fn_t generic = asdf_ndarray_get_convert_fn_kernel(
+        pair->src_t, pair->dst_t, true, ASDF_NDARRAY_CONVERT_KERNEL_GENERIC);
+
+    for (size_t offset = 0; offset < 8; offset++) {
+        fill_source(src + offset, 1024, pair, false, true);
+        int expected_ret = generic(expected, src + offset, 1024, sizeof(float));
+
+        for (size_t kdx = 0; kdx < N_CONVERT_KERNELS; kdx++) {
+            asdf_ndarray_convert_fn_t convert = asdf_ndarray_get_convert_fn_kernel(
+                pair->src_t, pair->dst_t, true, convert_kernels[kdx]);
+
+            if (!convert)
+                continue;
+
+            int ret = convert(dst + 7 - offset, src + offset, 1024, sizeof(float));
+            assert_int(ret, ==, expected_ret);
+            assert_memory_equal(1024 * sizeof(float), dst + 7 - offset, expected);
+        }
+    }
+
+    free(src);
+    free(dst);
+    free(expected);
+    return MUNIT_OK;
+}
+
+
+static double elapsed_sec(const struct timespec *start, const struct timespec *end) {
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+
+static void benchmark_pair(const convert_pair_t *pair, bool bswap, const char *desc) {
+    size_t count = 8 * 1024 * 1024;
+    uint8_t *src = malloc(count * pair->src_size);
+    uint8_t *dst = malloc(count * pair->dst_size);
+    assert_not_null(src);
+    assert_not_null(dst);
+    fill_source(src, count, pair, true, bswap);
+
+    struct timespec start;
+    struct timespec end;
+    asdf_ndarray_convert_fn_t generic = asdf_ndarray_get_convert_fn_kernel(
+        pair->src_t, pair->dst_t, bswap, ASDF_NDARRAY_CONVERT_KERNEL_GENERIC);
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    generic(dst, src, count, pair->dst_size);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    double generic_sec = elapsed_sec(&start, &end);
+    munit_logf(MUNIT_LOG_INFO, "%s generic: %.3f ms", desc, generic_sec * 1e3);
+
+    for (size_t kdx = 0; kdx < N_CONVERT_KERNELS; kdx++) {
+        asdf_ndarray_convert_fn_t convert = asdf_ndarray_get_convert_fn_kernel(
+            pair->src_t, pair->dst_t, bswap, convert_kernels[kdx]);
+
+        if (!convert)
+            continue;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        convert(dst, src, count, pair->dst_size);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        double sec = elapsed_sec(&start, &end);
+        munit_logf(
+            MUNIT_LOG_INFO,
+            "%s %s: %.3f ms (%.1fx)",
+            desc,
+            convert_kernel_names[kdx],
+            sec * 1e3,
+            sec > 0 ? generic_sec / sec : 0.0);
+    }
+
+    free(src);
+    free(dst);
+}
+
+
+/**
+ * Microbenchmark comparing the generic conversions to each available kernel
+ *
+ * Only logs the timings, as asserting on them would be flaky.
+ */
+MU_TEST(convert_benchmark) {
+    benchmark_pair(&convert_pairs[6], true, "big-endian float32");
+    benchmark_pair(&convert_pairs[8], true, "big-endian int16 -> float32");
+    benchmark_pair(&convert_pairs[10], false, "float64 -> float32");
+    benchmark_pair(&convert_pairs[11], false, "int32 -> int16");
+    benchmark_pair(&convert_pairs[18], false, "float16 -> float32");
+    benchmark_pair(&convert_pairs[19], false, "float32 -> float16");
+    return MUNIT_OK;
+}
+
+
+MU_TEST_SUITE(
+    ndarray_convert,
+    MU_RUN_TEST(convert_kernels_available),
+    MU_RUN_TEST(convert_float64_to_float32_clamp),
+    MU_RUN_TEST(convert_float16),
+    MU_RUN_TEST(convert_complex_bool),
+    MU_RUN_TEST(convert_all_types_registered),
+    MU_RUN_TEST(convert_kernels_match_generic),
+    MU_RUN_TEST(convert_kernels_unaligned),
+    MU_RUN_TEST(convert_benchmark)
+);
+
+
+MU_RUN_SUITE(ndarray_convert);
@@ -134,6 +134,79 @@ MU_TEST(ndarray_read_3d_tile) {
 }
 
 
+/*
+ * Access hints are advisory so they should never change the data read, whether set per
+ * file, per ndarray, or left to the defaults, and whichever stream backend is used
+ */
+MU_TEST(ndarray_access_hints) {
+    const char *path = get_fixture_file_path("tiles.asdf");
+    asdf_file_io_mode_t io_modes[] = {ASDF_FILE_IO_MODE_BUFFERED, ASDF_FILE_IO_MODE_MMAP};
+    uint64_t origin3[] = {1, 1, 1};
+    uint64_t shape3[] = {2, 2, 2};
+    int32_t expected3[2][2][2] = {{{222, 223}, {232, 233}}, {{322, 323}, {332, 333}}};
+
+    for (size_t idx = 0; idx < sizeof(io_modes) / sizeof(io_modes[0]); idx++) {
+        asdf_config_t config = {
+            .io = {
+                .mode = io_modes[idx],
+                .access_hint = ASDF_ACCESS_HINT_RANDOM | ASDF_ACCESS_HINT_DONTNEED}};
+        asdf_file_t *file = asdf_open_ex(path, "r", &config);
+        assert_not_null(file);
+
+        /* File-level hint */
+        asdf_ndarray_t *ndarray = NULL;
+        assert_int(asdf_get_ndarray(file, "3d", &ndarray), ==, ASDF_VALUE_OK);
+        void *tile = NULL;
+        asdf_ndarray_err_t err = asdf_ndarray_read_tile_ndim(
+            ndarray, origin3, shape3, ASDF_DATATYPE_SOURCE, &tile);
+        assert_int(err, ==, ASDF_NDARRAY_OK);
+        assert_memory_equal(sizeof(expected3), tile, expected3);
+        free(tile);
+
+        /* Per-ndarray hint applied to the already-mapped block */
+        assert_int(asdf_ndarray_access_hint(ndarray, ASDF_ACCESS_HINT_SEQUENTIAL), ==, 0);
+        tile = NULL;
+        err = asdf_ndarray_read_tile_ndim(ndarray, origin3, shape3, ASDF_DATATYPE_SOURCE, &tile);
+        assert_int(err, ==, ASDF_NDARRAY_OK);
+        assert_memory_equal(sizeof(expected3), tile, expected3);
+        free(tile);
+        asdf_ndarray_destroy(ndarray);
+
+        /* Per-ndarray hint set before the block is opened */
+        assert_int(asdf_get_ndarray(file, "3d", &ndarray), ==, ASDF_VALUE_OK);
+        assert_int(
+            asdf_ndarray_access_hint(
+                ndarray, ASDF_ACCESS_HINT_WILLNEED | ASDF_ACCESS_HINT_HUGEPAGE),
+            ==,
+            0);
+        tile = NULL;
+        err = asdf_ndarray_read_all(ndarray, ASDF_DATATYPE_SOURCE, &tile);
+        assert_int(err, ==, ASDF_NDARRAY_OK);
+        assert_int(((int32_t *)tile)[0], ==, 111);
+        assert_int(((int32_t *)tile)[(1 * 16) + (2 * 4) + 2], ==, 233);
+        free(tile);
+        asdf_ndarray_destroy(ndarray);
+
+        /* Per-block hint */
+        asdf_block_t *block = asdf_block_open(file, 3);
+        assert_not_null(block);
+        assert_int(asdf_block_access_hint(block, ASDF_ACCESS_HINT_NORMAL), ==, 0);
+        size_t size = 0;
+        assert_not_null(asdf_block_data(block, &size));
+        assert_size(size, ==, 64 * sizeof(int32_t));
+        assert_int(asdf_block_access_hint(block, ASDF_ACCESS_HINT_DONTNEED), ==, 0);
+        assert_not_null(asdf_block_data(block, &size));
+        asdf_block_close(block);
+
+        asdf_close(file);
+    }
+
+    assert_int(asdf_block_access_hint(NULL, ASDF_ACCESS_HINT_RANDOM), !=, 0);
+    assert_int(asdf_ndarray_access_hint(NULL, ASDF_ACCESS_HINT_RANDOM), !=, 0);
+    return MUNIT_OK;
+}
+
+
 /* Helper for ndarray_read_tile_byteswap
  *
  * Each array in byteorder.asdf just contains 0...7 in different int types, different
@@ -177,6 +250,271 @@ MU_TEST(ndarray_read_tile_byteswap) {
 }
 
 
+/* View tiles of arrays in place, without copying */
+MU_TEST(ndarray_view) {
+    const char *path = get_fixture_file_path("tiles.asdf");
+    asdf_file_t *file = asdf_open(path, "r");
+    assert_not_null(file);
+
+    asdf_ndarray_t *ndarray = NULL;
+    assert_int(asdf_get_ndarray(file, "3d", &ndarray), ==, ASDF_VALUE_OK);
+    const void *data = NULL;
+    int64_t strides[3] = {0};
+    uint64_t origin[] = {1, 1, 1};
+    uint64_t shape[] = {2, 2, 2};
+    asdf_ndarray_err_t err = asdf_ndarray_view(ndarray, origin, shape, &data, strides);
+    assert_int(err, ==, ASDF_NDARRAY_OK);
+    assert_not_null(data);
+    assert_int(strides[0], ==, 16 * sizeof(int32_t));
+    assert_int(strides[1], ==, 4 * sizeof(int32_t));
+    assert_int(strides[2], ==, sizeof(int32_t));
+    // The view shares the array's data
+    size_t size = 0;
+    const int32_t *raw = asdf_ndarray_data_raw(ndarray, &size);
+    assert_ptr_equal(data, raw + 16 + 4 + 1);
+
+    int32_t expected[2][2][2] = {{{222, 223}, {232, 233}}, {{322, 323}, {332, 333}}};
+    for (int idx = 0; idx < 2; idx++) {
+        for (int jdx = 0; jdx < 2; jdx++) {
+            for (int kdx = 0; kdx < 2; kdx++) {
+                const uint8_t *elem = (const uint8_t *)data + (idx * strides[0]) +
+                                      (jdx * strides[1]) + (kdx * strides[2]);
+                assert_int(*(const int32_t *)elem, ==, expected[idx][jdx][kdx]);
+            }
+        }
+    }
+
+    // The full array
+    assert_int(asdf_ndarray_view(ndarray, NULL, NULL, &data, strides), ==, ASDF_NDARRAY_OK);
+    assert_ptr_equal(data, raw);
+
+    uint64_t bad_shape[] = {2, 2, 4};
+    err = asdf_ndarray_view(ndarray, origin, bad_shape, &data, strides);
+    assert_int(err, ==, ASDF_NDARRAY_ERR_OUT_OF_BOUNDS);
+    asdf_ndarray_destroy(ndarray);
+
+    // Byte order does not matter for single-byte elements
+    assert_int(asdf_get_ndarray(file, "1d", &ndarray), ==, ASDF_VALUE_OK);
+    assert_int(asdf_ndarray_view(ndarray, NULL, NULL, &data, strides), ==, ASDF_NDARRAY_OK);
+    assert_int(((const uint8_t *)data)[3], ==, 4);
+    asdf_ndarray_destroy(ndarray);
+    asdf_close(file);
+
+    // Data in the non-native byte order can only be copied
+    uint16_t one = 1;
+    bool little = *(uint8_t *)&one == 1;
+    path = get_fixture_file_path("byteorder.asdf");
+    file = asdf_open(path, "r");
+    assert_not_null(file);
+    const char *native = little ? "uint32-little" : "uint32-big";
+    const char *swapped = little ? "uint32-big" : "uint32-little";
+    assert_int(asdf_get_ndarray(file, native, &ndarray), ==, ASDF_VALUE_OK);
+    assert_int(asdf_ndarray_view(ndarray, NULL, NULL, &data, strides), ==, ASDF_NDARRAY_OK);
+    assert_int(((const uint32_t *)data)[7], ==, 7);
+    asdf_ndarray_destroy(ndarray);
+    assert_int(asdf_get_ndarray(file, swapped, &ndarray), ==, ASDF_VALUE_OK);
+    err = asdf_ndarray_view(ndarray, NULL, NULL, &data, strides);
+    assert_int(err, ==, ASDF_NDARRAY_ERR_COPY_REQUIRED);
+    asdf_ndarray_destroy(ndarray);
+    asdf_close(file);
+
+    // A zero stride repeats the same row along the first dimension
+    uint64_t broadcast_shape[] = {3, 2};
+    int64_t broadcast_strides[] = {0, sizeof(int32_t)};
+    asdf_ndarray_t broadcast = {
+        .datatype = {.type = ASDF_DATATYPE_INT32, .size = sizeof(int32_t)},
+        .byteorder = little ? ASDF_BYTEORDER_LITTLE : ASDF_BYTEORDER_BIG,
+        .ndim = 2,
+        .shape = broadcast_shape,
+        .strides = broadcast_strides,
+    };
+    int32_t *broadcast_data = asdf_ndarray_data_alloc(&broadcast);
+    assert_not_null(broadcast_data);
+    uint64_t row_origin[] = {2, 0};
+    uint64_t row_shape[] = {1, 2};
+    err = asdf_ndarray_view(&broadcast, row_origin, row_shape, &data, strides);
+    assert_int(err, ==, ASDF_NDARRAY_OK);
+    assert_ptr_equal(data, broadcast_data);
+    assert_int(strides[0], ==, 0);
+    asdf_ndarray_data_dealloc(&broadcast);
+    return MUNIT_OK;
+}
+
+
+/**
+ * Tree for `ndarray_read_tile_strided`: several views of one block holding the int32 values
+ * 0..9, as written by Python asdf for views of a shared base array
+ */
+static const char strided_tree[] =
+    "#ASDF 1.0.0\n"
+    "#ASDF_STANDARD 1.5.0\n"
+    "%YAML 1.1\n"
+    "%TAG ! tag:stsci.edu:asdf/\n"
+    "--- !core/asdf-1.1.0\n"
+    "fortran: !core/ndarray-1.1.0\n"
+    "  {source: 0, datatype: int32, byteorder: little, shape: [3, 2], strides: [4, 12]}\n"
+    "flipped: !core/ndarray-1.1.0\n"
+    "  {source: 0, datatype: int32, byteorder: little, shape: [3, 2], offset: 16,\n"
+    "   strides: [-8, 4]}\n"
+    "sliced: !core/ndarray-1.1.0\n"
+    "  {source: 0, datatype: int32, byteorder: little, shape: [3, 2], offset: 4,\n"
+    "   strides: [12, 8]}\n"
+    "tail: !core/ndarray-1.1.0\n"
+    "  {source: 0, datatype: int32, byteorder: little, shape: [4], offset: 24}\n"
+    "too_big: !core/ndarray-1.1.0\n"
+    "  {source: 0, datatype: int32, byteorder: little, shape: [3, 2], offset: 8,\n"
+    "   strides: [16, 4]}\n"
+    "empty: !core/ndarray-1.1.0\n"
+    "  {source: 0, datatype: int32, byteorder: little, shape: [2, 3, 0, 4]}\n"
+    "...\n";
+
+
+/* Build an ASDF file from a tree and the data for a single uncompressed block */
+static size_t build_single_block_file(
+    uint8_t *buf, const char *tree, const void *data, uint64_t size) {
+    size_t tree_len = strlen(tree);
+    uint8_t *header = buf + tree_len;
+    memcpy(buf, tree, tree_len);
+    memset(header, 0, 54);
+    memcpy(header, "\xd3" "BLK", 4);
+    header[5] = 48;
+
+    // allocated_size, used_size and data_size are all big-endian
+    for (int field = 0; field < 3; field++) {
+        for (int byte = 0; byte < 8; byte++)
+            header[14 + (field * 8) + byte] = (uint8_t)(size >> (56 - (byte * 8)));
+    }
+
+    memcpy(header + 54, data, size);
+    return tree_len + 54 + size;
+}
+
+
+static void check_strided_tile(
+    asdf_file_t *file,
+    const char *name,
+    const uint64_t *origin,
+    const uint64_t *shape,
+    const int32_t *expected,
+    size_t nelems) {
+    asdf_ndarray_t *ndarray = NULL;
+    assert_int(asdf_get_ndarray(file, name, &ndarray), ==, ASDF_VALUE_OK);
+    void *tile = NULL;
+    asdf_ndarray_err_t err = asdf_ndarray_read_tile_ndim(
+        ndarray, origin, shape, ASDF_DATATYPE_SOURCE, &tile);
+    assert_int(err, ==, ASDF_NDARRAY_OK);
+    assert_memory_equal(nelems * sizeof(int32_t), tile, expected);
+    free(tile);
+
+    // Converting goes through the same paths
+    tile = NULL;
+    err = asdf_ndarray_read_tile_ndim(ndarray, origin, shape, ASDF_DATATYPE_FLOAT64, &tile);
+    assert_int(err, ==, ASDF_NDARRAY_OK);
+    for (size_t idx = 0; idx < nelems; idx++)
+        assert_double(((double *)tile)[idx], ==, (double)expected[idx]);
+    free(tile);
+    asdf_ndarray_destroy(ndarray);
+}
+
+
+/* Read tiles of arrays with strides and offsets into a shared block */
+MU_TEST(ndarray_read_tile_strided) {
+    uint8_t buf[sizeof(strided_tree) + 54 + (10 * sizeof(int32_t))];
+    int32_t values[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    uint16_t one = 1;
+    bool little = *(uint8_t *)&one == 1;
+
+    // The data is written little-endian
+    if (!little) {
+        for (int idx = 0; idx < 10; idx++)
+            values[idx] = (int32_t)__builtin_bswap32((uint32_t)values[idx]);
+    }
+
+    size_t len = build_single_block_file(buf, strided_tree, values, sizeof(values));
+    asdf_file_t *file = asdf_open_mem(buf, len);
+    assert_not_null(file);
+
+    uint64_t origin[] = {0, 0};
+    uint64_t shape[] = {3, 2};
+    const int32_t fortran[] = {0, 3, 1, 4, 2, 5};
+    const int32_t flipped[] = {4, 5, 2, 3, 0, 1};
+    const int32_t sliced[] = {1, 3, 4, 6, 7, 9};
+    check_strided_tile(file, "fortran", origin, shape, fortran, 6);
+    check_strided_tile(file, "flipped", origin, shape, flipped, 6);
+    check_strided_tile(file, "sliced", origin, shape, sliced, 6);
+
+    uint64_t sub_origin[] = {1, 0};
+    uint64_t sub_shape[] = {2, 2};
+    const int32_t fortran_sub[] = {1, 4, 2, 5};
+    const int32_t flipped_sub[] = {2, 3, 0, 1};
+    check_strided_tile(file, "fortran", sub_origin, sub_shape, fortran_sub, 4);
+    check_strided_tile(file, "flipped", sub_origin, sub_shape, flipped_sub, 4);
+
+    uint64_t tail_origin[] = {1};
+    uint64_t tail_shape[] = {3};
+    const int32_t tail[] = {7, 8, 9};
+    check_strided_tile(file, "tail", tail_origin, tail_shape, tail, 3);
+
+    // Views see the same strides and offsets
+    asdf_ndarray_t *ndarray = NULL;
+    const void *data = NULL;
+    int64_t strides[2] = {0};
+    asdf_ndarray_err_t err = ASDF_NDARRAY_OK;
+
+    if (little) {
+        assert_int(asdf_get_ndarray(file, "flipped", &ndarray), ==, ASDF_VALUE_OK);
+        err = asdf_ndarray_view(ndarray, sub_origin, sub_shape, &data, strides);
+        assert_int(err, ==, ASDF_NDARRAY_OK);
+        assert_int(strides[0], ==, -8);
+        assert_int(strides[1], ==, 4);
+        assert_int(*(const int32_t *)data, ==, 2);
+        asdf_ndarray_destroy(ndarray);
+    }
+
+    // An array reaching past the end of its block cannot be read
+    assert_int(asdf_get_ndarray(file, "too_big", &ndarray), ==, ASDF_VALUE_OK);
+    void *tile = NULL;
+    err = asdf_ndarray_read_tile_ndim(ndarray, origin, sub_shape, ASDF_DATATYPE_SOURCE, &tile);
+    assert_int(err, ==, ASDF_NDARRAY_ERR_OUT_OF_BOUNDS);
+    assert_null(tile);
+    err = asdf_ndarray_view(ndarray, origin, sub_shape, &data, strides);
+    assert_int(err, ==, ASDF_NDARRAY_ERR_OUT_OF_BOUNDS);
+    asdf_ndarray_destroy(ndarray);
+
+    // The C-order strides of every dimension before an empty one are zero
+    assert_int(asdf_get_ndarray(file, "empty", &ndarray), ==, ASDF_VALUE_OK);
+    tile = NULL;
+    err = asdf_ndarray_read_all(ndarray, ASDF_DATATYPE_SOURCE, &tile);
+    assert_int(err, ==, ASDF_NDARRAY_OK);
+    free(tile);
+    asdf_ndarray_destroy(ndarray);
+    asdf_close(file);
+
+    // A zero stride repeats the same row along the first dimension
+    uint64_t broadcast_shape[] = {3, 2};
+    int64_t broadcast_strides[] = {0, sizeof(int32_t)};
+    asdf_ndarray_t broadcast = {
+        .datatype = {.type = ASDF_DATATYPE_INT32, .size = sizeof(int32_t)},
+        .byteorder = little ? ASDF_BYTEORDER_LITTLE : ASDF_BYTEORDER_BIG,
+        .ndim = 2,
+        .shape = broadcast_shape,
+        .strides = broadcast_strides,
+    };
+    int32_t *broadcast_data = asdf_ndarray_data_alloc(&broadcast);
+    assert_not_null(broadcast_data);
+    broadcast_data[0] = 7;
+    broadcast_data[1] = 8;
+    tile = NULL;
+    err = asdf_ndarray_read_tile_ndim(&broadcast, origin, shape, ASDF_DATATYPE_INT64, &tile);
+    assert_int(err, ==, ASDF_NDARRAY_OK);
+    for (int idx = 0; idx < 6; idx++)
+        assert_int(((int64_t *)tile)[idx], ==, idx % 2 == 0 ? 7 : 8);
+    free(tile);
+    asdf_ndarray_data_dealloc(&broadcast);
+    return MUNIT_OK;
+}
+
+
 static char *supported_numeric_dtypes[] = {
     "int8", "uint8", "int16", "uint16", "int32", "uint32", "int64", "uint64",
     "float32", "float64", NULL};
@@ -554,6 +892,67 @@ MU_TEST(ndarray_structured_datatype) {
 }
 
 
+/**
+ * Reading the same ndarray twice returns the same object, which stays usable until its last
+ * reference is released; all references must be released before the file is closed
+ */
+MU_TEST(ndarray_shared) {
+    const char *path = get_fixture_file_path("tiles.asdf");
+    asdf_file_t *file = asdf_open(path, "r");
+    assert_not_null(file);
+
+    asdf_ndarray_t *ndarray = NULL;
+    asdf_ndarray_t *ndarray2 = NULL;
+    assert_int(asdf_get_ndarray(file, "2d", &ndarray), ==, ASDF_VALUE_OK);
+    assert_int(asdf_get_ndarray(file, "2d", &ndarray2), ==, ASDF_VALUE_OK);
+    assert_ptr_equal(ndarray, ndarray2);
+
+    // The block stays open for the remaining reference
+    asdf_ndarray_destroy(ndarray2);
+    uint64_t origin[] = {1, 1};
+    uint64_t shape[] = {1, 2};
+    uint16_t expected[] = {22, 23};
+    void *tile = NULL;
+    asdf_ndarray_err_t err = asdf_ndarray_read_tile_ndim(
+        ndarray, origin, shape, ASDF_DATATYPE_SOURCE, &tile);
+    assert_int(err, ==, ASDF_NDARRAY_OK);
+    assert_not_null(tile);
+    assert_memory_equal(2 * sizeof(uint16_t), tile, expected);
+    free(tile);
+    asdf_ndarray_destroy(ndarray);
+
+    // The file keeps its own reference, so the same object is returned again
+    ndarray2 = NULL;
+    assert_int(asdf_get_ndarray(file, "2d", &ndarray2), ==, ASDF_VALUE_OK);
+    assert_ptr_equal(ndarray2, ndarray);
+    asdf_ndarray_destroy(ndarray2);
+    asdf_close(file);
+
+    // Inline arrays are shared along with their decoded data
+    path = get_fixture_file_path("ndarray-inline.asdf");
+    file = asdf_open(path, "r");
+    assert_not_null(file);
+    ndarray = NULL;
+    ndarray2 = NULL;
+    assert_int(asdf_get_ndarray(file, "implicit", &ndarray), ==, ASDF_VALUE_OK);
+    size_t size = 0;
+    const uint8_t *data = asdf_ndarray_data_raw(ndarray, &size);
+    assert_not_null(data);
+    assert_int(asdf_get_ndarray(file, "implicit", &ndarray2), ==, ASDF_VALUE_OK);
+    assert_ptr_equal(ndarray, ndarray2);
+    asdf_ndarray_destroy(ndarray);
+    assert_ptr_equal(asdf_ndarray_data_raw(ndarray2, &size), data);
+    assert_size(size, ==, 9);
+
+    for (int idx = 0; idx < 9; idx++)
+        assert_int(data[idx], ==, idx);
+
+    asdf_ndarray_destroy(ndarray2);
+    asdf_close(file);
+    return MUNIT_OK;
+}
+
+
 MU_TEST(ndarray_read_inline_data) {
     const char *path = get_fixture_file_path("ndarray-inline.asdf");
     asdf_file_t *file = asdf_open(path, "r");
@@ -735,6 +1134,296 @@ MU_TEST(ndarray_write_inline_data) {
 }
 
 
+/**
+ * Inline arrays large enough to be decoded on several threads must come out
+ * the same as if they were decoded in order, with or without a thread pool
+ */
+MU_TEST(ndarray_read_large_inline_data) {
+    const char *out_path = get_temp_file_path(fixture->tempfile_prefix, ".asdf");
+    uint64_t shape[2] = {513, 257};
+    size_t n_elems = shape[0] * shape[1];
+
+    asdf_ndarray_t int_nd = {
+        .datatype = {.type = ASDF_DATATYPE_INT32, .size = sizeof(int32_t)},
+        .byteorder = ASDF_BYTEORDER_LITTLE,
+        .ndim = 2,
+        .shape = shape,
+    };
+    int32_t *int_data = asdf_ndarray_data_alloc(&int_nd);
+    assert_not_null(int_data);
+    for (size_t idx = 0; idx < n_elems; idx++)
+        int_data[idx] = (int32_t)idx - 70000;
+    asdf_ndarray_storage_set(&int_nd, ASDF_ARRAY_STORAGE_INLINE);
+
+    uint64_t dbl_shape[1] = {n_elems};
+    asdf_ndarray_t dbl_nd = {
+        .datatype = {.type = ASDF_DATATYPE_FLOAT64, .size = sizeof(double)},
+        .byteorder = ASDF_BYTEORDER_LITTLE,
+        .ndim = 1,
+        .shape = dbl_shape,
+    };
+    double *dbl_data = asdf_ndarray_data_alloc(&dbl_nd);
+    assert_not_null(dbl_data);
+    for (size_t idx = 0; idx < n_elems; idx++)
+        dbl_data[idx] = (double)idx * 0.25;
+    asdf_ndarray_storage_set(&dbl_nd, ASDF_ARRAY_STORAGE_INLINE);
+
+    asdf_file_t *file = asdf_open(NULL);
+    assert_not_null(file);
+    assert_int(asdf_set_ndarray(file, "ints", &int_nd), ==, ASDF_VALUE_OK);
+    assert_int(asdf_set_ndarray(file, "doubles", &dbl_nd), ==, ASDF_VALUE_OK);
+    assert_int(asdf_write_to(file, out_path), ==, 0);
+    asdf_close(file);
+
+    asdf_config_t config = {.threads = {.n_threads = 4, .min_task_bytes = 4096}};
+    asdf_file_t *files[2] = {asdf_open(out_path, "r"), asdf_open_ex(out_path, "r", &config)};
+
+    for (size_t file_idx = 0; file_idx < 2; file_idx++) {
+        file = files[file_idx];
+        assert_not_null(file);
+        asdf_ndarray_t *ndarray = NULL;
+        assert_int(asdf_get_ndarray(file, "ints", &ndarray), ==, ASDF_VALUE_OK);
+        assert_int(ndarray->datatype.type, ==, ASDF_DATATYPE_INT32);
+        size_t size = 0;
+        const int32_t *ints = asdf_ndarray_data_raw(ndarray, &size);
+        assert_not_null(ints);
+        assert_size(size, ==, n_elems * sizeof(int32_t));
+        assert_memory_equal(size, ints, int_data);
+        asdf_ndarray_destroy(ndarray);
+
+        ndarray = NULL;
+        assert_int(asdf_get_ndarray(file, "doubles", &ndarray), ==, ASDF_VALUE_OK);
+        assert_int(ndarray->datatype.type, ==, ASDF_DATATYPE_FLOAT64);
+        const double *doubles = asdf_ndarray_data_raw(ndarray, &size);
+        assert_not_null(doubles);
+        assert_size(size, ==, n_elems * sizeof(double));
+        assert_memory_equal(size, doubles, dbl_data);
+        asdf_ndarray_destroy(ndarray);
+        asdf_close(file);
+    }
+
+    asdf_ndarray_data_dealloc(&int_nd);
+    asdf_ndarray_data_dealloc(&dbl_nd);
+    return MUNIT_OK;
+}
+
+
+/** Fill value of the cubes written by `open_int32_cube`, within the int16 range */
+static int32_t int32_cube_value(size_t idx) {
+    return (int32_t)((idx * 7919) % 60000) - 30000;
+}
+
+
+/**
+ * Write a 3-D int32 cube of ``shape`` named "cube", with 100000 (out of range for int16) at each
+ * of the ``n_overflows`` indices in ``overflows``
+ *
+ * The file is opened twice: once reading only on the calling thread, and once with a pool of
+ * threads splitting even the smallest reads.
+ */
+static void open_int32_cube(
+    const fixtures *fixture,
+    const uint64_t *shape,
+    const size_t *overflows,
+    size_t n_overflows,
+    asdf_file_t **file_single,
+    asdf_file_t **file_threads) {
+    const char *out_path = get_temp_file_path(fixture->tempfile_prefix, ".asdf");
+    size_t n_elems = shape[0] * shape[1] * shape[2];
+
+    asdf_ndarray_t cube_nd = {
+        .datatype = {.type = ASDF_DATATYPE_INT32, .size = sizeof(int32_t)},
+        .byteorder = ASDF_BYTEORDER_LITTLE,
+        .ndim = 3,
+        .shape = (uint64_t *)shape,
+    };
+    int32_t *cube_data = asdf_ndarray_data_alloc(&cube_nd);
+    assert_not_null(cube_data);
+    for (size_t idx = 0; idx < n_elems; idx++)
+        cube_data[idx] = int32_cube_value(idx);
+    for (size_t idx = 0; idx < n_overflows; idx++)
+        cube_data[overflows[idx]] = 100000;
+
+    asdf_file_t *file = asdf_open(NULL);
+    assert_not_null(file);
+    assert_int(asdf_set_ndarray(file, "cube", &cube_nd), ==, ASDF_VALUE_OK);
+    assert_int(asdf_write_to(file, out_path), ==, 0);
+    asdf_close(file);
+    asdf_ndarray_data_dealloc(&cube_nd);
+
+    asdf_config_t config = {.threads = {.n_threads = 4, .min_task_bytes = 1}};
+    *file_single = asdf_open(out_path, "r");
+    *file_threads = asdf_open_ex(out_path, "r", &config);
+    assert_not_null(*file_single);
+    assert_not_null(*file_threads);
+}
+
+
+/**
+ * Tiles read on several threads must come out the same as if they were read on one,
+ * including whether an overflow is reported
+ */
+MU_TEST(ndarray_read_tile_threads) {
+    const uint64_t shape[3] = {6, 129, 67};
+    size_t n_elems = shape[0] * shape[1] * shape[2];
+    // Values out of range for int16: one in the second row of the cube, and one in the last
+    const size_t overflows[] = {(1 * 129 * 67) + (1 * 67) + 2, n_elems - 3};
+    asdf_file_t *file_single = NULL;
+    asdf_file_t *file_threads = NULL;
+    open_int32_cube(fixture, shape, overflows, 2, &file_single, &file_threads);
+
+    const uint64_t origins[][3] = {{0, 0, 0}, {1, 3, 5}, {2, 0, 0}, {5, 128, 0}, {0, 0, 0}};
+    const uint64_t shapes[][3] = {
+        {6, 129, 67}, {5, 125, 61}, {4, 129, 67}, {1, 1, 67}, {3, 4, 8}};
+    const asdf_ndarray_err_t expected_errs[] = {
+        ASDF_NDARRAY_ERR_OVERFLOW, ASDF_NDARRAY_OK, ASDF_NDARRAY_ERR_OVERFLOW,
+        ASDF_NDARRAY_ERR_OVERFLOW, ASDF_NDARRAY_ERR_OVERFLOW};
+    asdf_ndarray_t *single = NULL;
+    asdf_ndarray_t *threads = NULL;
+    assert_int(asdf_get_ndarray(file_single, "cube", &single), ==, ASDF_VALUE_OK);
+    assert_int(asdf_get_ndarray(file_threads, "cube", &threads), ==, ASDF_VALUE_OK);
+
+    for (size_t idx = 0; idx < sizeof(origins) / sizeof(origins[0]); idx++) {
+        size_t tile_size = shapes[idx][0] * shapes[idx][1] * shapes[idx][2] * sizeof(int16_t);
+        void *expected = NULL;
+        void *tile = NULL;
+        asdf_ndarray_err_t err = asdf_ndarray_read_tile_ndim(
+            single, origins[idx], shapes[idx], ASDF_DATATYPE_INT16, &expected);
+        assert_int(err, ==, expected_errs[idx]);
+        err = asdf_ndarray_read_tile_ndim(
+            threads, origins[idx], shapes[idx], ASDF_DATATYPE_INT16, &tile);
+        assert_int(err, ==, expected_errs[idx]);
+        assert_memory_equal(tile_size, tile, expected);
+        free(expected);
+        free(tile);
+    }
+
+    // The overflow in a row before the last of a non-contiguous tile is reported, and the tile is
+    // still returned, with the out of range value clamped
+    for (int nd_idx = 0; nd_idx < 2; nd_idx++) {
+        int16_t *tile = NULL;
+        asdf_ndarray_err_t err = asdf_ndarray_read_tile_ndim(
+            nd_idx == 0 ? single : threads, origins[4], shapes[4], ASDF_DATATYPE_INT16,
+            (void **)&tile);
+        assert_int(err, ==, ASDF_NDARRAY_ERR_OVERFLOW);
+        assert_not_null(tile);
+        assert_int16(tile[0], ==, (int16_t)int32_cube_value(0));
+        assert_int16(tile[(((1 * 4) + 1) * 8) + 2], ==, INT16_MAX);
+        // The last element of the tile, at {2, 3, 7}
+        assert_int16(tile[95], ==, (int16_t)int32_cube_value((2 * 129 * 67) + (3 * 67) + 7));
+        free(tile);
+    }
+
+    void *expected = NULL;
+    void *all = NULL;
+    asdf_ndarray_err_t err = asdf_ndarray_read_all(single, ASDF_DATATYPE_FLOAT64, &expected);
+    assert_int(err, ==, ASDF_NDARRAY_OK);
+    err = asdf_ndarray_read_all(threads, ASDF_DATATYPE_FLOAT64, &all);
+    assert_int(err, ==, ASDF_NDARRAY_OK);
+    assert_memory_equal(n_elems * sizeof(double), all, expected);
+    free(expected);
+    free(all);
+
+    asdf_ndarray_destroy(single);
+    asdf_ndarray_destroy(threads);
+    asdf_close(file_single);
+    asdf_close(file_threads);
+    return MUNIT_OK;
+}
+
+
+MU_TEST(ndarray_read_tiles) {
+    const uint64_t shape[3] = {5, 97, 83};
+    // A single value out of range for int16, in the first plane
+    const size_t overflows[] = {(50 * 83) + 40};
+    asdf_file_t *file_single = NULL;
+    asdf_file_t *file_threads = NULL;
+    open_int32_cube(fixture, shape, overflows, 1, &file_single, &file_threads);
+
+    // Out of order, overlapping, and including an empty tile and a whole plane
+    const uint64_t origins[][3] = {
+        {4, 90, 0}, {0, 48, 38}, {2, 0, 0}, {0, 0, 0}, {0, 45, 35}, {3, 10, 80}, {1, 5, 5}};
+    const uint64_t shapes[][3] = {
+        {1, 7, 83}, {1, 4, 4}, {1, 97, 83}, {5, 2, 3}, {2, 10, 10}, {2, 0, 3}, {3, 30, 1}};
+    const size_t n_tiles = sizeof(origins) / sizeof(origins[0]);
+    const uint64_t *origin_ptrs[sizeof(origins) / sizeof(origins[0])];
+    const uint64_t *shape_ptrs[sizeof(origins) / sizeof(origins[0])];
+    void *expected[sizeof(origins) / sizeof(origins[0])] = {0};
+    size_t tile_sizes[sizeof(origins) / sizeof(origins[0])];
+    asdf_ndarray_t *single = NULL;
+    asdf_ndarray_t *threads = NULL;
+    assert_int(asdf_get_ndarray(file_single, "cube", &single), ==, ASDF_VALUE_OK);
+    assert_int(asdf_get_ndarray(file_threads, "cube", &threads), ==, ASDF_VALUE_OK);
+
+    for (size_t idx = 0; idx < n_tiles; idx++) {
+        origin_ptrs[idx] = origins[idx];
+        shape_ptrs[idx] = shapes[idx];
+        tile_sizes[idx] = shapes[idx][0] * shapes[idx][1] * shapes[idx][2] * sizeof(int16_t);
+        asdf_ndarray_err_t err = asdf_ndarray_read_tile_ndim(
+            single, origins[idx], shapes[idx], ASDF_DATATYPE_INT16, &expected[idx]);
+        assert_true(err == ASDF_NDARRAY_OK || err == ASDF_NDARRAY_ERR_OVERFLOW);
+    }
+
+    asdf_ndarray_t *ndarrays[] = {single, threads};
+
+    for (size_t nd_idx = 0; nd_idx < 2; nd_idx++) {
+        void *tiles[sizeof(origins) / sizeof(origins[0])] = {0};
+        // One tile read into a buffer provided by the caller
+        int16_t provided[1 * 4 * 4];
+        tiles[1] = provided;
+        asdf_ndarray_err_t err = asdf_ndarray_read_tiles(
+            ndarrays[nd_idx], n_tiles, origin_ptrs, shape_ptrs, ASDF_DATATYPE_INT16, tiles);
+        // The overflowing value is in the overlapping tiles at {0, 48, 38} and {0, 45, 35}
+        assert_int(err, ==, ASDF_NDARRAY_ERR_OVERFLOW);
+        assert_ptr_equal(tiles[1], provided);
+
+        for (size_t idx = 0; idx < n_tiles; idx++) {
+            if (tile_sizes[idx] > 0)
+                assert_not_null(tiles[idx]);
+
+            assert_memory_equal(tile_sizes[idx], tiles[idx], expected[idx]);
+
+            if (tiles[idx] != provided)
+                free(tiles[idx]);
+        }
+    }
+
+    // Without the overflowing tile
+    void *tile = NULL;
+    asdf_ndarray_err_t err = asdf_ndarray_read_tiles(
+        threads, 1, origin_ptrs, shape_ptrs, ASDF_DATATYPE_INT16, &tile);
+    assert_int(err, ==, ASDF_NDARRAY_OK);
+    assert_memory_equal(tile_sizes[0], tile, expected[0]);
+    free(tile);
+
+    // If any tile is out of bounds none are read
+    const uint64_t bad_origin[3] = {4, 96, 80};
+    const uint64_t bad_shape[3] = {1, 1, 4};
+    const uint64_t *bad_origins[] = {origins[0], bad_origin};
+    const uint64_t *bad_shapes[] = {shapes[0], bad_shape};
+    void *bad_tiles[2] = {NULL, NULL};
+    err = asdf_ndarray_read_tiles(
+        threads, 2, bad_origins, bad_shapes, ASDF_DATATYPE_INT16, bad_tiles);
+    assert_int(err, ==, ASDF_NDARRAY_ERR_OUT_OF_BOUNDS);
+    assert_null(bad_tiles[0]);
+    assert_null(bad_tiles[1]);
+
+    assert_int(
+        asdf_ndarray_read_tiles(threads, 0, NULL, NULL, ASDF_DATATYPE_INT16, NULL),
+        ==,
+        ASDF_NDARRAY_OK);
+
+    for (size_t idx = 0; idx < n_tiles; idx++)
+        free(expected[idx]);
+
+    asdf_ndarray_destroy(single);
+    asdf_ndarray_destroy(threads);
+    asdf_close(file_single);
+    asdf_close(file_threads);
+    return MUNIT_OK;
+}
+
+
 MU_TEST(ndarray_inline_warning_thresh) {
     uint64_t shape[1] = {100};
     asdf_ndarray_t ndarray = {
@@ -959,12 +1648,19 @@ MU_TEST_SUITE(
     MU_RUN_TEST(ndarray_read_1d_tile_contiguous),
     MU_RUN_TEST(test_asdf_ndarray_read_tile_2d),
     MU_RUN_TEST(ndarray_read_3d_tile),
+    MU_RUN_TEST(ndarray_access_hints),
     MU_RUN_TEST(ndarray_read_tile_byteswap),
+    MU_RUN_TEST(ndarray_view),
+    MU_RUN_TEST(ndarray_read_tile_strided),
     MU_RUN_TEST(ndarray_numeric_conversion, test_numeric_conversion_params),
     MU_RUN_TEST(ndarray_structured_datatype),
+    MU_RUN_TEST(ndarray_shared),
     MU_RUN_TEST(ndarray_read_inline_data),
     MU_RUN_TEST(ndarray_write_empty_inline_data),
     MU_RUN_TEST(ndarray_write_inline_data),
+    MU_RUN_TEST(ndarray_read_large_inline_data),
+    MU_RUN_TEST(ndarray_read_tile_threads),
+    MU_RUN_TEST(ndarray_read_tiles),
     MU_RUN_TEST(ndarray_inline_warning_thresh),
     MU_RUN_TEST(ndarray_array_storage_override, ndarray_array_storage_params),
     MU_RUN_TEST(heap_use_after_free_issue_63),
@@ -1,3 +1,5 @@
+#include <string.h>
+
 #include "munit.h"
 #include "util.h"
 
@@ -37,10 +39,81 @@ MU_TEST(test_is_generic_yaml_directive) {
 }
 
 
+MU_TEST(test_is_block_index_char) {
+    const char *allowed = "0123456789 \t\r\n-.,[]%YAML";
+
+    for (const char *ch = allowed; *ch; ch++)
+        assert_true(is_block_index_char((uint8_t)*ch));
+
+    // In particular the end of the #ASDF BLOCK INDEX header
+    assert_false(is_block_index_char('X'));
+    assert_false(is_block_index_char('#'));
+    assert_false(is_block_index_char('\0'));
+    assert_false(is_block_index_char(0xd3));
+    return MUNIT_OK;
+}
+
+
+static bool parse_block_index(const char *buf, asdf_block_index_t *block_index) {
+    return asdf_parse_block_index(buf, strlen(buf), block_index);
+}
+
+
+MU_TEST(test_asdf_parse_block_index) {
+    asdf_block_index_t block_index = {0};
+
+    assert_true(parse_block_index("\n%YAML 1.1\n---\n- 425\n- 1137\n- 1849\n...\n", &block_index));
+    assert_int(asdf_block_index_size(&block_index), ==, 3);
+    assert_int(*asdf_block_index_at(&block_index, 0), ==, 425);
+    assert_int(*asdf_block_index_at(&block_index, 1), ==, 1137);
+    assert_int(*asdf_block_index_at(&block_index, 2), ==, 1849);
+    asdf_block_index_clear(&block_index);
+
+    // CRLF line endings, no document end marker
+    assert_true(parse_block_index("\r\n%YAML 1.1\r\n---\r\n- 425\r\n- 1137\r\n", &block_index));
+    assert_int(asdf_block_index_size(&block_index), ==, 2);
+    asdf_block_index_clear(&block_index);
+
+    // Flow sequences
+    assert_true(parse_block_index("\n--- [425, 1137 ,1849]\n...\n", &block_index));
+    assert_int(asdf_block_index_size(&block_index), ==, 3);
+    assert_int(*asdf_block_index_at(&block_index, 2), ==, 1849);
+    asdf_block_index_clear(&block_index);
+
+    assert_true(parse_block_index("\n---\n[]\n", &block_index));
+    assert_int(asdf_block_index_size(&block_index), ==, 0);
+
+    // Invalid indices leave the block index empty
+    const char *invalid[] = {
+        "",
+        "\n- 425\n",
+        "\n---\n- 425\n- abc\n",
+        "\n---\n- 425 1137\n",
+        "\n---\n-425\n",
+        "\n---\n- -425\n",
+        "\n---\n- 99999999999999999999999\n",
+        "\n---\n- 425\n...\n- 1137\n",
+        "\n--- [425, 1137\n",
+        "\n--- [425 1137]\n",
+        "\n---\n{a: 425}\n",
+    };
+
+    for (size_t idx = 0; idx < sizeof(invalid) / sizeof(invalid[0]); idx++) {
+        assert_false(parse_block_index(invalid[idx], &block_index));
+        assert_int(asdf_block_index_size(&block_index), ==, 0);
+    }
+
+    asdf_block_index_drop(&block_index);
+    return MUNIT_OK;
+}
+
+
 MU_TEST_SUITE(
     parse_util,
     MU_RUN_TEST(test_is_yaml_1_1_directive),
-    MU_RUN_TEST(test_is_generic_yaml_directive)
+    MU_RUN_TEST(test_is_generic_yaml_directive),
+    MU_RUN_TEST(test_is_block_index_char),
+    MU_RUN_TEST(test_asdf_parse_block_index)
 );
 
 
@@ -168,6 +168,53 @@ MU_TEST(parse_padding_no_tree_padding_after_header) {
 }
 
 
+/**
+ * Test that the buffered tree points directly into the input when parsing from memory, and is
+ * copied out of the stream otherwise
+ */
+MU_TEST(parse_tree_buffer) {
+    const char *filename = get_fixture_file_path("multi-block.asdf");
+    size_t len = 0;
+    char *contents = read_file(filename, &len);
+    assert_not_null(contents);
+
+    asdf_parser_cfg_t config = {.flags = ASDF_PARSER_OPT_BUFFER_TREE};
+    asdf_parser_t *parser = asdf_parser_create(&config);
+    asdf_event_t *event = NULL;
+    assert_not_null(parser);
+    assert_int(asdf_parser_set_input_mem(parser, contents, len), ==, 0);
+
+    do {
+        assert_not_null((event = asdf_event_iterate(parser)));
+    } while (asdf_event_type(event) != ASDF_TREE_END_EVENT);
+
+    const asdf_tree_info_t *tree = event->payload.tree;
+    assert_true(parser->tree.buf_borrowed);
+    assert_ptr_equal(tree->buf, contents + tree->start);
+    assert_int(parser->tree.size, ==, tree->end - tree->start);
+    asdf_parser_destroy(parser);
+
+    FILE *file = fopen(filename, "rb");
+    assert_not_null(file);
+    parser = asdf_parser_create(&config);
+    assert_not_null(parser);
+    assert_int(asdf_parser_set_input_fp(parser, file, filename), ==, 0);
+
+    do {
+        assert_not_null((event = asdf_event_iterate(parser)));
+    } while (asdf_event_type(event) != ASDF_TREE_END_EVENT);
+
+    tree = event->payload.tree;
+    assert_false(parser->tree.buf_borrowed);
+    assert_int(parser->tree.size, ==, tree->end - tree->start);
+    assert_memory_equal(parser->tree.size, tree->buf, contents + tree->start);
+    asdf_parser_destroy(parser);
+    fclose(file);
+    free(contents);
+    return MUNIT_OK;
+}
+
+
 MU_TEST_SUITE(
     parse,
     MU_RUN_TEST(parse_minimal),
@@ -176,7 +223,8 @@ MU_TEST_SUITE(
     MU_RUN_TEST(parse_padding_after_header),
     MU_RUN_TEST(parse_padding_after_tree),
     MU_RUN_TEST(parse_padding_no_newline_before_tree),
-    MU_RUN_TEST(parse_padding_no_tree_padding_after_header)
+    MU_RUN_TEST(parse_padding_no_tree_padding_after_header),
+    MU_RUN_TEST(parse_tree_buffer)
 );
 
 
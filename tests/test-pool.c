@@ -0,0 +1,97 @@
+#include <stdalign.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "munit.h"
+#include "util.h"
+
+#include "pool.h"
+
+
+typedef struct {
+    char name[24];
+    double x;
+} test_obj_t;
+
+
+MU_TEST(test_asdf_pool_alloc) {
+    asdf_pool_t pool;
+    asdf_pool_init(&pool, sizeof(test_obj_t));
+    assert_size(pool.obj_size, >=, sizeof(test_obj_t));
+    assert_size(pool.obj_size % alignof(max_align_t), ==, 0);
+
+    // Allocate enough objects to require several slabs
+    size_t n_objs = ASDF_POOL_SLAB_MIN_OBJECTS * 10;
+    test_obj_t **objs = calloc(n_objs, sizeof(test_obj_t *));
+    assert_not_null(objs);
+
+    for (size_t idx = 0; idx < n_objs; idx++) {
+        objs[idx] = asdf_pool_alloc(&pool);
+        assert_not_null(objs[idx]);
+        assert_size((uintptr_t)objs[idx] % alignof(max_align_t), ==, 0);
+        assert_string_equal(objs[idx]->name, "");
+        assert_double(objs[idx]->x, ==, 0.0);
+        snprintf(objs[idx]->name, sizeof(objs[idx]->name), "obj%zu", idx);
+        objs[idx]->x = (double)idx;
+    }
+
+    // Objects must not overlap
+    for (size_t idx = 0; idx < n_objs; idx++) {
+        char name[24];
+        snprintf(name, sizeof(name), "obj%zu", idx);
+        assert_string_equal(objs[idx]->name, name);
+        assert_double(objs[idx]->x, ==, (double)idx);
+    }
+
+    free((void *)objs);
+    asdf_pool_drop(&pool);
+    assert_null(pool.slabs);
+    assert_null(pool.free_list);
+    return MUNIT_OK;
+}
+
+
+MU_TEST(test_asdf_pool_free) {
+    asdf_pool_t pool;
+    asdf_pool_init(&pool, sizeof(test_obj_t));
+
+    test_obj_t *a = asdf_pool_alloc(&pool);
+    test_obj_t *b = asdf_pool_alloc(&pool);
+    assert_not_null(a);
+    assert_not_null(b);
+    assert_ptr_not_equal(a, b);
+    a->x = 1.0;
+    b->x = 2.0;
+
+    // Freed objects are reused most recently freed first, and come back zeroed
+    asdf_pool_free(&pool, a);
+    asdf_pool_free(&pool, b);
+    asdf_pool_free(&pool, NULL);
+    test_obj_t *c = asdf_pool_alloc(&pool);
+    test_obj_t *d = asdf_pool_alloc(&pool);
+    assert_ptr_equal(c, b);
+    assert_ptr_equal(d, a);
+    assert_double(c->x, ==, 0.0);
+    assert_double(d->x, ==, 0.0);
+    assert_null(pool.free_list);
+
+    // The pool can still be used after being dropped
+    asdf_pool_drop(&pool);
+    a = asdf_pool_alloc(&pool);
+    assert_not_null(a);
+    asdf_pool_drop(&pool);
+    return MUNIT_OK;
+}
+
+
+MU_TEST_SUITE(
+    pool,
+    MU_RUN_TEST(test_asdf_pool_alloc),
+    MU_RUN_TEST(test_asdf_pool_free)
+);
+
+
+MU_RUN_SUITE(pool);
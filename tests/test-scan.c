@@ -0,0 +1,289 @@
+#include "munit.h"
+#include "util.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "scan.h"
+
+
+#define TOKEN(t) ((const uint8_t *)(t))
+#define TOKEN_LEN(t) (sizeof(t) - 1)
+
+
+static const asdf_scan_kernel_t scan_kernels[] = {
+    ASDF_SCAN_KERNEL_AUTO,
+    ASDF_SCAN_KERNEL_GENERIC,
+    ASDF_SCAN_KERNEL_SSE2,
+    ASDF_SCAN_KERNEL_AVX2,
+};
+
+
+#define N_SCAN_KERNELS (sizeof(scan_kernels) / sizeof(scan_kernels[0]))
+
+
+/** Reference implementation: the straightforward O(len * n_tokens) scan */
+static int scan_tokens_reference(
+    const uint8_t *buf,
+    size_t len,
+    const uint8_t **tokens,
+    const size_t *token_lens,
+    size_t n_tokens,
+    size_t *match_offset,
+    size_t *match_token_idx) {
+    if (!buf || len == 0 || n_tokens == 0)
+        return 1;
+
+    for (size_t idx = 0; idx < len; idx++) {
+        for (size_t tdx = 0; tdx < n_tokens; tdx++) {
+            size_t tok_len = token_lens[tdx];
+            if (tok_len <= len - idx && memcmp(buf + idx, tokens[tdx], tok_len) == 0) {
+                *match_offset = idx;
+                *match_token_idx = tdx;
+                return 0;
+            }
+        }
+    }
+
+    return 1;
+}
+
+
+static void assert_scan_matches_reference(
+    const uint8_t *buf,
+    size_t len,
+    const uint8_t **tokens,
+    const size_t *token_lens,
+    size_t n_tokens) {
+    size_t expected_offset = 0;
+    size_t expected_idx = 0;
+    int expected = scan_tokens_reference(
+        buf, len, tokens, token_lens, n_tokens, &expected_offset, &expected_idx);
+
+    for (size_t kdx = 0; kdx < N_SCAN_KERNELS; kdx++) {
+        asdf_scan_tokens_fn scan = asdf_scan_kernel_get(scan_kernels[kdx]);
+
+        if (!scan)
+            continue;
+
+        size_t match_offset = SIZE_MAX;
+        size_t match_idx = SIZE_MAX;
+        int ret = scan(buf, len, tokens, token_lens, n_tokens, &match_offset, &match_idx);
+        assert_int(ret, ==, expected);
+
+        if (expected == 0) {
+            assert_size(match_offset, ==, expected_offset);
+            assert_size(match_idx, ==, expected_idx);
+        }
+    }
+}
+
+
+MU_TEST(scan_kernels_available) {
+    assert_not_null(asdf_scan_kernel_get(ASDF_SCAN_KERNEL_AUTO));
+    assert_not_null(asdf_scan_kernel_get(ASDF_SCAN_KERNEL_GENERIC));
+    return MUNIT_OK;
+}
+
+
+MU_TEST(scan_no_match) {
+    const uint8_t *tokens[] = {TOKEN("%YAML "), TOKEN("\xd3" "BLK")};
+    size_t token_lens[] = {TOKEN_LEN("%YAML "), TOKEN_LEN("\xd3" "BLK")};
+    const char *buf = "no tokens to be found in this string, which is longer than a vector";
+    assert_scan_matches_reference(TOKEN(buf), strlen(buf), tokens, token_lens, 2);
+    assert_int(asdf_scan_tokens(TOKEN(buf), strlen(buf), tokens, token_lens, 2, NULL, NULL), ==, 1);
+    assert_int(asdf_scan_tokens(NULL, 0, tokens, token_lens, 2, NULL, NULL), ==, 1);
+    assert_int(asdf_scan_tokens(TOKEN(buf), strlen(buf), tokens, token_lens, 0, NULL, NULL), ==, 1);
+    return MUNIT_OK;
+}
+
+
+MU_TEST(scan_overlapping_tokens) {
+    // When two tokens match at the same offset the lower index wins; when they match at
+    // different offsets the earlier offset wins regardless of the token index
+    const uint8_t *tokens[] = {TOKEN("abcd"), TOKEN("ab"), TOKEN("bc")};
+    size_t token_lens[] = {4, 2, 2};
+    const char *buf = "xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxabcxxxxabcdxxxxxxxxxxxxxxxxxxxxxxxxxxx";
+    size_t match_offset = 0;
+    size_t match_idx = 0;
+    int ret = asdf_scan_tokens(
+        TOKEN(buf), strlen(buf), tokens, token_lens, 3, &match_offset, &match_idx);
+    assert_int(ret, ==, 0);
+    assert_size(match_offset, ==, 40);
+    assert_size(match_idx, ==, 1);
+    assert_scan_matches_reference(TOKEN(buf), strlen(buf), tokens, token_lens, 3);
+
+    ret = asdf_scan_tokens(
+        TOKEN(buf) + 43, strlen(buf) - 43, tokens, token_lens, 3, &match_offset, &match_idx);
+    assert_int(ret, ==, 0);
+    assert_size(match_offset, ==, 4);
+    assert_size(match_idx, ==, 0);
+    return MUNIT_OK;
+}
+
+
+MU_TEST(scan_token_at_end) {
+    // Match in the last few bytes, after the vectorized portion of the scan, and a
+    // partial match truncated by the end of the buffer
+    const uint8_t *tokens[] = {TOKEN("\n..."), TOKEN("\xd3" "BLK")};
+    size_t token_lens[] = {4, 4};
+    uint8_t buf[131];
+    memset(buf, '.', sizeof(buf));
+
+    for (size_t len = 1; len <= sizeof(buf); len++) {
+        memset(buf, '.', sizeof(buf));
+        if (len >= 4)
+            memcpy(buf + len - 4, "\xd3" "BLK", 4);
+        assert_scan_matches_reference(buf, len, tokens, token_lens, 2);
+
+        memset(buf, '.', sizeof(buf));
+        memcpy(buf + len - 1, "\xd3", 1);
+        assert_scan_matches_reference(buf, len, tokens, token_lens, 2);
+    }
+
+    return MUNIT_OK;
+}
+
+
+MU_TEST(scan_empty_token) {
+    const uint8_t *tokens[] = {TOKEN("asdf"), TOKEN("")};
+    size_t token_lens[] = {4, 0};
+    const char *buf = "asdf";
+    size_t match_offset = 1;
+    size_t match_idx = 1;
+    assert_int(
+        asdf_scan_tokens(TOKEN(buf), 4, tokens, token_lens, 2, &match_offset, &match_idx), ==, 0);
+    assert_size(match_offset, ==, 0);
+    assert_size(match_idx, ==, 0);
+    assert_scan_matches_reference(TOKEN("qwer"), 4, tokens, token_lens, 2);
+    return MUNIT_OK;
+}
+
+
+MU_TEST(scan_many_tokens) {
+    // More tokens than the vector kernels handle
+    const uint8_t *tokens[ASDF_SCAN_MAX_VECTOR_TOKENS + 2];
+    size_t token_lens[ASDF_SCAN_MAX_VECTOR_TOKENS + 2];
+    char token_bufs[ASDF_SCAN_MAX_VECTOR_TOKENS + 2][2];
+    size_t n_tokens = ASDF_SCAN_MAX_VECTOR_TOKENS + 2;
+
+    for (size_t idx = 0; idx < n_tokens; idx++) {
+        token_bufs[idx][0] = (char)('a' + idx);
+        token_bufs[idx][1] = '!';
+        tokens[idx] = TOKEN(token_bufs[idx]);
+        token_lens[idx] = 2;
+    }
+
+    const char *buf = "zzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzzj!";
+    assert_scan_matches_reference(TOKEN(buf), strlen(buf), tokens, token_lens, n_tokens);
+    return MUNIT_OK;
+}
+
+
+MU_TEST(scan_random) {
+    // Small alphabet so that candidates (and false-positive candidates) are frequent
+    static const char alphabet[] = {'%', 'Y', 'A', '\n', '.', '\xd3', 'B', 'K', '#', ' '};
+    uint8_t buf[512];
+    uint8_t token_bufs[4][8];
+    const uint8_t *tokens[4];
+    size_t token_lens[4];
+
+    for (int iter = 0; iter < 20000; iter++) {
+        size_t len = munit_rand_int_range(1, sizeof(buf));
+        size_t n_tokens = munit_rand_int_range(1, 4);
+
+        for (size_t idx = 0; idx < len; idx++)
+            buf[idx] = alphabet[munit_rand_int_range(0, sizeof(alphabet) - 1)];
+
+        for (size_t tdx = 0; tdx < n_tokens; tdx++) {
+            token_lens[tdx] = munit_rand_int_range(1, sizeof(token_bufs[tdx]));
+            for (size_t idx = 0; idx < token_lens[tdx]; idx++)
+                token_bufs[tdx][idx] = alphabet[munit_rand_int_range(0, sizeof(alphabet) - 1)];
+            tokens[tdx] = token_bufs[tdx];
+        }
+
+        assert_scan_matches_reference(buf, len, tokens, token_lens, n_tokens);
+    }
+
+    return MUNIT_OK;
+}
+
+
+static double elapsed_sec(const struct timespec *start, const struct timespec *end) {
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+
+/**
+ * Microbenchmark comparing the reference scan to each available kernel
+ *
+ * Scans for the parser's block tokens in a large buffer with no matches until the end.
+ * Only logs the timings, as asserting on them would be flaky.
+ */
+MU_TEST(scan_benchmark) {
+    const uint8_t *tokens[] = {TOKEN("\xd3" "BLK"), TOKEN("#ASDF BLOCK INDEX")};
+    size_t token_lens[] = {4, TOKEN_LEN("#ASDF BLOCK INDEX")};
+    size_t len = 16 * 1024 * 1024;
+    uint8_t *buf = malloc(len);
+    assert_not_null(buf);
+
+    for (size_t idx = 0; idx < len; idx++)
+        buf[idx] = (uint8_t)(' ' + idx % 64);
+
+    memcpy(buf + len - 4, "\xd3" "BLK", 4);
+
+    size_t match_offset = 0;
+    size_t match_idx = 0;
+    struct timespec start;
+    struct timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    int ret = scan_tokens_reference(buf, len, tokens, token_lens, 2, &match_offset, &match_idx);
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    assert_int(ret, ==, 0);
+    double reference_sec = elapsed_sec(&start, &end);
+    munit_logf(MUNIT_LOG_INFO, "reference: %.3f ms", reference_sec * 1e3);
+
+    static const char *kernel_names[] = {"auto", "generic", "sse2", "avx2"};
+
+    for (size_t kdx = 0; kdx < N_SCAN_KERNELS; kdx++) {
+        asdf_scan_tokens_fn scan = asdf_scan_kernel_get(scan_kernels[kdx]);
+
+        if (!scan)
+            continue;
+
+        clock_gettime(CLOCK_MONOTONIC, &start);
+        ret = scan(buf, len, tokens, token_lens, 2, &match_offset, &match_idx);
+        clock_gettime(CLOCK_MONOTONIC, &end);
+        assert_int(ret, ==, 0);
+        assert_size(match_offset, ==, len - 4);
+        double sec = elapsed_sec(&start, &end);
+        munit_logf(
+            MUNIT_LOG_INFO,
+            "%s: %.3f ms (%.1fx)",
+            kernel_names[kdx],
+            sec * 1e3,
+            sec > 0 ? reference_sec / sec : 0.0);
+    }
+
+    free(buf);
+    return MUNIT_OK;
+}
+
+
+MU_TEST_SUITE(
+    scan,
+    MU_RUN_TEST(scan_kernels_available),
+    MU_RUN_TEST(scan_no_match),
+    MU_RUN_TEST(scan_overlapping_tokens),
+    MU_RUN_TEST(scan_token_at_end),
+    MU_RUN_TEST(scan_empty_token),
+    MU_RUN_TEST(scan_many_tokens),
+    MU_RUN_TEST(scan_random),
+    MU_RUN_TEST(scan_benchmark)
+);
+
+
+MU_RUN_SUITE(scan);
@@ -4,7 +4,9 @@
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
+#include <unistd.h>
 
 #include "block.h"
 #include "stream.h"
@@ -194,44 +196,155 @@ MU_TEST(stream_mem_open_mem) {
 }
 
 
+MU_TEST(stream_mmap_open_mem) {
+    const char *filename = get_fixture_file_path("255.asdf");
+    off_t offset = 0x3bb;  // Known offset of the first block data in this file
+    size_t size = 256;  // Known size of the block data in this file
+
+    // Whole-file mapping, then the smallest possible window
+    for (size_t window_size = 0; window_size <= 1; window_size++) {
+        asdf_stream_t *stream = asdf_stream_from_file_mmap(NULL, filename, window_size);
+        assert_not_null(stream);
+        size_t avail = 0;
+        uint8_t *addr = (uint8_t *)stream->open_mem(stream, offset, size, &avail);
+        assert_not_null(addr);
+        assert_int(avail, ==, size);
+        // Test file contains the integers 0 to 255
+        for (int idx = 0; idx <= 255; idx++) {
+            assert_int(addr[idx], ==, idx);
+        }
+        assert_int(stream->close_mem(stream, (void *)addr), ==, 0);
+        asdf_stream_close(stream);
+    }
+
+    return MUNIT_OK;
+}
+
+
+/**
+ * Test scanning and reading lines across the boundaries of a windowed mmap stream
+ */
+MU_TEST(stream_mmap_window) {
+    const char *filename = get_temp_file_path(fixture->tempfile_prefix, ".bin");
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t size = page_size * 4 + 123;
+    char *contents = malloc(size);
+    assert_not_null(contents);
+
+    for (size_t idx = 0; idx < size; idx++)
+        contents[idx] = (idx % 100 == 99) ? '\n' : 'x';
+
+    // Tokens straddling the first window boundary and near the end of the file
+    memcpy(contents + page_size - 2, "asdf", 4);
+    memcpy(contents + size - 10, "dummy", 5);
+
+    FILE *file = fopen(filename, "wb");
+    assert_not_null(file);
+    assert_size(fwrite(contents, 1, size, file), ==, size);
+    fclose(file);
+
+    asdf_stream_t *stream = asdf_stream_from_file_mmap(NULL, filename, page_size);
+    assert_not_null(stream);
+
+    size_t match_offset = 0;
+    size_t match_idx = 0;
+    int ret = asdf_stream_scan(stream, tokens, token_lens, 2, &match_offset, &match_idx);
+    assert_int(ret, ==, 0);
+    assert_size(match_offset, ==, page_size - 2);
+    assert_int(match_idx, ==, 1);
+    assert_int(asdf_stream_tell(stream), ==, page_size - 2);
+
+    size_t avail = 0;
+    const uint8_t *r = asdf_stream_next(stream, 4, &avail);
+    assert_not_null(r);
+    assert_int(memcmp(r, "asdf", 4), ==, 0);
+    asdf_stream_consume(stream, 4);
+
+    ret = asdf_stream_scan(stream, tokens, token_lens, 2, &match_offset, &match_idx);
+    assert_int(ret, ==, 0);
+    assert_size(match_offset, ==, size - 10);
+    assert_int(match_idx, ==, 0);
+
+    // Read all the lines back from the start; none are truncated by window boundaries
+    assert_int(asdf_stream_seek(stream, 0, SEEK_SET), ==, 0);
+    size_t pos = 0;
+    size_t len = 0;
+    const uint8_t *line = NULL;
+
+    while ((line = asdf_stream_readline(stream, &len))) {
+        assert_int(memcmp(line, contents + pos, len), ==, 0);
+        pos += len;
+    }
+
+    assert_size(pos, ==, size);
+    asdf_stream_close(stream);
+    free(contents);
+    return MUNIT_OK;
+}
+
+
+static uint8_t cache_test_byte(size_t offset) {
+    return (uint8_t)(offset % 251);
+}
+
+
+static void assert_cache_region(const uint8_t *addr, size_t offset, size_t size) {
+    for (size_t idx = 0; idx < size; idx++)
+        assert_int(addr[idx], ==, cache_test_byte(offset + idx));
+}
+
+
 /**
  * Regression test for the realloc wrong-size bug in
  * ``file_open_mem``.
  *
- * The mmap-info array starts at ``ASDF_FILE_STREAM_INITIAL_MMAPS``
- * slots and doubles when full.  The old code passed the new element
- * count instead of ``new_count * sizeof(file_mmap_info_t)`` bytes to
- * ``realloc``, allocating far too little memory.  Opening
- * ``ASDF_FILE_STREAM_INITIAL_MMAPS + 1`` regions without closing them
- * exercises the realloc path; AddressSanitizer will catch any
- * out-of-bounds writes from the old bug.
- *
- * The new slots must also be zeroed so the free-slot search finds
- * them; the test verifies that the extra slot is usable.
+ * The old code passed the new element count instead of
+ * ``new_count * sizeof(file_mmap_info_t)`` bytes to ``realloc``,
+ * allocating far too little memory.  Regions are now shared through the
+ * mmap cache, so this opens ``ASDF_FILE_STREAM_INITIAL_MMAPS + 1`` regions
+ * on different pages, with a granularity of one page so that none of them
+ * can share a mapping, forcing the cache's mapping arrays to grow.
+ * AddressSanitizer will catch any out-of-bounds accesses.
  */
 MU_TEST(stream_file_open_mem_realloc) {
-    const char *filename = get_fixture_file_path("255.asdf");
+    const char *filename = get_temp_file_path(fixture->tempfile_prefix, "-realloc.bin");
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t n_regions = ASDF_FILE_STREAM_INITIAL_MMAPS + 1;
+    size_t file_size = n_regions * page_size;
+    FILE *file = fopen(filename, "wb");
+    assert_not_null(file);
+
+    for (size_t idx = 0; idx < file_size; idx++)
+        fputc(cache_test_byte(idx), file);
+
+    fclose(file);
+
     asdf_stream_t *stream = asdf_stream_from_file(NULL, filename, false);
     assert_not_null(stream);
+    stream_mmap_cache_t *cache = stream->mmap_cache;
+    assert_not_null(cache);
+    asdf_stream_set_mmap_cache_limits(stream, n_regions, page_size);
 
-    off_t offset = 0x3bb;
     size_t size = 256;
     size_t avail = 0;
-
-    // Open ASDF_FILE_STREAM_INITIAL_MMAPS + 1 regions without closing,
-    // forcing the internal mmap-info array to realloc.
     uint8_t *addrs[ASDF_FILE_STREAM_INITIAL_MMAPS + 1];
-    for (int idx = 0; idx <= ASDF_FILE_STREAM_INITIAL_MMAPS; idx++) {
-        addrs[idx] = stream->open_mem(stream, offset, size, &avail);
+
+    // Open each region without closing any, so every one needs its own mapping
+    for (size_t idx = 0; idx < n_regions; idx++) {
+        size_t offset = (idx * page_size) + 1;
+        addrs[idx] = stream->open_mem(stream, (off_t)offset, size, &avail);
         assert_not_null(addrs[idx]);
-        assert_int(avail, ==, size);
+        assert_size(avail, ==, size);
     }
 
-    // Verify the last (post-realloc) region is accessible and correct
-    for (int idx = 0; idx <= 255; idx++)
-        assert_int(addrs[ASDF_FILE_STREAM_INITIAL_MMAPS][idx], ==, idx);
+    assert_size(cache->count, ==, n_regions);
+    assert_size(cache->capacity, >, ASDF_FILE_STREAM_INITIAL_MMAPS);
 
-    for (int idx = 0; idx <= ASDF_FILE_STREAM_INITIAL_MMAPS; idx++)
+    // Regions mapped both before and after the arrays grew are still correct
+    for (size_t idx = 0; idx < n_regions; idx++)
+        assert_cache_region(addrs[idx], (idx * page_size) + 1, size);
+
+    for (size_t idx = 0; idx < n_regions; idx++)
         assert_int(stream->close_mem(stream, addrs[idx]), ==, 0);
 
     asdf_stream_close(stream);
@@ -239,6 +352,84 @@ MU_TEST(stream_file_open_mem_realloc) {
 }
 
 
+
+/**
+ * Nearby regions share one mapping, idle mappings are kept for reuse, and are only unmapped
+ * once the cache exceeds its budget
+ */
+MU_TEST(stream_file_open_mem_cache) {
+    const char *filename = get_temp_file_path(fixture->tempfile_prefix, "-mmap-cache.bin");
+    size_t page_size = (size_t)sysconf(_SC_PAGESIZE);
+    size_t file_size = 16 * page_size;
+    FILE *file = fopen(filename, "wb");
+    assert_not_null(file);
+
+    for (size_t idx = 0; idx < file_size; idx++)
+        fputc(cache_test_byte(idx), file);
+
+    fclose(file);
+
+    asdf_stream_t *stream = asdf_stream_from_file(NULL, filename, false);
+    assert_not_null(stream);
+    stream_mmap_cache_t *cache = stream->mmap_cache;
+    assert_not_null(cache);
+    asdf_stream_set_mmap_cache_limits(stream, 2, page_size);
+
+    size_t avail = 0;
+    uint8_t *addr0 = stream->open_mem(stream, 10, 100, &avail);
+    assert_not_null(addr0);
+    assert_size(avail, ==, 100);
+    uint8_t *addr1 = stream->open_mem(stream, 200, 100, &avail);
+    assert_not_null(addr1);
+    assert_size(cache->count, ==, 1);
+    assert_ptr_equal(addr1, addr0 + 190);
+
+    uint8_t *addr5 = stream->open_mem(stream, (off_t)(5 * page_size), 100, &avail);
+    assert_not_null(addr5);
+    assert_size(cache->count, ==, 2);
+    assert_cache_region(addr0, 10, 100);
+    assert_cache_region(addr1, 200, 100);
+    assert_cache_region(addr5, 5 * page_size, 100);
+
+    // Closing does not unmap while within budget, so reopening reuses the mapping
+    assert_int(stream->close_mem(stream, addr0), ==, 0);
+    assert_int(stream->close_mem(stream, addr1), ==, 0);
+    assert_int(stream->close_mem(stream, addr5), ==, 0);
+    assert_size(cache->count, ==, 2);
+    assert_size(cache->n_idle, ==, 2);
+    assert_ptr_equal(stream->open_mem(stream, (off_t)(5 * page_size), 100, &avail), addr5);
+
+    // Over budget: the least recently used idle mapping (page 0) is unmapped
+    uint8_t *addr10 = stream->open_mem(stream, (off_t)(10 * page_size), 100, &avail);
+    assert_not_null(addr10);
+    assert_size(cache->count, ==, 2);
+    assert_size(cache->n_idle, ==, 0);
+
+    // A region spanning several pages, overlapping a mapping in use
+    size_t span_offset = (9 * page_size) + 1;
+    size_t span_size = 2 * page_size;
+    uint8_t *span = stream->open_mem(stream, (off_t)span_offset, span_size, &avail);
+    assert_not_null(span);
+    assert_size(avail, ==, span_size);
+    assert_cache_region(span, span_offset, span_size);
+    assert_cache_region(addr10, 10 * page_size, 100);
+
+    // Region truncated at the end of the file
+    uint8_t *tail = stream->open_mem(stream, (off_t)(file_size - 10), 100, &avail);
+    assert_not_null(tail);
+    assert_size(avail, ==, 10);
+    assert_cache_region(tail, file_size - 10, 10);
+
+    assert_int(stream->close_mem(stream, addr5), ==, 0);
+    assert_int(stream->close_mem(stream, addr10), ==, 0);
+    assert_int(stream->close_mem(stream, span), ==, 0);
+    assert_int(stream->close_mem(stream, tail), ==, 0);
+    assert_size(cache->count, <=, 2);
+    asdf_stream_close(stream);
+    return MUNIT_OK;
+}
+
+
 MU_TEST_SUITE(
     stream,
     MU_RUN_TEST(file_scan_token_at_beginning),
@@ -248,7 +439,10 @@ MU_TEST_SUITE(
     MU_RUN_TEST(file_write),
     MU_RUN_TEST(stream_file_open_mem),
     MU_RUN_TEST(stream_mem_open_mem),
-    MU_RUN_TEST(stream_file_open_mem_realloc)
+    MU_RUN_TEST(stream_mmap_open_mem),
+    MU_RUN_TEST(stream_mmap_window),
+    MU_RUN_TEST(stream_file_open_mem_realloc),
+    MU_RUN_TEST(stream_file_open_mem_cache)
 );
 
 
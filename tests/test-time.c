@@ -240,12 +240,130 @@ MU_TEST(test_asdf_time_explicit_format_types) {
 }
 
 
+/**
+ * Check converting sequences of time strings and Julian dates in one call
+ */
+MU_TEST(test_asdf_value_as_timespec_array) {
+    asdf_file_t *file = asdf_open(NULL);
+    assert_not_null(file);
+
+    asdf_sequence_t *seq = asdf_sequence_create(file);
+    assert_not_null(seq);
+    assert_int(asdf_sequence_append_string0(seq, "2025-10-14T13:26:41.5"), ==, ASDF_VALUE_OK);
+    assert_int(asdf_sequence_append_string0(seq, "2025-10-14 15:26:41+02:00"), ==, ASDF_VALUE_OK);
+    assert_int(asdf_sequence_append_string0(seq, "2025:287:13:26:41.25"), ==, ASDF_VALUE_OK);
+    asdf_value_t *value = asdf_value_of_sequence(seq);
+
+    /* Passing no array just returns the count */
+    int count = 0;
+    assert_int(asdf_value_as_timespec_array(value, NULL, NULL, 0, &count), ==, ASDF_VALUE_OK);
+    assert_int(count, ==, 3);
+
+    struct timespec ts[3] = {0};
+    assert_int(asdf_value_as_timespec_array(value, NULL, ts, 2, NULL), ==, ASDF_VALUE_ERR_OVERFLOW);
+    assert_int(asdf_value_as_timespec_array(value, NULL, ts, 3, &count), ==, ASDF_VALUE_OK);
+    assert_int64(ts[0].tv_sec, ==, 1760448401);
+    assert_int64(ts[0].tv_nsec, ==, 500000000);
+    assert_int64(ts[1].tv_sec, ==, 1760448401);
+    assert_int64(ts[1].tv_nsec, ==, 0);
+    assert_int64(ts[2].tv_sec, ==, 1760448401);
+    assert_int64(ts[2].tv_nsec, ==, 250000000);
+
+    /* A string not in the given format fails to parse */
+    asdf_time_format_t yday = {.is_base_format = true, .type = ASDF_TIME_FORMAT_YDAY};
+    assert_int(
+        asdf_value_as_timespec_array(value, &yday, ts, 3, NULL), ==, ASDF_VALUE_ERR_PARSE_FAILURE);
+    asdf_value_destroy(value);
+
+    /* Numbers are Julian dates unless another format is given */
+    const double jds[] = {2440588.0, 2460963.0};
+    seq = asdf_sequence_of_double(file, jds, 2);
+    assert_not_null(seq);
+    value = asdf_value_of_sequence(seq);
+    assert_int(asdf_value_as_timespec_array(value, NULL, ts, 3, &count), ==, ASDF_VALUE_OK);
+    assert_int(count, ==, 2);
+    assert_int64(ts[0].tv_sec, ==, 43200);
+    assert_int64(ts[1].tv_sec, ==, 1760443200);
+
+    asdf_time_format_t mjd = {.is_base_format = true, .type = ASDF_TIME_FORMAT_MJD};
+    assert_int(asdf_value_as_timespec_array(value, &mjd, ts, 3, NULL), ==, ASDF_VALUE_OK);
+    assert_int64(ts[0].tv_sec, ==, 207360086400);
+    asdf_value_destroy(value);
+
+    /* UNIX times are rounded to the nearest nanosecond, carrying into the seconds */
+    const double unix_times[] = {3.3, -1e-17, 1.001};
+    seq = asdf_sequence_of_double(file, unix_times, 3);
+    assert_not_null(seq);
+    value = asdf_value_of_sequence(seq);
+    asdf_time_format_t unix_fmt = {.is_base_format = true, .type = ASDF_TIME_FORMAT_UNIX};
+    assert_int(asdf_value_as_timespec_array(value, &unix_fmt, ts, 3, NULL), ==, ASDF_VALUE_OK);
+    assert_int64(ts[0].tv_sec, ==, 3);
+    assert_int64(ts[0].tv_nsec, ==, 300000000);
+    assert_int64(ts[1].tv_sec, ==, 0);
+    assert_int64(ts[1].tv_nsec, ==, 0);
+    assert_int64(ts[2].tv_sec, ==, 1);
+    assert_int64(ts[2].tv_nsec, ==, 1000000);
+    asdf_value_destroy(value);
+
+    /* Anything else is a type mismatch */
+    value = asdf_value_of_string0(file, "2025-10-14");
+    assert_not_null(value);
+    assert_int(
+        asdf_value_as_timespec_array(value, NULL, ts, 3, NULL), ==, ASDF_VALUE_ERR_TYPE_MISMATCH);
+    asdf_value_destroy(value);
+
+    asdf_close(file);
+    return MUNIT_OK;
+}
+
+
+/**
+ * ISO times may be just a date, but their fields must be zero-padded to their full width
+ */
+MU_TEST(test_asdf_time_iso_input) {
+    asdf_file_t *file = asdf_open(NULL);
+    assert_not_null(file);
+    asdf_time_format_t iso = {.is_base_format = true, .type = ASDF_TIME_FORMAT_ISO_TIME};
+    struct timespec ts[1] = {0};
+
+    /* A date alone is midnight UTC, whether or not the format is given */
+    asdf_sequence_t *seq = asdf_sequence_create(file);
+    assert_not_null(seq);
+    assert_int(asdf_sequence_append_string0(seq, "2025-10-14"), ==, ASDF_VALUE_OK);
+    asdf_value_t *value = asdf_value_of_sequence(seq);
+    assert_int(asdf_value_as_timespec_array(value, NULL, ts, 1, NULL), ==, ASDF_VALUE_OK);
+    assert_int64(ts[0].tv_sec, ==, 1760400000);
+    assert_int64(ts[0].tv_nsec, ==, 0);
+    assert_int(asdf_value_as_timespec_array(value, &iso, ts, 1, NULL), ==, ASDF_VALUE_OK);
+    assert_int64(ts[0].tv_sec, ==, 1760400000);
+    asdf_value_destroy(value);
+
+    /* Fields that are not zero-padded are rejected, even with an explicit iso_time format */
+    const char *unpadded[] = {"2025-1-05T01:02:03", "2025-01-5", "2025-01-05T1:02:03"};
+
+    for (size_t idx = 0; idx < sizeof(unpadded) / sizeof(unpadded[0]); idx++) {
+        seq = asdf_sequence_create(file);
+        assert_not_null(seq);
+        assert_int(asdf_sequence_append_string0(seq, unpadded[idx]), ==, ASDF_VALUE_OK);
+        value = asdf_value_of_sequence(seq);
+        assert_int(
+            asdf_value_as_timespec_array(value, &iso, ts, 1, NULL), ==, ASDF_VALUE_ERR_PARSE_FAILURE);
+        asdf_value_destroy(value);
+    }
+
+    asdf_close(file);
+    return MUNIT_OK;
+}
+
+
 MU_TEST_SUITE(
     test_asdf_time_extension,
     MU_RUN_TEST(test_asdf_time),
     MU_RUN_TEST(test_asdf_time_serialize),
     MU_RUN_TEST(test_asdf_time_format_detection),
-    MU_RUN_TEST(test_asdf_time_explicit_format_types)
+    MU_RUN_TEST(test_asdf_time_explicit_format_types),
+    MU_RUN_TEST(test_asdf_value_as_timespec_array),
+    MU_RUN_TEST(test_asdf_time_iso_input)
 );
 
 
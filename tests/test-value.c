@@ -1,8 +1,11 @@
 #include <float.h>
+#include <locale.h>
+#include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stdlib.h>
 #include <string.h>
+#include <time.h>
 
 #include <libfyaml.h>
 
@@ -795,6 +798,108 @@ MU_TEST(test_asdf_value_as_double) {
 }
 
 
+/** Tree for `test_asdf_value_number_edge_cases`, at the edges of the fast number parsers */
+static const char number_edge_tree[] =
+    "#ASDF 1.0.0\n"
+    "#ASDF_STANDARD 1.5.0\n"
+    "%YAML 1.1\n"
+    "%TAG ! tag:stsci.edu:asdf/\n"
+    "--- !core/asdf-1.1.0\n"
+    "digits18: 123456789012345678\n"
+    "digits19: 1234567890123456789\n"
+    "int64_min: -9223372036854775808\n"
+    "uint64_max: 18446744073709551615\n"
+    "leading_zero: 0755\n"
+    "hex: 0x1F\n"
+    "neg_zero: -0\n"
+    "neg_zero_float: -0.0\n"
+    "exp22: 1.5e22\n"
+    "exp23: 1.5e23\n"
+    "exp_neg22: 3e-22\n"
+    "exp_neg23: 3e-23\n"
+    "mantissa_2_53: 900719925474099.2\n"
+    "mantissa_above_2_53: 9007199254740993.0\n"
+    "long_mantissa: 0.1000000000000000055511151231257827\n"
+    "large: 1.5e300\n"
+    "...\n";
+
+
+/** Check the numbers read from `number_edge_tree` that are parsed with strtod */
+static void check_number_edge_floats(asdf_file_t *file) {
+    double val = 0.0;
+    assert_int(asdf_get_double(file, "exp23", &val), ==, ASDF_VALUE_OK);
+    assert_double(val, ==, 1.5e23);
+    assert_int(asdf_get_double(file, "exp_neg23", &val), ==, ASDF_VALUE_OK);
+    assert_double(val, ==, 3e-23);
+    assert_int(asdf_get_double(file, "mantissa_above_2_53", &val), ==, ASDF_VALUE_OK);
+    assert_double(val, ==, 9007199254740992.0);
+    assert_int(asdf_get_double(file, "long_mantissa", &val), ==, ASDF_VALUE_OK);
+    assert_double(val, ==, 0.1);
+    assert_int(asdf_get_double(file, "large", &val), ==, ASDF_VALUE_OK);
+    assert_double(val, ==, 1.5e300);
+}
+
+
+/**
+ * Numbers on either side of the limits of the fast decimal parsers must read the same as they
+ * do through libc, whatever the locale
+ */
+MU_TEST(test_asdf_value_number_edge_cases) {
+    asdf_file_t *file = asdf_open_mem(number_edge_tree, sizeof(number_edge_tree) - 1);
+    assert_not_null(file);
+
+    int64_t ival = 0;
+    assert_int(asdf_get_int64(file, "digits18", &ival), ==, ASDF_VALUE_OK);
+    assert_int64(ival, ==, INT64_C(123456789012345678));
+    assert_int(asdf_get_int64(file, "digits19", &ival), ==, ASDF_VALUE_OK);
+    assert_int64(ival, ==, INT64_C(1234567890123456789));
+    assert_int(asdf_get_int64(file, "int64_min", &ival), ==, ASDF_VALUE_OK);
+    assert_int64(ival, ==, INT64_MIN);
+    // Leading zeros and hex are left to strtoll
+    assert_int(asdf_get_int64(file, "leading_zero", &ival), ==, ASDF_VALUE_OK);
+    assert_int64(ival, ==, 0755);
+    assert_int(asdf_get_int64(file, "hex", &ival), ==, ASDF_VALUE_OK);
+    assert_int64(ival, ==, 0x1F);
+    assert_int(asdf_get_int64(file, "neg_zero", &ival), ==, ASDF_VALUE_OK);
+    assert_int64(ival, ==, 0);
+
+    uint64_t uval = 0;
+    assert_int(asdf_get_uint64(file, "uint64_max", &uval), ==, ASDF_VALUE_OK);
+    assert_uint64(uval, ==, UINT64_MAX);
+
+    double val = 0.0;
+    assert_int(asdf_get_double(file, "neg_zero_float", &val), ==, ASDF_VALUE_OK);
+    assert_double(val, ==, 0.0);
+    assert_true(signbit(val));
+    assert_int(asdf_get_double(file, "exp22", &val), ==, ASDF_VALUE_OK);
+    assert_double(val, ==, 1.5e22);
+    assert_int(asdf_get_double(file, "exp_neg22", &val), ==, ASDF_VALUE_OK);
+    assert_double(val, ==, 3e-22);
+    assert_int(asdf_get_double(file, "mantissa_2_53", &val), ==, ASDF_VALUE_OK);
+    assert_double(val, ==, 900719925474099.2);
+    check_number_edge_floats(file);
+    asdf_close(file);
+
+    // Under a locale with a decimal comma the fallback must still read ``.`` (if one of these
+    // locales is installed)
+    const char *comma_locales[] = {"de_DE.UTF-8", "fr_FR.UTF-8", "de_DE", "fr_FR"};
+
+    for (size_t idx = 0; idx < sizeof(comma_locales) / sizeof(comma_locales[0]); idx++) {
+        if (!setlocale(LC_NUMERIC, comma_locales[idx]))
+            continue;
+
+        file = asdf_open_mem(number_edge_tree, sizeof(number_edge_tree) - 1);
+        assert_not_null(file);
+        check_number_edge_floats(file);
+        asdf_close(file);
+        break;
+    }
+
+    setlocale(LC_NUMERIC, "C");
+    return MUNIT_OK;
+}
+
+
 MU_TEST(test_asdf_value_as_double_from_int) {
     /* Integer-typed values should be coercible to double */
     asdf_file_t *file = asdf_open(NULL);
@@ -1402,6 +1507,73 @@ MU_TEST(test_asdf_sequence_iter) {
 }
 
 
+static double elapsed_sec(const struct timespec *start, const struct timespec *end) {
+    return (double)(end->tv_sec - start->tv_sec) + (double)(end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+
+/**
+ * Benchmark iterating over a sequence of a million integers read back from a file
+ *
+ * Every item is handed out as a value from the file's pool.  Only logs the timings, as asserting
+ * on them would be flaky.
+ */
+MU_TEST(test_asdf_sequence_iter_benchmark) {
+    int n_items = 1000000;
+    int64_t *items = malloc(n_items * sizeof(int64_t));
+    assert_not_null(items);
+
+    for (int idx = 0; idx < n_items; idx++)
+        items[idx] = idx;
+
+    asdf_file_t *file = asdf_open(NULL);
+    assert_not_null(file);
+    asdf_sequence_t *sequence = asdf_sequence_of_int64(file, items, n_items);
+    assert_not_null(sequence);
+    assert_int(asdf_set_sequence(file, "items", sequence), ==, ASDF_VALUE_OK);
+    void *buf = NULL;
+    size_t size = 0;
+    assert_int(asdf_write_to(file, &buf, &size), ==, 0);
+    asdf_close(file);
+    free(items);
+
+    file = asdf_open((const void *)buf, size);
+    assert_not_null(file);
+    sequence = NULL;
+    assert_int(asdf_get_sequence(file, "items", &sequence), ==, ASDF_VALUE_OK);
+
+    struct timespec start;
+    struct timespec end;
+    int64_t sum = 0;
+    int count = 0;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    asdf_sequence_iter_t *iter = asdf_sequence_iter_init(sequence);
+
+    while (asdf_sequence_iter_next(&iter)) {
+        int64_t val = 0;
+        assert_int(asdf_value_as_int64(iter->value, &val), ==, ASDF_VALUE_OK);
+        sum += val;
+        count++;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    assert_int(count, ==, n_items);
+    assert_int64(sum, ==, (int64_t)n_items * (n_items - 1) / 2);
+    double sec = elapsed_sec(&start, &end);
+    munit_logf(
+        MUNIT_LOG_INFO,
+        "iterated %d items: %.3f ms (%.1f ns/item)",
+        n_items,
+        sec * 1e3,
+        sec * 1e9 / n_items);
+
+    asdf_sequence_destroy(sequence);
+    asdf_close(file);
+    free(buf);
+    return MUNIT_OK;
+}
+
+
 MU_TEST(test_asdf_sequence_get) {
     const char *path = get_fixture_file_path("value-types.asdf");
     asdf_file_t *file = asdf_open(path, "r");
@@ -1506,6 +1678,78 @@ MU_TEST(test_asdf_sequence_pop) {
 }
 
 
+MU_TEST(test_asdf_sequence_as_array) {
+    asdf_file_t *file = asdf_open(NULL);
+    assert_not_null(file);
+    const double in[] = {0.0, -1.5, 2.25, 1e-7, 6.02e23, 1e300};
+    int n_in = sizeof(in) / sizeof(in[0]);
+    asdf_sequence_t *sequence = asdf_sequence_of_double(file, in, n_in);
+    assert_not_null(sequence);
+    assert_int(asdf_set_sequence(file, "doubles", sequence), ==, ASDF_VALUE_OK);
+    sequence = asdf_sequence_create(file);
+
+    for (int idx = 0; idx < 4; idx++)
+        assert_int(asdf_sequence_append_int64(sequence, (idx - 2) * 1000), ==, ASDF_VALUE_OK);
+
+    assert_int(asdf_set_sequence(file, "ints", sequence), ==, ASDF_VALUE_OK);
+    void *buf = NULL;
+    size_t size = 0;
+    assert_int(asdf_write_to(file, &buf, &size), ==, 0);
+    asdf_close(file);
+
+    file = asdf_open((const void *)buf, size);
+    assert_not_null(file);
+    sequence = NULL;
+    assert_int(asdf_get_sequence(file, "doubles", &sequence), ==, ASDF_VALUE_OK);
+
+    // Passing no array just returns the number of items
+    int count = 0;
+    assert_int(asdf_sequence_as_double_array(sequence, NULL, 0, &count), ==, ASDF_VALUE_OK);
+    assert_int(count, ==, n_in);
+
+    double out[8] = {0};
+    assert_int(asdf_sequence_as_double_array(sequence, out, 8, &count), ==, ASDF_VALUE_OK);
+    assert_int(count, ==, n_in);
+
+    for (int idx = 0; idx < n_in; idx++)
+        assert_double(out[idx], ==, in[idx]);
+
+    assert_int(asdf_sequence_as_double_array(sequence, out, 2, NULL), ==, ASDF_VALUE_ERR_OVERFLOW);
+    float out_f[8] = {0};
+    assert_int(
+        asdf_sequence_as_float_array(sequence, out_f, 8, NULL), ==, ASDF_VALUE_ERR_OVERFLOW);
+    int64_t out_i[8] = {0};
+    assert_int(
+        asdf_sequence_as_int64_array(sequence, out_i, 8, NULL), ==, ASDF_VALUE_ERR_TYPE_MISMATCH);
+    asdf_sequence_destroy(sequence);
+
+    sequence = NULL;
+    assert_int(asdf_get_sequence(file, "ints", &sequence), ==, ASDF_VALUE_OK);
+    assert_int(asdf_sequence_as_int64_array(sequence, out_i, 8, &count), ==, ASDF_VALUE_OK);
+    assert_int(count, ==, 4);
+
+    for (int idx = 0; idx < count; idx++)
+        assert_int64(out_i[idx], ==, (idx - 2) * 1000);
+
+    assert_int(asdf_sequence_as_double_array(sequence, out, 8, NULL), ==, ASDF_VALUE_OK);
+    assert_double(out[0], ==, -2000.0);
+    int8_t out_i8[8] = {0};
+    assert_int(
+        asdf_sequence_as_int8_array(sequence, out_i8, 8, NULL), ==, ASDF_VALUE_ERR_OVERFLOW);
+    asdf_sequence_destroy(sequence);
+
+    // The file-level getters
+    assert_int(asdf_get_double_array(file, "doubles", out, 8, &count), ==, ASDF_VALUE_OK);
+    assert_int(count, ==, n_in);
+    assert_double(out[1], ==, -1.5);
+    assert_int(
+        asdf_get_double_array(file, "missing", out, 8, &count), ==, ASDF_VALUE_ERR_NOT_FOUND);
+    asdf_close(file);
+    free(buf);
+    return MUNIT_OK;
+}
+
+
 MU_TEST(test_asdf_container_iter) {
     const char *path = get_fixture_file_path("value-types.asdf");
     asdf_file_t *file = asdf_open(path, "r");
@@ -1870,6 +2114,88 @@ MU_TEST(test_asdf_value_find_on_scalar) {
 }
 
 
+MU_TEST(test_asdf_find_by_tag) {
+    const char *filename = get_fixture_file_path("multi-block.asdf");
+    asdf_file_t *file = asdf_open(filename, "r");
+    assert_not_null(file);
+    const char *expected[] = {"/1", "/2", "/3", "/4"};
+    size_t count = 0;
+
+    // Exact tag, in document order
+    asdf_find_iter_t *iter = asdf_find_by_tag(file, ASDF_CORE_NDARRAY_TAG);
+    assert_not_null(iter);
+
+    while (asdf_value_find_iter_next(&iter)) {
+        assert_size(count, <, 4);
+        assert_string_equal(asdf_value_path(iter->value), expected[count++]);
+        assert_true(asdf_value_is_ndarray(iter->value));
+    }
+
+    assert_null(iter);
+    assert_size(count, ==, 4);
+
+    // Any version of the tag, without the tag: prefix
+    count = 0;
+    iter = asdf_find_by_tag(file, "stsci.edu:asdf/core/software");
+
+    while (asdf_value_find_iter_next(&iter))
+        count++;
+
+    assert_size(count, ==, 3);
+    assert_null(asdf_find_by_tag(file, "stsci.edu:asdf/core/nonexistent-1.0.0"));
+    assert_null(asdf_find_by_tag(file, "stsci.edu:asdf/core/ndarray-1"));
+
+    // Mapping keys
+    count = 0;
+    iter = asdf_find_by_key(file, "source");
+
+    while (asdf_value_find_iter_next(&iter)) {
+        uint64_t source = 0;
+        assert_int(asdf_value_as_uint64(iter->value, &source), ==, ASDF_VALUE_OK);
+        assert_uint64(source, ==, count++);
+    }
+
+    assert_size(count, ==, 4);
+
+    // Breaking out early
+    iter = asdf_find_by_key(file, "source");
+    assert_true(asdf_value_find_iter_next(&iter));
+    asdf_find_iter_destroy(iter);
+    asdf_close(file);
+    return MUNIT_OK;
+}
+
+
+MU_TEST(test_asdf_find_by_key_after_update) {
+    asdf_file_t *file = asdf_open(NULL);
+    assert_not_null(file);
+    assert_int(asdf_set_int64(file, "a", 1), ==, ASDF_VALUE_OK);
+    assert_int(asdf_set_int64(file, "b/a", 2), ==, ASDF_VALUE_OK);
+
+    size_t count = 0;
+    asdf_find_iter_t *iter = asdf_find_by_key(file, "a");
+
+    while (asdf_value_find_iter_next(&iter))
+        count++;
+
+    assert_size(count, ==, 2);
+
+    // Values added after the index was built are found
+    asdf_mapping_t *b = NULL;
+    assert_int(asdf_get_mapping(file, "b", &b), ==, ASDF_VALUE_OK);
+    assert_int(asdf_mapping_set_int64(b, "c", 3), ==, ASDF_VALUE_OK);
+    asdf_mapping_destroy(b);
+
+    iter = asdf_find_by_key(file, "c");
+    assert_not_null(iter);
+    assert_true(asdf_value_find_iter_next(&iter));
+    assert_string_equal(asdf_value_path(iter->value), "/b/c");
+    assert_false(asdf_value_find_iter_next(&iter));
+    asdf_close(file);
+    return MUNIT_OK;
+}
+
+
 MU_TEST(test_asdf_value_path) {
     assert_null(asdf_value_path(NULL));
     const char *filename = get_fixture_file_path("nested.asdf");
@@ -1887,6 +2213,43 @@ MU_TEST(test_asdf_value_path) {
 }
 
 
+/**
+ * Paths of values created from a parent value are built from the parent's path
+ * when asked for, and remain valid after the parent is destroyed
+ */
+MU_TEST(test_asdf_value_path_from_parent) {
+    const char *filename = get_fixture_file_path("nested.asdf");
+    asdf_file_t *file = asdf_open(filename, "r");
+    assert_not_null(file);
+    asdf_value_t *value = asdf_get_value(file, "c");
+    assert_not_null(value);
+    // The parent's path must be known for its children to build theirs from it
+    assert_string_equal(asdf_value_path(value), "/c");
+    asdf_mapping_t *mapping = NULL;
+    assert_int(asdf_value_as_mapping(value, &mapping), ==, ASDF_VALUE_OK);
+    asdf_mapping_iter_t *iter = asdf_mapping_iter_init(mapping);
+    asdf_value_t *a = NULL;
+
+    while (asdf_mapping_iter_next(&iter)) {
+        if (strcmp(iter->key, "a") == 0)
+            a = asdf_value_clone(iter->value);
+        else
+            assert_string_equal(asdf_value_path(iter->value), "/c/b");
+    }
+
+    assert_not_null(a);
+    asdf_value_t *b = asdf_mapping_get(mapping, "b");
+    assert_not_null(b);
+    asdf_value_destroy(value);
+    assert_string_equal(asdf_value_path(a), "/c/a");
+    assert_string_equal(asdf_value_path(b), "/c/b");
+    asdf_value_destroy(a);
+    asdf_value_destroy(b);
+    asdf_close(file);
+    return MUNIT_OK;
+}
+
+
 MU_TEST(test_asdf_value_parent) {
     assert_null(asdf_value_path(NULL));
     const char *filename = get_fixture_file_path("nested.asdf");
@@ -2103,6 +2466,7 @@ MU_TEST_SUITE(
     MU_RUN_TEST(test_asdf_value_as_float),
     MU_RUN_TEST(test_asdf_value_is_float),
     MU_RUN_TEST(test_asdf_value_as_double),
+    MU_RUN_TEST(test_asdf_value_number_edge_cases),
     MU_RUN_TEST(test_asdf_value_as_double_from_int),
     MU_RUN_TEST(test_asdf_value_as_type),
     MU_RUN_TEST(test_asdf_value_is_type),
@@ -2120,8 +2484,10 @@ MU_TEST_SUITE(
     MU_RUN_TEST(test_asdf_sequence_append),
     MU_RUN_TEST(test_asdf_sequence_create),
     MU_RUN_TEST(test_asdf_sequence_iter),
+    MU_RUN_TEST(test_asdf_sequence_iter_benchmark),
     MU_RUN_TEST(test_asdf_sequence_get),
     MU_RUN_TEST(test_asdf_sequence_pop),
+    MU_RUN_TEST(test_asdf_sequence_as_array),
     MU_RUN_TEST(test_asdf_container_iter),
     MU_RUN_TEST(test_asdf_container_size),
     MU_RUN_TEST(test_value_copy_with_parent_path),
@@ -2133,7 +2499,10 @@ MU_TEST_SUITE(
     MU_RUN_TEST(test_asdf_value_find_iter),
     MU_RUN_TEST(test_asdf_value_find),
     MU_RUN_TEST(test_asdf_value_find_on_scalar),
+    MU_RUN_TEST(test_asdf_find_by_tag),
+    MU_RUN_TEST(test_asdf_find_by_key_after_update),
     MU_RUN_TEST(test_asdf_value_path),
+    MU_RUN_TEST(test_asdf_value_path_from_parent),
     MU_RUN_TEST(test_asdf_value_parent),
     MU_RUN_TEST(test_asdf_value_type_string),
     MU_RUN_TEST(test_raw_value_type_preserved_after_type_resolution),